@@ -64,6 +64,9 @@ constexpr char kOptionsTag[] = "OPTIONS";
 // including the current timestamp, and "ALLOW = false" indicates the start of
 // dropping frames including the current timestamp.
 //
+// Each dropped frame increments the counter "<node name>-dropped_frames",
+// which is exported by CalculatorGraph::GetOpenMetrics().
+//
 // FlowLimiterCalculator provides limited support for multiple input streams.
 // The first input stream is treated as the main input stream and successive
 // input streams are treated as auxiliary input streams.  The auxiliary input
@@ -100,6 +103,7 @@ class FlowLimiterCalculator : public CalculatorBase {
     }
     input_queues_.resize(cc->Inputs().NumEntries(""));
     allowed_[Timestamp::Unset()] = true;
+    dropped_frames_counter_ = cc->GetCounter("dropped_frames");
     RET_CHECK_OK(CopyInputHeadersToOutputs(cc->Inputs(), &(cc->Outputs())));
     return absl::OkStatus();
   }
@@ -154,6 +158,7 @@ class FlowLimiterCalculator : public CalculatorBase {
       Packet packet = input_queue.front();
       input_queue.pop_front();
       SendAllow(false, packet.Timestamp(), cc);
+      dropped_frames_counter_->Increment();
     }
 
     // Propagate the input timestamp bound.
@@ -261,6 +266,8 @@ class FlowLimiterCalculator : public CalculatorBase {
   std::vector<std::deque<Packet>> input_queues_;
   std::deque<Timestamp> frames_in_flight_;
   std::map<Timestamp, bool> allowed_;
+  // Counts the frames dropped to limit the input queue.
+  Counter* dropped_frames_counter_ = nullptr;
 };
 REGISTER_CALCULATOR(FlowLimiterCalculator);
 
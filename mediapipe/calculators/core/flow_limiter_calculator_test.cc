@@ -213,6 +213,16 @@ TEST_F(FlowLimiterCalculatorSemaphoreTest, FramesDropped) {
   // Extra inputs on in_1 have been dropped.
   EXPECT_EQ(TimestampValues(out_1_packets_),
             (std::vector<int64_t>{0, 10, 20, 30, 40, 50, 60, 70, 80, 90}));
+
+  // The dropped frames are counted and exported.
+  EXPECT_EQ(graph_.GetCounterFactory()
+                ->GetCounter("FlowLimiterCalculator-dropped_frames")
+                ->Get(),
+            9);
+  MP_ASSERT_OK_AND_ASSIGN(std::string metrics, graph_.GetOpenMetrics());
+  EXPECT_THAT(metrics,
+              testing::HasSubstr("mediapipe_counter_total{name=\""
+                                 "FlowLimiterCalculator-dropped_frames\"} 9"));
 }
 
 // A calculator that sleeps during Process.
@@ -5,6 +5,7 @@
 
 #include "mediapipe/calculators/image/image_cropping_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/image_multi_pool.h"
 
 #if !MEDIAPIPE_DISABLE_GPU
 #include "mediapipe/gpu/gl_calculator_helper.h"
@@ -83,6 +84,8 @@ class ImageCroppingCalculator : public CalculatorBase {
   float transformed_points_[8];
   float output_max_width_ = FLT_MAX;
   float output_max_height_ = FLT_MAX;
+  // Pool of the CPU output frames, if the graph provides one.
+  ImageMultiPool* image_frame_pool_ = nullptr;
 #if !MEDIAPIPE_DISABLE_GPU
   bool gpu_initialized_ = false;
   mediapipe::GlCalculatorHelper gpu_helper_;
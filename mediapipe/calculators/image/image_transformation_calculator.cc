@@ -18,7 +18,9 @@
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/formats/image_frame_opencv.h"
+#include "mediapipe/framework/formats/image_multi_pool.h"
 #include "mediapipe/framework/formats/video_stream_header.h"
+#include "mediapipe/framework/image_frame_pool_service.h"
 #include "mediapipe/framework/packet.h"
 #include "mediapipe/framework/port/opencv_core_inc.h"
 #include "mediapipe/framework/port/opencv_imgproc_inc.h"
@@ -209,6 +211,8 @@ class ImageTransformationCalculator : public CalculatorBase {
   bool flip_vertically_ = false;
 
   bool use_gpu_ = false;
+  // Pool of the CPU output frames, if the graph provides one.
+  ImageMultiPool* image_frame_pool_ = nullptr;
   cv::Scalar padding_color_;
   ImageTransformationCalculatorOptions::InterpolationMode interpolation_mode_;
 
@@ -234,6 +238,7 @@ absl::Status ImageTransformationCalculator::GetContract(
     RET_CHECK(cc->Outputs().HasTag(kImageFrameTag));
     cc->Inputs().Tag(kImageFrameTag).Set<ImageFrame>();
     cc->Outputs().Tag(kImageFrameTag).Set<ImageFrame>();
+    cc->UseService(kImageFramePoolService).Optional();
   }
 #if !MEDIAPIPE_DISABLE_GPU
   if (cc->Inputs().HasTag(kGpuBufferTag)) {
@@ -308,6 +313,8 @@ absl::Status ImageTransformationCalculator::Open(CalculatorContext* cc) {
 
   if (cc->Inputs().HasTag(kGpuBufferTag)) {
     use_gpu_ = true;
+  } else if (cc->Service(kImageFramePoolService).IsAvailable()) {
+    image_frame_pool_ = &cc->Service(kImageFramePoolService).GetObject();
   }
 
   if (cc->InputSidePackets().HasTag("OUTPUT_DIMENSIONS")) {
@@ -561,19 +568,19 @@ absl::Status ImageTransformationCalculator::RenderCpu(CalculatorContext* cc) {
     }
   }
 
-  cv::Mat flipped_mat;
+  std::unique_ptr<ImageFrame> output_frame =
+      image_frame_pool_
+          ? image_frame_pool_->GetImageFrame(output_width, output_height,
+                                             format)
+          : std::make_unique<ImageFrame>(format, output_width, output_height);
+  cv::Mat output_mat = formats::MatView(output_frame.get());
   if (flip_horizontally_ || flip_vertically_) {
     const int flip_code =
         flip_horizontally_ && flip_vertically_ ? -1 : flip_horizontally_;
-    cv::flip(rotated_mat, flipped_mat, flip_code);
+    cv::flip(rotated_mat, output_mat, flip_code);
   } else {
-    flipped_mat = rotated_mat;
+    rotated_mat.copyTo(output_mat);
   }
-
-  std::unique_ptr<ImageFrame> output_frame(
-      new ImageFrame(format, output_width, output_height));
-  cv::Mat output_mat = formats::MatView(output_frame.get());
-  flipped_mat.copyTo(output_mat);
   cc->Outputs()
       .Tag(kImageFrameTag)
       .Add(output_frame.release(), cc->InputTimestamp());
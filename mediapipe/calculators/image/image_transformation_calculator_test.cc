@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -14,10 +15,13 @@
 #include "mediapipe/framework/formats/image_format.pb.h"
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/formats/image_frame_opencv.h"
+#include "mediapipe/framework/formats/image_multi_pool.h"
+#include "mediapipe/framework/image_frame_pool_service.h"
 #include "mediapipe/framework/port/gtest.h"
 #include "mediapipe/framework/port/opencv_imgcodecs_inc.h"
 #include "mediapipe/framework/port/opencv_imgproc_inc.h"
 #include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
 #include "mediapipe/gpu/multi_pool.h"
 #include "testing/base/public/gmock.h"
 #include "testing/base/public/googletest.h"
@@ -432,5 +436,58 @@ TEST(ImageTransformationCalculatorTest, FitScalingClearsBackground) {
             cv::Scalar(0));
 }
 
+TEST(ImageTransformationCalculatorTest, ReusesCpuOutputFramesFromGraphPool) {
+  constexpr int kWidth = 8, kHeight = 4, kNumFrames = 3;
+  ImageFrame input_image(ImageFormat::SRGB, kWidth, kHeight);
+  cv::Mat input_mat = formats::MatView(&input_image);
+  input_mat = cv::Scalar(0, 0, 0);
+  input_mat.at<cv::Vec3b>(0, 0) = cv::Vec3b(255, 0, 0);
+  Packet input_image_packet = MakePacket<ImageFrame>(std::move(input_image));
+
+  CalculatorGraphConfig graph_config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "input_image"
+        output_stream: "output_image"
+        node {
+          calculator: "ImageTransformationCalculator"
+          input_stream: "IMAGE:input_image"
+          output_stream: "IMAGE:output_image"
+          options: {
+            [mediapipe.ImageTransformationCalculatorOptions.ext]: {
+              flip_horizontally: true
+            }
+          }
+        }
+      )pb");
+
+  CalculatorGraph graph(graph_config);
+  auto pool = std::make_shared<ImageMultiPool>();
+  MP_ASSERT_OK(graph.SetServiceObject(kImageFramePoolService, pool));
+  int num_outputs = 0;
+  MP_ASSERT_OK(graph.ObserveOutputStream(
+      "output_image", [&num_outputs](const Packet& packet) {
+        const auto& output_image = packet.Get<ImageFrame>();
+        cv::Mat output_mat = formats::MatView(&output_image);
+        EXPECT_EQ(output_mat.at<cv::Vec3b>(0, kWidth - 1),
+                  cv::Vec3b(255, 0, 0));
+        EXPECT_EQ(output_mat.at<cv::Vec3b>(0, 0), cv::Vec3b(0, 0, 0));
+        ++num_outputs;
+        return absl::OkStatus();
+      }));
+  MP_ASSERT_OK(graph.StartRun({}));
+  for (int n = 0; n < kNumFrames; ++n) {
+    MP_ASSERT_OK(graph.AddPacketToInputStream(
+        "input_image", input_image_packet.At(Timestamp(n))));
+    MP_ASSERT_OK(graph.WaitUntilIdle());
+  }
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+
+  EXPECT_EQ(num_outputs, kNumFrames);
+  ImageFramePool::Stats stats = pool->GetCpuStats();
+  EXPECT_EQ(stats.num_allocations, 1);
+  EXPECT_EQ(stats.num_reuses, kNumFrames - 1);
+}
+
 }  // namespace
 }  // namespace mediapipe
@@ -30,8 +30,10 @@
 #include "mediapipe/framework/formats/image_format.pb.h"
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/formats/image_frame_opencv.h"
+#include "mediapipe/framework/formats/image_multi_pool.h"
 #include "mediapipe/framework/formats/video_stream_header.h"
 #include "mediapipe/framework/formats/yuv_image.h"
+#include "mediapipe/framework/image_frame_pool_service.h"
 #include "mediapipe/framework/port/image_resizer.h"
 #include "mediapipe/framework/port/logging.h"
 #include "mediapipe/framework/port/opencv_core_inc.h"
@@ -181,6 +183,7 @@ class ScaleImageCalculator : public CalculatorBase {
       cc->Outputs().Get(output_data_id).Set<YUVImage>();
     } else {
       cc->Outputs().Get(output_data_id).Set<ImageFrame>();
+      cc->UseService(kImageFramePoolService).Optional();
     }
 
     if (cc->Inputs().HasTag("OVERRIDE_OPTIONS")) {
@@ -215,6 +218,10 @@ class ScaleImageCalculator : public CalculatorBase {
   // on which this function is called is used to initialize.
   absl::Status ValidateYUVImage(CalculatorContext* cc,
                                 const YUVImage& yuv_image);
+  // Returns a new ImageFrame with the given format and size and
+  // alignment_boundary_, from the graph's pool if there is one.
+  std::unique_ptr<ImageFrame> NewImageFrame(ImageFormat::Format format,
+                                            int width, int height);
 
   bool has_header_;  // True if the input stream has a header.
   int input_width_;
@@ -245,6 +252,9 @@ class ScaleImageCalculator : public CalculatorBase {
 
   // Efficient image resizer with gamma correction and optional sharpening.
   std::unique_ptr<ImageResizer> downscaler_;
+
+  // Pool of the cropped and downscaled frames, if the graph provides one.
+  ImageMultiPool* image_frame_pool_ = nullptr;
 };
 
 REGISTER_CALCULATOR(ScaleImageCalculator);
@@ -319,6 +329,10 @@ absl::Status ScaleImageCalculator::Open(CalculatorContext* cc) {
   // The output packets are at the same timestamp as the input.
   cc->Outputs().Get(output_data_id_).SetOffset(mediapipe::TimestampDiff(0));
 
+  if (cc->Service(kImageFramePoolService).IsAvailable()) {
+    image_frame_pool_ = &cc->Service(kImageFramePoolService).GetObject();
+  }
+
   has_header_ = false;
   input_width_ = 0;
   input_height_ = 0;
@@ -638,8 +652,8 @@ absl::Status ScaleImageCalculator::Process(CalculatorContext* cc) {
   if (crop_width_ < input_width_ || crop_height_ < input_height_) {
     cc->GetCounter("Crops")->Increment();
     // TODO Do the crop as a range restrict inside OpenCV code below.
-    cropped_image.reset(new ImageFrame(image_frame->Format(), crop_width_,
-                                       crop_height_, alignment_boundary_));
+    cropped_image =
+        NewImageFrame(image_frame->Format(), crop_width_, crop_height_);
     if (image_frame->ByteDepth() == 1 || image_frame->ByteDepth() == 2) {
       CropImageFrame(*image_frame, col_start_, row_start_, crop_width_,
                      crop_height_, cropped_image.get());
@@ -700,19 +714,20 @@ absl::Status ScaleImageCalculator::Process(CalculatorContext* cc) {
   }
 
   // Rescale the image frame.
-  std::unique_ptr<ImageFrame> output_frame(new ImageFrame());
+  std::unique_ptr<ImageFrame> output_frame;
   if (image_frame->Width() >= output_width_ &&
       image_frame->Height() >= output_height_) {
     // Downscale.
     cc->GetCounter("Downscales")->Increment();
     cv::Mat input_mat = ::mediapipe::formats::MatView(image_frame);
-    output_frame->Reset(image_frame->Format(), output_width_, output_height_,
-                        alignment_boundary_);
+    output_frame =
+        NewImageFrame(image_frame->Format(), output_width_, output_height_);
     cv::Mat output_mat = ::mediapipe::formats::MatView(output_frame.get());
     downscaler_->Resize(input_mat, &output_mat);
   } else {
     // Upscale. If upscaling is disallowed, output_width_ and output_height_ are
     // the same as the input/crop width and height.
+    output_frame = std::make_unique<ImageFrame>();
     image_frame_util::RescaleImageFrame(
         *image_frame, output_width_, output_height_, alignment_boundary_,
         interpolation_algorithm_, output_frame.get());
@@ -733,4 +748,14 @@ absl::Status ScaleImageCalculator::Process(CalculatorContext* cc) {
   return absl::OkStatus();
 }
 
+std::unique_ptr<ImageFrame> ScaleImageCalculator::NewImageFrame(
+    ImageFormat::Format format, int width, int height) {
+  if (image_frame_pool_) {
+    return image_frame_pool_->GetImageFrame(width, height, format,
+                                            alignment_boundary_);
+  }
+  return std::make_unique<ImageFrame>(format, width, height,
+                                      alignment_boundary_);
+}
+
 }  // namespace mediapipe
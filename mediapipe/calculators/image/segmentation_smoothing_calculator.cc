@@ -23,7 +23,9 @@
 #include "mediapipe/framework/formats/image_format.pb.h"
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/threadpool.h"
 #include "mediapipe/framework/port/vector.h"
+#include "mediapipe/util/parallel_for_rows.h"
 
 #if !MEDIAPIPE_DISABLE_GPU
 #include "mediapipe/gpu/gl_calculator_helper.h"
@@ -44,6 +46,9 @@ constexpr char kCurrentMaskTag[] = "MASK";
 constexpr char kPreviousMaskTag[] = "MASK_PREVIOUS";
 constexpr char kOutputMaskTag[] = "MASK_SMOOTHED";
 
+// Smallest number of rows worth handing to another thread.
+constexpr int kMinRowsPerBand = 16;
+
 enum { ATTRIB_VERTEX, ATTRIB_TEXTURE_POSITION, NUM_ATTRIBUTES };
 }  // namespace
 
@@ -66,6 +71,7 @@ enum { ATTRIB_VERTEX, ATTRIB_TEXTURE_POSITION, NUM_ATTRIBUTES };
 //
 // Options:
 //   combine_with_previous_ratio - Amount of previous to blend with current.
+//   cpu_num_threads - Number of threads blending CPU masks.
 //
 // Example:
 //  node {
@@ -99,6 +105,8 @@ class SegmentationSmoothingCalculator : public CalculatorBase {
   void GlRender(CalculatorContext* cc);
 
   float combine_with_previous_ratio_;
+  // Blends bands of rows of CPU masks in parallel, if set.
+  std::unique_ptr<ThreadPool> thread_pool_;
 
   bool gpu_initialized_ = false;
 #if !MEDIAPIPE_DISABLE_GPU
@@ -130,6 +138,13 @@ absl::Status SegmentationSmoothingCalculator::Open(CalculatorContext* cc) {
   auto options =
       cc->Options<mediapipe::SegmentationSmoothingCalculatorOptions>();
   combine_with_previous_ratio_ = options.combine_with_previous_ratio();
+  RET_CHECK_GE(options.cpu_num_threads(), 1);
+  if (options.cpu_num_threads() > 1) {
+    // The calling thread blends rows too.
+    thread_pool_ = std::make_unique<ThreadPool>(
+        "segmentation_smoothing", options.cpu_num_threads() - 1);
+    thread_pool_->StartWorkers();
+  }
 
   return absl::OkStatus();
 }
@@ -210,10 +225,11 @@ absl::Status SegmentationSmoothingCalculator::RenderCpu(CalculatorContext* cc) {
   auto output_frame = std::make_shared<ImageFrame>(
       current_frame.image_format(), current_mat->cols, current_mat->rows);
   cv::Mat output_mat = mediapipe::formats::MatView(output_frame.get());
-  output_mat.setTo(cv::Scalar(0));
 
   // Blending function.
-  const auto blending_fn = [&](const float prev_mask_value,
+  const float combine_with_previous_ratio = combine_with_previous_ratio_;
+  const auto blending_fn = [combine_with_previous_ratio](
+                               const float prev_mask_value,
                                const float new_mask_value) {
     /*
      * Assume p := new_mask_value
@@ -237,20 +253,25 @@ absl::Status SegmentationSmoothingCalculator::RenderCpu(CalculatorContext* cc) {
         std::min(1.0f, x * (c1 + x * (c2 + x * (c3 + x * (c4 + x * c5)))));
 
     return new_mask_value + (prev_mask_value - new_mask_value) *
-                                (uncertainty * combine_with_previous_ratio_);
+                                (uncertainty * combine_with_previous_ratio);
   };
 
-  // Write directly to the first channel of output.
-  for (int i = 0; i < output_mat.rows; ++i) {
-    float* out_ptr = output_mat.ptr<float>(i);
-    const float* curr_ptr = current_mat->ptr<float>(i);
-    const float* prev_ptr = previous_mat->ptr<float>(i);
-    for (int j = 0; j < output_mat.cols; ++j) {
-      const float new_mask_value = curr_ptr[j];
-      const float prev_mask_value = prev_ptr[j];
-      out_ptr[j] = blending_fn(prev_mask_value, new_mask_value);
-    }
-  }
+  // Write directly to the first channel of output, every pixel of which is
+  // written.
+  ParallelForRows(
+      output_mat.rows, kMinRowsPerBand, thread_pool_.get(),
+      [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+          float* out_ptr = output_mat.ptr<float>(i);
+          const float* curr_ptr = current_mat->ptr<float>(i);
+          const float* prev_ptr = previous_mat->ptr<float>(i);
+          for (int j = 0; j < output_mat.cols; ++j) {
+            const float new_mask_value = curr_ptr[j];
+            const float prev_mask_value = prev_ptr[j];
+            out_ptr[j] = blending_fn(prev_mask_value, new_mask_value);
+          }
+        }
+      });
 
   cc->Outputs()
       .Tag(kOutputMaskTag)
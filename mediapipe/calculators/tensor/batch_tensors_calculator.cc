@@ -0,0 +1,168 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "mediapipe/calculators/tensor/batch_tensors_calculator.pb.h"
+#include "mediapipe/calculators/tensor/tensor_batch.h"
+#include "mediapipe/framework/api2/node.h"
+#include "mediapipe/framework/api2/packet.h"
+#include "mediapipe/framework/api2/port.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/memory_manager.h"
+#include "mediapipe/framework/memory_manager_service.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+namespace api2 {
+
+namespace {
+using Tensors = std::vector<Tensor>;
+}  // namespace
+
+// BatchTensorsCalculator combines the tensors of several inputs into one
+// batch, so that an InferenceCalculator runs the model once for the whole
+// batch. The inputs are the packets received on the "TENSORS" input streams,
+// over successive timestamps. Their tensors are concatenated along the first
+// dimension, and the batched tensors have a dynamic shape, so the model must
+// accept a variable batch size.
+//
+// A batch is emitted when it holds "max_batch_size" inputs, when an input
+// arrives "max_delay_usec" or more after the first input of the batch, and
+// on Close(). Inputs of the same timestamp always go to the same batch. The
+// batch is emitted at the timestamp of its last input, together with the
+// "BATCH" info that UnbatchTensorsCalculator uses to re-emit the inference
+// results at the original timestamps.
+//
+// Inputs:
+//   TENSORS - std::vector<Tensor>
+//     One or more streams of tensors with the same number, types and shapes
+//     of tensors.
+//
+// Outputs:
+//   TENSORS - std::vector<Tensor>
+//     The batched tensors.
+//   BATCH - TensorBatchInfo
+//     The timestamp and input stream of each input of the batch.
+//
+// Example:
+// node {
+//   calculator: "BatchTensorsCalculator"
+//   input_stream: "TENSORS:0:tensors_a"
+//   input_stream: "TENSORS:1:tensors_b"
+//   output_stream: "TENSORS:batched_tensors"
+//   output_stream: "BATCH:batch"
+//   options {
+//     [mediapipe.BatchTensorsCalculatorOptions.ext] {
+//       max_batch_size: 8
+//       max_delay_usec: 20000
+//     }
+//   }
+// }
+class BatchTensorsCalculator : public Node {
+ public:
+  static constexpr Input<Tensors>::Multiple kTensorsIn{"TENSORS"};
+  static constexpr Output<Tensors> kTensorsOut{"TENSORS"};
+  static constexpr Output<TensorBatchInfo> kBatchOut{"BATCH"};
+
+  MEDIAPIPE_NODE_CONTRACT(kTensorsIn, kTensorsOut, kBatchOut,
+                          TimestampChange::Arbitrary());
+
+  static absl::Status UpdateContract(CalculatorContract* cc) {
+    RET_CHECK_GT(kTensorsIn(cc).Count(), 0)
+        << "Must have at least one TENSORS input";
+    const auto& options = cc->Options<BatchTensorsCalculatorOptions>();
+    RET_CHECK_GE(options.max_batch_size(), kTensorsIn(cc).Count())
+        << "max_batch_size must fit the inputs of one timestamp";
+    cc->UseService(kMemoryManagerService).Optional();
+    return absl::OkStatus();
+  }
+
+  absl::Status Open(CalculatorContext* cc) override {
+    if (cc->Service(kMemoryManagerService).IsAvailable()) {
+      memory_manager_ = &cc->Service(kMemoryManagerService).GetObject();
+    }
+    const auto& options = cc->Options<BatchTensorsCalculatorOptions>();
+    max_batch_size_ = options.max_batch_size();
+    max_delay_usec_ = options.max_delay_usec();
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    int num_inputs = 0;
+    for (const auto& input : kTensorsIn(cc)) {
+      if (!input.IsEmpty()) ++num_inputs;
+    }
+    if (num_inputs == 0) return absl::OkStatus();
+
+    // Emit the pending inputs first if this timestamp does not fit the batch.
+    if (!batch_info_.empty() &&
+        (batch_info_.size() + num_inputs > max_batch_size_ ||
+         (max_delay_usec_ > 0 &&
+          cc->InputTimestamp() - batch_info_.front().timestamp >=
+              TimestampDiff(max_delay_usec_)))) {
+      MP_RETURN_IF_ERROR(SendBatch(cc));
+    }
+    for (int i = 0; i < kTensorsIn(cc).Count(); ++i) {
+      if (kTensorsIn(cc)[i].IsEmpty()) continue;
+      batch_inputs_.push_back(kTensorsIn(cc)[i]);
+      batch_info_.push_back({cc->InputTimestamp(), i});
+    }
+    if (batch_info_.size() >= max_batch_size_) {
+      MP_RETURN_IF_ERROR(SendBatch(cc));
+    }
+    return absl::OkStatus();
+  }
+
+  absl::Status Close(CalculatorContext* cc) override {
+    if (!batch_info_.empty()) {
+      MP_RETURN_IF_ERROR(SendBatch(cc));
+    }
+    return absl::OkStatus();
+  }
+
+ private:
+  // Sends the pending inputs as one batch at the timestamp of the last input.
+  absl::Status SendBatch(CalculatorContext* cc) {
+    std::vector<const Tensors*> inputs;
+    inputs.reserve(batch_inputs_.size());
+    for (const auto& packet : batch_inputs_) {
+      inputs.push_back(&*packet);
+    }
+    MP_ASSIGN_OR_RETURN(Tensors batch, BatchTensors(inputs, memory_manager_));
+    const Timestamp timestamp = batch_info_.back().timestamp;
+    kTensorsOut(cc).Send(std::move(batch), timestamp);
+    kBatchOut(cc).Send(std::move(batch_info_), timestamp);
+    batch_inputs_.clear();
+    batch_info_.clear();
+    return absl::OkStatus();
+  }
+
+  int max_batch_size_ = 0;
+  int64_t max_delay_usec_ = 0;
+  // The pending inputs and their timestamps and input streams.
+  std::vector<Packet<Tensors>> batch_inputs_;
+  TensorBatchInfo batch_info_;
+  // Enable pooling of AHWBs in Tensor instances.
+  MemoryManager* memory_manager_ = nullptr;
+};
+
+MEDIAPIPE_REGISTER_NODE(BatchTensorsCalculator);
+
+}  // namespace api2
+}  // namespace mediapipe
@@ -0,0 +1,197 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Measures throughput versus latency of batched inference for different batch
+// sizes. Each iteration batches the input tensors of "batch_size" requests as
+// BatchTensorsCalculator does, runs the model once, and splits the results as
+// UnbatchTensorsCalculator does. The time per iteration is the latency of a
+// batch, and items_per_second is the throughput in requests per second.
+//
+// BM_GraphBatching runs the same requests through a graph with the two
+// calculators around a stand-in inference node that costs a fixed overhead
+// per call, to show the per-request cost of the batching calculators.
+//
+// $ bazel run -c opt \
+//   mediapipe/calculators/tensor:batch_tensors_calculator_benchmark
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "benchmark/benchmark.h"
+#include "mediapipe/calculators/tensor/tensor_batch.h"
+#include "mediapipe/framework/api2/node.h"
+#include "mediapipe/framework/api2/port.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/interpreter_builder.h"
+#include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/model_builder.h"
+
+namespace mediapipe {
+namespace {
+
+using Tensors = std::vector<Tensor>;
+
+// Input [1 3] : F32, output [1 3] : F32. Squares its input.
+constexpr char kModelPath[] =
+    "mediapipe/calculators/tensor/testdata/1x3_square_float32.tflite";
+constexpr int kNumValues = 3;
+
+Tensors MakeRequest(float value) {
+  Tensor tensor(Tensor::ElementType::kFloat32, Tensor::Shape{1, kNumValues});
+  auto view = tensor.GetCpuWriteView();
+  for (int i = 0; i < kNumValues; ++i) view.buffer<float>()[i] = value;
+  Tensors tensors;
+  tensors.push_back(std::move(tensor));
+  return tensors;
+}
+
+void BM_BatchedInference(benchmark::State& state) {
+  const int batch_size = state.range(0);
+  auto model = tflite::FlatBufferModel::BuildFromFile(kModelPath);
+  ABSL_CHECK(model);
+  tflite::ops::builtin::BuiltinOpResolver op_resolver;
+  std::unique_ptr<tflite::Interpreter> interpreter;
+  ABSL_CHECK_EQ(tflite::InterpreterBuilder(*model, op_resolver)(&interpreter),
+                kTfLiteOk);
+  ABSL_CHECK_EQ(
+      interpreter->ResizeInputTensor(interpreter->inputs()[0],
+                                     {batch_size, kNumValues}),
+      kTfLiteOk);
+  ABSL_CHECK_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+
+  std::vector<Tensors> requests;
+  for (int i = 0; i < batch_size; ++i) {
+    requests.push_back(MakeRequest(i));
+  }
+  std::vector<const Tensors*> inputs;
+  for (const Tensors& request : requests) inputs.push_back(&request);
+
+  for (auto _ : state) {
+    auto batch = BatchTensors(inputs);
+    ABSL_CHECK_OK(batch);
+    {
+      auto view = (*batch)[0].GetCpuReadView();
+      std::memcpy(interpreter->typed_input_tensor<float>(0),
+                  view.buffer<float>(), (*batch)[0].bytes());
+    }
+    ABSL_CHECK_EQ(interpreter->Invoke(), kTfLiteOk);
+    Tensors results;
+    results.emplace_back(Tensor::ElementType::kFloat32,
+                         Tensor::Shape{batch_size, kNumValues});
+    std::memcpy(results[0].GetCpuWriteView().buffer<float>(),
+                interpreter->typed_output_tensor<float>(0),
+                results[0].bytes());
+    auto outputs = UnbatchTensors(results, batch_size);
+    ABSL_CHECK_OK(outputs);
+    benchmark::DoNotOptimize(*outputs);
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+  state.SetLabel(absl::StrCat("batch_size=", batch_size));
+}
+BENCHMARK(BM_BatchedInference)->RangeMultiplier(2)->Range(1, 64);
+
+// Stands in for an InferenceCalculator whose runner call has a fixed cost,
+// independent of the batch size.
+class FixedCostInferenceNode : public api2::Node {
+ public:
+  static constexpr api2::Input<Tensors> kIn{"TENSORS"};
+  static constexpr api2::Output<Tensors> kOut{"TENSORS"};
+  MEDIAPIPE_NODE_CONTRACT(kIn, kOut);
+
+  absl::Status Process(CalculatorContext* cc) override {
+    const absl::Time deadline = absl::Now() + absl::Microseconds(100);
+    while (absl::Now() < deadline) {
+    }
+    Tensors outputs;
+    for (const Tensor& tensor : *kIn(cc)) {
+      outputs.emplace_back(tensor.element_type(), tensor.shape());
+      std::memcpy(outputs.back().GetCpuWriteView().buffer<uint8_t>(),
+                  tensor.GetCpuReadView().buffer<uint8_t>(), tensor.bytes());
+    }
+    kOut(cc).Send(std::move(outputs));
+    return absl::OkStatus();
+  }
+};
+MEDIAPIPE_REGISTER_NODE(FixedCostInferenceNode);
+
+void BM_GraphBatching(benchmark::State& state) {
+  const int batch_size = state.range(0);
+  CalculatorGraphConfig config = ParseTextProtoOrDie<CalculatorGraphConfig>(
+      absl::StrCat(R"pb(
+                     input_stream: "tensors"
+                     output_stream: "results"
+                     node {
+                       calculator: "BatchTensorsCalculator"
+                       input_stream: "TENSORS:tensors"
+                       output_stream: "TENSORS:batched_tensors"
+                       output_stream: "BATCH:batch"
+                       options {
+                         [mediapipe.BatchTensorsCalculatorOptions.ext] {
+                           max_batch_size: )pb",
+                   batch_size, R"pb(
+                         }
+                       }
+                     }
+                     node {
+                       calculator: "FixedCostInferenceNode"
+                       input_stream: "TENSORS:batched_tensors"
+                       output_stream: "TENSORS:batched_results"
+                     }
+                     node {
+                       calculator: "UnbatchTensorsCalculator"
+                       input_stream: "TENSORS:batched_results"
+                       input_stream: "BATCH:batch"
+                       output_stream: "TENSORS:results"
+                     }
+                   )pb"));
+  CalculatorGraph graph;
+  ABSL_CHECK_OK(graph.Initialize(config));
+  auto poller = graph.AddOutputStreamPoller("results");
+  ABSL_CHECK_OK(poller);
+  ABSL_CHECK_OK(graph.StartRun({}));
+
+  int64_t t = 0;
+  for (auto _ : state) {
+    // Send one batch worth of requests, then wait for all their results.
+    for (int i = 0; i < batch_size; ++i, ++t) {
+      ABSL_CHECK_OK(graph.AddPacketToInputStream(
+          "tensors", MakePacket<Tensors>(MakeRequest(t)).At(Timestamp(t))));
+    }
+    Packet result;
+    for (int i = 0; i < batch_size; ++i) {
+      ABSL_CHECK(poller->Next(&result));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+  state.SetLabel(absl::StrCat("batch_size=", batch_size));
+  ABSL_CHECK_OK(graph.CloseAllInputStreams());
+  ABSL_CHECK_OK(graph.WaitUntilDone());
+}
+BENCHMARK(BM_GraphBatching)->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
+
+}  // namespace
+}  // namespace mediapipe
+
+BENCHMARK_MAIN();
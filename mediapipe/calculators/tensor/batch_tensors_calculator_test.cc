@@ -0,0 +1,199 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/substitute.h"
+#include "mediapipe/calculators/tensor/tensor_batch.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/timestamp.h"
+#include "mediapipe/framework/tool/sink.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+using Tensors = std::vector<Tensor>;
+
+// Returns a vector holding one 1x2 float tensor filled with "value".
+Tensors MakeTensors(float value) {
+  Tensor tensor(Tensor::ElementType::kFloat32, Tensor::Shape{1, 2});
+  float* data = tensor.GetCpuWriteView().buffer<float>();
+  data[0] = value;
+  data[1] = value;
+  Tensors tensors;
+  tensors.push_back(std::move(tensor));
+  return tensors;
+}
+
+// Returns the first value of each row of a float tensor.
+std::vector<float> RowValues(const Tensor& tensor) {
+  const float* data = tensor.GetCpuReadView().buffer<float>();
+  std::vector<float> values;
+  for (int i = 0; i < tensor.shape().dims[0]; ++i) {
+    values.push_back(data[i * 2]);
+  }
+  return values;
+}
+
+std::vector<int64_t> BatchTimestamps(const TensorBatchInfo& batch_info) {
+  std::vector<int64_t> timestamps;
+  for (const TensorBatchEntry& entry : batch_info) {
+    timestamps.push_back(entry.timestamp.Value());
+  }
+  return timestamps;
+}
+
+class BatchTensorsCalculatorTest : public testing::Test {
+ protected:
+  void RunBatchGraph(const std::string& options,
+                     const std::vector<int64_t>& timestamps) {
+    CalculatorGraphConfig config =
+        ParseTextProtoOrDie<CalculatorGraphConfig>(absl::Substitute(
+            R"pb(
+              input_stream: "tensors"
+              node {
+                calculator: "BatchTensorsCalculator"
+                input_stream: "TENSORS:tensors"
+                output_stream: "TENSORS:batched_tensors"
+                output_stream: "BATCH:batch"
+                options {
+                  [mediapipe.BatchTensorsCalculatorOptions.ext] { $0 }
+                }
+              }
+            )pb",
+            options));
+    tool::AddVectorSink("batched_tensors", &config, &batched_tensors_);
+    tool::AddVectorSink("batch", &config, &batches_);
+    MP_ASSERT_OK(graph_.Initialize(config));
+    MP_ASSERT_OK(graph_.StartRun({}));
+    for (int64_t t : timestamps) {
+      MP_ASSERT_OK(graph_.AddPacketToInputStream(
+          "tensors", MakePacket<Tensors>(MakeTensors(t)).At(Timestamp(t))));
+    }
+    MP_ASSERT_OK(graph_.CloseAllInputStreams());
+    MP_ASSERT_OK(graph_.WaitUntilDone());
+  }
+
+  CalculatorGraph graph_;
+  std::vector<Packet> batched_tensors_;
+  std::vector<Packet> batches_;
+};
+
+TEST_F(BatchTensorsCalculatorTest, EmitsFullBatchesAndRemainderOnClose) {
+  RunBatchGraph("max_batch_size: 3", {0, 1, 2, 3, 4, 5, 6});
+
+  ASSERT_EQ(batched_tensors_.size(), 3);
+  ASSERT_EQ(batches_.size(), 3);
+  EXPECT_EQ(batched_tensors_[0].Timestamp(), Timestamp(2));
+  EXPECT_EQ(batched_tensors_[1].Timestamp(), Timestamp(5));
+  EXPECT_EQ(batched_tensors_[2].Timestamp(), Timestamp(6));
+
+  const Tensor& first = batched_tensors_[0].Get<Tensors>()[0];
+  EXPECT_THAT(first.shape().dims, ElementsAre(3, 2));
+  EXPECT_TRUE(first.shape().is_dynamic);
+  EXPECT_THAT(RowValues(first), ElementsAre(0, 1, 2));
+  EXPECT_THAT(RowValues(batched_tensors_[2].Get<Tensors>()[0]),
+              ElementsAre(6));
+  EXPECT_THAT(BatchTimestamps(batches_[1].Get<TensorBatchInfo>()),
+              ElementsAre(3, 4, 5));
+}
+
+TEST_F(BatchTensorsCalculatorTest, EmitsPartialBatchAfterMaxDelay) {
+  RunBatchGraph("max_batch_size: 8 max_delay_usec: 10", {0, 5, 10, 12, 30});
+
+  ASSERT_EQ(batches_.size(), 3);
+  EXPECT_THAT(BatchTimestamps(batches_[0].Get<TensorBatchInfo>()),
+              ElementsAre(0, 5));
+  EXPECT_THAT(BatchTimestamps(batches_[1].Get<TensorBatchInfo>()),
+              ElementsAre(10, 12));
+  EXPECT_THAT(BatchTimestamps(batches_[2].Get<TensorBatchInfo>()),
+              ElementsAre(30));
+  EXPECT_EQ(batched_tensors_[1].Timestamp(), Timestamp(12));
+}
+
+TEST(UnbatchTensorsCalculatorTest, RestoresTimestampsAndStreams) {
+  CalculatorGraphConfig config = ParseTextProtoOrDie<CalculatorGraphConfig>(
+      R"pb(
+        input_stream: "tensors_a"
+        input_stream: "tensors_b"
+        node {
+          calculator: "BatchTensorsCalculator"
+          input_stream: "TENSORS:0:tensors_a"
+          input_stream: "TENSORS:1:tensors_b"
+          output_stream: "TENSORS:batched_tensors"
+          output_stream: "BATCH:batch"
+          options {
+            [mediapipe.BatchTensorsCalculatorOptions.ext] {
+              max_batch_size: 4
+            }
+          }
+        }
+        node {
+          calculator: "UnbatchTensorsCalculator"
+          input_stream: "TENSORS:batched_tensors"
+          input_stream: "BATCH:batch"
+          output_stream: "TENSORS:0:output_a"
+          output_stream: "TENSORS:1:output_b"
+        }
+      )pb");
+  std::vector<Packet> output_a;
+  std::vector<Packet> output_b;
+  tool::AddVectorSink("output_a", &config, &output_a);
+  tool::AddVectorSink("output_b", &config, &output_b);
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config));
+  MP_ASSERT_OK(graph.StartRun({}));
+  for (int t = 0; t < 5; ++t) {
+    MP_ASSERT_OK(graph.AddPacketToInputStream(
+        "tensors_a", MakePacket<Tensors>(MakeTensors(t)).At(Timestamp(t))));
+    // Stream "tensors_b" skips timestamp 2.
+    if (t != 2) {
+      MP_ASSERT_OK(graph.AddPacketToInputStream(
+          "tensors_b",
+          MakePacket<Tensors>(MakeTensors(100 + t)).At(Timestamp(t))));
+    }
+  }
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+
+  ASSERT_EQ(output_a.size(), 5);
+  ASSERT_EQ(output_b.size(), 4);
+  for (int t = 0; t < 5; ++t) {
+    EXPECT_EQ(output_a[t].Timestamp(), Timestamp(t));
+    const Tensor& tensor = output_a[t].Get<Tensors>()[0];
+    EXPECT_THAT(tensor.shape().dims, ElementsAre(1, 2));
+    EXPECT_THAT(RowValues(tensor), ElementsAre(t));
+  }
+  std::vector<int64_t> timestamps_b;
+  std::vector<float> values_b;
+  for (const Packet& packet : output_b) {
+    timestamps_b.push_back(packet.Timestamp().Value());
+    values_b.push_back(RowValues(packet.Get<Tensors>()[0])[0]);
+  }
+  EXPECT_THAT(timestamps_b, ElementsAre(0, 1, 3, 4));
+  EXPECT_THAT(values_b, ElementsAre(100, 101, 103, 104));
+}
+
+}  // namespace
+}  // namespace mediapipe
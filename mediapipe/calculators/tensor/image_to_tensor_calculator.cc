@@ -20,6 +20,7 @@
 #include "absl/log/absl_log.h"
 #include "mediapipe/calculators/tensor/image_to_tensor_calculator.pb.h"
 #include "mediapipe/calculators/tensor/image_to_tensor_converter.h"
+#include "mediapipe/calculators/tensor/image_to_tensor_converter_fused.h"
 #include "mediapipe/calculators/tensor/image_to_tensor_utils.h"
 #include "mediapipe/framework/api2/node.h"
 #include "mediapipe/framework/api2/packet.h"
@@ -92,9 +93,17 @@ namespace api2 {
 //     Describes region of image to extract.
 //     @Optional: rect covering the whole image is used if not specified.
 //
+//   NORM_RECTS - std::vector<NormalizedRect> @Optional
+//     Describes several regions of the image to extract into one batched
+//     tensor, e.g. one per detected hand or face, so that inference can run
+//     once for all of them. Cannot be used together with NORM_RECT. Nothing
+//     is output for an empty vector.
+//
 // Outputs:
 //   TENSORS - std::vector<Tensor>
 //     Vector containing a single Tensor populated with an extracted RGB image.
+//     With NORM_RECTS, the tensor has shape [N, height, width, channels], and
+//     its i-th image is extracted from the i-th rect.
 //   MATRIX - std::array<float, 16> @Optional
 //     An std::array<float, 16> representing a 4x4 row-major-order matrix that
 //     maps a point on the input image to a point on the output tensor, and
@@ -111,6 +120,10 @@ namespace api2 {
 //     20x20 and places it in the middle of the output image with an equal
 //     padding of 10 pixels at the top and the bottom. The resulting array is
 //     therefore [0.f, 0.25f, 0.f, 0.25f] (10/40 = 0.25f).
+//   MATRICES - std::vector<std::array<float, 16>> @Optional
+//   LETTERBOX_PADDINGS - std::vector<std::array<float, 4>> @Optional
+//     Per-rect MATRIX and LETTERBOX_PADDING when NORM_RECTS is used, which
+//     replace MATRIX and LETTERBOX_PADDING.
 //
 // Example:
 // node {
@@ -139,14 +152,21 @@ class ImageToTensorCalculator : public Node {
   static constexpr Input<GpuBuffer>::Optional kInGpu{"IMAGE_GPU"};
   static constexpr Input<mediapipe::NormalizedRect>::Optional kInNormRect{
       "NORM_RECT"};
+  static constexpr Input<std::vector<mediapipe::NormalizedRect>>::Optional
+      kInNormRects{"NORM_RECTS"};
   static constexpr Output<std::vector<Tensor>>::Optional kOutTensors{"TENSORS"};
   static constexpr Output<Tensor>::Optional kOutTensor{"TENSOR"};
   static constexpr Output<std::array<float, 4>>::Optional kOutLetterboxPadding{
       "LETTERBOX_PADDING"};
   static constexpr Output<std::array<float, 16>>::Optional kOutMatrix{"MATRIX"};
+  static constexpr Output<std::vector<std::array<float, 4>>>::Optional
+      kOutLetterboxPaddings{"LETTERBOX_PADDINGS"};
+  static constexpr Output<std::vector<std::array<float, 16>>>::Optional
+      kOutMatrices{"MATRICES"};
 
-  MEDIAPIPE_NODE_CONTRACT(kIn, kInGpu, kInNormRect, kOutTensors, kOutTensor,
-                          kOutLetterboxPadding, kOutMatrix);
+  MEDIAPIPE_NODE_CONTRACT(kIn, kInGpu, kInNormRect, kInNormRects, kOutTensors,
+                          kOutTensor, kOutLetterboxPadding, kOutMatrix,
+                          kOutLetterboxPaddings, kOutMatrices);
 
   static absl::Status UpdateContract(CalculatorContract* cc) {
     const auto& options =
@@ -157,6 +177,17 @@ class ImageToTensorCalculator : public Node {
         << "One and only one of IMAGE and IMAGE_GPU input is expected.";
     RET_CHECK(kOutTensors(cc).IsConnected() ^ kOutTensor(cc).IsConnected())
         << "One and only one of TENSORS and TENSOR output is supported.";
+    if (kInNormRects(cc).IsConnected()) {
+      RET_CHECK(!kInNormRect(cc).IsConnected())
+          << "NORM_RECT and NORM_RECTS inputs cannot be used together.";
+      RET_CHECK(!kOutLetterboxPadding(cc).IsConnected() &&
+                !kOutMatrix(cc).IsConnected())
+          << "Use LETTERBOX_PADDINGS and MATRICES outputs with NORM_RECTS.";
+    } else {
+      RET_CHECK(!kOutLetterboxPaddings(cc).IsConnected() &&
+                !kOutMatrices(cc).IsConnected())
+          << "LETTERBOX_PADDINGS and MATRICES outputs require NORM_RECTS.";
+    }
 
 #if MEDIAPIPE_DISABLE_GPU
     if (kInGpu(cc).IsConnected()) {
@@ -212,6 +243,11 @@ class ImageToTensorCalculator : public Node {
         return absl::OkStatus();
       }
     }
+    if (kInNormRects(cc).IsConnected() &&
+        (kInNormRects(cc).IsEmpty() || kInNormRects(cc)->empty())) {
+      // Timestamp bound update happens automatically.
+      return absl::OkStatus();
+    }
 
 #if MEDIAPIPE_DISABLE_GPU
     MP_ASSIGN_OR_RETURN(auto image, GetInputImage(kIn(cc)));
@@ -221,9 +257,14 @@ class ImageToTensorCalculator : public Node {
                                                  : GetInputImage(kIn(cc)));
 #endif  // MEDIAPIPE_DISABLE_GPU
 
-    RotatedRect roi = GetRoi(image->width(), image->height(), norm_rect);
     const int tensor_width = params_.output_width.value_or(image->width());
     const int tensor_height = params_.output_height.value_or(image->height());
+    if (kInNormRects(cc).IsConnected()) {
+      return ProcessBatch(cc, *image, *kInNormRects(cc), tensor_width,
+                          tensor_height);
+    }
+
+    RotatedRect roi = GetRoi(image->width(), image->height(), norm_rect);
     MP_ASSIGN_OR_RETURN(auto padding,
                         PadRoi(tensor_width, tensor_height,
                                options_.keep_aspect_ratio(), &roi));
@@ -252,6 +293,58 @@ class ImageToTensorCalculator : public Node {
                                      params_.range_max,
                                      /*tensor_buffer_offset=*/0, tensor));
 
+    SendTensor(cc, std::move(tensor));
+    return absl::OkStatus();
+  }
+
+ private:
+  // Extracts all "norm_rects" of "image" into one batched tensor.
+  absl::Status ProcessBatch(
+      CalculatorContext* cc, const Image& image,
+      const std::vector<mediapipe::NormalizedRect>& norm_rects,
+      int tensor_width, int tensor_height) {
+    std::vector<RotatedRect> rois;
+    rois.reserve(norm_rects.size());
+    auto paddings = std::make_unique<std::vector<std::array<float, 4>>>();
+    paddings->reserve(norm_rects.size());
+    for (const mediapipe::NormalizedRect& norm_rect : norm_rects) {
+      RotatedRect roi = GetRoi(image.width(), image.height(), norm_rect);
+      MP_ASSIGN_OR_RETURN(auto padding,
+                          PadRoi(tensor_width, tensor_height,
+                                 options_.keep_aspect_ratio(), &roi));
+      rois.push_back(roi);
+      paddings->push_back(padding);
+    }
+
+    MP_RETURN_IF_ERROR(InitConverterIfNecessary(cc, image));
+
+    Tensor tensor(GetOutputTensorType(image.UsesGpu(), params_),
+                  {static_cast<int>(rois.size()), tensor_height, tensor_width,
+                   GetNumOutputChannels(image)},
+                  memory_manager_);
+    MP_RETURN_IF_ERROR((image.UsesGpu() ? gpu_converter_ : cpu_converter_)
+                           ->ConvertBatch(image, rois, params_.range_min,
+                                          params_.range_max, tensor));
+
+    // The per-rect outputs are only sent along with the tensor.
+    if (kOutLetterboxPaddings(cc).IsConnected()) {
+      kOutLetterboxPaddings(cc).Send(std::move(paddings));
+    }
+    if (kOutMatrices(cc).IsConnected()) {
+      auto matrices = std::make_unique<std::vector<std::array<float, 16>>>(
+          rois.size());
+      for (int i = 0; i < rois.size(); ++i) {
+        GetRotatedSubRectToRectTransformMatrix(
+            rois[i], image.width(), image.height(),
+            /*flip_horizontally=*/false, &(*matrices)[i]);
+      }
+      kOutMatrices(cc).Send(std::move(matrices));
+    }
+    SendTensor(cc, std::move(tensor));
+    return absl::OkStatus();
+  }
+
+  void SendTensor(CalculatorContext* cc, Tensor tensor) {
     if (kOutTensors(cc).IsConnected()) {
       auto result = std::make_unique<std::vector<Tensor>>();
       result->push_back(std::move(tensor));
@@ -259,10 +352,8 @@ class ImageToTensorCalculator : public Node {
     } else {
       kOutTensor(cc).Send(std::move(tensor));
     }
-    return absl::OkStatus();
   }
 
- private:
   absl::Status InitConverterIfNecessary(CalculatorContext* cc,
                                         const Image& image) {
     // Lazy initialization of the GPU or CPU converter.
@@ -310,6 +401,16 @@ class ImageToTensorCalculator : public Node {
 #endif  // !MEDIAPIPE_DISABLE_GPU
       }
     } else {
+      if (!cpu_converter_ &&
+          options_.cpu_converter() ==
+              mediapipe::ImageToTensorCalculatorOptions::CPU_CONVERTER_FUSED) {
+        MP_ASSIGN_OR_RETURN(
+            cpu_converter_,
+            CreateFusedCpuConverter(
+                cc, GetBorderMode(options_.border_mode()),
+                GetOutputTensorType(/*uses_gpu=*/false, params_),
+                options_.cpu_num_threads()));
+      }
       if (!cpu_converter_) {
 #if !MEDIAPIPE_DISABLE_OPENCV
         MP_ASSIGN_OR_RETURN(
@@ -325,7 +426,8 @@ class ImageToTensorCalculator : public Node {
             cpu_converter_,
             CreateFrameBufferConverter(
                 cc, GetBorderMode(options_.border_mode()),
-                GetOutputTensorType(/*uses_gpu=*/false, params_)));
+                GetOutputTensorType(/*uses_gpu=*/false, params_),
+                options_.fuse_frame_buffer_yuv_conversion()));
 #else
         ABSL_LOG(FATAL) << "Cannot create image to tensor CPU converter since "
                            "MEDIAPIPE_DISABLE_OPENCV is defined and "
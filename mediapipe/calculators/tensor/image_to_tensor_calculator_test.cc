@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
+#include <cmath>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -557,6 +559,145 @@ TEST(ImageToTensorCalculatorTest, CanBeUsedWithoutGpuServiceSet) {
   MP_ASSERT_OK(graph.WaitUntilDone());
 }
 
+TEST(ImageToTensorCalculatorTest, BatchesNormRects) {
+  for (absl::string_view cpu_converter :
+       {"CPU_CONVERTER_DEFAULT", "CPU_CONVERTER_FUSED"}) {
+    SCOPED_TRACE(cpu_converter);
+    // The "single" node converts one rect per timestamp, the "batch" node all
+    // of them at timestamp 0.
+    auto graph_config = mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(
+        absl::Substitute(R"pb(
+                           input_stream: "image"
+                           input_stream: "roi"
+                           input_stream: "batch_image"
+                           input_stream: "rois"
+                           node {
+                             calculator: "ImageToTensorCalculator"
+                             input_stream: "IMAGE:image"
+                             input_stream: "NORM_RECT:roi"
+                             output_stream: "TENSOR:tensor"
+                             output_stream: "MATRIX:matrix"
+                             options {
+                               [mediapipe.ImageToTensorCalculatorOptions.ext] {
+                                 output_tensor_width: 32
+                                 output_tensor_height: 24
+                                 keep_aspect_ratio: true
+                                 output_tensor_float_range { min: -1 max: 1 }
+                                 cpu_converter: $0
+                               }
+                             }
+                           }
+                           node {
+                             calculator: "ImageToTensorCalculator"
+                             input_stream: "IMAGE:batch_image"
+                             input_stream: "NORM_RECTS:rois"
+                             output_stream: "TENSOR:batch_tensor"
+                             output_stream: "MATRICES:matrices"
+                             options {
+                               [mediapipe.ImageToTensorCalculatorOptions.ext] {
+                                 output_tensor_width: 32
+                                 output_tensor_height: 24
+                                 keep_aspect_ratio: true
+                                 output_tensor_float_range { min: -1 max: 1 }
+                                 cpu_converter: $0
+                                 cpu_num_threads: 3
+                               }
+                             }
+                           }
+                         )pb",
+                         cpu_converter));
+    std::vector<Packet> tensor_packets;
+    std::vector<Packet> matrix_packets;
+    std::vector<Packet> batch_tensor_packets;
+    std::vector<Packet> matrices_packets;
+    tool::AddVectorSink("tensor", &graph_config, &tensor_packets);
+    tool::AddVectorSink("matrix", &graph_config, &matrix_packets);
+    tool::AddVectorSink("batch_tensor", &graph_config, &batch_tensor_packets);
+    tool::AddVectorSink("matrices", &graph_config, &matrices_packets);
+
+    std::vector<mediapipe::NormalizedRect> rois(3);
+    rois[0].set_x_center(0.5f);
+    rois[0].set_y_center(0.5f);
+    rois[0].set_width(1.0f);
+    rois[0].set_height(1.0f);
+    rois[1].set_x_center(0.3f);
+    rois[1].set_y_center(0.4f);
+    rois[1].set_width(0.5f);
+    rois[1].set_height(0.3f);
+    rois[2].set_x_center(0.7f);
+    rois[2].set_y_center(0.6f);
+    rois[2].set_width(0.4f);
+    rois[2].set_height(0.6f);
+    rois[2].set_rotation(M_PI / 4.0f);
+
+    cv::Mat input(48, 64, CV_8UC3);
+    cv::randu(input, cv::Scalar::all(0), cv::Scalar::all(255));
+    CalculatorGraph graph;
+    MP_ASSERT_OK(graph.Initialize(graph_config));
+    MP_ASSERT_OK(graph.StartRun({}));
+    for (int i = 0; i < rois.size(); ++i) {
+      MP_ASSERT_OK(graph.AddPacketToInputStream(
+          "image", MakeImagePacket(input).At(Timestamp(i))));
+      MP_ASSERT_OK(graph.AddPacketToInputStream(
+          "roi", MakePacket<mediapipe::NormalizedRect>(rois[i])
+                     .At(Timestamp(i))));
+    }
+    MP_ASSERT_OK(graph.AddPacketToInputStream(
+        "batch_image", MakeImagePacket(input).At(Timestamp(0))));
+    MP_ASSERT_OK(graph.AddPacketToInputStream(
+        "rois", MakePacket<std::vector<mediapipe::NormalizedRect>>(rois).At(
+                    Timestamp(0))));
+    MP_ASSERT_OK(graph.CloseAllPacketSources());
+    MP_ASSERT_OK(graph.WaitUntilDone());
+
+    ASSERT_THAT(tensor_packets, testing::SizeIs(rois.size()));
+    ASSERT_THAT(batch_tensor_packets, testing::SizeIs(1));
+    ASSERT_THAT(matrices_packets, testing::SizeIs(1));
+    const Tensor& batch_tensor = batch_tensor_packets[0].Get<Tensor>();
+    EXPECT_EQ(batch_tensor.shape().dims, (std::vector<int>{3, 24, 32, 3}));
+    const auto& matrices =
+        matrices_packets[0].Get<std::vector<std::array<float, 16>>>();
+    ASSERT_THAT(matrices, testing::SizeIs(rois.size()));
+    auto batch_view = batch_tensor.GetCpuReadView();
+    for (int i = 0; i < rois.size(); ++i) {
+      const Tensor& tensor = tensor_packets[i].Get<Tensor>();
+      auto view = tensor.GetCpuReadView();
+      const int num_elements = tensor.shape().num_elements();
+      const float* batch_values =
+          batch_view.buffer<float>() + i * num_elements;
+      for (int j = 0; j < num_elements; ++j) {
+        ASSERT_EQ(batch_values[j], view.buffer<float>()[j])
+            << "rect " << i << " element " << j;
+      }
+      EXPECT_EQ(matrices[i],
+                (matrix_packets[i].Get<std::array<float, 16>>()));
+    }
+  }
+}
+
+TEST(ImageToTensorCalculatorTest, RejectsNormRectAndNormRects) {
+  auto graph_config =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "image"
+        input_stream: "roi"
+        input_stream: "rois"
+        node {
+          calculator: "ImageToTensorCalculator"
+          input_stream: "IMAGE:image"
+          input_stream: "NORM_RECT:roi"
+          input_stream: "NORM_RECTS:rois"
+          output_stream: "TENSORS:tensors"
+          options {
+            [mediapipe.ImageToTensorCalculatorOptions.ext] {
+              output_tensor_float_range { min: 0.0f max: 1.0f }
+            }
+          }
+        }
+      )pb");
+  CalculatorGraph graph;
+  EXPECT_FALSE(graph.Initialize(graph_config).ok());
+}
+
 #if !MEDIAPIPE_DISABLE_GPU && !MEDIAPIPE_METAL_ENABLED
 
 TEST(ImageToTensorCalculatorTest,
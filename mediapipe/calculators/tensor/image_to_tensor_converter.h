@@ -15,9 +15,13 @@
 #ifndef MEDIAPIPE_CALCULATORS_TENSOR_IMAGE_TO_TENSOR_CONVERTER_H_
 #define MEDIAPIPE_CALCULATORS_TENSOR_IMAGE_TO_TENSOR_CONVERTER_H_
 
+#include "absl/status/status.h"
+#include "absl/types/span.h"
 #include "mediapipe/calculators/tensor/image_to_tensor_utils.h"
 #include "mediapipe/framework/formats/image.h"
 #include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
 #include "mediapipe/framework/port/statusor.h"
 
 namespace mediapipe {
@@ -46,6 +50,33 @@ class ImageToTensorConverter {
                                const RotatedRect& roi, float range_min,
                                float range_max, int tensor_buffer_offset,
                                Tensor& output_tensor) = 0;
+
+  // Converts several regions of the same image into a batched tensor.
+  // @rois describes the regions of interest within the image (absolute
+  // values). Region i is written to the i-th image of @output_tensor, whose
+  // shape is [rois.size(), height, width, channels].
+  //
+  // The default implementation calls Convert once per region, with the
+  // tensor_buffer_offset of the region. Converters that only support a zero
+  // offset (GL texture and Metal) fail for more than one region. Converters
+  // that can process all regions in one pass should override it.
+  virtual absl::Status ConvertBatch(const mediapipe::Image& input,
+                                    absl::Span<const RotatedRect> rois,
+                                    float range_min, float range_max,
+                                    Tensor& output_tensor) {
+    RET_CHECK(!rois.empty()) << "No region of interest to convert.";
+    RET_CHECK_EQ(output_tensor.shape().dims.size(), 4)
+        << "Wrong output dims size: " << output_tensor.shape().dims.size();
+    RET_CHECK_EQ(output_tensor.shape().dims[0], rois.size())
+        << "The batch dimension needs to be equal to the number of ROIs.";
+    const int bytes_per_image = output_tensor.bytes() / rois.size();
+    for (int i = 0; i < rois.size(); ++i) {
+      MP_RETURN_IF_ERROR(Convert(input, rois[i], range_min, range_max,
+                                 /*tensor_buffer_offset=*/i * bytes_per_image,
+                                 output_tensor));
+    }
+    return absl::OkStatus();
+  }
 };
 
 }  // namespace mediapipe
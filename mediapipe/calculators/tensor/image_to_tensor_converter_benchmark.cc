@@ -0,0 +1,156 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Compares the CPU image-to-tensor converters on a rotated crop of a 720p
+// image, as done for the ROIs of landmark models. The OpenCV converter warps
+// into an intermediate image, drops alpha into another one and then converts
+// the range, while the fused converter writes the tensor in a single pass.
+// The batch benchmarks convert several ROIs into one tensor, as done for
+// multi-hand or multi-face landmark models with NORM_RECTS.
+//
+// $ bazel run -c opt \
+//   mediapipe/calculators/tensor:image_to_tensor_converter_benchmark
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "benchmark/benchmark.h"
+#include "mediapipe/calculators/tensor/image_to_tensor_converter.h"
+#include "mediapipe/calculators/tensor/image_to_tensor_converter_fused.h"
+#include "mediapipe/calculators/tensor/image_to_tensor_converter_opencv.h"
+#include "mediapipe/calculators/tensor/image_to_tensor_utils.h"
+#include "mediapipe/framework/formats/image.h"
+#include "mediapipe/framework/formats/image_format.pb.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/formats/tensor.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr int kImageWidth = 1280;
+constexpr int kImageHeight = 720;
+
+enum class ConverterKind { kOpenCv, kFused };
+
+Image MakeImage(ImageFormat::Format format) {
+  auto frame = std::make_shared<ImageFrame>(format, kImageWidth, kImageHeight);
+  const int row_bytes = kImageWidth * frame->NumberOfChannels();
+  for (int y = 0; y < kImageHeight; ++y) {
+    uint8_t* row = frame->MutablePixelData() + y * frame->WidthStep();
+    for (int x = 0; x < row_bytes; ++x) {
+      row[x] = (x * 7 + y * 13) % 256;
+    }
+  }
+  return Image(std::move(frame));
+}
+
+// Args: output tensor side.
+void RunConverter(benchmark::State& state, ConverterKind kind,
+                  ImageFormat::Format format, Tensor::ElementType type) {
+  const int size = state.range(0);
+  Image image = MakeImage(format);
+  auto converter =
+      kind == ConverterKind::kOpenCv
+          ? CreateOpenCvConverter(/*cc=*/nullptr, BorderMode::kZero, type)
+          : CreateFusedCpuConverter(/*cc=*/nullptr, BorderMode::kZero, type);
+  ABSL_CHECK_OK(converter);
+  const int channels = format == ImageFormat::GRAY8 ? 1 : 3;
+  const RotatedRect roi{.center_x = 640,
+                        .center_y = 360,
+                        .width = 400,
+                        .height = 400,
+                        .rotation = 0.3f};
+  const float range_min = type == Tensor::ElementType::kFloat32 ? -1.0f : 0.0f;
+  const float range_max = type == Tensor::ElementType::kFloat32 ? 1.0f : 255.0f;
+  for (auto _ : state) {
+    Tensor tensor(type, Tensor::Shape{1, size, size, channels});
+    ABSL_CHECK_OK((*converter)->Convert(image, roi, range_min, range_max,
+                                        /*tensor_buffer_offset=*/0, tensor));
+    benchmark::DoNotOptimize(tensor);
+  }
+  state.SetItemsProcessed(state.iterations() * size * size);
+}
+
+void BM_OpenCvSrgbaToFloat(benchmark::State& state) {
+  RunConverter(state, ConverterKind::kOpenCv, ImageFormat::SRGBA,
+               Tensor::ElementType::kFloat32);
+}
+BENCHMARK(BM_OpenCvSrgbaToFloat)->Arg(128)->Arg(256);
+
+void BM_FusedSrgbaToFloat(benchmark::State& state) {
+  RunConverter(state, ConverterKind::kFused, ImageFormat::SRGBA,
+               Tensor::ElementType::kFloat32);
+}
+BENCHMARK(BM_FusedSrgbaToFloat)->Arg(128)->Arg(256);
+
+void BM_OpenCvSrgbToFloat(benchmark::State& state) {
+  RunConverter(state, ConverterKind::kOpenCv, ImageFormat::SRGB,
+               Tensor::ElementType::kFloat32);
+}
+BENCHMARK(BM_OpenCvSrgbToFloat)->Arg(128)->Arg(256);
+
+void BM_FusedSrgbToFloat(benchmark::State& state) {
+  RunConverter(state, ConverterKind::kFused, ImageFormat::SRGB,
+               Tensor::ElementType::kFloat32);
+}
+BENCHMARK(BM_FusedSrgbToFloat)->Arg(128)->Arg(256);
+
+void BM_OpenCvSrgbToUint8(benchmark::State& state) {
+  RunConverter(state, ConverterKind::kOpenCv, ImageFormat::SRGB,
+               Tensor::ElementType::kUInt8);
+}
+BENCHMARK(BM_OpenCvSrgbToUint8)->Arg(128)->Arg(256);
+
+void BM_FusedSrgbToUint8(benchmark::State& state) {
+  RunConverter(state, ConverterKind::kFused, ImageFormat::SRGB,
+               Tensor::ElementType::kUInt8);
+}
+BENCHMARK(BM_FusedSrgbToUint8)->Arg(128)->Arg(256);
+
+// Args: number of ROIs, number of threads. Converts 224x224 float tensors.
+void BM_FusedSrgbToFloatBatch(benchmark::State& state) {
+  constexpr int kSize = 224;
+  const int num_rois = state.range(0);
+  Image image = MakeImage(ImageFormat::SRGB);
+  auto converter = CreateFusedCpuConverter(
+      /*cc=*/nullptr, BorderMode::kZero, Tensor::ElementType::kFloat32,
+      /*num_threads=*/state.range(1));
+  ABSL_CHECK_OK(converter);
+  std::vector<RotatedRect> rois;
+  for (int i = 0; i < num_rois; ++i) {
+    rois.push_back({.center_x = 300.0f + 200.0f * i,
+                    .center_y = 360,
+                    .width = 300,
+                    .height = 300,
+                    .rotation = 0.3f * i});
+  }
+  for (auto _ : state) {
+    Tensor tensor(Tensor::ElementType::kFloat32,
+                  Tensor::Shape{num_rois, kSize, kSize, 3});
+    ABSL_CHECK_OK((*converter)->ConvertBatch(image, rois, /*range_min=*/-1.0f,
+                                             /*range_max=*/1.0f, tensor));
+    benchmark::DoNotOptimize(tensor);
+  }
+  state.SetItemsProcessed(state.iterations() * num_rois * kSize * kSize);
+}
+BENCHMARK(BM_FusedSrgbToFloatBatch)
+    ->ArgsProduct({{1, 2, 4}, {1, 2, 4}})
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace mediapipe
+
+BENCHMARK_MAIN();
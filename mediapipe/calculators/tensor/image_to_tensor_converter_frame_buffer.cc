@@ -17,6 +17,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 
 #include "absl/status/status.h"
@@ -36,6 +37,9 @@ namespace mediapipe {
 
 namespace {
 
+constexpr float kInputImageRangeMin = 0.0f;
+constexpr float kInputImageRangeMax = 255.0f;
+
 // Converts from radians (clockwise) to degrees (counter-clockwise) in [0,360).
 int RadiansToDegrees(float radians) {
   int degrees = static_cast<int>(std::round(-radians * 180 / M_PI)) % 360;
@@ -45,11 +49,46 @@ int RadiansToDegrees(float radians) {
   return degrees;
 }
 
+// Returns whether the format is one of the YUV formats that
+// frame_buffer::CropRotateResizeToTensor accepts.
+bool IsYuvFormat(FrameBuffer::Format format) {
+  return format == FrameBuffer::Format::kNV12 ||
+         format == FrameBuffer::Format::kNV21 ||
+         format == FrameBuffer::Format::kYV12 ||
+         format == FrameBuffer::Format::kYV21;
+}
+
+// Corners of the region-of-interest before rotation, as expected by
+// frame_buffer::Crop.
+struct CropPoints {
+  int left;
+  int top;
+  int right;
+  int bottom;
+};
+
+CropPoints GetCropPoints(const RotatedRect& roi, int rotation_degrees) {
+  CropPoints points;
+  if (rotation_degrees % 180 != 0) {
+    points.left = roi.center_x - roi.height / 2;
+    points.right = points.left + roi.height - 1;
+    points.top = roi.center_y - roi.width / 2;
+    points.bottom = points.top + roi.width - 1;
+  } else {
+    points.left = roi.center_x - roi.width / 2;
+    points.right = points.left + roi.width - 1;
+    points.top = roi.center_y - roi.height / 2;
+    points.bottom = points.top + roi.height - 1;
+  }
+  return points;
+}
+
 // FrameBuffer-based implementation of ImageToTensorConverter.
 class ImageToTensorFrameBufferConverter : public ImageToTensorConverter {
  public:
-  explicit ImageToTensorFrameBufferConverter(Tensor::ElementType tensor_type)
-      : tensor_type_(tensor_type) {}
+  ImageToTensorFrameBufferConverter(Tensor::ElementType tensor_type,
+                                    bool fuse_yuv_conversion)
+      : tensor_type_(tensor_type), fuse_yuv_conversion_(fuse_yuv_conversion) {}
 
   absl::Status Convert(const mediapipe::Image& input, const RotatedRect& roi,
                        float range_min, float range_max,
@@ -58,6 +97,12 @@ class ImageToTensorFrameBufferConverter : public ImageToTensorConverter {
 
  private:
   absl::Status ValidateTensorShape(const Tensor::Shape& output_shape);
+  // Converts the input into the image of `output_tensor` that starts at
+  // `tensor_buffer_offset` bytes, for batched output tensors.
+  absl::Status ConvertAtOffset(const mediapipe::Image& input,
+                               const RotatedRect& roi, float range_min,
+                               float range_max, int tensor_buffer_offset,
+                               Tensor& output_tensor);
   // Crops, rotates and resizes the input based on the provided
   // region-of-interest.
   absl::Status CropRotateResize90Degrees(
@@ -70,6 +115,7 @@ class ImageToTensorFrameBufferConverter : public ImageToTensorConverter {
       float range_max, Tensor& output_tensor);
 
   Tensor::ElementType tensor_type_;
+  bool fuse_yuv_conversion_;
 
   // Temporary buffers and their respective sizes.
   std::unique_ptr<uint8_t[]> cropped_buffer_;
@@ -78,14 +124,15 @@ class ImageToTensorFrameBufferConverter : public ImageToTensorConverter {
   size_t rotated_buffer_size_ = 0;
   std::unique_ptr<uint8_t[]> output_buffer_;
   size_t output_buffer_size_ = 0;
+  // Single-image tensor that ConvertAtOffset converts into.
+  std::unique_ptr<Tensor> image_tensor_;
 };
 
 absl::Status ImageToTensorFrameBufferConverter::Convert(
     const mediapipe::Image& input, const RotatedRect& roi, float range_min,
     float range_max, int tensor_buffer_offset, Tensor& output_tensor) {
-  // TODO: add support for non-zero tensor buffer offset.
-  RET_CHECK_EQ(tensor_buffer_offset, 0)
-      << "Non-zero tensor_buffer_offset input is not supported yet.";
+  RET_CHECK_GE(tensor_buffer_offset, 0)
+      << "The input tensor_buffer_offset needs to be non-negative.";
 
   // Range other than [0,255] is not supported for uint8 tensor outputs.
   if (tensor_type_ == Tensor::ElementType::kUInt8) {
@@ -93,15 +140,41 @@ absl::Status ImageToTensorFrameBufferConverter::Convert(
               static_cast<int>(range_max) == 255);
   }
 
-  auto input_frame =
-      input.GetGpuBuffer(/*upload_to_gpu=*/false).GetReadView<FrameBuffer>();
   const auto& output_shape = output_tensor.shape();
   MP_RETURN_IF_ERROR(ValidateTensorShape(output_shape));
+  if (output_shape.dims[0] != 1 || tensor_buffer_offset != 0) {
+    return ConvertAtOffset(input, roi, range_min, range_max,
+                           tensor_buffer_offset, output_tensor);
+  }
+
+  auto input_frame =
+      input.GetGpuBuffer(/*upload_to_gpu=*/false).GetReadView<FrameBuffer>();
   FrameBuffer::Dimension output_dimension{/*width=*/output_shape.dims[2],
                                           /*height=*/output_shape.dims[1]};
 
   // Optimized path for multiples of 90°.
   if (RadiansToDegrees(roi.rotation) % 90 == 0) {
+    const int rotation_degrees = RadiansToDegrees(roi.rotation);
+    const CropPoints crop = GetCropPoints(roi, rotation_degrees);
+    // The fused conversion needs the crop to start on a chroma sample; other
+    // crops take the path below.
+    if (fuse_yuv_conversion_ && IsYuvFormat(input_frame->format()) &&
+        crop.left % 2 == 0 && crop.top % 2 == 0) {
+      // Crops, rotates, resizes and converts YUV in a single pass.
+      float scale = 1.0f;
+      float offset = 0.0f;
+      if (tensor_type_ == Tensor::ElementType::kFloat32) {
+        MP_ASSIGN_OR_RETURN(auto transform,
+                            GetValueRangeTransformation(
+                                kInputImageRangeMin, kInputImageRangeMax,
+                                range_min, range_max));
+        scale = transform.scale;
+        offset = transform.offset;
+      }
+      return frame_buffer::CropRotateResizeToTensor(
+          *input_frame, crop.left, crop.top, crop.right, crop.bottom,
+          rotation_degrees, scale, offset, output_tensor);
+    }
     if (tensor_type_ == Tensor::ElementType::kUInt8) {
       auto view = output_tensor.GetCpuWriteView();
       uint8_t* data = view.buffer<uint8_t>();
@@ -135,13 +208,34 @@ absl::Status ImageToTensorFrameBufferConverter::ValidateTensorShape(
     const Tensor::Shape& shape) {
   RET_CHECK_EQ(shape.dims.size(), 4)
       << "Wrong output dims size: " << shape.dims.size();
-  RET_CHECK_EQ(shape.dims[0], 1)
-      << "Handling batch dimension not equal to 1 is not implemented in this "
-         "converter.";
   RET_CHECK_EQ(shape.dims[3], 3) << "Wrong output channel: " << shape.dims[3];
   return absl::OkStatus();
 }
 
+absl::Status ImageToTensorFrameBufferConverter::ConvertAtOffset(
+    const mediapipe::Image& input, const RotatedRect& roi, float range_min,
+    float range_max, int tensor_buffer_offset, Tensor& output_tensor) {
+  // The FrameBuffer operations write whole [1, height, width, 3] tensors, so
+  // the image is converted separately and then copied to its offset.
+  const auto& shape = output_tensor.shape();
+  const Tensor::Shape image_shape{1, shape.dims[1], shape.dims[2],
+                                  shape.dims[3]};
+  if (!image_tensor_ || image_tensor_->shape().dims != image_shape.dims) {
+    image_tensor_ = std::make_unique<Tensor>(tensor_type_, image_shape);
+  }
+  const size_t image_bytes = image_tensor_->bytes();
+  RET_CHECK_LE(tensor_buffer_offset + image_bytes, output_tensor.bytes())
+      << "The buffer offset + the input image size is larger than the "
+         "allocated tensor buffer.";
+  MP_RETURN_IF_ERROR(Convert(input, roi, range_min, range_max,
+                             /*tensor_buffer_offset=*/0, *image_tensor_));
+  auto image_view = image_tensor_->GetCpuReadView();
+  auto output_view = output_tensor.GetCpuWriteView();
+  std::memcpy(output_view.buffer<uint8_t>() + tensor_buffer_offset,
+              image_view.buffer<uint8_t>(), image_bytes);
+  return absl::OkStatus();
+}
+
 absl::Status ImageToTensorFrameBufferConverter::CropRotateResize90Degrees(
     std::shared_ptr<const FrameBuffer> input, const RotatedRect& roi,
     std::shared_ptr<FrameBuffer> output) {
@@ -152,19 +246,10 @@ absl::Status ImageToTensorFrameBufferConverter::CropRotateResize90Degrees(
   // First, crop and resize.
   std::shared_ptr<FrameBuffer> cropped = output;
   FrameBuffer::Dimension cropped_dims = output->dimension();
-  int left, right, top, bottom;
   if (rotation_degrees % 180 != 0) {
     cropped_dims.Swap();
-    left = roi.center_x - roi.height / 2;
-    right = left + roi.height - 1;
-    top = roi.center_y - roi.width / 2;
-    bottom = top + roi.width - 1;
-  } else {
-    left = roi.center_x - roi.width / 2;
-    right = left + roi.width - 1;
-    top = roi.center_y - roi.height / 2;
-    bottom = top + roi.height - 1;
   }
+  const CropPoints crop = GetCropPoints(roi, rotation_degrees);
   if (rotation_required || conversion_required) {
     // Create temporary FrameBuffer from recycled buffer.
     size_t cropped_buffer_size =
@@ -177,8 +262,9 @@ absl::Status ImageToTensorFrameBufferConverter::CropRotateResize90Degrees(
         cropped, frame_buffer::CreateFromRawBuffer(
                      cropped_buffer_.get(), cropped_dims, input->format()));
   }
-  MP_RETURN_IF_ERROR(
-      frame_buffer::Crop(*input, left, top, right, bottom, cropped.get()));
+  MP_RETURN_IF_ERROR(frame_buffer::Crop(*input, crop.left, crop.top,
+                                        crop.right, crop.bottom,
+                                        cropped.get()));
 
   // Then rotate if needed.
   std::shared_ptr<FrameBuffer> rotated = output;
@@ -192,9 +278,9 @@ absl::Status ImageToTensorFrameBufferConverter::CropRotateResize90Degrees(
         rotated_buffer_ = std::make_unique<uint8_t[]>(rotated_buffer_size);
         rotated_buffer_size_ = rotated_buffer_size;
       }
-      MP_ASSIGN_OR_RETURN(auto rotated, frame_buffer::CreateFromRawBuffer(
-                                            rotated_buffer_.get(), rotated_dims,
-                                            cropped->format()));
+      MP_ASSIGN_OR_RETURN(rotated, frame_buffer::CreateFromRawBuffer(
+                                       rotated_buffer_.get(), rotated_dims,
+                                       cropped->format()));
     }
     MP_RETURN_IF_ERROR(
         frame_buffer::Rotate(*cropped, rotation_degrees, rotated.get()));
@@ -213,8 +299,6 @@ absl::Status ImageToTensorFrameBufferConverter::ConvertToFloatTensor(
     std::shared_ptr<const FrameBuffer> input_frame, float range_min,
     float range_max, Tensor& output_tensor) {
   RET_CHECK(output_tensor.element_type() == Tensor::ElementType::kFloat32);
-  constexpr float kInputImageRangeMin = 0.0f;
-  constexpr float kInputImageRangeMax = 255.0f;
   MP_ASSIGN_OR_RETURN(
       auto transform,
       GetValueRangeTransformation(kInputImageRangeMin, kInputImageRangeMax,
@@ -227,7 +311,8 @@ absl::Status ImageToTensorFrameBufferConverter::ConvertToFloatTensor(
 
 absl::StatusOr<std::unique_ptr<ImageToTensorConverter>>
 CreateFrameBufferConverter(CalculatorContext* cc, BorderMode border_mode,
-                           Tensor::ElementType tensor_type) {
+                           Tensor::ElementType tensor_type,
+                           bool fuse_yuv_conversion) {
   if (tensor_type != Tensor::ElementType::kUInt8 &&
       tensor_type != Tensor::ElementType::kFloat32) {
     return absl::InvalidArgumentError(
@@ -241,7 +326,8 @@ CreateFrameBufferConverter(CalculatorContext* cc, BorderMode border_mode,
         "BorderMode::kZero is not yet supported by "
         "ImageToTensorFrameBufferConverter");
   }
-  return std::make_unique<ImageToTensorFrameBufferConverter>(tensor_type);
+  return std::make_unique<ImageToTensorFrameBufferConverter>(
+      tensor_type, fuse_yuv_conversion);
 }
 
 }  // namespace mediapipe
@@ -25,9 +25,13 @@
 namespace mediapipe {
 
 // Creates FrameBuffer-based image-to-tensor converter relying on Halide.
+// If `fuse_yuv_conversion` is true, YUV inputs are cropped, rotated, resized
+// and converted to the output tensor in a single pass, unless the crop starts
+// at an odd row or column.
 absl::StatusOr<std::unique_ptr<ImageToTensorConverter>>
 CreateFrameBufferConverter(CalculatorContext* cc, BorderMode border_mode,
-                           Tensor::ElementType tensor_type);
+                           Tensor::ElementType tensor_type,
+                           bool fuse_yuv_conversion = false);
 
 }  // namespace mediapipe
 
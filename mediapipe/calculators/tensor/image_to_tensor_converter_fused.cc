@@ -0,0 +1,349 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/image_to_tensor_converter_fused.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "mediapipe/calculators/tensor/image_to_tensor_converter.h"
+#include "mediapipe/calculators/tensor/image_to_tensor_utils.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/image.h"
+#include "mediapipe/framework/formats/image_format.pb.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/statusor.h"
+#include "mediapipe/framework/port/threadpool.h"
+#include "mediapipe/util/parallel_for_rows.h"
+
+namespace mediapipe {
+
+namespace {
+
+// Maps the output pixel (x, y) to the input image position
+//   (x0 + x * dx_x + y * dy_x, y0 + x * dx_y + y * dy_y).
+// Like the OpenCV converter, the corners of the output tensor map to the
+// corners of the ROI and pixels are sampled at their integer coordinates.
+struct Sampling {
+  float x0;
+  float y0;
+  float dx_x;
+  float dx_y;
+  float dy_x;
+  float dy_y;
+};
+
+Sampling GetSampling(const RotatedRect& roi, int output_width,
+                     int output_height) {
+  const float cos_r = std::cos(roi.rotation);
+  const float sin_r = std::sin(roi.rotation);
+  Sampling sampling;
+  sampling.dx_x = roi.width / output_width * cos_r;
+  sampling.dx_y = roi.width / output_width * sin_r;
+  sampling.dy_x = -roi.height / output_height * sin_r;
+  sampling.dy_y = roi.height / output_height * cos_r;
+  sampling.x0 =
+      roi.center_x - 0.5f * roi.width * cos_r + 0.5f * roi.height * sin_r;
+  sampling.y0 =
+      roi.center_y - 0.5f * roi.width * sin_r - 0.5f * roi.height * cos_r;
+  return sampling;
+}
+
+// Like OpenCV, sampling positions are rounded to 1/32 of a pixel so that the
+// interpolation runs on integers, with weights that sum to kWeightScale.
+constexpr int kInterBits = 5;
+constexpr int kInterTabSize = 1 << kInterBits;
+constexpr int kWeightScale = kInterTabSize * kInterTabSize;
+
+// Converts a value to the tensor element type, rounding to nearest and
+// saturating for integer types like cv::saturate_cast. Avoids std::lrint and
+// std::floor, which are library calls unless built with -ffast-math.
+template <typename T>
+inline T ConvertValue(float value) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return value;
+  } else {
+    const float clamped =
+        std::clamp(value, static_cast<float>(std::numeric_limits<T>::min()),
+                   static_cast<float>(std::numeric_limits<T>::max()));
+    return static_cast<T>(clamped >= 0.0f ? clamped + 0.5f : clamped - 0.5f);
+  }
+}
+
+inline int FloorToInt(float value) {
+  const int truncated = static_cast<int>(value);
+  return truncated - (truncated > value);
+}
+
+struct SourceImage {
+  const uint8_t* data;
+  int width;
+  int height;
+  int step;
+};
+
+// Returns channel "c" of the input pixel (x, y), which may be outside of the
+// image.
+template <int kInChannels>
+inline int BorderTap(const SourceImage& src, BorderMode border_mode, int x,
+                     int y, int c) {
+  if (x < 0 || y < 0 || x >= src.width || y >= src.height) {
+    if (border_mode == BorderMode::kZero) return 0;
+    x = std::clamp(x, 0, src.width - 1);
+    y = std::clamp(y, 0, src.height - 1);
+  }
+  return src.data[y * src.step + x * kInChannels + c];
+}
+
+// Fills one output row: samples each pixel, keeps the first kOutChannels
+// channels and writes weighted_sum * weight_scale + offset. Pixels whose 2x2
+// neighborhood is inside the image take a path without border handling.
+template <typename T, int kInChannels, int kOutChannels>
+void ConvertRow(const SourceImage& src, BorderMode border_mode,
+                const Sampling& sampling, int y, int output_width,
+                float weight_scale, float offset, T* dst) {
+  // Copies the fields to locals, as stores to "dst" may alias them when T is
+  // a byte type.
+  const uint8_t* const data = src.data;
+  const int step = src.step;
+  const int max_x = src.width - 1;
+  const int max_y = src.height - 1;
+  const float row_x = (sampling.x0 + y * sampling.dy_x) * kInterTabSize;
+  const float row_y = (sampling.y0 + y * sampling.dy_y) * kInterTabSize;
+  const float dx_x = sampling.dx_x * kInterTabSize;
+  const float dx_y = sampling.dx_y * kInterTabSize;
+  for (int x = 0; x < output_width; ++x) {
+    const int qx = FloorToInt(row_x + x * dx_x + 0.5f);
+    const int qy = FloorToInt(row_y + x * dx_y + 0.5f);
+    const int ix = qx >> kInterBits;
+    const int iy = qy >> kInterBits;
+    const int fx = qx & (kInterTabSize - 1);
+    const int fy = qy & (kInterTabSize - 1);
+    const int w00 = (kInterTabSize - fx) * (kInterTabSize - fy);
+    const int w01 = fx * (kInterTabSize - fy);
+    const int w10 = (kInterTabSize - fx) * fy;
+    const int w11 = fx * fy;
+    T* out = dst + x * kOutChannels;
+    if (ix >= 0 && iy >= 0 && ix < max_x && iy < max_y) {
+      const uint8_t* p00 = data + iy * step + ix * kInChannels;
+      const uint8_t* p10 = p00 + step;
+      for (int c = 0; c < kOutChannels; ++c) {
+        const int sum = w00 * p00[c] + w01 * p00[kInChannels + c] +
+                        w10 * p10[c] + w11 * p10[kInChannels + c];
+        out[c] = ConvertValue<T>(sum * weight_scale + offset);
+      }
+    } else {
+      for (int c = 0; c < kOutChannels; ++c) {
+        const int sum =
+            w00 * BorderTap<kInChannels>(src, border_mode, ix, iy, c) +
+            w01 * BorderTap<kInChannels>(src, border_mode, ix + 1, iy, c) +
+            w10 * BorderTap<kInChannels>(src, border_mode, ix, iy + 1, c) +
+            w11 * BorderTap<kInChannels>(src, border_mode, ix + 1, iy + 1, c);
+        out[c] = ConvertValue<T>(sum * weight_scale + offset);
+      }
+    }
+  }
+}
+
+template <typename T>
+using RowConverter = void (*)(const SourceImage& src, BorderMode border_mode,
+                              const Sampling& sampling, int y,
+                              int output_width, float weight_scale,
+                              float offset, T* dst);
+
+template <typename T>
+absl::StatusOr<RowConverter<T>> GetRowConverter(int input_channels,
+                                                int output_channels) {
+  if (input_channels == 1 && output_channels == 1) {
+    return &ConvertRow<T, 1, 1>;
+  } else if (input_channels == 3 && output_channels == 3) {
+    return &ConvertRow<T, 3, 3>;
+  } else if (input_channels == 4 && output_channels == 3) {
+    return &ConvertRow<T, 4, 3>;
+  }
+  return absl::InvalidArgumentError(
+      absl::StrCat("Unsupported conversion from ", input_channels,
+                   " input channels to ", output_channels,
+                   " output channels."));
+}
+
+class ImageToTensorFusedCpuConverter : public ImageToTensorConverter {
+ public:
+  ImageToTensorFusedCpuConverter(BorderMode border_mode,
+                                 Tensor::ElementType tensor_type,
+                                 int num_threads)
+      : border_mode_(border_mode), tensor_type_(tensor_type) {
+    if (num_threads > 1) {
+      // The calling thread converts rows too.
+      thread_pool_ = std::make_unique<ThreadPool>(
+          "image_to_tensor_fused", num_threads - 1);
+      thread_pool_->StartWorkers();
+    }
+  }
+
+  absl::Status Convert(const mediapipe::Image& input, const RotatedRect& roi,
+                       float range_min, float range_max,
+                       int tensor_buffer_offset,
+                       Tensor& output_tensor) override {
+    return ConvertRois(input, absl::MakeConstSpan(&roi, 1), range_min,
+                       range_max, tensor_buffer_offset, output_tensor);
+  }
+
+  absl::Status ConvertBatch(const mediapipe::Image& input,
+                            absl::Span<const RotatedRect> rois,
+                            float range_min, float range_max,
+                            Tensor& output_tensor) override {
+    RET_CHECK(!rois.empty()) << "No region of interest to convert.";
+    RET_CHECK_EQ(output_tensor.shape().dims.size(), 4)
+        << "Wrong output dims size: " << output_tensor.shape().dims.size();
+    RET_CHECK_EQ(output_tensor.shape().dims[0], rois.size())
+        << "The batch dimension needs to be equal to the number of ROIs.";
+    return ConvertRois(input, rois, range_min, range_max,
+                       /*tensor_buffer_offset=*/0, output_tensor);
+  }
+
+ private:
+  // Converts "rois" into consecutive images of "output_tensor", starting at
+  // "tensor_buffer_offset" bytes.
+  absl::Status ConvertRois(const mediapipe::Image& input,
+                           absl::Span<const RotatedRect> rois, float range_min,
+                           float range_max, int tensor_buffer_offset,
+                           Tensor& output_tensor) {
+    const bool is_supported_format =
+        input.image_format() == mediapipe::ImageFormat::SRGB ||
+        input.image_format() == mediapipe::ImageFormat::SRGBA ||
+        input.image_format() == mediapipe::ImageFormat::GRAY8;
+    if (!is_supported_format) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Unsupported format: ", static_cast<uint32_t>(input.image_format())));
+    }
+
+    RET_CHECK_GE(tensor_buffer_offset, 0)
+        << "The input tensor_buffer_offset needs to be non-negative.";
+    const auto& output_shape = output_tensor.shape();
+    RET_CHECK_EQ(output_shape.dims.size(), 4)
+        << "Wrong output dims size: " << output_shape.dims.size();
+    RET_CHECK_GE(output_shape.dims[0], 1)
+        << "The batch dimension needs to be equal or larger than 1.";
+    RET_CHECK(output_shape.dims[3] == 3 || output_shape.dims[3] == 1)
+        << "Wrong output channel: " << output_shape.dims[3];
+
+    std::shared_ptr<const ImageFrame> frame = input.GetImageFrameSharedPtr();
+    RET_CHECK(frame) << "The input image has no CPU data.";
+    const SourceImage src{frame->PixelData(), frame->Width(), frame->Height(),
+                          frame->WidthStep()};
+
+    constexpr float kInputImageRangeMin = 0.0f;
+    constexpr float kInputImageRangeMax = 255.0f;
+    MP_ASSIGN_OR_RETURN(
+        auto transform,
+        GetValueRangeTransformation(kInputImageRangeMin, kInputImageRangeMax,
+                                    range_min, range_max));
+
+    auto buffer_view = output_tensor.GetCpuWriteView();
+    switch (tensor_type_) {
+      case Tensor::ElementType::kInt8:
+        return ConvertToBuffer(src, frame->NumberOfChannels(), output_shape,
+                               rois, transform, tensor_buffer_offset,
+                               buffer_view.buffer<int8_t>());
+      case Tensor::ElementType::kFloat32:
+        return ConvertToBuffer(src, frame->NumberOfChannels(), output_shape,
+                               rois, transform, tensor_buffer_offset,
+                               buffer_view.buffer<float>());
+      case Tensor::ElementType::kUInt8:
+        return ConvertToBuffer(src, frame->NumberOfChannels(), output_shape,
+                               rois, transform, tensor_buffer_offset,
+                               buffer_view.buffer<uint8_t>());
+      default:
+        return absl::InvalidArgumentError(
+            absl::StrCat("Unsupported tensor type: ", tensor_type_));
+    }
+  }
+
+  template <typename T>
+  absl::Status ConvertToBuffer(const SourceImage& src, int input_channels,
+                               const Tensor::Shape& output_shape,
+                               absl::Span<const RotatedRect> rois,
+                               const ValueTransformation& transform,
+                               int tensor_buffer_offset, T* buffer) {
+    const int output_height = output_shape.dims[1];
+    const int output_width = output_shape.dims[2];
+    const int output_channels = output_shape.dims[3];
+    const int num_elements_per_img =
+        output_height * output_width * output_channels;
+    RET_CHECK_GE(output_shape.num_elements(),
+                 tensor_buffer_offset / sizeof(T) +
+                     rois.size() * num_elements_per_img)
+        << "The buffer offset + the input image size is larger than the "
+           "allocated tensor buffer.";
+    MP_ASSIGN_OR_RETURN(RowConverter<T> convert_row,
+                        GetRowConverter<T>(input_channels, output_channels));
+
+    std::vector<Sampling> samplings;
+    samplings.reserve(rois.size());
+    for (const RotatedRect& roi : rois) {
+      samplings.push_back(GetSampling(roi, output_width, output_height));
+    }
+    T* const dst = buffer + tensor_buffer_offset / sizeof(T);
+    const float weight_scale = transform.scale / kWeightScale;
+    // Row r is row r % output_height of ROI r / output_height.
+    ParallelForRows(
+        rois.size() * output_height, /*min_rows_per_band=*/1,
+        thread_pool_.get(), [&](int begin, int end) {
+          for (int r = begin; r < end; ++r) {
+            const int i = r / output_height;
+            const int y = r % output_height;
+            convert_row(src, border_mode_, samplings[i], y, output_width,
+                        weight_scale, transform.offset,
+                        dst + i * num_elements_per_img +
+                            y * output_width * output_channels);
+          }
+        });
+    return absl::OkStatus();
+  }
+
+  BorderMode border_mode_;
+  Tensor::ElementType tensor_type_;
+  std::unique_ptr<ThreadPool> thread_pool_;
+};
+
+}  // namespace
+
+absl::StatusOr<std::unique_ptr<ImageToTensorConverter>> CreateFusedCpuConverter(
+    CalculatorContext* cc, BorderMode border_mode,
+    Tensor::ElementType tensor_type, int num_threads) {
+  if (tensor_type != Tensor::ElementType::kInt8 &&
+      tensor_type != Tensor::ElementType::kFloat32 &&
+      tensor_type != Tensor::ElementType::kUInt8) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Tensor type is currently not supported by "
+                     "ImageToTensorFusedCpuConverter, type: ",
+                     tensor_type));
+  }
+  RET_CHECK_GE(num_threads, 1) << "The number of threads must be positive.";
+  return std::make_unique<ImageToTensorFusedCpuConverter>(
+      border_mode, tensor_type, num_threads);
+}
+
+}  // namespace mediapipe
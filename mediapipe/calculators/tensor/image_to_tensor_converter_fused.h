@@ -0,0 +1,45 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_CALCULATORS_TENSOR_IMAGE_TO_TENSOR_CONVERTER_FUSED_H_
+#define MEDIAPIPE_CALCULATORS_TENSOR_IMAGE_TO_TENSOR_CONVERTER_FUSED_H_
+
+#include <memory>
+
+#include "mediapipe/calculators/tensor/image_to_tensor_converter.h"
+#include "mediapipe/calculators/tensor/image_to_tensor_utils.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/statusor.h"
+
+namespace mediapipe {
+
+// Creates a CPU image-to-tensor converter that samples the ROI with bilinear
+// interpolation, drops the alpha channel and converts the values to the output
+// range in a single pass, writing straight into the output tensor. Supports
+// SRGB, SRGBA and GRAY8 input images, and float32, int8 and uint8 tensors.
+//
+// It follows the sampling conventions of the OpenCV converter, so the results
+// only differ by the rounding of the interpolated values.
+//
+// The output rows are split between "num_threads" threads: the calling thread
+// and a pool owned by the converter. ConvertBatch splits the rows of all ROIs
+// at once, so a batch is converted in a single parallel pass.
+absl::StatusOr<std::unique_ptr<ImageToTensorConverter>> CreateFusedCpuConverter(
+    CalculatorContext* cc, BorderMode border_mode,
+    Tensor::ElementType tensor_type, int num_threads = 1);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_TENSOR_IMAGE_TO_TENSOR_CONVERTER_FUSED_H_
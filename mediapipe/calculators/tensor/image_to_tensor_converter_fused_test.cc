@@ -0,0 +1,300 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/image_to_tensor_converter_fused.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "mediapipe/calculators/tensor/image_to_tensor_converter.h"
+#include "mediapipe/calculators/tensor/image_to_tensor_converter_opencv.h"
+#include "mediapipe/calculators/tensor/image_to_tensor_utils.h"
+#include "mediapipe/framework/formats/image.h"
+#include "mediapipe/framework/formats/image_format.pb.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr float kPi = 3.14159265f;
+
+Image MakeTestImage(ImageFormat::Format format, int width, int height) {
+  auto frame = std::make_shared<ImageFrame>(format, width, height);
+  const int channels = frame->NumberOfChannels();
+  for (int y = 0; y < height; ++y) {
+    uint8_t* row = frame->MutablePixelData() + y * frame->WidthStep();
+    for (int x = 0; x < width; ++x) {
+      for (int c = 0; c < channels; ++c) {
+        row[x * channels + c] = (x * 7 + y * 13 + c * 61 + x * y) % 256;
+      }
+    }
+  }
+  return Image(std::move(frame));
+}
+
+// Returns the tensor elements as floats.
+std::vector<float> GetValues(const Tensor& tensor) {
+  auto view = tensor.GetCpuReadView();
+  const int num_elements = tensor.shape().num_elements();
+  std::vector<float> values(num_elements);
+  for (int i = 0; i < num_elements; ++i) {
+    switch (tensor.element_type()) {
+      case Tensor::ElementType::kFloat32:
+        values[i] = view.buffer<float>()[i];
+        break;
+      case Tensor::ElementType::kInt8:
+        values[i] = view.buffer<int8_t>()[i];
+        break;
+      case Tensor::ElementType::kUInt8:
+        values[i] = view.buffer<uint8_t>()[i];
+        break;
+      default:
+        ADD_FAILURE() << "Unexpected tensor type.";
+    }
+  }
+  return values;
+}
+
+struct Range {
+  Tensor::ElementType type;
+  float min;
+  float max;
+};
+
+TEST(ImageToTensorConverterFusedTest, CopiesPixelsForIdentityRoi) {
+  Image image = MakeTestImage(ImageFormat::SRGBA, 20, 10);
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto converter,
+      CreateFusedCpuConverter(/*cc=*/nullptr, BorderMode::kZero,
+                              Tensor::ElementType::kUInt8));
+  Tensor tensor(Tensor::ElementType::kUInt8, Tensor::Shape{1, 10, 20, 3});
+  MP_ASSERT_OK(converter->Convert(
+      image,
+      RotatedRect{.center_x = 10, .center_y = 5, .width = 20, .height = 10},
+      /*range_min=*/0.0f, /*range_max=*/255.0f, /*tensor_buffer_offset=*/0,
+      tensor));
+
+  auto frame = image.GetImageFrameSharedPtr();
+  auto view = tensor.GetCpuReadView();
+  const uint8_t* values = view.buffer<uint8_t>();
+  for (int y = 0; y < 10; ++y) {
+    const uint8_t* row = frame->PixelData() + y * frame->WidthStep();
+    for (int x = 0; x < 20; ++x) {
+      for (int c = 0; c < 3; ++c) {
+        ASSERT_EQ(values[(y * 20 + x) * 3 + c], row[x * 4 + c])
+            << "x=" << x << " y=" << y << " c=" << c;
+      }
+    }
+  }
+}
+
+TEST(ImageToTensorConverterFusedTest, RotatesRoi) {
+  Image image = MakeTestImage(ImageFormat::GRAY8, 10, 10);
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto converter,
+      CreateFusedCpuConverter(/*cc=*/nullptr, BorderMode::kReplicate,
+                              Tensor::ElementType::kUInt8));
+  Tensor tensor(Tensor::ElementType::kUInt8, Tensor::Shape{1, 10, 10, 1});
+  // The top left corner of the ROI is (9, 0), and its top edge goes down.
+  MP_ASSERT_OK(converter->Convert(image,
+                                  RotatedRect{.center_x = 4,
+                                              .center_y = 5,
+                                              .width = 10,
+                                              .height = 10,
+                                              .rotation = kPi / 2},
+                                  /*range_min=*/0.0f, /*range_max=*/255.0f,
+                                  /*tensor_buffer_offset=*/0, tensor));
+
+  auto frame = image.GetImageFrameSharedPtr();
+  std::vector<float> values = GetValues(tensor);
+  for (int y = 0; y < 10; ++y) {
+    for (int x = 0; x < 10; ++x) {
+      ASSERT_EQ(values[y * 10 + x],
+                frame->PixelData()[x * frame->WidthStep() + 9 - y])
+          << "x=" << x << " y=" << y;
+    }
+  }
+}
+
+TEST(ImageToTensorConverterFusedTest, WritesAtBufferOffset) {
+  Image image = MakeTestImage(ImageFormat::GRAY8, 4, 4);
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto converter,
+      CreateFusedCpuConverter(/*cc=*/nullptr, BorderMode::kReplicate,
+                              Tensor::ElementType::kFloat32));
+  Tensor tensor(Tensor::ElementType::kFloat32, Tensor::Shape{2, 4, 4, 1});
+  MP_ASSERT_OK(converter->Convert(
+      image, RotatedRect{.center_x = 2, .center_y = 2, .width = 4, .height = 4},
+      /*range_min=*/0.0f, /*range_max=*/1.0f,
+      /*tensor_buffer_offset=*/16 * sizeof(float), tensor));
+
+  auto frame = image.GetImageFrameSharedPtr();
+  std::vector<float> values = GetValues(tensor);
+  for (int y = 0; y < 4; ++y) {
+    for (int x = 0; x < 4; ++x) {
+      EXPECT_FLOAT_EQ(values[16 + y * 4 + x],
+                      frame->PixelData()[y * frame->WidthStep() + x] / 255.0f);
+    }
+  }
+}
+
+TEST(ImageToTensorConverterFusedTest, RejectsTooSmallTensor) {
+  Image image = MakeTestImage(ImageFormat::SRGB, 8, 8);
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto converter,
+      CreateFusedCpuConverter(/*cc=*/nullptr, BorderMode::kZero,
+                              Tensor::ElementType::kFloat32));
+  Tensor tensor(Tensor::ElementType::kFloat32, Tensor::Shape{1, 8, 8, 3});
+  EXPECT_FALSE(converter
+                   ->Convert(image,
+                             RotatedRect{.center_x = 4,
+                                         .center_y = 4,
+                                         .width = 8,
+                                         .height = 8},
+                             /*range_min=*/0.0f, /*range_max=*/1.0f,
+                             /*tensor_buffer_offset=*/sizeof(float), tensor)
+                   .ok());
+}
+
+TEST(ImageToTensorConverterFusedTest, RejectsUnsupportedFormat) {
+  Image image(std::make_shared<ImageFrame>(ImageFormat::SRGB48, 8, 8));
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto converter,
+      CreateFusedCpuConverter(/*cc=*/nullptr, BorderMode::kZero,
+                              Tensor::ElementType::kFloat32));
+  Tensor tensor(Tensor::ElementType::kFloat32, Tensor::Shape{1, 8, 8, 3});
+  EXPECT_FALSE(converter
+                   ->Convert(image,
+                             RotatedRect{.center_x = 4,
+                                         .center_y = 4,
+                                         .width = 8,
+                                         .height = 8},
+                             /*range_min=*/0.0f, /*range_max=*/1.0f,
+                             /*tensor_buffer_offset=*/0, tensor)
+                   .ok());
+}
+
+TEST(ImageToTensorConverterFusedTest, ConvertBatchMatchesConvert) {
+  Image image = MakeTestImage(ImageFormat::SRGBA, 64, 48);
+  const std::vector<RotatedRect> rois = {
+      {.center_x = 32, .center_y = 24, .width = 64, .height = 48},
+      {.center_x = 30, .center_y = 20, .width = 40, .height = 30,
+       .rotation = kPi / 6},
+      {.center_x = 60, .center_y = 5, .width = 30, .height = 20,
+       .rotation = 1.0f}};
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto converter,
+      CreateFusedCpuConverter(/*cc=*/nullptr, BorderMode::kReplicate,
+                              Tensor::ElementType::kFloat32));
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto batch_converter,
+      CreateFusedCpuConverter(/*cc=*/nullptr, BorderMode::kReplicate,
+                              Tensor::ElementType::kFloat32,
+                              /*num_threads=*/4));
+  Tensor batch_tensor(Tensor::ElementType::kFloat32,
+                      Tensor::Shape{3, 15, 20, 3});
+  MP_ASSERT_OK(batch_converter->ConvertBatch(image, rois, /*range_min=*/-1.0f,
+                                             /*range_max=*/1.0f,
+                                             batch_tensor));
+
+  std::vector<float> batch_values = GetValues(batch_tensor);
+  for (int i = 0; i < rois.size(); ++i) {
+    Tensor tensor(Tensor::ElementType::kFloat32, Tensor::Shape{1, 15, 20, 3});
+    MP_ASSERT_OK(converter->Convert(image, rois[i], /*range_min=*/-1.0f,
+                                    /*range_max=*/1.0f,
+                                    /*tensor_buffer_offset=*/0, tensor));
+    std::vector<float> values = GetValues(tensor);
+    for (int j = 0; j < values.size(); ++j) {
+      ASSERT_EQ(batch_values[i * values.size() + j], values[j])
+          << "roi " << i << " element " << j;
+    }
+  }
+
+  Tensor wrong_batch_tensor(Tensor::ElementType::kFloat32,
+                            Tensor::Shape{2, 15, 20, 3});
+  EXPECT_FALSE(batch_converter
+                   ->ConvertBatch(image, rois, /*range_min=*/-1.0f,
+                                  /*range_max=*/1.0f, wrong_batch_tensor)
+                   .ok());
+}
+
+// The OpenCV converter interpolates with fixed-point weights and rounds the
+// interpolated pixels to integers before converting the range, so the two
+// converters may differ by up to one unit of the input range (and rounding).
+TEST(ImageToTensorConverterFusedTest, MatchesOpenCvConverter) {
+  const std::vector<ImageFormat::Format> formats = {
+      ImageFormat::SRGB, ImageFormat::SRGBA, ImageFormat::GRAY8};
+  const std::vector<Range> ranges = {
+      {Tensor::ElementType::kFloat32, -1.0f, 1.0f},
+      {Tensor::ElementType::kInt8, -128.0f, 127.0f},
+      {Tensor::ElementType::kUInt8, 0.0f, 255.0f}};
+  const std::vector<RotatedRect> rois = {
+      {.center_x = 32, .center_y = 24, .width = 64, .height = 48},
+      {.center_x = 30, .center_y = 20, .width = 40, .height = 30},
+      {.center_x = 30, .center_y = 20, .width = 40, .height = 30,
+       .rotation = kPi / 6},
+      {.center_x = 10, .center_y = 40, .width = 50, .height = 50,
+       .rotation = -kPi / 2},
+      {.center_x = 60, .center_y = 5, .width = 30, .height = 20,
+       .rotation = 1.0f}};
+
+  for (ImageFormat::Format format : formats) {
+    Image image = MakeTestImage(format, 64, 48);
+    const int channels = format == ImageFormat::GRAY8 ? 1 : 3;
+    for (const Range& range : ranges) {
+      for (BorderMode border_mode :
+           {BorderMode::kZero, BorderMode::kReplicate}) {
+        MP_ASSERT_OK_AND_ASSIGN(
+            auto fused,
+            CreateFusedCpuConverter(/*cc=*/nullptr, border_mode, range.type));
+        MP_ASSERT_OK_AND_ASSIGN(
+            auto opencv,
+            CreateOpenCvConverter(/*cc=*/nullptr, border_mode, range.type));
+        const float tolerance = (range.max - range.min) / 255.0f * 2.0f +
+                                (range.type == Tensor::ElementType::kFloat32
+                                     ? 1e-5f
+                                     : 1.0f);
+        for (int i = 0; i < rois.size(); ++i) {
+          SCOPED_TRACE(absl::StrCat(
+              "format=", format, " type=", static_cast<int>(range.type),
+              " border=", static_cast<int>(border_mode), " roi=", i));
+          Tensor fused_tensor(range.type, Tensor::Shape{1, 24, 32, channels});
+          Tensor opencv_tensor(range.type, Tensor::Shape{1, 24, 32, channels});
+          MP_ASSERT_OK(fused->Convert(image, rois[i], range.min, range.max,
+                                      /*tensor_buffer_offset=*/0,
+                                      fused_tensor));
+          MP_ASSERT_OK(opencv->Convert(image, rois[i], range.min, range.max,
+                                       /*tensor_buffer_offset=*/0,
+                                       opencv_tensor));
+          std::vector<float> fused_values = GetValues(fused_tensor);
+          std::vector<float> opencv_values = GetValues(opencv_tensor);
+          ASSERT_EQ(fused_values.size(), opencv_values.size());
+          for (int j = 0; j < fused_values.size(); ++j) {
+            ASSERT_NEAR(fused_values[j], opencv_values[j], tolerance)
+                << "element " << j;
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
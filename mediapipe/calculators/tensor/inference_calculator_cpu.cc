@@ -28,6 +28,8 @@
 #include "mediapipe/calculators/tensor/tensor_span.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/memory_manager.h"
+#include "mediapipe/framework/memory_manager_service.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status_macros.h"
 #if defined(MEDIAPIPE_ANDROID)
@@ -63,6 +65,7 @@ absl::Status InferenceCalculatorCpuImpl::UpdateContract(
       << "Either model as side packet or model path in options is required.";
 
   MP_RETURN_IF_ERROR(TensorContractCheck(cc));
+  cc->UseService(kMemoryManagerService).Optional();
 
   return absl::OkStatus();
 }
@@ -93,10 +96,19 @@ InferenceCalculatorCpuImpl::CreateInferenceRunner(CalculatorContext* cc) {
   const int interpreter_num_threads =
       cc->Options<mediapipe::InferenceCalculatorOptions>().cpu_num_thread();
   MP_ASSIGN_OR_RETURN(TfLiteDelegatePtr delegate, MaybeCreateDelegate(cc));
+  const bool enable_zero_copy_tensor_io =
+      options.delegate().tflite().enable_zero_copy_tensor_io() ||
+      options.delegate().xnnpack().enable_zero_copy_tensor_io();
+  MemoryManager* memory_manager = nullptr;
+  if (cc->Service(kMemoryManagerService).IsAvailable()) {
+    memory_manager = &cc->Service(kMemoryManagerService).GetObject();
+  }
   return CreateInferenceInterpreterDelegateRunner(
       std::move(model_packet), std::move(op_resolver_packet),
       std::move(delegate), interpreter_num_threads,
-      &options.input_output_config());
+      &options.input_output_config(), enable_zero_copy_tensor_io,
+      memory_manager, options.dynamic_shape_cache_size(),
+      [this](CalculatorContext* cc) { return MaybeCreateDelegate(cc); });
 }
 
 absl::StatusOr<TfLiteDelegatePtr>
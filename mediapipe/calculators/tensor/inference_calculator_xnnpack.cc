@@ -27,6 +27,8 @@
 #include "mediapipe/calculators/tensor/tensor_span.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/memory_manager.h"
+#include "mediapipe/framework/memory_manager_service.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status_macros.h"
 #include "tensorflow/lite/delegates/xnnpack/xnnpack_delegate.h"
@@ -56,6 +58,7 @@ class InferenceCalculatorXnnpackImpl
 absl::Status InferenceCalculatorXnnpackImpl::UpdateContract(
     CalculatorContract* cc) {
   MP_RETURN_IF_ERROR(TensorContractCheck(cc));
+  cc->UseService(kMemoryManagerService).Optional();
 
   const auto& options = cc->Options<mediapipe::InferenceCalculatorOptions>();
   RET_CHECK(!options.model_path().empty() ^ kSideInModel(cc).IsConnected())
@@ -90,11 +93,17 @@ InferenceCalculatorXnnpackImpl::CreateInferenceRunner(CalculatorContext* cc) {
       cc->Options<mediapipe::InferenceCalculatorOptions>();
   const int interpreter_num_threads = calculator_opts.cpu_num_thread();
   MP_ASSIGN_OR_RETURN(TfLiteDelegatePtr delegate, CreateDelegate(cc));
+  MemoryManager* memory_manager = nullptr;
+  if (cc->Service(kMemoryManagerService).IsAvailable()) {
+    memory_manager = &cc->Service(kMemoryManagerService).GetObject();
+  }
   return CreateInferenceInterpreterDelegateRunner(
       std::move(model_packet), std::move(op_resolver_packet),
       std::move(delegate), interpreter_num_threads,
       &calculator_opts.input_output_config(),
-      calculator_opts.delegate().xnnpack().enable_zero_copy_tensor_io());
+      calculator_opts.delegate().xnnpack().enable_zero_copy_tensor_io(),
+      memory_manager, calculator_opts.dynamic_shape_cache_size(),
+      [this](CalculatorContext* cc) { return CreateDelegate(cc); });
 }
 
 absl::StatusOr<TfLiteDelegatePtr>
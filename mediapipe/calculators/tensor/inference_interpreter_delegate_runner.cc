@@ -14,6 +14,7 @@
 
 #include "mediapipe/calculators/tensor/inference_interpreter_delegate_runner.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -23,6 +24,7 @@
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "mediapipe/calculators/tensor/inference_calculator_utils.h"
 #include "mediapipe/calculators/tensor/inference_feedback_manager.h"
 #include "mediapipe/calculators/tensor/inference_io_mapper.h"
@@ -32,6 +34,7 @@
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/mediapipe_profiling.h"
+#include "mediapipe/framework/memory_manager.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status_macros.h"
 #include "tensorflow/lite/c/c_api_types.h"
@@ -46,6 +49,50 @@ namespace {
 using Interpreter = ::tflite::Interpreter;
 using InterpreterBuilder = ::tflite::InterpreterBuilder;
 
+// An interpreter and the delegate it was built with.
+struct PreparedInterpreter {
+  // Declared first so that it is destroyed after the interpreter.
+  TfLiteDelegatePtr delegate;
+  std::unique_ptr<Interpreter> interpreter;
+};
+
+absl::StatusOr<std::unique_ptr<Interpreter>> BuildInterpreter(
+    const tflite::FlatBufferModel& model, const tflite::OpResolver& op_resolver,
+    TfLiteOpaqueDelegate* delegate, int interpreter_num_threads) {
+  InterpreterBuilder interpreter_builder(model, op_resolver);
+  if (delegate) {
+    interpreter_builder.AddDelegate(delegate);
+  }
+#if defined(__EMSCRIPTEN__)
+  interpreter_builder.SetNumThreads(1);
+#else
+  interpreter_builder.SetNumThreads(interpreter_num_threads);
+#endif  // __EMSCRIPTEN__
+  std::unique_ptr<Interpreter> interpreter;
+  RET_CHECK_EQ(interpreter_builder(&interpreter), kTfLiteOk);
+  RET_CHECK(interpreter);
+  RET_CHECK_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+  return interpreter;
+}
+
+// Returns whether the dynamic tensors of `tensor_span` have the shapes of the
+// corresponding inputs of `interpreter`.
+bool HasInputShapes(const Interpreter& interpreter,
+                    const TensorSpan& tensor_span,
+                    const std::vector<int>& input_indices) {
+  for (int i = 0; i < input_indices.size(); ++i) {
+    const Tensor& input_tensor = tensor_span[i];
+    if (!input_tensor.shape().is_dynamic) continue;
+    const TfLiteIntArray* dims =
+        interpreter.tensor(interpreter.inputs()[input_indices[i]])->dims;
+    if (absl::MakeConstSpan(dims->data, dims->size) !=
+        absl::MakeConstSpan(input_tensor.shape().dims)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 absl::Status VerifyModelTensorsForCustomAllocation(
     const Interpreter& interpreter) {
   absl::flat_hash_set<int> input_tensor_indices_set(
@@ -71,7 +118,7 @@ absl::Status VerifyModelTensorsForCustomAllocation(
 
 absl::StatusOr<std::vector<Tensor>> AllocateOutputTensors(
     const std::vector<int>& model_output_indexes,
-    const Interpreter& interpreter) {
+    const Interpreter& interpreter, MemoryManager* memory_manager) {
   std::vector<Tensor> output_tensors;
   output_tensors.reserve(model_output_indexes.size());
   for (int i = 0; i < model_output_indexes.size(); ++i) {
@@ -79,13 +126,29 @@ absl::StatusOr<std::vector<Tensor>> AllocateOutputTensors(
         interpreter.tensor(interpreter.outputs()[model_output_indexes[i]]);
     MP_ASSIGN_OR_RETURN(Tensor output_tensor,
                         CreateTensorWithTfLiteTensorSpecs(
-                            *reference_tensor, /*memory_manager=*/nullptr,
+                            *reference_tensor, memory_manager,
                             tflite::kDefaultTensorAlignment));
     output_tensors.push_back(std::move(output_tensor));
   }
   return output_tensors;
 }
 
+absl::StatusOr<Tensor> CopyIntoAlignedTensor(
+    const Tensor& input_tensor, const Tensor::CpuReadView& input_tensor_view,
+    MemoryManager* memory_manager) {
+  Tensor aligned_tensor(input_tensor.element_type(), input_tensor.shape(),
+                        input_tensor.quantization_parameters(), memory_manager,
+                        tflite::kDefaultTensorAlignment);
+  {
+    auto aligned_tensor_view = aligned_tensor.GetCpuWriteView();
+    RET_CHECK(IsAlignedWithTFLiteDefaultAlignment(
+        aligned_tensor_view.buffer<void>()));
+    std::memcpy(aligned_tensor_view.buffer<void>(),
+                input_tensor_view.buffer<const void>(), input_tensor.bytes());
+  }
+  return aligned_tensor;
+}
+
 absl::Status CopyCpuInputIntoInterpreterTensor(const Tensor& input_tensor,
                                                tflite::Interpreter& interpreter,
                                                int input_tensor_index) {
@@ -113,16 +176,26 @@ class InferenceInterpreterDelegateRunner : public InferenceRunner {
  public:
   InferenceInterpreterDelegateRunner(
       api2::Packet<TfLiteModelPtr> model,
+      api2::Packet<tflite::OpResolver> op_resolver,
       std::unique_ptr<Interpreter> interpreter, TfLiteDelegatePtr delegate,
+      int interpreter_num_threads,
       InputOutputTensorNames&& input_output_tensor_names,
       std::unique_ptr<InferenceFeedbackManager> feedback_manager,
-      bool enable_zero_copy_tensor_io)
+      bool enable_zero_copy_tensor_io, MemoryManager* memory_manager,
+      int dynamic_shape_cache_size, DelegateFactory delegate_factory)
       : model_(std::move(model)),
-        delegate_(std::move(delegate)),
-        interpreter_(std::move(interpreter)),
+        op_resolver_(std::move(op_resolver)),
+        interpreter_num_threads_(interpreter_num_threads),
         input_output_tensor_names_(std::move(input_output_tensor_names)),
         feedback_manager_(std::move(feedback_manager)),
-        enable_zero_copy_tensor_io_(enable_zero_copy_tensor_io) {}
+        enable_zero_copy_tensor_io_(enable_zero_copy_tensor_io),
+        memory_manager_(memory_manager),
+        dynamic_shape_cache_size_(dynamic_shape_cache_size),
+        delegate_factory_(std::move(delegate_factory)) {
+    interpreter_ = interpreter.get();
+    interpreters_.push_back({.delegate = std::move(delegate),
+                             .interpreter = std::move(interpreter)});
+  }
 
   absl::StatusOr<std::vector<Tensor>> Run(
       CalculatorContext* cc, const TensorSpan& tensor_span) override;
@@ -132,14 +205,107 @@ class InferenceInterpreterDelegateRunner : public InferenceRunner {
   }
 
  private:
+  // Makes `interpreter_` one with the input shapes of `tensor_span`, and
+  // returns whether its input tensors were resized.
+  absl::StatusOr<bool> PrepareInterpreter(
+      CalculatorContext* cc, const TensorSpan& tensor_span,
+      const std::vector<int>& input_indices);
+
+  // Increments the "InterpreterCacheHits" or "InterpreterCacheMisses" counter
+  // of the node.
+  void CountCacheLookup(CalculatorContext* cc, bool hit);
+
   api2::Packet<TfLiteModelPtr> model_;
-  TfLiteDelegatePtr delegate_;
-  std::unique_ptr<Interpreter> interpreter_;
+  api2::Packet<tflite::OpResolver> op_resolver_;
+  int interpreter_num_threads_;
+  // Ordered from the most to the least recently used. Holds a single
+  // interpreter unless `dynamic_shape_cache_size_` > 1.
+  std::vector<PreparedInterpreter> interpreters_;
+  // The first of `interpreters_`.
+  Interpreter* interpreter_ = nullptr;
   InputOutputTensorNames input_output_tensor_names_;
   std::unique_ptr<InferenceFeedbackManager> feedback_manager_;
   bool enable_zero_copy_tensor_io_ = false;
+  MemoryManager* memory_manager_ = nullptr;
+  int dynamic_shape_cache_size_;
+  DelegateFactory delegate_factory_;
+  // Looked up on first use.
+  Counter* cache_hits_counter_ = nullptr;
+  Counter* cache_misses_counter_ = nullptr;
 };
 
+void InferenceInterpreterDelegateRunner::CountCacheLookup(CalculatorContext* cc,
+                                                          bool hit) {
+  Counter*& counter = hit ? cache_hits_counter_ : cache_misses_counter_;
+  if (counter == nullptr) {
+    counter = cc->GetCounter(hit ? "InterpreterCacheHits"
+                                 : "InterpreterCacheMisses");
+  }
+  counter->Increment();
+}
+
+absl::StatusOr<bool> InferenceInterpreterDelegateRunner::PrepareInterpreter(
+    CalculatorContext* cc, const TensorSpan& tensor_span,
+    const std::vector<int>& input_indices) {
+  bool has_dynamic_input = false;
+  for (int i = 0; i < tensor_span.size(); ++i) {
+    has_dynamic_input |= tensor_span[i].shape().is_dynamic;
+  }
+  if (!has_dynamic_input) return false;
+  if (HasInputShapes(*interpreter_, tensor_span, input_indices)) {
+    if (dynamic_shape_cache_size_ > 1) {
+      CountCacheLookup(cc, /*hit=*/true);
+    }
+    return false;
+  }
+  if (dynamic_shape_cache_size_ > 1) {
+    auto it = std::find_if(
+        interpreters_.begin() + 1, interpreters_.end(),
+        [&](const PreparedInterpreter& prepared) {
+          return HasInputShapes(*prepared.interpreter, tensor_span,
+                                input_indices);
+        });
+    if (it != interpreters_.end()) {
+      std::rotate(interpreters_.begin(), it, it + 1);
+      interpreter_ = interpreters_.front().interpreter.get();
+      CountCacheLookup(cc, /*hit=*/true);
+      return false;
+    }
+    CountCacheLookup(cc, /*hit=*/false);
+    if (interpreters_.size() < dynamic_shape_cache_size_) {
+      PreparedInterpreter prepared;
+      if (delegate_factory_) {
+        MP_ASSIGN_OR_RETURN(prepared.delegate, delegate_factory_(cc));
+      }
+      MP_ASSIGN_OR_RETURN(
+          prepared.interpreter,
+          BuildInterpreter(*model_.Get(), op_resolver_.Get(),
+                           prepared.delegate.get(), interpreter_num_threads_));
+      interpreters_.insert(interpreters_.begin(), std::move(prepared));
+    } else {
+      // Resizes the least recently used interpreter.
+      std::rotate(interpreters_.begin(), interpreters_.end() - 1,
+                  interpreters_.end());
+    }
+    interpreter_ = interpreters_.front().interpreter.get();
+  }
+
+  bool resized_tensor_shapes = false;
+  for (int i = 0; i < input_indices.size(); ++i) {
+    const Tensor& input_tensor = tensor_span[i];
+    if (!input_tensor.shape().is_dynamic) continue;
+    const TfLiteIntArray* dims =
+        interpreter_->tensor(interpreter_->inputs()[input_indices[i]])->dims;
+    if (absl::MakeConstSpan(dims->data, dims->size) !=
+        absl::MakeConstSpan(input_tensor.shape().dims)) {
+      interpreter_->ResizeInputTensorStrict(input_indices[i],
+                                            input_tensor.shape().dims);
+      resized_tensor_shapes = true;
+    }
+  }
+  return resized_tensor_shapes;
+}
+
 absl::StatusOr<std::vector<Tensor>> InferenceInterpreterDelegateRunner::Run(
     CalculatorContext* cc, const TensorSpan& tensor_span) {
   const int num_feedback_tensors =
@@ -170,31 +336,22 @@ absl::StatusOr<std::vector<Tensor>> InferenceInterpreterDelegateRunner::Run(
     output_indices_excluding_feedback_tensors.push_back(i);
   }
 
+  // Aligned copies of the input tensors that cannot be bound directly with
+  // TfLite custom allocation.
+  std::vector<Tensor> staged_input_tensors;
+  staged_input_tensors.reserve(tensor_span.size());
   // Input tensor views for TfLite custom allocation. They must outlive the
   // inference call to provide Tensor read access to the interpreter.
   std::vector<Tensor::CpuReadView> input_tensor_views;
   input_tensor_views.reserve(tensor_span.size());
 
   // If the input tensors have dynamic shape, then the tensors need to be
-  // resized and reallocated before we can copy the tensor values.
-  bool resized_tensor_shapes = false;
-  for (int i = 0; i < input_indices_excluding_feedback_tensors.size(); ++i) {
-    const int input_tensor_index = input_indices_excluding_feedback_tensors[i];
-    const Tensor& input_tensor = tensor_span[i];
-    if (input_tensor.shape().is_dynamic) {
-      const TfLiteTensor* interpreter_tensor =
-          interpreter_->tensor(interpreter_->inputs()[input_tensor_index]);
-      // TODO: Can avoid copying even these <= 4 values in the future.
-      std::vector<int> interpreter_dims{
-          interpreter_tensor->dims->data,
-          interpreter_tensor->dims->data + interpreter_tensor->dims->size};
-      if (interpreter_dims != input_tensor.shape().dims) {
-        interpreter_->ResizeInputTensorStrict(input_tensor_index,
-                                              input_tensor.shape().dims);
-        resized_tensor_shapes = true;
-      }
-    }
-  }
+  // resized and reallocated before we can copy the tensor values, unless an
+  // interpreter with these shapes is cached.
+  MP_ASSIGN_OR_RETURN(
+      const bool resized_tensor_shapes,
+      PrepareInterpreter(cc, tensor_span,
+                         input_indices_excluding_feedback_tensors));
   // Reallocation is needed for memory sanity.
   if (resized_tensor_shapes) interpreter_->AllocateTensors();
 
@@ -206,14 +363,26 @@ absl::StatusOr<std::vector<Tensor>> InferenceInterpreterDelegateRunner::Run(
     // TODO b/329100795 - can TfLite custom allocation work with dynamic
     // tensors?
     if (enable_zero_copy_tensor_io_) {
-      auto input_tensor_view = input_tensor.GetCpuReadView();
-      RET_CHECK(IsAlignedWithTFLiteDefaultAlignment(
-          input_tensor_view.buffer<const void>()))
-          << "TfLite custom tensor allocation of input tensors is enabled but "
-             "tensor memory is not aligned to tflite::kDefaultTensorAlignment.";
+      const Tensor* bound_tensor = &input_tensor;
+      {
+        auto input_tensor_view = input_tensor.GetCpuReadView();
+        if (!IsAlignedWithTFLiteDefaultAlignment(
+                input_tensor_view.buffer<const void>())) {
+          // Tensors that were not allocated with
+          // tflite::kDefaultTensorAlignment are copied into an aligned one, so
+          // that only they pay for a copy.
+          MP_ASSIGN_OR_RETURN(Tensor staged_tensor,
+                              CopyIntoAlignedTensor(input_tensor,
+                                                    input_tensor_view,
+                                                    memory_manager_));
+          staged_input_tensors.push_back(std::move(staged_tensor));
+          bound_tensor = &staged_input_tensors.back();
+        }
+      }
+      auto input_tensor_view = bound_tensor->GetCpuReadView();
       MP_RETURN_IF_ERROR(SetTfLiteCustomAllocation(
           *interpreter_, input_tensor_view.buffer<const void>(),
-          input_tensor.bytes(), interpreter_->inputs()[input_tensor_index]));
+          bound_tensor->bytes(), interpreter_->inputs()[input_tensor_index]));
       input_tensor_views.emplace_back(std::move(input_tensor_view));
       continue;
     }
@@ -225,7 +394,7 @@ absl::StatusOr<std::vector<Tensor>> InferenceInterpreterDelegateRunner::Run(
   MP_ASSIGN_OR_RETURN(
       std::vector<Tensor> output_tensors,
       AllocateOutputTensors(output_indices_excluding_feedback_tensors,
-                            *interpreter_));
+                            *interpreter_, memory_manager_));
 
   std::vector<Tensor::CpuWriteView> output_tensor_views;
   if (enable_zero_copy_tensor_io_) {
@@ -282,20 +451,16 @@ CreateInferenceInterpreterDelegateRunner(
     int interpreter_num_threads,
     const mediapipe::InferenceCalculatorOptions::InputOutputConfig*
         input_output_config,
-    bool enable_zero_copy_tensor_io) {
-  InterpreterBuilder interpreter_builder(*model.Get(), op_resolver.Get());
-  if (delegate) {
-    interpreter_builder.AddDelegate(delegate.get());
-  }
-#if defined(__EMSCRIPTEN__)
-  interpreter_builder.SetNumThreads(1);
-#else
-  interpreter_builder.SetNumThreads(interpreter_num_threads);
-#endif  // __EMSCRIPTEN__
-  std::unique_ptr<Interpreter> interpreter;
-  RET_CHECK_EQ(interpreter_builder(&interpreter), kTfLiteOk);
-  RET_CHECK(interpreter);
-  RET_CHECK_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+    bool enable_zero_copy_tensor_io, MemoryManager* memory_manager,
+    int dynamic_shape_cache_size, DelegateFactory delegate_factory) {
+  RET_CHECK_GE(dynamic_shape_cache_size, 1);
+  RET_CHECK(dynamic_shape_cache_size == 1 || !delegate || delegate_factory)
+      << "Caching interpreters for dynamic shapes requires a delegate "
+         "factory when using a delegate.";
+  MP_ASSIGN_OR_RETURN(
+      std::unique_ptr<Interpreter> interpreter,
+      BuildInterpreter(*model.Get(), op_resolver.Get(), delegate.get(),
+                       interpreter_num_threads));
   MP_ASSIGN_OR_RETURN(
       auto input_output_tensor_names,
       InferenceIoMapper::GetInputOutputTensorNamesFromInterpreter(
@@ -306,14 +471,21 @@ CreateInferenceInterpreterDelegateRunner(
     inference_feedback_manager = std::make_unique<InferenceFeedbackManager>();
     MP_RETURN_IF_ERROR(inference_feedback_manager->Init(
         *input_output_config, input_output_tensor_names, interpreter.get()));
+    // The feedback manager is bound to a single interpreter.
+    RET_CHECK(dynamic_shape_cache_size == 1 ||
+              inference_feedback_manager->GetNumberOfFeedbackTensors() == 0)
+        << "Caching interpreters for dynamic shapes is not supported with "
+           "feedback tensors.";
   }
   if (enable_zero_copy_tensor_io) {
     MP_RETURN_IF_ERROR(VerifyModelTensorsForCustomAllocation(*interpreter));
   }
   return std::make_unique<InferenceInterpreterDelegateRunner>(
-      std::move(model), std::move(interpreter), std::move(delegate),
+      std::move(model), std::move(op_resolver), std::move(interpreter),
+      std::move(delegate), interpreter_num_threads,
       std::move(input_output_tensor_names),
-      std::move(inference_feedback_manager), enable_zero_copy_tensor_io);
+      std::move(inference_feedback_manager), enable_zero_copy_tensor_io,
+      memory_manager, dynamic_shape_cache_size, std::move(delegate_factory));
 }
 
 }  // namespace mediapipe
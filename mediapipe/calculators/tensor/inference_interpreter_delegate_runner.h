@@ -15,6 +15,7 @@
 #ifndef MEDIAPIPE_CALCULATORS_TENSOR_INFERENCE_INTERPRETER_DELEGATE_RUNNER_H_
 #define MEDIAPIPE_CALCULATORS_TENSOR_INFERENCE_INTERPRETER_DELEGATE_RUNNER_H_
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -22,6 +23,8 @@
 #include "mediapipe/calculators/tensor/inference_runner.h"
 #include "mediapipe/calculators/tensor/tflite_delegate_ptr.h"
 #include "mediapipe/framework/api2/packet.h"
+#include "mediapipe/framework/calculator_context.h"
+#include "mediapipe/framework/memory_manager.h"
 #include "mediapipe/util/tflite/tflite_model_loader.h"
 #include "tensorflow/lite/c/c_api_types.h"
 #include "tensorflow/lite/core/api/op_resolver.h"
@@ -35,14 +38,34 @@ namespace mediapipe {
 // use what is available by default.
 // `input_output_config` optional config to enable feedback tensors.
 //
-// `enable_zero_copy_tensor_input` and `enable_zero_copy_tensor_output` enable
-// zero copy tensor I/O using TfLite's custom allocator API.
-// Note that `enable_zero_copy_tensor_input` requires *all* input tensors to be
-// aligned to tflite::kDefaultTensorAlignment bytes.
-// `enable_zero_copy_tensor_output` requires that the model has no duplicate
-// output tensors (tensors with identical TfLite tensor indices) and no
-// passthrough input->output tensors (input and output tensors with identical
-// TfLite tensor indices).
+// `enable_zero_copy_tensor_io` enables zero copy tensor I/O using TfLite's
+// custom allocator API: input tensor buffers are bound to the interpreter and
+// the interpreter writes directly into the output tensors. Input tensors that
+// are not aligned to tflite::kDefaultTensorAlignment bytes are copied into
+// aligned tensors first, so producers should allocate their tensors with that
+// alignment to avoid the copy. Zero copy requires that the model has no
+// duplicate output tensors (tensors with identical TfLite tensor indices) and
+// no passthrough input->output tensors (input and output tensors with
+// identical TfLite tensor indices).
+//
+// `memory_manager` optional MemoryManager used to pool the CPU buffers of the
+// output tensors. Must outlive the runner.
+//
+// `dynamic_shape_cache_size` is the number of interpreters, each allocated for
+// the input shapes of a previous run, kept for inputs with dynamic shapes.
+// Runs with the shapes of a cached interpreter use it as is, instead of
+// resizing the input tensors and reallocating all tensors, and the least
+// recently used interpreter is resized otherwise. With 1, a single
+// interpreter is resized whenever the shapes change. Hits and misses are
+// counted in the "<node name>-InterpreterCacheHits" and
+// "<node name>-InterpreterCacheMisses" graph counters. Caching more than one
+// interpreter is not supported with feedback tensors.
+// `delegate_factory` creates the delegate of each interpreter but the first
+// one, which uses `delegate`. Required if `delegate` is set and
+// `dynamic_shape_cache_size` is greater than 1, as a delegate cannot be
+// shared between interpreters.
+using DelegateFactory =
+    std::function<absl::StatusOr<TfLiteDelegatePtr>(CalculatorContext* cc)>;
 absl::StatusOr<std::unique_ptr<InferenceRunner>>
 CreateInferenceInterpreterDelegateRunner(
     api2::Packet<TfLiteModelPtr> model,
@@ -50,7 +73,9 @@ CreateInferenceInterpreterDelegateRunner(
     int interpreter_num_threads,
     const mediapipe::InferenceCalculatorOptions::InputOutputConfig*
         input_output_config = nullptr,
-    bool enable_zero_copy_tensor_io = false);
+    bool enable_zero_copy_tensor_io = false,
+    MemoryManager* memory_manager = nullptr, int dynamic_shape_cache_size = 1,
+    DelegateFactory delegate_factory = nullptr);
 
 }  // namespace mediapipe
 
@@ -1,13 +1,18 @@
 #include "mediapipe/calculators/tensor/inference_interpreter_delegate_runner.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/functional/any_invocable.h"
+#include "absl/log/absl_check.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "mediapipe/calculators/tensor/tensor_span.h"
 #include "mediapipe/calculators/tensor/tflite_delegate_ptr.h"
 #include "mediapipe/framework/api2/builder.h"
@@ -26,6 +31,8 @@
 #include "tensorflow/lite/core/api/op_resolver.h"
 #include "tensorflow/lite/delegates/xnnpack/xnnpack_delegate.h"
 #include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/model_builder.h"
+#include "tensorflow/lite/schema/schema_generated.h"
 #include "tensorflow/lite/util.h"
 
 namespace mediapipe {
@@ -54,6 +61,52 @@ constexpr char k3In3OutSwaps2And0ModelPath[] =
     "mediapipe/calculators/tensor/testdata/"
     "3in3out_model_swaps_input_2_and_0.tflite";
 
+// Builds a model squaring a float32 input of shape [1, -1] with a MUL op.
+api2::Packet<TfLiteModelPtr> BuildDynamicSquareModel() {
+  flatbuffers::FlatBufferBuilder builder;
+  const std::vector<int32_t> shape = {1, 1};
+  const std::vector<int32_t> shape_signature = {1, -1};
+  const std::vector<flatbuffers::Offset<tflite::Tensor>> tensors = {
+      tflite::CreateTensorDirect(builder, &shape, tflite::TensorType_FLOAT32,
+                                 /*buffer=*/0, "input", /*quantization=*/0,
+                                 /*is_variable=*/false, /*sparsity=*/0,
+                                 &shape_signature),
+      tflite::CreateTensorDirect(builder, &shape, tflite::TensorType_FLOAT32,
+                                 /*buffer=*/0, "output", /*quantization=*/0,
+                                 /*is_variable=*/false, /*sparsity=*/0,
+                                 &shape_signature)};
+  const std::vector<int32_t> inputs = {0};
+  const std::vector<int32_t> outputs = {1};
+  const std::vector<int32_t> mul_inputs = {0, 0};
+  const std::vector<flatbuffers::Offset<tflite::Operator>> operators = {
+      tflite::CreateOperatorDirect(builder, /*opcode_index=*/0, &mul_inputs,
+                                   &outputs, tflite::BuiltinOptions_MulOptions,
+                                   tflite::CreateMulOptions(builder).Union())};
+  const std::vector<flatbuffers::Offset<tflite::SubGraph>> subgraphs = {
+      tflite::CreateSubGraphDirect(builder, &tensors, &inputs, &outputs,
+                                   &operators)};
+  const std::vector<flatbuffers::Offset<tflite::OperatorCode>> operator_codes =
+      {tflite::CreateOperatorCode(
+          builder, static_cast<int8_t>(tflite::BuiltinOperator_MUL),
+          /*custom_code=*/0, /*version=*/1, tflite::BuiltinOperator_MUL)};
+  const std::vector<flatbuffers::Offset<tflite::Buffer>> buffers = {
+      tflite::CreateBuffer(builder)};
+  tflite::FinishModelBuffer(
+      builder, tflite::CreateModelDirect(builder, TFLITE_SCHEMA_VERSION,
+                                         &operator_codes, &subgraphs,
+                                         "dynamic_square", &buffers));
+  auto buffer =
+      std::make_shared<flatbuffers::DetachedBuffer>(builder.Release());
+  std::unique_ptr<tflite::FlatBufferModel> model =
+      tflite::FlatBufferModel::BuildFromBuffer(
+          reinterpret_cast<const char*>(buffer->data()), buffer->size());
+  ABSL_CHECK(model);
+  // The model points into the buffer.
+  return api2::MakePacket<TfLiteModelPtr>(
+      model.release(),
+      [buffer](tflite::FlatBufferModel* model) { delete model; });
+}
+
 class AnyInvocableCalculator : public Node {
  public:
   static constexpr Input<
@@ -69,8 +122,11 @@ REGISTER_CALCULATOR(AnyInvocableCalculator);
 
 class InferenceCalculatorDelegateRunnnerTest : public ::testing::Test {
  public:
+  // Runs `invokable` inside a calculator. If `counters` is set, it receives
+  // the values of the graph's counters once the graph is done.
   absl::Status ExecuteAnyInvocableInGraphCalculator(
-      absl::AnyInvocable<absl::Status(CalculatorContext*) const> invokable) {
+      absl::AnyInvocable<absl::Status(CalculatorContext*) const> invokable,
+      std::map<std::string, int64_t>* counters = nullptr) {
     mediapipe::api2::builder::Graph graph_builder;
     auto input = graph_builder.In("INPUT")
                      .SetName("input")
@@ -87,7 +143,12 @@ class InferenceCalculatorDelegateRunnnerTest : public ::testing::Test {
                      CalculatorContext*) const>>(std::move(invokable))
                      .At(mediapipe::Timestamp(0))));
     MP_RETURN_IF_ERROR(graph.CloseAllInputStreams());
-    return graph.WaitUntilDone();
+    MP_RETURN_IF_ERROR(graph.WaitUntilDone());
+    if (counters != nullptr) {
+      *counters =
+          graph.GetCounterFactory()->GetCounterSet()->GetCountersValues();
+    }
+    return absl::OkStatus();
   }
 
   template <typename VectorT, Tensor::ElementType TensorT>
@@ -96,7 +157,8 @@ class InferenceCalculatorDelegateRunnnerTest : public ::testing::Test {
       api2::Packet<tflite::OpResolver> op_resolver, TfLiteDelegatePtr delegate,
       bool enable_zero_copy_tensor_io,
       const std::vector<std::vector<VectorT>>& inputs,
-      const std::vector<std::vector<VectorT>>& expected_outputs) {
+      const std::vector<std::vector<VectorT>>& expected_outputs,
+      int input_alignment = tflite::kDefaultTensorAlignment) {
     return ExecuteAnyInvocableInGraphCalculator(
         [&](CalculatorContext* cc) -> absl::Status {
           MP_ASSIGN_OR_RETURN(
@@ -113,7 +175,7 @@ class InferenceCalculatorDelegateRunnnerTest : public ::testing::Test {
             dims.push_back(input_vec.size());
             input_tensors.push_back(Tensor(TensorT, dims,
                                            /*memory_manager=*/nullptr,
-                                           tflite::kDefaultTensorAlignment));
+                                           input_alignment));
             {
               auto input_tensor_view = input_tensors.back().GetCpuWriteView();
               EXPECT_EQ(input_vec.size(),
@@ -294,6 +356,70 @@ TEST_F(InferenceCalculatorDelegateRunnnerTest,
           /*expected_outputs=*/{{0.f * 0.f, 1.f * 1.f, 2.f * 2.f}})));
 }
 
+TEST_F(InferenceCalculatorDelegateRunnnerTest,
+       RunFloat32ModelWithCustomAllocationAndUnalignedInput) {
+  std::unique_ptr<Resources> resources = CreateDefaultResources();
+  MP_ASSERT_OK_AND_ASSIGN(auto model, TfLiteModelLoader::LoadFromPath(
+                                          *resources, kFloat32ModelFile));
+  auto op_resolver = PacketAdopting<tflite::OpResolver>(
+      std::make_unique<
+          tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates>());
+  auto xnnpack_opts = TfLiteXNNPackDelegateOptionsDefault();
+  auto delegate = TfLiteDelegatePtr(TfLiteXNNPackDelegateCreate(&xnnpack_opts),
+                                    &TfLiteXNNPackDelegateDelete);
+  // Without alignment, the input buffer is usually not aligned to
+  // tflite::kDefaultTensorAlignment and is copied into an aligned one.
+  MP_EXPECT_OK(
+      (CreateAndRunInferenceRunner<float, Tensor::ElementType::kFloat32>(
+          std::move(model), std::move(op_resolver), std::move(delegate),
+          /*enable_zero_copy_tensor_io=*/true,
+          /*inputs=*/{{0.f, 1.f, 2.f}},
+          /*expected_outputs=*/{{0.f * 0.f, 1.f * 1.f, 2.f * 2.f}},
+          /*input_alignment=*/0)));
+}
+
+TEST_F(InferenceCalculatorDelegateRunnnerTest,
+       CustomAllocationKeepsOutputsOfPreviousRuns) {
+  std::unique_ptr<Resources> resources = CreateDefaultResources();
+  MP_ASSERT_OK_AND_ASSIGN(auto model, TfLiteModelLoader::LoadFromPath(
+                                          *resources, kFloat32ModelFile));
+  auto op_resolver = PacketAdopting<tflite::OpResolver>(
+      std::make_unique<
+          tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates>());
+  MP_EXPECT_OK(ExecuteAnyInvocableInGraphCalculator(
+      [&](CalculatorContext* cc) -> absl::Status {
+        MP_ASSIGN_OR_RETURN(
+            auto inference_runner,
+            CreateInferenceInterpreterDelegateRunner(
+                std::move(model), std::move(op_resolver), /*delegate=*/nullptr,
+                /*interpreter_num_threads=*/-1,
+                /*input_output_config=*/nullptr,
+                /*enable_zero_copy_tensor_io=*/true));
+        auto run = [&](float value) -> absl::StatusOr<std::vector<Tensor>> {
+          std::vector<Tensor> input_tensors;
+          input_tensors.push_back(Tensor(Tensor::ElementType::kFloat32,
+                                         Tensor::Shape{1, 3},
+                                         /*memory_manager=*/nullptr,
+                                         tflite::kDefaultTensorAlignment));
+          {
+            auto view = input_tensors[0].GetCpuWriteView();
+            std::fill_n(view.buffer<float>(), 3, value);
+          }
+          return inference_runner->Run(cc, MakeTensorSpan(input_tensors));
+        };
+        MP_ASSIGN_OR_RETURN(std::vector<Tensor> first_outputs, run(2.f));
+        MP_ASSIGN_OR_RETURN(std::vector<Tensor> second_outputs, run(3.f));
+        // Each run writes into its own output tensors.
+        auto first_view = first_outputs[0].GetCpuReadView();
+        auto second_view = second_outputs[0].GetCpuReadView();
+        for (int i = 0; i < 3; ++i) {
+          EXPECT_EQ(first_view.buffer<float>()[i], 4.f);
+          EXPECT_EQ(second_view.buffer<float>()[i], 9.f);
+        }
+        return absl::OkStatus();
+      }));
+}
+
 TEST_F(InferenceCalculatorDelegateRunnnerTest,
        RunFloat32ModelWithXNNPackDelegatePassthrough) {
   std::unique_ptr<Resources> resources = CreateDefaultResources();
@@ -348,6 +474,70 @@ TEST_F(InferenceCalculatorDelegateRunnnerTest,
                          "input->output passthrough tensors")));
 }
 
+TEST_F(InferenceCalculatorDelegateRunnnerTest,
+       CachesInterpretersForDynamicShapes) {
+  std::string node_name;
+  std::map<std::string, int64_t> counters;
+  auto op_resolver = PacketAdopting<tflite::OpResolver>(
+      std::make_unique<
+          tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates>());
+  MP_EXPECT_OK(ExecuteAnyInvocableInGraphCalculator(
+      [&](CalculatorContext* cc) -> absl::Status {
+        MP_ASSIGN_OR_RETURN(
+            auto inference_runner,
+            CreateInferenceInterpreterDelegateRunner(
+                BuildDynamicSquareModel(), std::move(op_resolver),
+                /*delegate=*/nullptr, /*interpreter_num_threads=*/1,
+                /*input_output_config=*/nullptr,
+                /*enable_zero_copy_tensor_io=*/false,
+                /*memory_manager=*/nullptr, /*dynamic_shape_cache_size=*/2));
+        for (int size : {2, 3, 2, 4, 2, 3}) {
+          std::vector<Tensor> input_tensors;
+          input_tensors.push_back(Tensor(Tensor::ElementType::kFloat32,
+                                         Tensor::Shape({1, size},
+                                                       /*is_dynamic=*/true)));
+          {
+            auto view = input_tensors[0].GetCpuWriteView();
+            for (int i = 0; i < size; ++i) view.buffer<float>()[i] = i;
+          }
+          MP_ASSIGN_OR_RETURN(
+              std::vector<Tensor> output_tensors,
+              inference_runner->Run(cc, MakeTensorSpan(input_tensors)));
+          EXPECT_EQ(output_tensors[0].shape().dims,
+                    std::vector<int>({1, size}));
+          auto view = output_tensors[0].GetCpuReadView();
+          for (int i = 0; i < size; ++i) {
+            EXPECT_EQ(view.buffer<float>()[i], i * i);
+          }
+        }
+        node_name = cc->NodeName();
+        return absl::OkStatus();
+      },
+      &counters));
+  // 2 and 3 are both cached until 4 evicts 3.
+  EXPECT_EQ(counters[absl::StrCat(node_name, "-InterpreterCacheHits")], 2);
+  EXPECT_EQ(counters[absl::StrCat(node_name, "-InterpreterCacheMisses")], 4);
+}
+
+TEST_F(InferenceCalculatorDelegateRunnnerTest,
+       CachingInterpretersWithDelegateRequiresFactory) {
+  auto op_resolver = PacketAdopting<tflite::OpResolver>(
+      std::make_unique<
+          tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates>());
+  auto xnnpack_opts = TfLiteXNNPackDelegateOptionsDefault();
+  auto delegate = TfLiteDelegatePtr(TfLiteXNNPackDelegateCreate(&xnnpack_opts),
+                                    &TfLiteXNNPackDelegateDelete);
+  EXPECT_THAT(
+      CreateInferenceInterpreterDelegateRunner(
+          BuildDynamicSquareModel(), std::move(op_resolver),
+          std::move(delegate), /*interpreter_num_threads=*/1,
+          /*input_output_config=*/nullptr,
+          /*enable_zero_copy_tensor_io=*/false, /*memory_manager=*/nullptr,
+          /*dynamic_shape_cache_size=*/2),
+      StatusIs(absl::StatusCode::kInternal,
+               HasSubstr("requires a delegate factory")));
+}
+
 }  // namespace
 }  // namespace api2
 }  // namespace mediapipe
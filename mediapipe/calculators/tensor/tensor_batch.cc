@@ -0,0 +1,101 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/tensor_batch.h"
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/memory_manager.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+
+absl::StatusOr<std::vector<Tensor>> BatchTensors(
+    absl::Span<const std::vector<Tensor>* const> inputs,
+    MemoryManager* memory_manager) {
+  RET_CHECK(!inputs.empty());
+  const std::vector<Tensor>& first = *inputs[0];
+  for (const std::vector<Tensor>* input : inputs) {
+    RET_CHECK_EQ(input->size(), first.size())
+        << "Batched inputs must hold the same number of tensors.";
+  }
+
+  std::vector<Tensor> batch;
+  batch.reserve(first.size());
+  for (int i = 0; i < first.size(); ++i) {
+    const Tensor& tensor = first[i];
+    RET_CHECK(!tensor.shape().dims.empty())
+        << "Scalar tensors cannot be batched.";
+    for (const std::vector<Tensor>* input : inputs) {
+      RET_CHECK((*input)[i].element_type() == tensor.element_type())
+          << "Batched tensors must have the same element type.";
+      RET_CHECK((*input)[i].shape().dims == tensor.shape().dims)
+          << "Batched tensors must have the same shape.";
+    }
+    std::vector<int> dims = tensor.shape().dims;
+    dims[0] *= inputs.size();
+    Tensor batched(tensor.element_type(), Tensor::Shape(dims, true),
+                   tensor.quantization_parameters(), memory_manager);
+    {
+      auto write_view = batched.GetCpuWriteView();
+      uint8_t* dst = write_view.buffer<uint8_t>();
+      const int bytes = tensor.bytes();
+      for (const std::vector<Tensor>* input : inputs) {
+        auto read_view = (*input)[i].GetCpuReadView();
+        std::memcpy(dst, read_view.buffer<uint8_t>(), bytes);
+        dst += bytes;
+      }
+    }
+    batch.push_back(std::move(batched));
+  }
+  return batch;
+}
+
+absl::StatusOr<std::vector<std::vector<Tensor>>> UnbatchTensors(
+    const std::vector<Tensor>& batch, int batch_size,
+    MemoryManager* memory_manager) {
+  RET_CHECK_GT(batch_size, 0);
+  std::vector<std::vector<Tensor>> outputs(batch_size);
+  for (auto& output : outputs) {
+    output.reserve(batch.size());
+  }
+  for (const Tensor& tensor : batch) {
+    RET_CHECK(!tensor.shape().dims.empty())
+        << "Scalar tensors cannot be unbatched.";
+    RET_CHECK_EQ(tensor.shape().dims[0] % batch_size, 0)
+        << "The first dimension of a batched tensor must be a multiple of the "
+           "batch size.";
+    std::vector<int> dims = tensor.shape().dims;
+    dims[0] /= batch_size;
+    const int bytes = tensor.bytes() / batch_size;
+    auto read_view = tensor.GetCpuReadView();
+    const uint8_t* src = read_view.buffer<uint8_t>();
+    for (auto& output : outputs) {
+      Tensor part(tensor.element_type(), Tensor::Shape(dims),
+                  tensor.quantization_parameters(), memory_manager);
+      std::memcpy(part.GetCpuWriteView().buffer<uint8_t>(), src, bytes);
+      src += bytes;
+      output.push_back(std::move(part));
+    }
+  }
+  return outputs;
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,55 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_CALCULATORS_TENSOR_TENSOR_BATCH_H_
+#define MEDIAPIPE_CALCULATORS_TENSOR_TENSOR_BATCH_H_
+
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/memory_manager.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+
+// An input combined into a tensor batch: its input timestamp and the index of
+// the "TENSORS" input stream it arrived on.
+struct TensorBatchEntry {
+  Timestamp timestamp;
+  int stream_index = 0;
+};
+
+// Describes the inputs of a tensor batch, in batch order.
+using TensorBatchInfo = std::vector<TensorBatchEntry>;
+
+// Concatenates the tensors of several inputs along their first dimension.
+// All inputs must hold the same number of tensors, and the i-th tensors of all
+// inputs must have the same element type and shape. The batched tensors have
+// a dynamic shape, so that the inference runner resizes the model inputs to
+// the batch size.
+absl::StatusOr<std::vector<Tensor>> BatchTensors(
+    absl::Span<const std::vector<Tensor>* const> inputs,
+    MemoryManager* memory_manager = nullptr);
+
+// Splits each tensor of a batch along its first dimension into "batch_size"
+// equal parts. Returns one vector of tensors per batch input.
+absl::StatusOr<std::vector<std::vector<Tensor>>> UnbatchTensors(
+    const std::vector<Tensor>& batch, int batch_size,
+    MemoryManager* memory_manager = nullptr);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_TENSOR_TENSOR_BATCH_H_
@@ -0,0 +1,230 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Compares the post-processing of SSD-like detection models with and without
+// fused non-maximum suppression. The unfused path mirrors what
+// TensorsToDetectionsCalculator followed by NonMaxSuppressionCalculator do:
+// decode and score all anchors, create a Detection per anchor above the score
+// threshold, then sort and suppress the Detection protos.
+//
+// $ bazel run -c opt \
+//   mediapipe/calculators/tensor:tensors_to_detections_benchmark
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "mediapipe/calculators/tensor/tensors_to_detections_calculator.pb.h"
+#include "mediapipe/calculators/tensor/tensors_to_detections_fused.h"
+#include "mediapipe/framework/formats/detection.pb.h"
+#include "mediapipe/framework/formats/location_data.pb.h"
+#include "mediapipe/framework/formats/object_detection/anchor.pb.h"
+#include "mediapipe/framework/port/rectangle.h"
+
+namespace mediapipe {
+namespace {
+
+using Options = TensorsToDetectionsCalculatorOptions;
+
+struct ModelOutputs {
+  Options options;
+  std::vector<float> raw_boxes;
+  std::vector<float> raw_scores;
+  std::vector<Anchor> anchors;
+};
+
+// Random outputs of a model with 16 keypoint coordinates per box, where about
+// 1% of the anchors have a score above the threshold, in clusters of
+// neighboring anchors as for real objects.
+ModelOutputs MakeModelOutputs(int num_boxes, int num_classes) {
+  ModelOutputs outputs;
+  Options& options = outputs.options;
+  options.set_num_boxes(num_boxes);
+  options.set_num_classes(num_classes);
+  options.set_num_coords(4 + 2 * 8);
+  options.set_num_keypoints(8);
+  options.set_keypoint_coord_offset(4);
+  options.set_x_scale(128.0f);
+  options.set_y_scale(128.0f);
+  options.set_w_scale(128.0f);
+  options.set_h_scale(128.0f);
+  options.set_sigmoid_score(true);
+  options.set_score_clipping_thresh(100.0f);
+  options.set_min_score_thresh(0.5f);
+  options.mutable_non_max_suppression()->set_algorithm(
+      Options::NonMaxSuppression::WEIGHTED);
+
+  std::mt19937 rng(0);
+  std::normal_distribution<float> background_score(-6.0f, 1.5f);
+  std::uniform_real_distribution<float> offset(-8.0f, 8.0f);
+  outputs.raw_scores.resize(num_boxes * num_classes);
+  for (float& score : outputs.raw_scores) score = background_score(rng);
+  for (int i = 0; i < num_boxes; i += 200) {
+    for (int j = i; j < std::min(i + 2, num_boxes); ++j) {
+      outputs.raw_scores[j * num_classes] = 2.0f;
+    }
+  }
+  outputs.raw_boxes.resize(num_boxes * options.num_coords());
+  for (int i = 0; i < num_boxes; ++i) {
+    float* raw_box = &outputs.raw_boxes[i * options.num_coords()];
+    raw_box[0] = offset(rng);
+    raw_box[1] = offset(rng);
+    raw_box[2] = 40.0f + offset(rng);
+    raw_box[3] = 40.0f + offset(rng);
+    for (int k = 4; k < options.num_coords(); ++k) raw_box[k] = offset(rng);
+  }
+  outputs.anchors.resize(num_boxes);
+  for (int i = 0; i < num_boxes; ++i) {
+    outputs.anchors[i].set_x_center((i % 64) / 64.0f);
+    outputs.anchors[i].set_y_center((i / 64 % 64) / 64.0f);
+    outputs.anchors[i].set_w(1.0f);
+    outputs.anchors[i].set_h(1.0f);
+  }
+  return outputs;
+}
+
+float IntersectionOverUnion(const Rectangle_f& rect1,
+                            const Rectangle_f& rect2) {
+  if (!rect1.Intersects(rect2)) return 0.0f;
+  const float intersection_area = Rectangle_f(rect1).Intersect(rect2).Area();
+  const float normalization = rect1.Area() + rect2.Area() - intersection_area;
+  return normalization > 0.0f ? intersection_area / normalization : 0.0f;
+}
+
+Rectangle_f GetRect(const Detection& detection) {
+  const auto& box = detection.location_data().relative_bounding_box();
+  return Rectangle_f(box.xmin(), box.ymin(), box.width(), box.height());
+}
+
+std::vector<Detection> RunUnfused(const ModelOutputs& outputs) {
+  const Options& options = outputs.options;
+  const int num_boxes = options.num_boxes();
+  const int num_classes = options.num_classes();
+  const int num_coords = options.num_coords();
+  const float clipping_thresh = options.score_clipping_thresh();
+
+  // TensorsToDetectionsCalculator.
+  std::vector<float> boxes(num_boxes * num_coords);
+  for (int i = 0; i < num_boxes; ++i) {
+    DecodeBox(options, Options::YXHW, &outputs.raw_boxes[i * num_coords],
+              outputs.anchors[i], &boxes[i * num_coords]);
+  }
+  std::vector<Detection> detections;
+  for (int i = 0; i < num_boxes; ++i) {
+    int class_id = -1;
+    float max_score = -std::numeric_limits<float>::max();
+    for (int c = 0; c < num_classes; ++c) {
+      float score = std::min(
+          std::max(outputs.raw_scores[i * num_classes + c], -clipping_thresh),
+          clipping_thresh);
+      score = 1.0f / (1.0f + std::exp(-score));
+      if (max_score < score) {
+        max_score = score;
+        class_id = c;
+      }
+    }
+    if (max_score < options.min_score_thresh()) continue;
+    const float* box = &boxes[i * num_coords];
+    Detection detection;
+    detection.add_score(max_score);
+    detection.add_label_id(class_id);
+    auto* location_data = detection.mutable_location_data();
+    location_data->set_format(LocationData::RELATIVE_BOUNDING_BOX);
+    auto* bbox = location_data->mutable_relative_bounding_box();
+    bbox->set_xmin(box[1]);
+    bbox->set_ymin(box[0]);
+    bbox->set_width(box[3] - box[1]);
+    bbox->set_height(box[2] - box[0]);
+    for (int k = 0; k < options.num_keypoints(); ++k) {
+      auto* keypoint = location_data->add_relative_keypoints();
+      keypoint->set_x(box[4 + 2 * k]);
+      keypoint->set_y(box[4 + 2 * k + 1]);
+    }
+    detections.push_back(std::move(detection));
+  }
+
+  // NonMaxSuppressionCalculator with the WEIGHTED algorithm.
+  std::vector<std::pair<int, float>> remaining;
+  for (int i = 0; i < detections.size(); ++i) {
+    remaining.emplace_back(i, detections[i].score(0));
+  }
+  std::sort(remaining.begin(), remaining.end(),
+            [](const auto& a, const auto& b) { return a.second > b.second; });
+  std::vector<Detection> retained;
+  std::vector<std::pair<int, float>> still_remaining;
+  std::vector<std::pair<int, float>> cluster;
+  while (!remaining.empty()) {
+    const Detection& detection = detections[remaining[0].first];
+    const Rectangle_f rect = GetRect(detection);
+    still_remaining.clear();
+    cluster.clear();
+    for (const auto& indexed_score : remaining) {
+      if (IntersectionOverUnion(GetRect(detections[indexed_score.first]),
+                                rect) >
+          options.non_max_suppression().min_suppression_threshold()) {
+        cluster.push_back(indexed_score);
+      } else {
+        still_remaining.push_back(indexed_score);
+      }
+    }
+    Detection weighted_detection = detection;
+    float total_score = 0.0f;
+    float xmin = 0.0f;
+    for (const auto& [index, score] : cluster) {
+      total_score += score;
+      xmin += GetRect(detections[index]).xmin() * score;
+    }
+    weighted_detection.mutable_location_data()
+        ->mutable_relative_bounding_box()
+        ->set_xmin(xmin / total_score);
+    retained.push_back(std::move(weighted_detection));
+    if (still_remaining.size() == remaining.size()) break;
+    std::swap(remaining, still_remaining);
+  }
+  return retained;
+}
+
+// Args: number of anchors, number of classes.
+void BM_Unfused(benchmark::State& state) {
+  const ModelOutputs outputs = MakeModelOutputs(state.range(0), state.range(1));
+  for (auto _ : state) {
+    std::vector<Detection> detections = RunUnfused(outputs);
+    benchmark::DoNotOptimize(detections);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Unfused)->Args({2304, 1})->Args({20000, 1})->Args({1917, 91});
+
+void BM_Fused(benchmark::State& state) {
+  const ModelOutputs outputs = MakeModelOutputs(state.range(0), state.range(1));
+  FusedDetectionDecoder decoder(outputs.options,
+                                std::vector<bool>(state.range(1), true));
+  for (auto _ : state) {
+    std::vector<Detection> detections;
+    decoder.Decode(outputs.raw_boxes.data(), outputs.raw_scores.data(),
+                   outputs.anchors, &detections);
+    benchmark::DoNotOptimize(detections);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Fused)->Args({2304, 1})->Args({20000, 1})->Args({1917, 91});
+
+}  // namespace
+}  // namespace mediapipe
+
+BENCHMARK_MAIN();
@@ -12,12 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
+#include "absl/log/absl_log.h"
 #include "absl/strings/str_format.h"
 #include "absl/types/span.h"
 #include "mediapipe/calculators/tensor/tensors_to_detections_calculator.pb.h"
+#include "mediapipe/calculators/tensor/tensors_to_detections_fused.h"
 #include "mediapipe/framework/api2/node.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/deps/file_path.h"
@@ -128,15 +131,6 @@ absl::Status CheckCustomTensorMapping(
   return absl::OkStatus();
 }
 
-BoxFormat GetBoxFormat(const TensorsToDetectionsCalculatorOptions& options) {
-  if (options.has_box_format()) {
-    return options.box_format();
-  } else if (options.reverse_output_order()) {
-    return mediapipe::TensorsToDetectionsCalculatorOptions::XYWH;
-  }
-  return mediapipe::TensorsToDetectionsCalculatorOptions::YXHW;
-}
-
 }  // namespace
 
 // Convert result Tensors from object detection models into MediaPipe
@@ -163,6 +157,11 @@ BoxFormat GetBoxFormat(const TensorsToDetectionsCalculatorOptions& options) {
 // Output:
 //  DETECTIONS - Result MediaPipe detections.
 //
+// When `non_max_suppression` is set in the options, the suppression is fused
+// into the decoding and the output only contains the retained detections, so
+// no NonMaxSuppressionCalculator is needed downstream. This requires
+// `max_classes_per_detection` to be 1; otherwise the option is ignored.
+//
 // Usage example:
 // node {
 //   calculator: "TensorsToDetectionsCalculator"
@@ -242,6 +241,8 @@ class TensorsToDetectionsCalculator : public Node {
   std::vector<int> box_indices_ = {0, 1, 2, 3};
   bool has_custom_box_indices_ = false;
   std::vector<Anchor> anchors_;
+  // Set if non-maximum suppression is fused into the decoding.
+  std::unique_ptr<FusedDetectionDecoder> fused_decoder_;
 
 #ifndef MEDIAPIPE_DISABLE_GL_COMPUTE
   mediapipe::GlCalculatorHelper gpu_helper_;
@@ -416,6 +417,12 @@ absl::Status TensorsToDetectionsCalculator::ProcessCPU(
       }
       anchors_init_ = true;
     }
+    if (fused_decoder_) {
+      RET_CHECK_EQ(anchors_.size(), num_boxes_);
+      fused_decoder_->Decode(raw_boxes, raw_scores, anchors_,
+                             output_detections);
+      return absl::OkStatus();
+    }
     std::vector<float> boxes(num_boxes_ * num_coords_);
     MP_RETURN_IF_ERROR(DecodeBoxes(raw_boxes, anchors_, &boxes));
 
@@ -587,6 +594,11 @@ absl::Status TensorsToDetectionsCalculator::ProcessGPU(
   }
   auto decoded_boxes_view = decoded_boxes_buffer_->GetCpuReadView();
   auto boxes = decoded_boxes_view.buffer<float>();
+  if (fused_decoder_) {
+    fused_decoder_->DecodeScored(boxes, detection_scores.data(),
+                                 detection_classes.data(), output_detections);
+    return absl::OkStatus();
+  }
   MP_RETURN_IF_ERROR(ConvertToDetections(boxes, detection_scores.data(),
                                          detection_classes.data(),
                                          output_detections));
@@ -674,6 +686,11 @@ absl::Status TensorsToDetectionsCalculator::ProcessGPU(
   }
   auto decoded_boxes_view = decoded_boxes_buffer_->GetCpuReadView();
   auto boxes = decoded_boxes_view.buffer<float>();
+  if (fused_decoder_) {
+    fused_decoder_->DecodeScored(boxes, detection_scores.data(),
+                                 detection_classes.data(), output_detections);
+    return absl::OkStatus();
+  }
   MP_RETURN_IF_ERROR(ConvertToDetections(boxes, detection_scores.data(),
                                          detection_classes.data(),
                                          output_detections));
@@ -780,6 +797,22 @@ absl::Status TensorsToDetectionsCalculator::LoadOptions(CalculatorContext* cc) {
     has_custom_box_indices_ = true;
   }
 
+  // The fused decoder keeps a single class per anchor, so it is only used
+  // with the default max_classes_per_detection.
+  if (options_.has_non_max_suppression() &&
+      options_.max_classes_per_detection() != 1) {
+    ABSL_LOG(WARNING) << "non_max_suppression is ignored because "
+                         "max_classes_per_detection is not 1; use a "
+                         "NonMaxSuppressionCalculator downstream.";
+  } else if (options_.has_non_max_suppression()) {
+    std::vector<bool> class_allowed(num_classes_);
+    for (int i = 0; i < num_classes_; ++i) {
+      class_allowed[i] = IsClassIndexAllowed(i);
+    }
+    fused_decoder_ = std::make_unique<FusedDetectionDecoder>(
+        options_, std::move(class_allowed));
+  }
+
   return absl::OkStatus();
 }
 
@@ -787,86 +820,9 @@ absl::Status TensorsToDetectionsCalculator::DecodeBoxes(
     const float* raw_boxes, const std::vector<Anchor>& anchors,
     std::vector<float>* boxes) {
   for (int i = 0; i < num_boxes_; ++i) {
-    const int box_offset = i * num_coords_ + options_.box_coord_offset();
-
-    float y_center = 0.0;
-    float x_center = 0.0;
-    float h = 0.0;
-    float w = 0.0;
-    // TODO
-    switch (box_output_format_) {
-      case mediapipe::TensorsToDetectionsCalculatorOptions::UNSPECIFIED:
-      case mediapipe::TensorsToDetectionsCalculatorOptions::YXHW:
-        y_center = raw_boxes[box_offset];
-        x_center = raw_boxes[box_offset + 1];
-        h = raw_boxes[box_offset + 2];
-        w = raw_boxes[box_offset + 3];
-        break;
-      case mediapipe::TensorsToDetectionsCalculatorOptions::XYWH:
-        x_center = raw_boxes[box_offset];
-        y_center = raw_boxes[box_offset + 1];
-        w = raw_boxes[box_offset + 2];
-        h = raw_boxes[box_offset + 3];
-        break;
-      case mediapipe::TensorsToDetectionsCalculatorOptions::XYXY:
-        x_center = (-raw_boxes[box_offset] + raw_boxes[box_offset + 2]) / 2;
-        y_center = (-raw_boxes[box_offset + 1] + raw_boxes[box_offset + 3]) / 2;
-        w = raw_boxes[box_offset + 2] + raw_boxes[box_offset];
-        h = raw_boxes[box_offset + 3] + raw_boxes[box_offset + 1];
-        break;
-    }
-    x_center =
-        x_center / options_.x_scale() * anchors[i].w() + anchors[i].x_center();
-    y_center =
-        y_center / options_.y_scale() * anchors[i].h() + anchors[i].y_center();
-
-    if (options_.apply_exponential_on_box_size()) {
-      h = std::exp(h / options_.h_scale()) * anchors[i].h();
-      w = std::exp(w / options_.w_scale()) * anchors[i].w();
-    } else {
-      h = h / options_.h_scale() * anchors[i].h();
-      w = w / options_.w_scale() * anchors[i].w();
-    }
-
-    const float ymin = y_center - h / 2.f;
-    const float xmin = x_center - w / 2.f;
-    const float ymax = y_center + h / 2.f;
-    const float xmax = x_center + w / 2.f;
-
-    (*boxes)[i * num_coords_ + 0] = ymin;
-    (*boxes)[i * num_coords_ + 1] = xmin;
-    (*boxes)[i * num_coords_ + 2] = ymax;
-    (*boxes)[i * num_coords_ + 3] = xmax;
-
-    if (options_.num_keypoints()) {
-      for (int k = 0; k < options_.num_keypoints(); ++k) {
-        const int offset = i * num_coords_ + options_.keypoint_coord_offset() +
-                           k * options_.num_values_per_keypoint();
-
-        float keypoint_y = 0.0;
-        float keypoint_x = 0.0;
-        switch (box_output_format_) {
-          case mediapipe::TensorsToDetectionsCalculatorOptions::UNSPECIFIED:
-          case mediapipe::TensorsToDetectionsCalculatorOptions::YXHW:
-            keypoint_y = raw_boxes[offset];
-            keypoint_x = raw_boxes[offset + 1];
-            break;
-          case mediapipe::TensorsToDetectionsCalculatorOptions::XYWH:
-          case mediapipe::TensorsToDetectionsCalculatorOptions::XYXY:
-            keypoint_x = raw_boxes[offset];
-            keypoint_y = raw_boxes[offset + 1];
-            break;
-        }
-
-        (*boxes)[offset] = keypoint_x / options_.x_scale() * anchors[i].w() +
-                           anchors[i].x_center();
-        (*boxes)[offset + 1] =
-            keypoint_y / options_.y_scale() * anchors[i].h() +
-            anchors[i].y_center();
-      }
-    }
+    DecodeBox(options_, box_output_format_, raw_boxes + i * num_coords_,
+              anchors[i], boxes->data() + i * num_coords_);
   }
-
   return absl::OkStatus();
 }
 
@@ -0,0 +1,425 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/tensors_to_detections_fused.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_log.h"
+#include "absl/types/span.h"
+#include "mediapipe/calculators/tensor/tensors_to_detections_calculator.pb.h"
+#include "mediapipe/framework/formats/detection.pb.h"
+#include "mediapipe/framework/formats/location_data.pb.h"
+#include "mediapipe/framework/formats/object_detection/anchor.pb.h"
+#include "mediapipe/framework/port/rectangle.h"
+
+namespace mediapipe {
+namespace {
+
+using Options = TensorsToDetectionsCalculatorOptions;
+using NonMaxSuppression =
+    TensorsToDetectionsCalculatorOptions::NonMaxSuppression;
+
+// Number of values of a candidate box in FusedDetectionDecoder::boxes_ before
+// the keypoints.
+constexpr int kNumBoxValues = 4;
+
+// Returns a raw score below which the score cannot pass min_score_thresh.
+// With sigmoid scores, this is the logit of the threshold lowered by a few
+// float ulps to cover the rounding of the sigmoid. Raw scores above it are
+// checked exactly after the sigmoid.
+float GetRawScoreThreshold(const Options& options) {
+  if (!options.has_min_score_thresh()) {
+    return -std::numeric_limits<float>::infinity();
+  }
+  if (!options.sigmoid_score()) return options.min_score_thresh();
+  const double min_score = static_cast<double>(options.min_score_thresh()) -
+                           4 * std::numeric_limits<float>::epsilon();
+  if (min_score <= 0.0) return -std::numeric_limits<float>::infinity();
+  if (min_score >= 1.0) return std::numeric_limits<float>::max();
+  return std::log(min_score / (1.0 - min_score));
+}
+
+// Computes an overlap similarity between two rectangles, as in
+// NonMaxSuppressionCalculator.
+float OverlapSimilarity(NonMaxSuppression::OverlapType overlap_type,
+                        const Rectangle_f& rect1, const Rectangle_f& rect2) {
+  if (!rect1.Intersects(rect2)) return 0.0f;
+  const float intersection_area = Rectangle_f(rect1).Intersect(rect2).Area();
+  float normalization;
+  switch (overlap_type) {
+    case NonMaxSuppression::JACCARD:
+      normalization = Rectangle_f(rect1).Union(rect2).Area();
+      break;
+    case NonMaxSuppression::MODIFIED_JACCARD:
+      normalization = rect2.Area();
+      break;
+    case NonMaxSuppression::INTERSECTION_OVER_UNION:
+      normalization = rect1.Area() + rect2.Area() - intersection_area;
+      break;
+    default:
+      ABSL_LOG(FATAL) << "Unrecognized overlap type: " << overlap_type;
+  }
+  return normalization > 0.0f ? intersection_area / normalization : 0.0f;
+}
+
+}  // namespace
+
+Options::BoxFormat GetBoxFormat(const Options& options) {
+  if (options.has_box_format()) {
+    return options.box_format();
+  } else if (options.reverse_output_order()) {
+    return Options::XYWH;
+  }
+  return Options::YXHW;
+}
+
+void DecodeBox(const Options& options, Options::BoxFormat box_format,
+               const float* raw_box, const Anchor& anchor, float* box) {
+  const float* raw = raw_box + options.box_coord_offset();
+  float y_center = 0.0;
+  float x_center = 0.0;
+  float h = 0.0;
+  float w = 0.0;
+  switch (box_format) {
+    case Options::UNSPECIFIED:
+    case Options::YXHW:
+      y_center = raw[0];
+      x_center = raw[1];
+      h = raw[2];
+      w = raw[3];
+      break;
+    case Options::XYWH:
+      x_center = raw[0];
+      y_center = raw[1];
+      w = raw[2];
+      h = raw[3];
+      break;
+    case Options::XYXY:
+      x_center = (-raw[0] + raw[2]) / 2;
+      y_center = (-raw[1] + raw[3]) / 2;
+      w = raw[2] + raw[0];
+      h = raw[3] + raw[1];
+      break;
+  }
+  x_center = x_center / options.x_scale() * anchor.w() + anchor.x_center();
+  y_center = y_center / options.y_scale() * anchor.h() + anchor.y_center();
+
+  if (options.apply_exponential_on_box_size()) {
+    h = std::exp(h / options.h_scale()) * anchor.h();
+    w = std::exp(w / options.w_scale()) * anchor.w();
+  } else {
+    h = h / options.h_scale() * anchor.h();
+    w = w / options.w_scale() * anchor.w();
+  }
+
+  box[0] = y_center - h / 2.f;
+  box[1] = x_center - w / 2.f;
+  box[2] = y_center + h / 2.f;
+  box[3] = x_center + w / 2.f;
+
+  for (int k = 0; k < options.num_keypoints(); ++k) {
+    const int offset =
+        options.keypoint_coord_offset() + k * options.num_values_per_keypoint();
+    float keypoint_y = 0.0;
+    float keypoint_x = 0.0;
+    switch (box_format) {
+      case Options::UNSPECIFIED:
+      case Options::YXHW:
+        keypoint_y = raw_box[offset];
+        keypoint_x = raw_box[offset + 1];
+        break;
+      case Options::XYWH:
+      case Options::XYXY:
+        keypoint_x = raw_box[offset];
+        keypoint_y = raw_box[offset + 1];
+        break;
+    }
+    box[offset] =
+        keypoint_x / options.x_scale() * anchor.w() + anchor.x_center();
+    box[offset + 1] =
+        keypoint_y / options.y_scale() * anchor.h() + anchor.y_center();
+  }
+}
+
+FusedDetectionDecoder::FusedDetectionDecoder(const Options& options,
+                                             std::vector<bool> class_allowed)
+    : options_(options),
+      box_format_(GetBoxFormat(options)),
+      class_allowed_(std::move(class_allowed)),
+      all_classes_allowed_(std::all_of(class_allowed_.begin(),
+                                       class_allowed_.end(),
+                                       [](bool allowed) { return allowed; })),
+      num_keypoints_(options.num_keypoints()),
+      decoded_box_(options.num_coords()) {}
+
+void FusedDetectionDecoder::Decode(const float* raw_boxes,
+                                   const float* raw_scores,
+                                   absl::Span<const Anchor> anchors,
+                                   std::vector<Detection>* detections) {
+  const int num_boxes = options_.num_boxes();
+  const int num_classes = options_.num_classes();
+  const int num_coords = options_.num_coords();
+  const bool sigmoid = options_.sigmoid_score();
+  const float clipping_thresh = sigmoid && options_.has_score_clipping_thresh()
+                                    ? options_.score_clipping_thresh()
+                                    : std::numeric_limits<float>::infinity();
+  const auto clip = [clipping_thresh](float score) {
+    return std::min(std::max(score, -clipping_thresh), clipping_thresh);
+  };
+  const float raw_score_thresh = GetRawScoreThreshold(options_);
+
+  candidates_.clear();
+  boxes_.clear();
+  for (int i = 0; i < num_boxes; ++i) {
+    const float* scores = raw_scores + i * num_classes;
+    // Clipping and the sigmoid preserve the order of the scores, so the best
+    // class can be found, and most anchors rejected, on the raw scores. This
+    // plain max reduction is vectorized by the compiler.
+    float max_score = -std::numeric_limits<float>::max();
+    if (all_classes_allowed_) {
+      for (int c = 0; c < num_classes; ++c) {
+        max_score = std::max(max_score, clip(scores[c]));
+      }
+    } else {
+      for (int c = 0; c < num_classes; ++c) {
+        if (class_allowed_[c]) {
+          max_score = std::max(max_score, clip(scores[c]));
+        }
+      }
+    }
+    if (!(max_score >= raw_score_thresh)) continue;
+
+    int class_id = -1;
+    for (int c = 0; c < num_classes; ++c) {
+      if (class_allowed_[c] && clip(scores[c]) == max_score) {
+        class_id = c;
+        break;
+      }
+    }
+    if (class_id < 0) continue;
+    float score = max_score;
+    if (sigmoid) {
+      score = 1.0f / (1.0f + std::exp(-score));
+    }
+    if (options_.has_min_score_thresh() &&
+        score < options_.min_score_thresh()) {
+      continue;
+    }
+    DecodeBox(options_, box_format_, raw_boxes + i * num_coords, anchors[i],
+              decoded_box_.data());
+    AddCandidate(i, class_id, score, decoded_box_.data());
+  }
+  Suppress(detections);
+}
+
+void FusedDetectionDecoder::DecodeScored(const float* boxes,
+                                         const float* scores,
+                                         const int* classes,
+                                         std::vector<Detection>* detections) {
+  const int num_boxes = options_.num_boxes();
+  const int num_coords = options_.num_coords();
+  candidates_.clear();
+  boxes_.clear();
+  for (int i = 0; i < num_boxes; ++i) {
+    const int class_id = classes[i];
+    if (class_id < 0 || class_id >= static_cast<int>(class_allowed_.size()) ||
+        !class_allowed_[class_id]) {
+      continue;
+    }
+    if (options_.has_min_score_thresh() &&
+        scores[i] < options_.min_score_thresh()) {
+      continue;
+    }
+    AddCandidate(i, class_id, scores[i], boxes + i * num_coords);
+  }
+  Suppress(detections);
+}
+
+void FusedDetectionDecoder::AddCandidate(int index, int class_id, float score,
+                                         const float* box) {
+  const float ymin = box[0];
+  const float xmin = box[1];
+  const float ymax = box[2];
+  const float xmax = box[3];
+  const float width = xmax - xmin;
+  const float height = ymax - ymin;
+  // Decoded boxes could have negative or NaN sizes, which are filtered out as
+  // in TensorsToDetectionsCalculator.
+  if (width < 0 || height < 0 || std::isnan(width) || std::isnan(height)) {
+    return;
+  }
+  const bool flip_vertically = options_.flip_vertically();
+  candidates_.push_back({.index = index,
+                         .class_id = class_id,
+                         .score = score,
+                         .box_offset = static_cast<int>(boxes_.size())});
+  boxes_.push_back(xmin);
+  boxes_.push_back(flip_vertically ? 1.f - ymax : ymin);
+  boxes_.push_back(width);
+  boxes_.push_back(height);
+  for (int k = 0; k < num_keypoints_; ++k) {
+    const float* keypoint = box + options_.keypoint_coord_offset() +
+                            k * options_.num_values_per_keypoint();
+    boxes_.push_back(keypoint[0]);
+    boxes_.push_back(flip_vertically ? 1.f - keypoint[1] : keypoint[1]);
+  }
+}
+
+void FusedDetectionDecoder::Suppress(std::vector<Detection>* detections) {
+  // Highest scores first, ties broken by anchor index to be deterministic.
+  const auto by_score = [](const Candidate& a, const Candidate& b) {
+    return a.score > b.score || (a.score == b.score && a.index < b.index);
+  };
+  const int max_candidates = options_.non_max_suppression().max_candidates();
+  if (max_candidates > 0 && candidates_.size() > max_candidates) {
+    std::partial_sort(candidates_.begin(),
+                      candidates_.begin() + max_candidates, candidates_.end(),
+                      by_score);
+    candidates_.resize(max_candidates);
+  } else {
+    std::sort(candidates_.begin(), candidates_.end(), by_score);
+  }
+
+  if (options_.non_max_suppression().algorithm() ==
+      NonMaxSuppression::WEIGHTED) {
+    SuppressWeighted(detections);
+  } else {
+    SuppressDefault(detections);
+  }
+}
+
+void FusedDetectionDecoder::SuppressDefault(
+    std::vector<Detection>* detections) {
+  const auto& nms_options = options_.non_max_suppression();
+  const int max_results = options_.max_results();
+  std::vector<Rectangle_f> retained_rects;
+  for (const Candidate& candidate : candidates_) {
+    const Rectangle_f rect = GetRect(candidate);
+    bool suppressed = false;
+    for (const Rectangle_f& retained_rect : retained_rects) {
+      if (OverlapSimilarity(nms_options.overlap_type(), retained_rect, rect) >
+          nms_options.min_suppression_threshold()) {
+        suppressed = true;
+        break;
+      }
+    }
+    if (suppressed) continue;
+    detections->push_back(MakeDetection(candidate));
+    retained_rects.push_back(rect);
+    if (max_results > 0 && detections->size() >= max_results) break;
+  }
+}
+
+void FusedDetectionDecoder::SuppressWeighted(
+    std::vector<Detection>* detections) {
+  const auto& nms_options = options_.non_max_suppression();
+  const int max_results = options_.max_results();
+  const int num_values = kNumBoxValues + 2 * num_keypoints_;
+  std::vector<Rectangle_f> rects;
+  rects.reserve(candidates_.size());
+  for (const Candidate& candidate : candidates_) {
+    rects.push_back(GetRect(candidate));
+  }
+
+  // Indices in candidates_ of the boxes that are not suppressed yet, by
+  // decreasing score.
+  std::vector<int> remaining(candidates_.size());
+  for (int i = 0; i < remaining.size(); ++i) remaining[i] = i;
+  std::vector<int> still_remaining;
+  std::vector<int> cluster;
+  std::vector<float> weighted(num_values);
+  while (!remaining.empty()) {
+    const int top = remaining[0];
+    still_remaining.clear();
+    cluster.clear();
+    // This includes the top box.
+    for (int i : remaining) {
+      if (OverlapSimilarity(nms_options.overlap_type(), rects[i], rects[top]) >
+          nms_options.min_suppression_threshold()) {
+        cluster.push_back(i);
+      } else {
+        still_remaining.push_back(i);
+      }
+    }
+
+    Detection detection = MakeDetection(candidates_[top]);
+    if (!cluster.empty()) {
+      // Averages the corners and keypoints of the cluster, weighted by score.
+      std::fill(weighted.begin(), weighted.end(), 0.0f);
+      float total_score = 0.0f;
+      for (int i : cluster) {
+        const float score = candidates_[i].score;
+        const float* box = &boxes_[candidates_[i].box_offset];
+        total_score += score;
+        weighted[0] += box[0] * score;
+        weighted[1] += box[1] * score;
+        weighted[2] += (box[0] + box[2]) * score;
+        weighted[3] += (box[1] + box[3]) * score;
+        for (int v = kNumBoxValues; v < num_values; ++v) {
+          weighted[v] += box[v] * score;
+        }
+      }
+      auto* location_data = detection.mutable_location_data();
+      auto* bbox = location_data->mutable_relative_bounding_box();
+      bbox->set_xmin(weighted[0] / total_score);
+      bbox->set_ymin(weighted[1] / total_score);
+      bbox->set_width(weighted[2] / total_score - bbox->xmin());
+      bbox->set_height(weighted[3] / total_score - bbox->ymin());
+      for (int k = 0; k < num_keypoints_; ++k) {
+        auto* keypoint = location_data->mutable_relative_keypoints(k);
+        keypoint->set_x(weighted[kNumBoxValues + 2 * k] / total_score);
+        keypoint->set_y(weighted[kNumBoxValues + 2 * k + 1] / total_score);
+      }
+    }
+    detections->push_back(std::move(detection));
+    if (max_results > 0 && detections->size() >= max_results) break;
+    // Stops if no box was suppressed, e.g. for empty top boxes.
+    if (still_remaining.size() == remaining.size()) break;
+    std::swap(remaining, still_remaining);
+  }
+}
+
+Detection FusedDetectionDecoder::MakeDetection(
+    const Candidate& candidate) const {
+  const float* box = &boxes_[candidate.box_offset];
+  Detection detection;
+  detection.add_score(candidate.score);
+  detection.add_label_id(candidate.class_id);
+  LocationData* location_data = detection.mutable_location_data();
+  location_data->set_format(LocationData::RELATIVE_BOUNDING_BOX);
+  LocationData::RelativeBoundingBox* bbox =
+      location_data->mutable_relative_bounding_box();
+  bbox->set_xmin(box[0]);
+  bbox->set_ymin(box[1]);
+  bbox->set_width(box[2]);
+  bbox->set_height(box[3]);
+  for (int k = 0; k < num_keypoints_; ++k) {
+    auto* keypoint = location_data->add_relative_keypoints();
+    keypoint->set_x(box[kNumBoxValues + 2 * k]);
+    keypoint->set_y(box[kNumBoxValues + 2 * k + 1]);
+  }
+  return detection;
+}
+
+Rectangle_f FusedDetectionDecoder::GetRect(const Candidate& candidate) const {
+  const float* box = &boxes_[candidate.box_offset];
+  return Rectangle_f(box[0], box[1], box[2], box[3]);
+}
+
+}  // namespace mediapipe
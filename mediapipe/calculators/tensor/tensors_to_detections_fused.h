@@ -0,0 +1,106 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_CALCULATORS_TENSOR_TENSORS_TO_DETECTIONS_FUSED_H_
+#define MEDIAPIPE_CALCULATORS_TENSOR_TENSORS_TO_DETECTIONS_FUSED_H_
+
+#include <vector>
+
+#include "absl/types/span.h"
+#include "mediapipe/calculators/tensor/tensors_to_detections_calculator.pb.h"
+#include "mediapipe/framework/formats/detection.pb.h"
+#include "mediapipe/framework/formats/object_detection/anchor.pb.h"
+#include "mediapipe/framework/port/rectangle.h"
+
+namespace mediapipe {
+
+// Returns the box format configured in `options`, taking the deprecated
+// `reverse_output_order` into account.
+TensorsToDetectionsCalculatorOptions::BoxFormat GetBoxFormat(
+    const TensorsToDetectionsCalculatorOptions& options);
+
+// Decodes the raw box of one anchor into `box`, which has the layout of the
+// raw box: {ymin, xmin, ymax, xmax} followed by the (x, y) keypoints.
+void DecodeBox(const TensorsToDetectionsCalculatorOptions& options,
+               TensorsToDetectionsCalculatorOptions::BoxFormat box_format,
+               const float* raw_box, const Anchor& anchor, float* box);
+
+// Converts the raw outputs of detection models without built-in
+// post-processing into detections, with the non-maximum suppression of
+// `options.non_max_suppression()` fused in. Works on the flat model outputs
+// and only creates Detection protos for the retained boxes:
+// 1) The best class of every anchor is found on the raw scores. The sigmoid is
+//    monotonic, so anchors below `min_score_thresh` are rejected before
+//    computing any sigmoid or decoding their box.
+// 2) Only the boxes of the remaining anchors are decoded.
+// 3) The `max_candidates` highest-scoring boxes are selected with a partial
+//    sort.
+// 4) Non-maximum suppression runs on the decoded boxes, keeping at most
+//    `max_results` detections.
+//
+// The scores and boxes are computed as in TensorsToDetectionsCalculator, and
+// the suppression follows NonMaxSuppressionCalculator.
+//
+// Not thread-safe: scratch buffers are reused across calls.
+class FusedDetectionDecoder {
+ public:
+  // `class_allowed[c]` tells whether class c is kept.
+  FusedDetectionDecoder(const TensorsToDetectionsCalculatorOptions& options,
+                        std::vector<bool> class_allowed);
+
+  // `raw_boxes` and `raw_scores` hold num_boxes x num_coords and
+  // num_boxes x num_classes values, and `anchors` num_boxes anchors.
+  void Decode(const float* raw_boxes, const float* raw_scores,
+              absl::Span<const Anchor> anchors,
+              std::vector<Detection>* detections);
+
+  // Same as Decode(), for boxes that have already been decoded and scored
+  // elsewhere, e.g. on GPU.
+  void DecodeScored(const float* boxes, const float* scores,
+                    const int* classes, std::vector<Detection>* detections);
+
+ private:
+  struct Candidate {
+    int index;
+    int class_id;
+    float score;
+    // Offset of the candidate box in boxes_.
+    int box_offset;
+  };
+
+  // Appends the candidate to candidates_ if its decoded box is valid.
+  void AddCandidate(int index, int class_id, float score, const float* box);
+  // Runs steps 3) and 4) on candidates_.
+  void Suppress(std::vector<Detection>* detections);
+  void SuppressDefault(std::vector<Detection>* detections);
+  void SuppressWeighted(std::vector<Detection>* detections);
+  Detection MakeDetection(const Candidate& candidate) const;
+  Rectangle_f GetRect(const Candidate& candidate) const;
+
+  const TensorsToDetectionsCalculatorOptions options_;
+  const TensorsToDetectionsCalculatorOptions::BoxFormat box_format_;
+  const std::vector<bool> class_allowed_;
+  const bool all_classes_allowed_;
+  const int num_keypoints_;
+
+  std::vector<Candidate> candidates_;
+  // The output space boxes of the candidates: {xmin, ymin, width, height}
+  // followed by the (x, y) keypoints, with flip_vertically applied.
+  std::vector<float> boxes_;
+  std::vector<float> decoded_box_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_TENSOR_TENSORS_TO_DETECTIONS_FUSED_H_
@@ -0,0 +1,270 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/tensors_to_detections_fused.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "mediapipe/calculators/tensor/tensors_to_detections_calculator.pb.h"
+#include "mediapipe/framework/formats/detection.pb.h"
+#include "mediapipe/framework/formats/object_detection/anchor.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+using Options = TensorsToDetectionsCalculatorOptions;
+using ::testing::ElementsAre;
+using ::testing::FloatEq;
+
+// Anchors that leave the raw boxes unchanged with unit scales.
+std::vector<Anchor> MakeAnchors(int num_boxes) {
+  std::vector<Anchor> anchors(num_boxes);
+  for (Anchor& anchor : anchors) {
+    anchor.set_w(1.0f);
+    anchor.set_h(1.0f);
+  }
+  return anchors;
+}
+
+Options MakeOptions(int num_boxes, int num_classes) {
+  Options options;
+  options.set_num_boxes(num_boxes);
+  options.set_num_classes(num_classes);
+  options.set_num_coords(4);
+  options.set_x_scale(1.0f);
+  options.set_y_scale(1.0f);
+  options.set_w_scale(1.0f);
+  options.set_h_scale(1.0f);
+  options.mutable_non_max_suppression();
+  return options;
+}
+
+// Appends a raw YXHW box with the given corners.
+void AddBox(float xmin, float ymin, float xmax, float ymax,
+            std::vector<float>* raw_boxes) {
+  raw_boxes->insert(raw_boxes->end(), {(ymin + ymax) / 2, (xmin + xmax) / 2,
+                                       ymax - ymin, xmax - xmin});
+}
+
+std::vector<float> GetScores(const std::vector<Detection>& detections) {
+  std::vector<float> scores;
+  for (const Detection& detection : detections) {
+    scores.push_back(detection.score(0));
+  }
+  return scores;
+}
+
+TEST(FusedDetectionDecoderTest, AppliesSigmoidAndThreshold) {
+  Options options = MakeOptions(/*num_boxes=*/3, /*num_classes=*/2);
+  options.set_sigmoid_score(true);
+  options.set_score_clipping_thresh(2.0f);
+  options.set_min_score_thresh(0.5f);
+  std::vector<float> raw_boxes;
+  AddBox(0.0f, 0.0f, 0.1f, 0.1f, &raw_boxes);
+  AddBox(0.3f, 0.3f, 0.4f, 0.4f, &raw_boxes);
+  AddBox(0.6f, 0.6f, 0.7f, 0.7f, &raw_boxes);
+  const std::vector<float> raw_scores = {-1.0f, 0.5f,   //
+                                         -0.1f, -2.0f,  //
+                                         10.0f, 1.0f};
+  FusedDetectionDecoder decoder(options, {true, true});
+  std::vector<Detection> detections;
+  decoder.Decode(raw_boxes.data(), raw_scores.data(), MakeAnchors(3),
+                 &detections);
+
+  ASSERT_EQ(detections.size(), 2);
+  // The score of the last box is clipped.
+  EXPECT_EQ(detections[0].score(0), 1.0f / (1.0f + std::exp(-2.0f)));
+  EXPECT_EQ(detections[0].label_id(0), 0);
+  EXPECT_EQ(detections[1].score(0), 1.0f / (1.0f + std::exp(-0.5f)));
+  EXPECT_EQ(detections[1].label_id(0), 1);
+  const auto& bbox = detections[1].location_data().relative_bounding_box();
+  EXPECT_FLOAT_EQ(bbox.xmin(), 0.0f);
+  EXPECT_FLOAT_EQ(bbox.ymin(), 0.0f);
+  EXPECT_FLOAT_EQ(bbox.width(), 0.1f);
+  EXPECT_FLOAT_EQ(bbox.height(), 0.1f);
+}
+
+TEST(FusedDetectionDecoderTest, SkipsIgnoredClasses) {
+  Options options = MakeOptions(/*num_boxes=*/1, /*num_classes=*/3);
+  std::vector<float> raw_boxes;
+  AddBox(0.0f, 0.0f, 0.1f, 0.1f, &raw_boxes);
+  const std::vector<float> raw_scores = {0.9f, 0.2f, 0.5f};
+  FusedDetectionDecoder decoder(options, {false, true, true});
+  std::vector<Detection> detections;
+  decoder.Decode(raw_boxes.data(), raw_scores.data(), MakeAnchors(1),
+                 &detections);
+
+  ASSERT_EQ(detections.size(), 1);
+  EXPECT_EQ(detections[0].label_id(0), 2);
+  EXPECT_EQ(detections[0].score(0), 0.5f);
+}
+
+TEST(FusedDetectionDecoderTest, SuppressesOverlappingBoxes) {
+  Options options = MakeOptions(/*num_boxes=*/4, /*num_classes=*/1);
+  std::vector<float> raw_boxes;
+  AddBox(0.0f, 0.0f, 0.4f, 0.4f, &raw_boxes);
+  AddBox(0.02f, 0.02f, 0.42f, 0.42f, &raw_boxes);
+  AddBox(0.5f, 0.5f, 0.9f, 0.9f, &raw_boxes);
+  AddBox(0.52f, 0.5f, 0.92f, 0.9f, &raw_boxes);
+  const std::vector<float> raw_scores = {0.6f, 0.8f, 0.7f, 0.5f};
+  FusedDetectionDecoder decoder(options, {true});
+  std::vector<Detection> detections;
+  decoder.Decode(raw_boxes.data(), raw_scores.data(), MakeAnchors(4),
+                 &detections);
+
+  EXPECT_THAT(GetScores(detections), ElementsAre(0.8f, 0.7f));
+}
+
+TEST(FusedDetectionDecoderTest, AveragesOverlappingBoxesWithWeightedNms) {
+  Options options = MakeOptions(/*num_boxes=*/2, /*num_classes=*/1);
+  options.mutable_non_max_suppression()->set_algorithm(
+      Options::NonMaxSuppression::WEIGHTED);
+  std::vector<float> raw_boxes;
+  AddBox(0.0f, 0.0f, 0.4f, 0.4f, &raw_boxes);
+  AddBox(0.1f, 0.0f, 0.5f, 0.4f, &raw_boxes);
+  const std::vector<float> raw_scores = {0.75f, 0.25f};
+  FusedDetectionDecoder decoder(options, {true});
+  std::vector<Detection> detections;
+  decoder.Decode(raw_boxes.data(), raw_scores.data(), MakeAnchors(2),
+                 &detections);
+
+  ASSERT_EQ(detections.size(), 1);
+  EXPECT_EQ(detections[0].score(0), 0.75f);
+  const auto& bbox = detections[0].location_data().relative_bounding_box();
+  EXPECT_FLOAT_EQ(bbox.xmin(), 0.025f);
+  EXPECT_FLOAT_EQ(bbox.width(), 0.4f);
+  EXPECT_FLOAT_EQ(bbox.height(), 0.4f);
+}
+
+TEST(FusedDetectionDecoderTest, LimitsCandidatesAndResults) {
+  constexpr int kNumBoxes = 10;
+  Options options = MakeOptions(kNumBoxes, /*num_classes=*/1);
+  options.mutable_non_max_suppression()->set_max_candidates(5);
+  options.set_max_results(3);
+  std::vector<float> raw_boxes;
+  std::vector<float> raw_scores;
+  for (int i = 0; i < kNumBoxes; ++i) {
+    AddBox(0.1f * i, 0.0f, 0.1f * i + 0.05f, 0.05f, &raw_boxes);
+    raw_scores.push_back(0.01f * i);
+  }
+  FusedDetectionDecoder decoder(options, {true});
+  std::vector<Detection> detections;
+  decoder.Decode(raw_boxes.data(), raw_scores.data(), MakeAnchors(kNumBoxes),
+                 &detections);
+
+  EXPECT_THAT(GetScores(detections),
+              ElementsAre(FloatEq(0.09f), FloatEq(0.08f), FloatEq(0.07f)));
+}
+
+TEST(FusedDetectionDecoderTest, FlipsVerticallyAndDecodesKeypoints) {
+  Options options = MakeOptions(/*num_boxes=*/1, /*num_classes=*/1);
+  options.set_num_coords(6);
+  options.set_num_keypoints(1);
+  options.set_keypoint_coord_offset(4);
+  options.set_flip_vertically(true);
+  std::vector<float> raw_boxes;
+  AddBox(0.1f, 0.2f, 0.3f, 0.6f, &raw_boxes);
+  // Keypoint (x=0.15, y=0.25) in YX order.
+  raw_boxes.insert(raw_boxes.end(), {0.25f, 0.15f});
+  const std::vector<float> raw_scores = {0.9f};
+  FusedDetectionDecoder decoder(options, {true});
+  std::vector<Detection> detections;
+  decoder.Decode(raw_boxes.data(), raw_scores.data(), MakeAnchors(1),
+                 &detections);
+
+  ASSERT_EQ(detections.size(), 1);
+  const auto& location_data = detections[0].location_data();
+  EXPECT_FLOAT_EQ(location_data.relative_bounding_box().ymin(), 0.4f);
+  ASSERT_EQ(location_data.relative_keypoints_size(), 1);
+  EXPECT_FLOAT_EQ(location_data.relative_keypoints(0).x(), 0.15f);
+  EXPECT_FLOAT_EQ(location_data.relative_keypoints(0).y(), 0.75f);
+}
+
+// Decode() rejects anchors on the raw scores, which must give the same
+// detections as scoring all anchors first, as the calculator does without
+// fused suppression.
+TEST(FusedDetectionDecoderTest, MatchesDecodingOfScoredBoxes) {
+  constexpr int kNumBoxes = 500;
+  constexpr int kNumClasses = 3;
+  Options options = MakeOptions(kNumBoxes, kNumClasses);
+  options.set_sigmoid_score(true);
+  options.set_score_clipping_thresh(4.0f);
+  options.set_min_score_thresh(0.6f);
+  options.set_apply_exponential_on_box_size(true);
+  const std::vector<bool> class_allowed = {true, false, true};
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> score_dist(-6.0f, 6.0f);
+  std::uniform_real_distribution<float> box_dist(0.0f, 1.0f);
+  std::vector<float> raw_scores(kNumBoxes * kNumClasses);
+  for (float& score : raw_scores) score = score_dist(rng);
+  std::vector<float> raw_boxes(kNumBoxes * 4);
+  for (float& value : raw_boxes) value = box_dist(rng) - 0.5f;
+  std::vector<Anchor> anchors(kNumBoxes);
+  for (Anchor& anchor : anchors) {
+    anchor.set_x_center(box_dist(rng));
+    anchor.set_y_center(box_dist(rng));
+    anchor.set_w(0.1f);
+    anchor.set_h(0.1f);
+  }
+
+  // Scores all anchors as TensorsToDetectionsCalculator::ProcessCPU does.
+  std::vector<float> boxes(kNumBoxes * 4);
+  std::vector<float> scores(kNumBoxes);
+  std::vector<int> classes(kNumBoxes);
+  for (int i = 0; i < kNumBoxes; ++i) {
+    DecodeBox(options, Options::YXHW, &raw_boxes[i * 4], anchors[i],
+              &boxes[i * 4]);
+    int class_id = -1;
+    float max_score = -std::numeric_limits<float>::max();
+    for (int c = 0; c < kNumClasses; ++c) {
+      if (!class_allowed[c]) continue;
+      float score = std::min(std::max(raw_scores[i * kNumClasses + c], -4.0f),
+                             4.0f);
+      score = 1.0f / (1.0f + std::exp(-score));
+      if (max_score < score) {
+        max_score = score;
+        class_id = c;
+      }
+    }
+    scores[i] = max_score;
+    classes[i] = class_id;
+  }
+
+  for (auto algorithm : {Options::NonMaxSuppression::DEFAULT,
+                         Options::NonMaxSuppression::WEIGHTED}) {
+    options.mutable_non_max_suppression()->set_algorithm(algorithm);
+    FusedDetectionDecoder decoder(options, class_allowed);
+    std::vector<Detection> detections;
+    decoder.Decode(raw_boxes.data(), raw_scores.data(), anchors, &detections);
+    std::vector<Detection> expected_detections;
+    decoder.DecodeScored(boxes.data(), scores.data(), classes.data(),
+                         &expected_detections);
+
+    ASSERT_FALSE(expected_detections.empty());
+    ASSERT_EQ(detections.size(), expected_detections.size());
+    for (int i = 0; i < detections.size(); ++i) {
+      EXPECT_EQ(detections[i].DebugString(),
+                expected_detections[i].DebugString());
+    }
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
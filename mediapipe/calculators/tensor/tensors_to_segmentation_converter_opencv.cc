@@ -15,34 +15,48 @@
 #include "mediapipe/calculators/tensor/tensors_to_segmentation_converter_opencv.h"
 
 #include <algorithm>
-#include <cmath>
+#include <cstring>
 #include <memory>
-#include <vector>
+#include <optional>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "mediapipe/calculators/tensor/tensors_to_segmentation_calculator.pb.h"
 #include "mediapipe/calculators/tensor/tensors_to_segmentation_converter.h"
+#include "mediapipe/calculators/tensor/tensors_to_segmentation_cpu_kernels.h"
 #include "mediapipe/calculators/tensor/tensors_to_segmentation_utils.h"
 #include "mediapipe/framework/formats/image.h"
 #include "mediapipe/framework/formats/image_frame.h"
-#include "mediapipe/framework/formats/image_opencv.h"
 #include "mediapipe/framework/formats/tensor.h"
-#include "mediapipe/framework/port/opencv_core_inc.h"
-#include "mediapipe/framework/port/opencv_imgproc_inc.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/port/threadpool.h"
+#include "mediapipe/util/parallel_for_rows.h"
 
 namespace mediapipe {
 namespace {
 
+using ::mediapipe::tensors_to_segmentation_utils::BilinearResizer;
 using ::mediapipe::tensors_to_segmentation_utils::GetHwcFromDims;
+using ::mediapipe::tensors_to_segmentation_utils::SigmoidActivation;
+using ::mediapipe::tensors_to_segmentation_utils::SoftmaxActivation;
+using Options = ::mediapipe::TensorsToSegmentationCalculatorOptions;
+
+// Smallest number of rows worth handing to another thread.
+constexpr int kMinRowsPerBand = 16;
 
 class TensorsToSegmentationOpenCvConverter
     : public TensorsToSegmentationConverter {
  public:
   absl::Status Init(const TensorsToSegmentationCalculatorOptions& options) {
     options_ = options;
+    RET_CHECK_GE(options_.cpu_num_threads(), 1);
+    if (options_.cpu_num_threads() > 1) {
+      // The calling thread processes rows too.
+      thread_pool_ = std::make_unique<ThreadPool>(
+          "tensors_to_segmentation", options_.cpu_num_threads() - 1);
+      thread_pool_->StartWorkers();
+    }
     return absl::OkStatus();
   }
 
@@ -51,10 +65,16 @@ class TensorsToSegmentationOpenCvConverter
                                                  int output_height) override;
 
  private:
-  template <class T>
-  absl::Status ApplyActivation(cv::Mat& tensor_mat, cv::Mat* small_mask_mat);
+  // Writes the activated mask of "num_pixels" input pixels to "output".
+  void ApplyActivation(const float* input, int num_pixels, int num_channels,
+                       float* output) const;
 
   TensorsToSegmentationCalculatorOptions options_;
+  std::unique_ptr<ThreadPool> thread_pool_;
+  // Reused across calls with the same sizes.
+  std::optional<BilinearResizer> resizer_;
+  std::unique_ptr<float[]> small_mask_;
+  int small_mask_size_ = 0;
 };
 
 absl::StatusOr<std::unique_ptr<Image>>
@@ -63,90 +83,101 @@ TensorsToSegmentationOpenCvConverter::Convert(const Tensor& input_tensor,
                                               int output_height) {
   MP_ASSIGN_OR_RETURN(auto hwc, GetHwcFromDims(input_tensor.shape().dims));
   auto [tensor_height, tensor_width, tensor_channels] = hwc;
-  // Create initial working mask.
-  cv::Mat small_mask_mat(cv::Size(tensor_width, tensor_height), CV_32FC1);
-
-  // Wrap input tensor.
-  auto raw_input_tensor = &input_tensor;
-  auto raw_input_view = raw_input_tensor->GetCpuReadView();
-  const float* raw_input_data = raw_input_view.buffer<float>();
-  cv::Mat tensor_mat(cv::Size(tensor_width, tensor_height),
-                     CV_MAKETYPE(CV_32F, tensor_channels),
-                     const_cast<float*>(raw_input_data));
-
-  // Process mask tensor and apply activation function.
-  if (tensor_channels == 2) {
-    MP_RETURN_IF_ERROR(ApplyActivation<cv::Vec2f>(tensor_mat, &small_mask_mat));
-  } else if (tensor_channels == 1) {
-    RET_CHECK(mediapipe::TensorsToSegmentationCalculatorOptions::SOFTMAX !=
-              options_.activation());  // Requires 2 channels.
-    if (mediapipe::TensorsToSegmentationCalculatorOptions::NONE ==
-        options_.activation())  // Pass-through optimization.
-      tensor_mat.copyTo(small_mask_mat);
-    else
-      MP_RETURN_IF_ERROR(ApplyActivation<float>(tensor_mat, &small_mask_mat));
-  } else {
+  if (tensor_channels == 1) {
+    // Requires 2 channels.
+    RET_CHECK(Options::SOFTMAX != options_.activation());
+  } else if (tensor_channels != 2) {
     RET_CHECK_FAIL() << "Unsupported number of tensor channels "
                      << tensor_channels;
   }
 
-  // Send out image as CPU packet.
+  if (options_.activation() == Options::SOFTMAX) {
+    RET_CHECK(options_.output_layer_index() == 0 ||
+              options_.output_layer_index() == 1);
+  }
+
+  auto raw_input_view = input_tensor.GetCpuReadView();
+  const float* raw_input_data = raw_input_view.buffer<float>();
+
   std::shared_ptr<ImageFrame> mask_frame = std::make_shared<ImageFrame>(
       ImageFormat::VEC32F1, output_width, output_height);
-  auto output_mask = std::make_unique<Image>(mask_frame);
-  auto output_mat = formats::MatView(output_mask.get());
-  // Upsample small mask into output.
-  cv::resize(small_mask_mat, *output_mat,
-             cv::Size(output_width, output_height));
-  return output_mask;
+  float* output_data = reinterpret_cast<float*>(mask_frame->MutablePixelData());
+  const int output_stride = mask_frame->WidthStep() / sizeof(float);
+
+  const bool resize =
+      tensor_width != output_width || tensor_height != output_height;
+  if (!resize) {
+    // Activates directly into the output.
+    ParallelForRows(tensor_height, kMinRowsPerBand, thread_pool_.get(),
+                    [&](int begin, int end) {
+                      for (int y = begin; y < end; ++y) {
+                        ApplyActivation(
+                            raw_input_data + y * tensor_width * tensor_channels,
+                            tensor_width, tensor_channels,
+                            output_data + y * output_stride);
+                      }
+                    });
+    return std::make_unique<Image>(mask_frame);
+  }
+
+  // Activates the small mask, then upsamples it into the output. Both steps
+  // are split into bands of rows, the second one only starting when the
+  // whole small mask is ready.
+  const int small_mask_size = tensor_width * tensor_height;
+  if (small_mask_size_ != small_mask_size) {
+    small_mask_ = std::make_unique<float[]>(small_mask_size);
+    small_mask_size_ = small_mask_size;
+  }
+  float* small_mask = small_mask_.get();
+  ParallelForRows(tensor_height, kMinRowsPerBand, thread_pool_.get(),
+                  [&](int begin, int end) {
+                    ApplyActivation(
+                        raw_input_data + begin * tensor_width * tensor_channels,
+                        (end - begin) * tensor_width, tensor_channels,
+                        small_mask + begin * tensor_width);
+                  });
+
+  if (!resizer_ || resizer_->src_width() != tensor_width ||
+      resizer_->src_height() != tensor_height ||
+      resizer_->dst_width() != output_width ||
+      resizer_->dst_height() != output_height) {
+    resizer_.emplace(tensor_width, tensor_height, output_width,
+                     output_height);
+  }
+  ParallelForRows(output_height, kMinRowsPerBand, thread_pool_.get(),
+                  [&](int begin, int end) {
+                    resizer_->ResizeRows(small_mask, tensor_width, begin, end,
+                                         output_data, output_stride);
+                  });
+  return std::make_unique<Image>(mask_frame);
 }
 
-template <class T>
-absl::Status TensorsToSegmentationOpenCvConverter::ApplyActivation(
-    cv::Mat& tensor_mat, cv::Mat* small_mask_mat) {
-  // Configure activation function.
-  const int output_layer_index = options_.output_layer_index();
-  using Options = ::mediapipe::TensorsToSegmentationCalculatorOptions;
-  const auto activation_fn = [&](const cv::Vec2f& mask_value) {
-    float new_mask_value = 0;
-    // TODO consider moving switch out of the loop,
-    // and also avoid float/Vec2f casting.
-    switch (options_.activation()) {
-      case Options::NONE: {
-        new_mask_value = mask_value[0];
-        break;
+void TensorsToSegmentationOpenCvConverter::ApplyActivation(
+    const float* input, int num_pixels, int num_channels,
+    float* output) const {
+  switch (options_.activation()) {
+    case Options::NONE:
+      if (num_channels == 1) {
+        std::memcpy(output, input, num_pixels * sizeof(float));
+      } else {
+        // Only the first channel is used.
+        for (int i = 0; i < num_pixels; ++i) output[i] = input[2 * i];
       }
-      case Options::SIGMOID: {
-        const float pixel0 = mask_value[0];
-        new_mask_value = 1.0 / (std::exp(-pixel0) + 1.0);
-        break;
+      break;
+    case Options::SIGMOID:
+      if (num_channels == 1) {
+        SigmoidActivation(input, num_pixels, output);
+      } else {
+        // Applies to the first channel only, as before.
+        for (int i = 0; i < num_pixels; ++i) output[i] = input[2 * i];
+        SigmoidActivation(output, num_pixels, output);
       }
-      case Options::SOFTMAX: {
-        const float pixel0 = mask_value[0];
-        const float pixel1 = mask_value[1];
-        const float max_pixel = std::max(pixel0, pixel1);
-        const float min_pixel = std::min(pixel0, pixel1);
-        const float softmax_denom =
-            /*exp(max_pixel - max_pixel)=*/1.0f +
-            std::exp(min_pixel - max_pixel);
-        new_mask_value = std::exp(mask_value[output_layer_index] - max_pixel) /
-                         softmax_denom;
-        break;
-      }
-    }
-    return new_mask_value;
-  };
-
-  // Process mask tensor.
-  for (int i = 0; i < tensor_mat.rows; ++i) {
-    for (int j = 0; j < tensor_mat.cols; ++j) {
-      const T& input_pix = tensor_mat.at<T>(i, j);
-      const float mask_value = activation_fn(input_pix);
-      small_mask_mat->at<float>(i, j) = mask_value;
-    }
+      break;
+    case Options::SOFTMAX:
+      SoftmaxActivation(input, num_pixels, options_.output_layer_index(),
+                        output);
+      break;
   }
-
-  return absl::OkStatus();
 }
 
 }  // namespace
@@ -0,0 +1,148 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/tensors_to_segmentation_cpu_kernels.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace mediapipe {
+namespace tensors_to_segmentation_utils {
+
+namespace {
+
+// Number of values the activations process at once.
+constexpr int kBlockSize = 8;
+
+// Computes the input positions and weights of cv::resize with INTER_LINEAR
+// along one axis.
+void GetLinearTaps(int src_size, int dst_size, std::vector<int>& offsets,
+                   std::vector<int>& next_offsets,
+                   std::vector<float>& weights) {
+  offsets.resize(dst_size);
+  next_offsets.resize(dst_size);
+  weights.resize(dst_size);
+  const double scale = static_cast<double>(src_size) / dst_size;
+  for (int i = 0; i < dst_size; ++i) {
+    float position = static_cast<float>((i + 0.5) * scale - 0.5);
+    int offset = static_cast<int>(position);
+    offset -= offset > position;
+    float weight = position - offset;
+    if (offset < 0) {
+      offset = 0;
+      weight = 0.0f;
+    }
+    offsets[i] = std::min(offset, src_size - 1);
+    next_offsets[i] = std::min(offset + 1, src_size - 1);
+    weights[i] = weight;
+  }
+}
+
+}  // namespace
+
+void SigmoidActivation(const float* input, int size, float* output) {
+  int i = 0;
+  // Blocks of fixed size through local arrays are vectorized even at -O2,
+  // where GCC neither adds a remainder loop nor checks for aliasing.
+  for (; i + kBlockSize <= size; i += kBlockSize) {
+    float block[kBlockSize];
+    std::memcpy(block, input + i, sizeof(block));
+    for (int j = 0; j < kBlockSize; ++j) {
+      block[j] = 1.0f / (1.0f + FastExp(-block[j]));
+    }
+    std::memcpy(output + i, block, sizeof(block));
+  }
+  for (; i < size; ++i) {
+    output[i] = 1.0f / (1.0f + FastExp(-input[i]));
+  }
+}
+
+void SoftmaxActivation(const float* input, int size, int channel,
+                       float* output) {
+  // With two channels, softmax(x)[c] = 1 / (1 + exp(x[1 - c] - x[c])).
+  const int other_channel = 1 - channel;
+  int i = 0;
+  for (; i + kBlockSize <= size; i += kBlockSize) {
+    float block[kBlockSize];
+    for (int j = 0; j < kBlockSize; ++j) {
+      block[j] = input[2 * (i + j) + other_channel] -
+                 input[2 * (i + j) + channel];
+    }
+    for (int j = 0; j < kBlockSize; ++j) {
+      block[j] = 1.0f / (1.0f + FastExp(block[j]));
+    }
+    std::memcpy(output + i, block, sizeof(block));
+  }
+  for (; i < size; ++i) {
+    output[i] = 1.0f / (1.0f + FastExp(input[2 * i + other_channel] -
+                                       input[2 * i + channel]));
+  }
+}
+
+BilinearResizer::BilinearResizer(int src_width, int src_height, int dst_width,
+                                 int dst_height)
+    : src_width_(src_width), src_height_(src_height) {
+  GetLinearTaps(src_width, dst_width, x_offsets_, x_next_offsets_,
+                x_weights_);
+  GetLinearTaps(src_height, dst_height, y_offsets_, y_next_offsets_,
+                y_weights_);
+}
+
+void BilinearResizer::ResizeRow(const float* src_row, float* dst_row) const {
+  const int dst_width = this->dst_width();
+  for (int x = 0; x < dst_width; ++x) {
+    const float x_weight = x_weights_[x];
+    dst_row[x] = src_row[x_offsets_[x]] * (1.0f - x_weight) +
+                 src_row[x_next_offsets_[x]] * x_weight;
+  }
+}
+
+void BilinearResizer::ResizeRows(const float* src, int src_stride, int begin,
+                                 int end, float* dst, int dst_stride) const {
+  const int dst_width = this->dst_width();
+  // Like cv::resize, interpolates input rows horizontally first, and keeps the
+  // last two of them, as consecutive output rows mostly share input rows when
+  // upsampling.
+  std::vector<float> rows(2 * dst_width);
+  float* row0 = rows.data();
+  float* row1 = rows.data() + dst_width;
+  int row0_offset = -1;
+  int row1_offset = -1;
+  for (int y = begin; y < end; ++y) {
+    const int offset = y_offsets_[y];
+    const int next_offset = y_next_offsets_[y];
+    if (offset == row1_offset) {
+      std::swap(row0, row1);
+      std::swap(row0_offset, row1_offset);
+    }
+    if (offset != row0_offset) {
+      ResizeRow(src + offset * src_stride, row0);
+      row0_offset = offset;
+    }
+    if (next_offset != row1_offset) {
+      ResizeRow(src + next_offset * src_stride, row1);
+      row1_offset = next_offset;
+    }
+    const float y_weight = y_weights_[y];
+    float* dst_row = dst + y * dst_stride;
+    for (int x = 0; x < dst_width; ++x) {
+      dst_row[x] = row0[x] * (1.0f - y_weight) + row1[x] * y_weight;
+    }
+  }
+}
+
+}  // namespace tensors_to_segmentation_utils
+}  // namespace mediapipe
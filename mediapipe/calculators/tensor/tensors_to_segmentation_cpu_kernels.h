@@ -0,0 +1,109 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_CALCULATORS_TENSOR_TENSORS_TO_SEGMENTATION_CPU_KERNELS_H_
+#define MEDIAPIPE_CALCULATORS_TENSOR_TENSORS_TO_SEGMENTATION_CPU_KERNELS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "absl/base/casts.h"
+
+namespace mediapipe {
+namespace tensors_to_segmentation_utils {
+
+// Kernels for the CPU segmentation converter. They are written as plain loops
+// over floats without library calls or float comparisons, so that the
+// compiler vectorizes them, and process disjoint ranges so that they can be
+// split between threads.
+
+// Writes 1 / (1 + exp(-input[i])) to output[i], for i in [0, size).
+void SigmoidActivation(const float* input, int size, float* output);
+
+// Writes the softmax probability of channel "channel" (0 or 1) of the
+// 2-channel interleaved "input" to output[i], for i in [0, size).
+void SoftmaxActivation(const float* input, int size, int channel,
+                       float* output);
+
+// Approximates exp(x) with a relative error below 2e-7 for x in
+// [-87, 87], and clamps x to that range. Inline, so that loops calling it are
+// vectorized.
+inline float FastExp(float x) {
+  // exp(x) = 2^n * exp(r), with n = round(x / ln(2)) and |r| <= ln(2) / 2.
+  // The polynomial approximating exp(r) is the one of Cephes' expf.
+  constexpr float kLog2e = 1.44269504088896341f;
+  constexpr float kLn2High = 0.693359375f;
+  constexpr float kLn2Low = -2.12194440e-4f;
+  // Adding and subtracting 1.5 * 2^23 rounds to the nearest integer.
+  constexpr float kRoundingBias = 12582912.0f;
+  // Clamps |x| to 87 on the bits of x: float comparisons would keep GCC from
+  // vectorizing the loops calling this, as they may trap.
+  constexpr int32_t kSignMask = static_cast<int32_t>(0x80000000u);
+  const int32_t bits = absl::bit_cast<int32_t>(x);
+  x = absl::bit_cast<float>(
+      (bits & kSignMask) |
+      std::min(bits & ~kSignMask, absl::bit_cast<int32_t>(87.0f)));
+  const float n_float = (x * kLog2e + kRoundingBias) - kRoundingBias;
+  const int n = static_cast<int>(n_float);
+  const float r = x - n_float * kLn2High - n_float * kLn2Low;
+  float p = 1.9875691500e-4f;
+  p = p * r + 1.3981999507e-3f;
+  p = p * r + 8.3334519073e-3f;
+  p = p * r + 4.1665795894e-2f;
+  p = p * r + 1.6666665459e-1f;
+  p = p * r + 5.0000001201e-1f;
+  const float exp_r = p * r * r + r + 1.0f;
+  return exp_r * absl::bit_cast<float>(static_cast<int32_t>(n + 127) << 23);
+}
+
+// Resizes one-channel float images with bilinear interpolation, following
+// the conventions of cv::resize with INTER_LINEAR: pixel centers are at
+// half-integer coordinates and borders are replicated.
+class BilinearResizer {
+ public:
+  BilinearResizer(int src_width, int src_height, int dst_width,
+                  int dst_height);
+
+  // Writes rows [begin, end) of the resized "src" to "dst". Strides are in
+  // floats.
+  void ResizeRows(const float* src, int src_stride, int begin, int end,
+                  float* dst, int dst_stride) const;
+
+  int src_width() const { return src_width_; }
+  int src_height() const { return src_height_; }
+  int dst_width() const { return static_cast<int>(x_offsets_.size()); }
+  int dst_height() const { return static_cast<int>(y_offsets_.size()); }
+
+ private:
+  // Interpolates one input row horizontally.
+  void ResizeRow(const float* src_row, float* dst_row) const;
+
+  int src_width_;
+  int src_height_;
+  // For each output column: the two input columns to interpolate, and the
+  // weight of the second one.
+  std::vector<int> x_offsets_;
+  std::vector<int> x_next_offsets_;
+  std::vector<float> x_weights_;
+  // Same for each output row.
+  std::vector<int> y_offsets_;
+  std::vector<int> y_next_offsets_;
+  std::vector<float> y_weights_;
+};
+
+}  // namespace tensors_to_segmentation_utils
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_TENSOR_TENSORS_TO_SEGMENTATION_CPU_KERNELS_H_
@@ -0,0 +1,104 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/tensors_to_segmentation_cpu_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace tensors_to_segmentation_utils {
+namespace {
+
+TEST(TensorsToSegmentationCpuKernelsTest, FastExpMatchesExp) {
+  for (float x = -87.0f; x <= 87.0f; x += 0.01f) {
+    EXPECT_NEAR(FastExp(x), std::exp(x), 2e-7f * std::exp(x)) << x;
+  }
+  EXPECT_EQ(FastExp(-1000.0f), FastExp(-87.0f));
+  EXPECT_EQ(FastExp(1000.0f), FastExp(87.0f));
+}
+
+TEST(TensorsToSegmentationCpuKernelsTest, SigmoidActivation) {
+  std::vector<float> input;
+  for (float x = -20.0f; x <= 20.0f; x += 0.25f) input.push_back(x);
+  std::vector<float> output(input.size());
+  SigmoidActivation(input.data(), input.size(), output.data());
+  for (int i = 0; i < input.size(); ++i) {
+    EXPECT_NEAR(output[i], 1.0f / (1.0f + std::exp(-input[i])), 1e-7f);
+  }
+}
+
+TEST(TensorsToSegmentationCpuKernelsTest, SoftmaxActivation) {
+  const std::vector<float> input = {1.0f,  2.0f,  4.0f, 2.0f,
+                                    30.0f, 24.6f, -3.0f, 5.0f};
+  std::vector<float> output(input.size() / 2);
+  for (int channel : {0, 1}) {
+    SoftmaxActivation(input.data(), output.size(), channel, output.data());
+    for (int i = 0; i < output.size(); ++i) {
+      const float expected = std::exp(input[2 * i + channel]) /
+                             (std::exp(input[2 * i]) +
+                              std::exp(input[2 * i + 1]));
+      EXPECT_NEAR(output[i], expected, 1e-7f);
+    }
+  }
+}
+
+TEST(TensorsToSegmentationCpuKernelsTest, BilinearResizerKeepsSameSize) {
+  const std::vector<float> src = {1, 2, 3, 4, 5, 6};
+  BilinearResizer resizer(/*src_width=*/3, /*src_height=*/2, /*dst_width=*/3,
+                          /*dst_height=*/2);
+  std::vector<float> dst(6);
+  resizer.ResizeRows(src.data(), /*src_stride=*/3, 0, 2, dst.data(),
+                     /*dst_stride=*/3);
+  EXPECT_EQ(dst, src);
+}
+
+TEST(TensorsToSegmentationCpuKernelsTest, BilinearResizerUpsamples) {
+  // Expected values of cv::resize with INTER_LINEAR.
+  const std::vector<float> src = {0, 4, 8, 12};
+  BilinearResizer resizer(/*src_width=*/2, /*src_height=*/2, /*dst_width=*/4,
+                          /*dst_height=*/3);
+  // Padded rows.
+  std::vector<float> dst(3 * 5, -1.0f);
+  resizer.ResizeRows(src.data(), /*src_stride=*/2, 0, 3, dst.data(),
+                     /*dst_stride=*/5);
+  const std::vector<float> expected = {
+      0, 1,  3,  4,  -1,  //
+      4, 5,  7,  8,  -1,  //
+      8, 9, 11, 12, -1};
+  for (int i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(dst[i], expected[i], 1e-5f) << i;
+  }
+}
+
+TEST(TensorsToSegmentationCpuKernelsTest, BilinearResizerSplitsRows) {
+  std::vector<float> src(16 * 9);
+  for (int i = 0; i < src.size(); ++i) src[i] = (i * 37) % 11;
+  BilinearResizer resizer(16, 9, 45, 30);
+  std::vector<float> all_rows(45 * 30);
+  resizer.ResizeRows(src.data(), 16, 0, 30, all_rows.data(), 45);
+  std::vector<float> bands(45 * 30);
+  for (int begin = 0; begin < 30; begin += 7) {
+    resizer.ResizeRows(src.data(), 16, begin, std::min(begin + 7, 30),
+                       bands.data(), 45);
+  }
+  EXPECT_EQ(bands, all_rows);
+}
+
+}  // namespace
+}  // namespace tensors_to_segmentation_utils
+}  // namespace mediapipe
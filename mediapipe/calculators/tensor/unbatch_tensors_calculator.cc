@@ -0,0 +1,106 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "mediapipe/calculators/tensor/tensor_batch.h"
+#include "mediapipe/framework/api2/node.h"
+#include "mediapipe/framework/api2/port.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/memory_manager.h"
+#include "mediapipe/framework/memory_manager_service.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+namespace api2 {
+
+namespace {
+using Tensors = std::vector<Tensor>;
+}  // namespace
+
+// UnbatchTensorsCalculator splits the inference results of a batch built by
+// BatchTensorsCalculator, and emits the results of each input at its original
+// timestamp, on the "TENSORS" output stream with the index of the input
+// stream. Each tensor is split along its first dimension.
+//
+// Inputs:
+//   TENSORS - std::vector<Tensor>
+//     The batched inference results.
+//   BATCH - TensorBatchInfo
+//     The "BATCH" output of the BatchTensorsCalculator.
+//
+// Outputs:
+//   TENSORS - std::vector<Tensor>
+//     One stream of results per BatchTensorsCalculator input stream.
+//
+// Example:
+// node {
+//   calculator: "UnbatchTensorsCalculator"
+//   input_stream: "TENSORS:batched_output_tensors"
+//   input_stream: "BATCH:batch"
+//   output_stream: "TENSORS:0:output_tensors_a"
+//   output_stream: "TENSORS:1:output_tensors_b"
+// }
+class UnbatchTensorsCalculator : public Node {
+ public:
+  static constexpr Input<Tensors> kTensorsIn{"TENSORS"};
+  static constexpr Input<TensorBatchInfo> kBatchIn{"BATCH"};
+  static constexpr Output<Tensors>::Multiple kTensorsOut{"TENSORS"};
+
+  MEDIAPIPE_NODE_CONTRACT(kTensorsIn, kBatchIn, kTensorsOut,
+                          TimestampChange::Arbitrary());
+
+  static absl::Status UpdateContract(CalculatorContract* cc) {
+    RET_CHECK_GT(kTensorsOut(cc).Count(), 0)
+        << "Must have at least one TENSORS output";
+    cc->UseService(kMemoryManagerService).Optional();
+    return absl::OkStatus();
+  }
+
+  absl::Status Open(CalculatorContext* cc) override {
+    if (cc->Service(kMemoryManagerService).IsAvailable()) {
+      memory_manager_ = &cc->Service(kMemoryManagerService).GetObject();
+    }
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    if (kBatchIn(cc).IsEmpty()) return absl::OkStatus();
+    RET_CHECK(!kTensorsIn(cc).IsEmpty())
+        << "Missing the inference results of a batch";
+    const TensorBatchInfo& batch_info = *kBatchIn(cc);
+    MP_ASSIGN_OR_RETURN(
+        std::vector<Tensors> outputs,
+        UnbatchTensors(*kTensorsIn(cc), batch_info.size(), memory_manager_));
+    for (int i = 0; i < batch_info.size(); ++i) {
+      const TensorBatchEntry& entry = batch_info[i];
+      RET_CHECK_LT(entry.stream_index, kTensorsOut(cc).Count());
+      kTensorsOut(cc)[entry.stream_index].Send(std::move(outputs[i]),
+                                               entry.timestamp);
+    }
+    return absl::OkStatus();
+  }
+
+ private:
+  // Enable pooling of AHWBs in Tensor instances.
+  MemoryManager* memory_manager_ = nullptr;
+};
+
+MEDIAPIPE_REGISTER_NODE(UnbatchTensorsCalculator);
+
+}  // namespace api2
+}  // namespace mediapipe
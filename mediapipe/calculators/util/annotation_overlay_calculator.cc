@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <memory>
+#include <vector>
 
 #include "absl/log/absl_log.h"
 #include "absl/strings/str_cat.h"
@@ -31,6 +32,7 @@
 #include "mediapipe/framework/port/vector.h"
 #include "mediapipe/util/annotation_renderer.h"
 #include "mediapipe/util/color.pb.h"
+#include "mediapipe/util/incremental_annotation_renderer.h"
 #include "mediapipe/util/render_data.pb.h"
 
 #if !MEDIAPIPE_DISABLE_GPU
@@ -154,6 +156,10 @@ class AnnotationOverlayCalculator : public CalculatorBase {
   absl::Status RenderToCpu(CalculatorContext* cc,
                            const ImageFormat::Format& target_format,
                            uchar* data_image);
+  // Renders with incremental_renderer_ directly on the output frame.
+  absl::Status RenderIncrementalCpu(CalculatorContext* cc);
+  // Returns the RenderData of all input streams, in rendering order.
+  std::vector<const RenderData*> GetRenderData(CalculatorContext* cc);
 
   absl::Status GlRender(CalculatorContext* cc);
   template <typename Type, const char* Tag>
@@ -164,6 +170,8 @@ class AnnotationOverlayCalculator : public CalculatorBase {
 
   // Underlying helper renderer library.
   std::unique_ptr<AnnotationRenderer> renderer_;
+  // Set if incremental_cpu_rendering is enabled.
+  std::unique_ptr<IncrementalAnnotationRenderer> incremental_renderer_;
 
   // Indicates if image frame is available as input.
   bool image_frame_available_ = false;
@@ -277,6 +285,11 @@ absl::Status AnnotationOverlayCalculator::Open(CalculatorContext* cc) {
   if (renderer_->GetScaleFactor() < 1.0 && HasImageTag(cc))
     ABSL_LOG(WARNING)
         << "Annotation scale factor only supports GPU backed Image.";
+  if (options_.incremental_cpu_rendering()) {
+    incremental_renderer_ = std::make_unique<IncrementalAnnotationRenderer>();
+    incremental_renderer_->SetFlipTextVertically(
+        options_.flip_text_vertically());
+  }
 
   // Set the output header based on the input header (if present).
   const char* tag = HasImageTag(cc) ? kImageTag
@@ -313,6 +326,9 @@ absl::Status AnnotationOverlayCalculator::Process(CalculatorContext* cc) {
   if (HasImageTag(cc)) {
     use_gpu_ = cc->Inputs().Tag(kImageTag).Get<mediapipe::Image>().UsesGpu();
   }
+  if (!use_gpu_ && incremental_renderer_) {
+    return RenderIncrementalCpu(cc);
+  }
 
   // Initialize render target, drawn with OpenCV.
   std::unique_ptr<cv::Mat> image_mat;
@@ -353,28 +369,8 @@ absl::Status AnnotationOverlayCalculator::Process(CalculatorContext* cc) {
   renderer_->AdoptImage(image_mat.get());
 
   // Render streams onto render target.
-  for (CollectionItemId id = cc->Inputs().BeginId(); id < cc->Inputs().EndId();
-       ++id) {
-    auto tag_and_index = cc->Inputs().TagAndIndexFromId(id);
-    std::string tag = tag_and_index.first;
-    if (!tag.empty() && tag != kVectorTag) {
-      continue;
-    }
-    if (cc->Inputs().Get(id).IsEmpty()) {
-      continue;
-    }
-    if (tag.empty()) {
-      // Empty tag defaults to accepting a single object of RenderData type.
-      const RenderData& render_data = cc->Inputs().Get(id).Get<RenderData>();
-      renderer_->RenderDataOnImage(render_data);
-    } else {
-      RET_CHECK_EQ(kVectorTag, tag);
-      const std::vector<RenderData>& render_data_vec =
-          cc->Inputs().Get(id).Get<std::vector<RenderData>>();
-      for (const RenderData& render_data : render_data_vec) {
-        renderer_->RenderDataOnImage(render_data);
-      }
-    }
+  for (const RenderData* render_data : GetRenderData(cc)) {
+    renderer_->RenderDataOnImage(*render_data);
   }
 
   if (use_gpu_) {
@@ -441,6 +437,105 @@ absl::Status AnnotationOverlayCalculator::RenderToCpu(
   return absl::OkStatus();
 }
 
+absl::Status AnnotationOverlayCalculator::RenderIncrementalCpu(
+    CalculatorContext* cc) {
+#if !MEDIAPIPE_DISABLE_GPU
+  constexpr uint32_t kAlignmentBoundary =
+      ImageFrame::kGlDefaultAlignmentBoundary;
+#else
+  constexpr uint32_t kAlignmentBoundary = ImageFrame::kDefaultAlignmentBoundary;
+#endif  // !MEDIAPIPE_DISABLE_GPU
+
+  // Copy the input image, or the canvas, straight into the output frame.
+  std::unique_ptr<ImageFrame> output_frame;
+  if (image_frame_available_) {
+    cv::Mat input_mat;
+    ImageFormat::Format input_format;
+    std::shared_ptr<cv::Mat> input_image_view;
+    if (HasImageTag(cc)) {
+      const auto& input_image =
+          cc->Inputs().Tag(kImageTag).Get<mediapipe::Image>();
+      input_image_view = formats::MatView(&input_image);
+      input_mat = *input_image_view;
+      input_format = input_image.image_format();
+    } else {
+      const auto& input_frame =
+          cc->Inputs().Tag(kImageFrameTag).Get<ImageFrame>();
+      input_mat = formats::MatView(&input_frame);
+      input_format = input_frame.Format();
+    }
+    ImageFormat::Format target_format;
+    switch (input_format) {
+      case ImageFormat::SRGBA:
+        target_format = ImageFormat::SRGBA;
+        break;
+      case ImageFormat::SRGB:
+      case ImageFormat::GRAY8:
+        target_format = ImageFormat::SRGB;
+        break;
+      default:
+        return absl::UnknownError("Unexpected image frame format.");
+    }
+    output_frame = absl::make_unique<ImageFrame>(
+        target_format, input_mat.cols, input_mat.rows, kAlignmentBoundary);
+    cv::Mat output_mat = formats::MatView(output_frame.get());
+    if (input_format == ImageFormat::GRAY8) {
+      cv::cvtColor(input_mat, output_mat, cv::COLOR_GRAY2RGB);
+    } else {
+      input_mat.copyTo(output_mat);
+    }
+  } else {
+    output_frame = absl::make_unique<ImageFrame>(
+        ImageFormat::SRGB, options_.canvas_width_px(),
+        options_.canvas_height_px(), kAlignmentBoundary);
+    formats::MatView(output_frame.get())
+        .setTo(cv::Scalar(options_.canvas_color().r(),
+                          options_.canvas_color().g(),
+                          options_.canvas_color().b()));
+  }
+
+  cv::Mat output_mat = formats::MatView(output_frame.get());
+  incremental_renderer_->RenderDataOnImage(GetRenderData(cc), output_mat);
+
+  if (HasImageTag(cc)) {
+    auto out = std::make_unique<mediapipe::Image>(std::move(output_frame));
+    cc->Outputs().Tag(kImageTag).Add(out.release(), cc->InputTimestamp());
+  }
+  if (cc->Outputs().HasTag(kImageFrameTag)) {
+    cc->Outputs()
+        .Tag(kImageFrameTag)
+        .Add(output_frame.release(), cc->InputTimestamp());
+  }
+
+  return absl::OkStatus();
+}
+
+std::vector<const RenderData*> AnnotationOverlayCalculator::GetRenderData(
+    CalculatorContext* cc) {
+  std::vector<const RenderData*> render_data;
+  for (CollectionItemId id = cc->Inputs().BeginId(); id < cc->Inputs().EndId();
+       ++id) {
+    auto tag_and_index = cc->Inputs().TagAndIndexFromId(id);
+    std::string tag = tag_and_index.first;
+    if (!tag.empty() && tag != kVectorTag) {
+      continue;
+    }
+    if (cc->Inputs().Get(id).IsEmpty()) {
+      continue;
+    }
+    if (tag.empty()) {
+      // Empty tag defaults to accepting a single object of RenderData type.
+      render_data.push_back(&cc->Inputs().Get(id).Get<RenderData>());
+    } else {
+      for (const RenderData& data :
+           cc->Inputs().Get(id).Get<std::vector<RenderData>>()) {
+        render_data.push_back(&data);
+      }
+    }
+  }
+  return render_data;
+}
+
 template <typename Type, const char* Tag>
 absl::Status AnnotationOverlayCalculator::RenderToGpu(CalculatorContext* cc,
                                                       uchar* overlay_image) {
@@ -73,6 +73,7 @@
 #include "mediapipe/framework/thread_pool_executor.pb.h"
 #include "mediapipe/framework/timestamp.h"
 #include "mediapipe/framework/tool/fill_packet_set.h"
+#include "mediapipe/framework/tool/open_metrics_utils.h"
 #include "mediapipe/framework/tool/status_util.h"
 #include "mediapipe/framework/tool/tag_map.h"
 #include "mediapipe/framework/tool/validate.h"
@@ -95,6 +96,9 @@ namespace {
 // threshold.
 constexpr int kMaxNumAccumulatedErrors = 1000;
 constexpr char kApplicationThreadExecutorType[] = "ApplicationThreadExecutor";
+// Counts the times a graph input stream became throttled by a full queue.
+constexpr char kThrottledGraphInputStreamsCounter[] =
+    "CalculatorGraph-throttled_graph_input_streams";
 
 // Do not log status payloads, but do include stack traces.
 constexpr absl::StatusToStringMode kStatusLogFlags =
@@ -234,6 +238,10 @@ absl::Status CalculatorGraph::InitializeStreams() {
     const EdgeInfo& edge_info = validated_graph_->InputStreamInfos()[index];
     MP_RETURN_IF_ERROR(input_stream_managers_[index].Initialize(
         edge_info.name, edge_info.packet_type, edge_info.back_edge));
+    if (edge_info.queue_capacity > 0) {
+      input_stream_managers_[index].ReserveQueueCapacity(
+          edge_info.queue_capacity);
+    }
     input_stream_to_index_[&input_stream_managers_[index]] = index;
   }
 
@@ -488,6 +496,8 @@ absl::Status CalculatorGraph::Initialize(
   MP_RETURN_IF_ERROR(InitializePacketGeneratorGraph(side_packets));
   MP_RETURN_IF_ERROR(InitializeStreams());
   MP_RETURN_IF_ERROR(InitializeCalculatorNodes());
+  scheduler_.SetQueueType(validated_graph_->Config().scheduler_queue().type(),
+                          nodes_.size());
 #ifdef MEDIAPIPE_PROFILER_AVAILABLE
   MP_RETURN_IF_ERROR(InitializeProfiler());
 #endif
@@ -979,6 +989,26 @@ absl::StatusOr<GraphRuntimeInfo> CalculatorGraph::GetGraphRuntimeInfo() {
   return info;
 }
 
+absl::StatusOr<std::string> CalculatorGraph::GetOpenMetrics() {
+  tool::GraphMetrics metrics;
+  MP_ASSIGN_OR_RETURN(metrics.runtime_info, GetGraphRuntimeInfo());
+  if (validated_graph_->Config().profiler_config().enable_profiler()) {
+    MP_RETURN_IF_ERROR(
+        profiler_->GetCalculatorProfiles(&metrics.calculator_profiles));
+  }
+  metrics.counters = counter_factory_->GetCounterSet()->GetCountersValues();
+  return tool::GetOpenMetricsString(metrics);
+}
+
+#if !defined(__EMSCRIPTEN__)
+absl::Status CalculatorGraph::StartMetricsExport(
+    std::shared_ptr<tool::MetricsSink> sink, absl::Duration interval) {
+  RET_CHECK(initialized_);
+  return metrics_exporter_.StartInBackground(
+      interval, std::move(sink), [this]() { return GetOpenMetrics(); });
+}
+#endif  // !defined(__EMSCRIPTEN__)
+
 absl::Status CalculatorGraph::AddPacketToInputStream(
     absl::string_view stream_name, const Packet& packet) {
   return AddPacketToInputStreamInternal(stream_name, packet);
@@ -1293,6 +1323,8 @@ void CalculatorGraph::UpdateThrottledNodes(InputStreamManager* stream,
             scheduler_.UnthrottledGraphInputStream();
           } else if (!was_throttled && is_throttled) {
             scheduler_.ThrottledGraphInputStream();
+            counter_factory_->GetCounter(kThrottledGraphInputStreamsCounter)
+                ->Increment();
           }
         } else {
           if (!is_throttled) {
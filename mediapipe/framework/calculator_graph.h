@@ -60,6 +60,7 @@
 
 #if !defined(__EMSCRIPTEN__)
 #include "mediapipe/framework/tool/graph_runtime_info_logger.h"
+#include "mediapipe/framework/tool/metrics_exporter.h"
 #endif  // !defined(__EMSCRIPTEN__)
 
 namespace mediapipe {
@@ -267,6 +268,21 @@ class CalculatorGraph {
   // is thread safe and can be called from any thread.
   absl::StatusOr<GraphRuntimeInfo> GetGraphRuntimeInfo();
 
+  // Returns the live metrics of the graph in the OpenMetrics text format:
+  // the Process() runtime histogram of each calculator when the profiler is
+  // enabled, the queue size of each calculator input stream, and the graph
+  // counters, including the frames dropped by FlowLimiterCalculator and the
+  // throttling of graph input streams. This method is thread safe and can be
+  // called from any thread, for example from an HTTP handler.
+  absl::StatusOr<std::string> GetOpenMetrics();
+
+#if !defined(__EMSCRIPTEN__)
+  // Writes GetOpenMetrics() to "sink" every "interval" in the background,
+  // until the graph is destroyed. Can be called only once, after Initialize().
+  absl::Status StartMetricsExport(std::shared_ptr<tool::MetricsSink> sink,
+                                  absl::Duration interval);
+#endif  // !defined(__EMSCRIPTEN__)
+
   // Add a Packet to a graph input stream based on the graph input stream add
   // mode. If the mode is ADD_IF_NOT_FULL, the packet will not be added if any
   // queue exceeds max_queue_size specified by the graph config and will return
@@ -778,6 +794,9 @@ class CalculatorGraph {
 #if !defined(__EMSCRIPTEN__)
   // Collects runtime information about the graph in the background.
   tool::GraphRuntimeInfoLogger graph_runtime_info_logger_;
+
+  // Exports the graph metrics in the background.
+  tool::MetricsExporter metrics_exporter_;
 #endif  // !defined(__EMSCRIPTEN__)
 };
 
@@ -1581,6 +1581,26 @@ TEST(CalculatorGraph, RunsCorrectlyWithMultipleExecutors) {
   RunComprehensiveTest(&graph, proto, /*define_node_5=*/true);
 }
 
+TEST(CalculatorGraph, RunsCorrectlyWithShardedSchedulerQueue) {
+  CalculatorGraph graph;
+  CalculatorGraphConfig proto = GetConfig();
+  proto.mutable_scheduler_queue()->set_type(SchedulerQueueConfig::SHARDED);
+  RunComprehensiveTest(&graph, proto, /*define_node_5=*/true);
+}
+
+TEST(CalculatorGraph, RunsCorrectlyWithShardedSchedulerQueueAndExecutors) {
+  CalculatorGraph graph;
+  MP_ASSERT_OK(
+      graph.SetExecutor("second", std::make_shared<ThreadPoolExecutor>(1)));
+  CalculatorGraphConfig proto = GetConfig();
+  proto.mutable_scheduler_queue()->set_type(SchedulerQueueConfig::SHARDED);
+  proto.add_executor()->set_name("second");
+  for (int i = 1; i < proto.node_size(); i += 2) {
+    proto.mutable_node(i)->set_executor("second");
+  }
+  RunComprehensiveTest(&graph, proto, /*define_node_5=*/true);
+}
+
 // Packet generator for an arbitrary unit64 packet.
 class Uint64PacketGenerator : public PacketGenerator {
  public:
@@ -0,0 +1,224 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/deps/block_pool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/log/absl_check.h"
+#include "absl/synchronization/mutex.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr int kNumSizeClasses =
+    BlockPool::kMaxBlockSize / BlockPool::kBlockGranularity;
+// Free blocks a thread may cache per size class.
+constexpr int kMaxCachedBlocks = 64;
+// Blocks moved between a thread cache and the depot at once.
+constexpr int kTransferBatchSize = kMaxCachedBlocks / 2;
+// Free blocks the depot may hold per size class. Blocks freed beyond that are
+// returned to the system allocator.
+constexpr int64_t kMaxDepotBlocks = 16384;
+
+// A free block stores the link to the next free block in its first bytes.
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+int SizeClass(size_t size) {
+  return size == 0
+             ? 0
+             : static_cast<int>((size - 1) / BlockPool::kBlockGranularity);
+}
+
+size_t BlockSize(int size_class) {
+  return (size_class + 1) * BlockPool::kBlockGranularity;
+}
+
+std::atomic<int64_t> num_system_allocations{0};
+
+void* SystemAllocate(int size_class) {
+  num_system_allocations.fetch_add(1, std::memory_order_relaxed);
+  return ::operator new(BlockSize(size_class));
+}
+
+void SystemDeallocate(void* block, int size_class) {
+  ::operator delete(block, BlockSize(size_class));
+}
+
+// Free blocks shared by all threads.
+class Depot {
+ public:
+  // Adds the "count" blocks of the list [head, tail].
+  void Put(int size_class, FreeBlock* head, FreeBlock* tail, int count) {
+    FreeList& list = lists_[size_class];
+    {
+      absl::MutexLock lock(&list.mutex);
+      if (list.count + count <= kMaxDepotBlocks) {
+        tail->next = list.head;
+        list.head = head;
+        list.count += count;
+        return;
+      }
+    }
+    while (head != nullptr) {
+      FreeBlock* next = head->next;
+      SystemDeallocate(head, size_class);
+      head = next;
+    }
+  }
+
+  // Removes up to "max_count" blocks and returns them as a list in "head".
+  // Returns the number of blocks removed.
+  int Take(int size_class, int max_count, FreeBlock** head) {
+    FreeList& list = lists_[size_class];
+    absl::MutexLock lock(&list.mutex);
+    FreeBlock* first = list.head;
+    FreeBlock* last = nullptr;
+    int count = 0;
+    for (FreeBlock* block = first; block != nullptr && count < max_count;
+         block = block->next) {
+      last = block;
+      ++count;
+    }
+    if (count > 0) {
+      list.head = last->next;
+      list.count -= count;
+      last->next = nullptr;
+    }
+    *head = count > 0 ? first : nullptr;
+    return count;
+  }
+
+ private:
+  struct FreeList {
+    absl::Mutex mutex;
+    FreeBlock* head ABSL_GUARDED_BY(mutex) = nullptr;
+    int64_t count ABSL_GUARDED_BY(mutex) = 0;
+  };
+
+  FreeList lists_[kNumSizeClasses];
+};
+
+Depot& GetDepot() {
+  // Never destroyed, so that blocks can still be freed during static
+  // destruction.
+  static Depot* depot = new Depot;
+  return *depot;
+}
+
+// Set once the current thread's ThreadCache has been destroyed. Blocks freed
+// by thread_local destructors that run later go straight to the depot.
+thread_local bool thread_cache_destroyed = false;
+
+class ThreadCache {
+ public:
+  ThreadCache() {
+    for (int i = 0; i < kNumSizeClasses; ++i) {
+      heads_[i] = nullptr;
+      counts_[i] = 0;
+    }
+  }
+
+  ~ThreadCache() {
+    for (int i = 0; i < kNumSizeClasses; ++i) {
+      if (heads_[i] != nullptr) {
+        FreeBlock* tail = heads_[i];
+        while (tail->next != nullptr) tail = tail->next;
+        GetDepot().Put(i, heads_[i], tail, counts_[i]);
+      }
+    }
+    thread_cache_destroyed = true;
+  }
+
+  void* Allocate(int size_class) {
+    if (heads_[size_class] == nullptr) {
+      counts_[size_class] =
+          GetDepot().Take(size_class, kTransferBatchSize, &heads_[size_class]);
+      if (heads_[size_class] == nullptr) {
+        return SystemAllocate(size_class);
+      }
+    }
+    FreeBlock* block = heads_[size_class];
+    heads_[size_class] = block->next;
+    --counts_[size_class];
+    return block;
+  }
+
+  void Deallocate(void* ptr, int size_class) {
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = heads_[size_class];
+    heads_[size_class] = block;
+    if (++counts_[size_class] < kMaxCachedBlocks) return;
+
+    // Keep the most recently freed blocks, which are likely to be in cache,
+    // and move the rest to the depot.
+    FreeBlock* last_kept = heads_[size_class];
+    for (int i = 1; i < kMaxCachedBlocks - kTransferBatchSize; ++i) {
+      last_kept = last_kept->next;
+    }
+    FreeBlock* head = last_kept->next;
+    FreeBlock* tail = head;
+    while (tail->next != nullptr) tail = tail->next;
+    last_kept->next = nullptr;
+    counts_[size_class] -= kTransferBatchSize;
+    GetDepot().Put(size_class, head, tail, kTransferBatchSize);
+  }
+
+ private:
+  FreeBlock* heads_[kNumSizeClasses];
+  int counts_[kNumSizeClasses];
+};
+
+ThreadCache& GetThreadCache() {
+  thread_local ThreadCache cache;
+  return cache;
+}
+
+}  // namespace
+
+void* BlockPool::Allocate(size_t size) {
+  ABSL_DCHECK_LE(size, kMaxBlockSize);
+  const int size_class = SizeClass(size);
+  if (thread_cache_destroyed) {
+    FreeBlock* block;
+    if (GetDepot().Take(size_class, 1, &block) == 1) return block;
+    return SystemAllocate(size_class);
+  }
+  return GetThreadCache().Allocate(size_class);
+}
+
+void BlockPool::Deallocate(void* block, size_t size) {
+  ABSL_DCHECK_LE(size, kMaxBlockSize);
+  const int size_class = SizeClass(size);
+  if (thread_cache_destroyed) {
+    FreeBlock* free_block = static_cast<FreeBlock*>(block);
+    free_block->next = nullptr;
+    GetDepot().Put(size_class, free_block, free_block, 1);
+    return;
+  }
+  GetThreadCache().Deallocate(block, size_class);
+}
+
+int64_t BlockPool::NumSystemAllocations() {
+  return num_system_allocations.load(std::memory_order_relaxed);
+}
+
+}  // namespace mediapipe
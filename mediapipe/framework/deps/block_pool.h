@@ -0,0 +1,103 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_DEPS_BLOCK_POOL_H_
+#define MEDIAPIPE_DEPS_BLOCK_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace mediapipe {
+
+// A process-wide pool of small, fixed-size memory blocks.
+//
+// Blocks are grouped in size classes of kBlockGranularity bytes, up to
+// kMaxBlockSize. Each thread keeps a small cache of free blocks per size
+// class, so that allocating and freeing does not take any lock in the common
+// case. When a thread cache overflows, or runs empty, a batch of blocks is
+// exchanged with a shared depot. This keeps producer/consumer patterns, where
+// blocks are allocated on one thread and freed on another, from falling back
+// to the system allocator.
+//
+// Memory held by the pool is never returned to the system allocator, except
+// when the depot is full.
+class BlockPool {
+ public:
+  static constexpr size_t kBlockGranularity = 16;
+  static constexpr size_t kMaxBlockSize = 512;
+  // Blocks are aligned like memory returned by operator new.
+  static constexpr size_t kBlockAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+  // Returns a block of at least "size" bytes. REQUIRES: size <= kMaxBlockSize.
+  static void* Allocate(size_t size);
+
+  // Returns a block obtained from Allocate(size) to the pool.
+  static void Deallocate(void* block, size_t size);
+
+  // Number of blocks obtained from the system allocator so far. Provided for
+  // testing and benchmarking only.
+  static int64_t NumSystemAllocations();
+};
+
+// A standard allocator that takes small allocations from the BlockPool, and
+// larger or over-aligned ones from operator new. Stateless.
+//
+// This is typically used with std::allocate_shared, so that the object and
+// its control block come out of a single pooled block.
+template <typename T>
+class BlockPoolAllocator {
+ public:
+  using value_type = T;
+
+  BlockPoolAllocator() = default;
+  template <typename U>
+  BlockPoolAllocator(const BlockPoolAllocator<U>&) {}  // NOLINT
+
+  T* allocate(size_t n) {
+    const size_t size = n * sizeof(T);
+    if (IsPooled(size)) {
+      return static_cast<T*>(BlockPool::Allocate(size));
+    }
+    return static_cast<T*>(::operator new(size, std::align_val_t(alignof(T))));
+  }
+
+  void deallocate(T* p, size_t n) {
+    const size_t size = n * sizeof(T);
+    if (IsPooled(size)) {
+      BlockPool::Deallocate(p, size);
+      return;
+    }
+    ::operator delete(p, std::align_val_t(alignof(T)));
+  }
+
+  template <typename U>
+  bool operator==(const BlockPoolAllocator<U>&) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const BlockPoolAllocator<U>&) const {
+    return false;
+  }
+
+ private:
+  static constexpr bool IsPooled(size_t size) {
+    return size <= BlockPool::kMaxBlockSize &&
+           alignof(T) <= BlockPool::kBlockAlignment;
+  }
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_DEPS_BLOCK_POOL_H_
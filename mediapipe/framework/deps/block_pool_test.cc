@@ -0,0 +1,99 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/deps/block_pool.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(BlockPoolTest, ReusesFreedBlocks) {
+  // Warm up the thread cache for this size class.
+  std::vector<void*> blocks;
+  for (int i = 0; i < 16; ++i) blocks.push_back(BlockPool::Allocate(40));
+  for (void* block : blocks) BlockPool::Deallocate(block, 40);
+  blocks.clear();
+
+  const int64_t num_system_allocations = BlockPool::NumSystemAllocations();
+  for (int round = 0; round < 1000; ++round) {
+    for (int i = 0; i < 16; ++i) {
+      void* block = BlockPool::Allocate(40);
+      std::memset(block, 0xab, 40);
+      blocks.push_back(block);
+    }
+    for (void* block : blocks) BlockPool::Deallocate(block, 40);
+    blocks.clear();
+  }
+  EXPECT_EQ(BlockPool::NumSystemAllocations(), num_system_allocations);
+}
+
+TEST(BlockPoolTest, BlocksAreAligned) {
+  for (size_t size = 1; size <= BlockPool::kMaxBlockSize; size += 7) {
+    void* block = BlockPool::Allocate(size);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % BlockPool::kBlockAlignment,
+              0);
+    std::memset(block, 0, size);
+    BlockPool::Deallocate(block, size);
+  }
+}
+
+// Blocks allocated on one thread and freed on another flow back to the
+// allocating thread through the depot.
+TEST(BlockPoolTest, RecyclesBlocksAcrossThreads) {
+  constexpr int kNumBlocks = 256;
+  constexpr int kNumRounds = 20;
+  int64_t num_system_allocations_after_warm_up = 0;
+  for (int round = 0; round < kNumRounds; ++round) {
+    if (round == 2) {
+      num_system_allocations_after_warm_up = BlockPool::NumSystemAllocations();
+    }
+    std::vector<void*> blocks;
+    for (int i = 0; i < kNumBlocks; ++i) {
+      blocks.push_back(BlockPool::Allocate(96));
+    }
+    std::thread consumer([&blocks] {
+      for (void* block : blocks) BlockPool::Deallocate(block, 96);
+    });
+    consumer.join();
+  }
+  // Each consumer thread keeps at most a thread cache worth of blocks, and
+  // returns it to the depot when it exits.
+  EXPECT_EQ(BlockPool::NumSystemAllocations(),
+            num_system_allocations_after_warm_up);
+}
+
+struct alignas(64) OverAligned {
+  char data[64];
+};
+
+TEST(BlockPoolAllocatorTest, AllocateShared) {
+  auto value = std::allocate_shared<std::vector<int>>(
+      BlockPoolAllocator<std::vector<int>>(), 3, 7);
+  EXPECT_EQ(value->size(), 3);
+  EXPECT_EQ((*value)[2], 7);
+
+  auto aligned = std::allocate_shared<OverAligned>(
+      BlockPoolAllocator<OverAligned>());
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned.get()) % 64, 0);
+}
+
+}  // namespace
+}  // namespace mediapipe
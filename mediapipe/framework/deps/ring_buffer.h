@@ -0,0 +1,116 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_DEPS_RING_BUFFER_H_
+#define MEDIAPIPE_DEPS_RING_BUFFER_H_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "absl/log/absl_check.h"
+
+namespace mediapipe {
+
+// A FIFO queue stored in a single circular array.
+//
+// Unlike std::deque, which allocates a new block every few elements, a
+// RingBuffer only allocates when it grows beyond its capacity, which doubles
+// each time. Reserve() can be used to preallocate the expected maximum size so
+// that steady-state push_back/pop_front never allocate. Slots keep their
+// (moved-from or reset) elements; popped elements are reset to T() so that any
+// resources they hold are released immediately.
+//
+// Not thread-safe.
+template <typename T>
+class RingBuffer {
+ public:
+  RingBuffer() = default;
+  RingBuffer(const RingBuffer&) = delete;
+  RingBuffer& operator=(const RingBuffer&) = delete;
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+
+  // Element access; index 0 is the front (oldest element).
+  T& operator[](size_t i) {
+    ABSL_DCHECK_LT(i, size_);
+    return buffer_[(head_ + i) & (capacity_ - 1)];
+  }
+  const T& operator[](size_t i) const {
+    ABSL_DCHECK_LT(i, size_);
+    return buffer_[(head_ + i) & (capacity_ - 1)];
+  }
+
+  T& front() { return (*this)[0]; }
+  const T& front() const { return (*this)[0]; }
+  T& back() { return (*this)[size_ - 1]; }
+  const T& back() const { return (*this)[size_ - 1]; }
+
+  // Ensures that at least "capacity" elements fit without reallocation.
+  void Reserve(size_t capacity) {
+    if (capacity > capacity_) Grow(capacity);
+  }
+
+  void push_back(const T& value) {
+    if (size_ == capacity_) Grow(size_ + 1);
+    buffer_[(head_ + size_) & (capacity_ - 1)] = value;
+    ++size_;
+  }
+
+  void push_back(T&& value) {
+    if (size_ == capacity_) Grow(size_ + 1);
+    buffer_[(head_ + size_) & (capacity_ - 1)] = std::move(value);
+    ++size_;
+  }
+
+  void pop_front() {
+    ABSL_DCHECK(!empty());
+    buffer_[head_] = T();
+    head_ = (head_ + 1) & (capacity_ - 1);
+    --size_;
+  }
+
+  // Removes all elements but keeps the capacity.
+  void clear() {
+    while (!empty()) pop_front();
+    head_ = 0;
+  }
+
+ private:
+  // Reallocates to the smallest power of two that is at least "min_capacity",
+  // moving the elements to the beginning of the new array.
+  void Grow(size_t min_capacity) {
+    size_t new_capacity = capacity_ == 0 ? 4 : capacity_;
+    while (new_capacity < min_capacity) new_capacity *= 2;
+    std::unique_ptr<T[]> new_buffer(new T[new_capacity]);
+    for (size_t i = 0; i < size_; ++i) {
+      new_buffer[i] = std::move((*this)[i]);
+    }
+    buffer_ = std::move(new_buffer);
+    capacity_ = new_capacity;
+    head_ = 0;
+  }
+
+  std::unique_ptr<T[]> buffer_;
+  // Always zero or a power of two.
+  size_t capacity_ = 0;
+  size_t head_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_DEPS_RING_BUFFER_H_
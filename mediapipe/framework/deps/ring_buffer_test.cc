@@ -0,0 +1,110 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/deps/ring_buffer.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(RingBufferTest, PushAndPopInFifoOrder) {
+  RingBuffer<int> buffer;
+  EXPECT_TRUE(buffer.empty());
+  for (int i = 0; i < 10; ++i) {
+    buffer.push_back(i);
+  }
+  EXPECT_EQ(buffer.size(), 10);
+  EXPECT_EQ(buffer.front(), 0);
+  EXPECT_EQ(buffer.back(), 9);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(buffer[i], i);
+  }
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(buffer.front(), i);
+    buffer.pop_front();
+  }
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(RingBufferTest, WrapsAroundWithoutGrowing) {
+  RingBuffer<int> buffer;
+  buffer.Reserve(8);
+  const size_t capacity = buffer.capacity();
+  EXPECT_GE(capacity, 8);
+  int next_in = 0;
+  int next_out = 0;
+  for (int round = 0; round < 100; ++round) {
+    while (buffer.size() < 5) buffer.push_back(next_in++);
+    while (buffer.size() > 2) {
+      EXPECT_EQ(buffer.front(), next_out++);
+      buffer.pop_front();
+    }
+  }
+  EXPECT_EQ(buffer.capacity(), capacity);
+  EXPECT_EQ(buffer.front(), next_out);
+  EXPECT_EQ(buffer.back(), next_in - 1);
+}
+
+TEST(RingBufferTest, GrowsWhenWrappedAround) {
+  RingBuffer<std::string> buffer;
+  buffer.Reserve(4);
+  buffer.push_back("a");
+  buffer.push_back("b");
+  buffer.pop_front();
+  buffer.pop_front();
+  // The head is now in the middle of the array, so growing has to unwrap.
+  for (int i = 0; i < 20; ++i) {
+    buffer.push_back(std::to_string(i));
+  }
+  EXPECT_GE(buffer.capacity(), 20);
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_EQ(buffer[i], std::to_string(i));
+  }
+}
+
+TEST(RingBufferTest, PopReleasesElement) {
+  auto value = std::make_shared<int>(1);
+  RingBuffer<std::shared_ptr<int>> buffer;
+  buffer.push_back(value);
+  EXPECT_EQ(value.use_count(), 2);
+  buffer.pop_front();
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(RingBufferTest, MovesRvalues) {
+  RingBuffer<std::unique_ptr<int>> buffer;
+  auto value = std::make_unique<int>(7);
+  buffer.push_back(std::move(value));
+  EXPECT_EQ(value, nullptr);
+  EXPECT_EQ(*buffer.front(), 7);
+}
+
+TEST(RingBufferTest, ClearKeepsCapacity) {
+  RingBuffer<int> buffer;
+  for (int i = 0; i < 9; ++i) buffer.push_back(i);
+  const size_t capacity = buffer.capacity();
+  buffer.clear();
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.capacity(), capacity);
+  buffer.push_back(42);
+  EXPECT_EQ(buffer.front(), 42);
+}
+
+}  // namespace
+}  // namespace mediapipe
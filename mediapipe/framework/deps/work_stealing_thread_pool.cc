@@ -0,0 +1,258 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/deps/work_stealing_thread_pool.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <iterator>
+#include <set>
+#include <utility>
+
+#include "absl/log/absl_log.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/deps/threadpool.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // __linux__
+
+namespace mediapipe {
+
+namespace {
+
+// The number of times an idle worker looks for a task again while tasks are
+// pending, before it waits for kRetryDelay between attempts.
+constexpr int kMaxRetries = 64;
+constexpr absl::Duration kRetryDelay = absl::Microseconds(50);
+
+// Identifies the pool and worker index of the current thread, if it is a
+// worker thread of a WorkStealingThreadPool.
+struct CurrentWorker {
+  const void* pool = nullptr;
+  int index = -1;
+};
+
+thread_local CurrentWorker current_worker;
+
+}  // namespace
+
+struct WorkStealingThreadPool::Worker {
+  Worker() : deque(kDequeCapacity) {}
+
+  internal::WorkStealingDeque<Task> deque;
+  // Per-worker state for picking steal victims; only touched by the owner.
+  uint32_t rng_state = 0;
+};
+
+WorkStealingThreadPool::WorkStealingThreadPool(const std::string& name_prefix,
+                                               int num_threads)
+    : WorkStealingThreadPool(ThreadOptions(), name_prefix, num_threads) {}
+
+WorkStealingThreadPool::WorkStealingThreadPool(
+    const ThreadOptions& thread_options, const std::string& name_prefix,
+    int num_threads, bool pin_threads)
+    : name_prefix_(name_prefix),
+      thread_options_(thread_options),
+      num_threads_(num_threads <= 0 ? 1 : num_threads),
+      pin_threads_(pin_threads) {
+  workers_.reserve(num_threads_);
+  for (int i = 0; i < num_threads_; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+    workers_.back()->rng_state = 0x9E3779B9u * (i + 1);
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  {
+    absl::MutexLock lock(&sleep_mutex_);
+    stopped_ = true;
+    sleep_cv_.SignalAll();
+  }
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+  threads_.clear();
+
+  // Only non-empty if StartWorkers() was never called.
+  absl::MutexLock lock(&injection_mutex_);
+  for (Task* task : injected_) {
+    delete task;
+  }
+  injected_.clear();
+}
+
+void WorkStealingThreadPool::StartWorkers() {
+  threads_.reserve(num_threads_);
+  for (int i = 0; i < num_threads_; ++i) {
+    threads_.emplace_back([this, i] { RunWorker(i); });
+  }
+}
+
+void WorkStealingThreadPool::Schedule(std::function<void()> callback) {
+  Task* task = new Task(std::move(callback));
+  if (current_worker.pool != this ||
+      !workers_[current_worker.index]->deque.Push(task)) {
+    absl::MutexLock lock(&injection_mutex_);
+    injected_.push_back(task);
+  }
+  // Publishing the task through num_pending_ must be sequentially consistent
+  // with the num_sleeping_ check below, and with the opposite order in
+  // RunWorker, so that a worker going to sleep never misses a task.
+  num_pending_.fetch_add(1, std::memory_order_seq_cst);
+  if (num_sleeping_.load(std::memory_order_seq_cst) > 0) {
+    NotifyOne();
+  }
+}
+
+void WorkStealingThreadPool::NotifyOne() {
+  absl::MutexLock lock(&sleep_mutex_);
+  sleep_cv_.Signal();
+}
+
+bool WorkStealingThreadPool::HasPendingTasks() {
+  return num_pending_.load(std::memory_order_seq_cst) > 0;
+}
+
+WorkStealingThreadPool::Task* WorkStealingThreadPool::PopInjected() {
+  absl::MutexLock lock(&injection_mutex_);
+  if (injected_.empty()) return nullptr;
+  Task* task = injected_.front();
+  injected_.pop_front();
+  return task;
+}
+
+WorkStealingThreadPool::Task* WorkStealingThreadPool::StealFromOthers(
+    int index) {
+  if (num_threads_ == 1) return nullptr;
+  Worker& self = *workers_[index];
+  // xorshift32; a fresh random victim order spreads thieves across workers.
+  uint32_t x = self.rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  self.rng_state = x;
+  const int start = x % num_threads_;
+  for (int i = 0; i < num_threads_; ++i) {
+    const int victim = (start + i) % num_threads_;
+    if (victim == index) continue;
+    if (Task* task = workers_[victim]->deque.Steal()) {
+      num_steals_.fetch_add(1, std::memory_order_relaxed);
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+WorkStealingThreadPool::Task* WorkStealingThreadPool::FindTask(int index) {
+  if (Task* task = workers_[index]->deque.Pop()) return task;
+  if (Task* task = PopInjected()) return task;
+  return StealFromOthers(index);
+}
+
+void WorkStealingThreadPool::RunWorker(int index) {
+  ConfigureWorkerThread(index);
+  current_worker.pool = this;
+  current_worker.index = index;
+  int num_retries = 0;
+  while (true) {
+    if (Task* task = FindTask(index)) {
+      num_pending_.fetch_sub(1, std::memory_order_relaxed);
+      (*task)();
+      delete task;
+      num_retries = 0;
+      continue;
+    }
+    if (HasPendingTasks() && num_retries < kMaxRetries) {
+      // A task is in flight between a deque and its taker; retry.
+      ++num_retries;
+      std::this_thread::yield();
+      continue;
+    }
+    num_retries = 0;
+    absl::MutexLock lock(&sleep_mutex_);
+    num_sleeping_.fetch_add(1, std::memory_order_seq_cst);
+    if (HasPendingTasks()) {
+      // The pending tasks could not be taken yet; look again a bit later
+      // rather than spinning.
+      sleep_cv_.WaitWithTimeout(&sleep_mutex_, kRetryDelay);
+    }
+    while (!HasPendingTasks() && !stopped_) {
+      sleep_cv_.Wait(&sleep_mutex_);
+    }
+    num_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+    if (stopped_ && !HasPendingTasks()) break;
+  }
+  current_worker = CurrentWorker();
+}
+
+void WorkStealingThreadPool::ConfigureWorkerThread(int index) {
+#if defined(__linux__)
+  const std::string name =
+      internal::CreateThreadName(name_prefix_, syscall(SYS_gettid));
+  int error = pthread_setname_np(pthread_self(), name.c_str());
+  if (error != 0) {
+    ABSL_LOG(ERROR) << "Error : " << strerror(error) << std::endl
+                    << "Failed to set name for thread: " << name;
+  }
+  const int nice_priority_level = thread_options_.nice_priority_level();
+  if (nice_priority_level != 0) {
+    if (nice(nice_priority_level) == -1 && errno != 0) {
+      ABSL_LOG(ERROR) << "Error : " << strerror(errno) << std::endl
+                      << "Could not change the nice priority level by "
+                      << nice_priority_level;
+    }
+  }
+  std::set<int> cpus = thread_options_.cpu_set();
+  if (pin_threads_) {
+    int cpu = index;
+    if (!cpus.empty()) {
+      auto it = cpus.begin();
+      std::advance(it, index % cpus.size());
+      cpu = *it;
+    } else {
+      const int num_cpus = std::thread::hardware_concurrency();
+      if (num_cpus > 0) cpu = index % num_cpus;
+    }
+    cpus = {cpu};
+  }
+  if (!cpus.empty()) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const int cpu : cpus) {
+      CPU_SET(cpu, &cpu_set);
+    }
+    if (sched_setaffinity(syscall(SYS_gettid), sizeof(cpu_set_t), &cpu_set) ==
+            -1 &&
+        errno != 0) {
+      ABSL_LOG(ERROR) << "Error : " << strerror(errno) << std::endl
+                      << "Failed to set processor affinity. Ignore processor "
+                         "affinity setting for now.";
+    }
+  }
+#else
+  if (pin_threads_ || thread_options_.nice_priority_level() != 0 ||
+      !thread_options_.cpu_set().empty()) {
+    ABSL_LOG(ERROR) << "Thread priority and processor affinity feature aren't "
+                       "supported on the current platform.";
+  }
+#endif  // __linux__
+}
+
+}  // namespace mediapipe
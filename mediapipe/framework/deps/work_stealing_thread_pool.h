@@ -0,0 +1,219 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_DEPS_WORK_STEALING_THREAD_POOL_H_
+#define MEDIAPIPE_DEPS_WORK_STEALING_THREAD_POOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/deps/thread_options.h"
+
+namespace mediapipe {
+
+namespace internal {
+
+// A bounded single-producer, multi-consumer work-stealing deque
+// (Chase & Lev, "Dynamic Circular Work-Stealing Deque", with the memory
+// orderings from Le et al., "Correct and Efficient Work-Stealing for Weak
+// Memory Models").
+//
+// Only the owning thread may call Push() and Pop(); any thread may call
+// Steal(). The owner works LIFO at the bottom, thieves take FIFO from the top.
+// The deque does not grow: Push() returns false when it is full and the caller
+// is expected to spill the item somewhere else.
+template <typename T>
+class WorkStealingDeque {
+ public:
+  // "capacity" must be a power of two.
+  explicit WorkStealingDeque(int64_t capacity)
+      : mask_(capacity - 1), buffer_(new std::atomic<T*>[capacity]) {
+    for (int64_t i = 0; i < capacity; ++i) {
+      buffer_[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  // Owner only. Returns false if the deque is full.
+  bool Push(T* item) {
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_acquire);
+    if (b - t > mask_) return false;
+    buffer_[b & mask_].store(item, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Owner only. Returns nullptr if the deque is empty.
+  T* Pop() {
+    const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    T* item = buffer_[b & mask_].load(std::memory_order_relaxed);
+    if (t == b) {
+      // Last item: race against thieves for it.
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  // Any thread. Returns nullptr if the deque is empty or the steal lost a race.
+  T* Steal() {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) return nullptr;
+    T* item = buffer_[t & mask_].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return item;
+  }
+
+  // Approximate; may be stale by the time it returns.
+  bool Empty() const {
+    return top_.load(std::memory_order_relaxed) >=
+           bottom_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  const int64_t mask_;
+  std::unique_ptr<std::atomic<T*>[]> buffer_;
+  // Kept on separate cache lines so that the owner and thieves do not
+  // false-share.
+  alignas(64) std::atomic<int64_t> top_{0};
+  alignas(64) std::atomic<int64_t> bottom_{0};
+};
+
+}  // namespace internal
+
+// A thread pool in which every worker owns a lock-free deque of tasks.
+//
+// Tasks scheduled from a worker thread of the pool are pushed onto that
+// worker's own deque and do not touch any shared lock. Tasks scheduled from
+// other threads go through a shared injection queue. Idle workers first drain
+// their own deque, then take from the injection queue, then steal from the
+// other workers, and only then go to sleep.
+//
+// Unlike ThreadPool, tasks are not run in FIFO order, even with one thread.
+//
+// If pin_threads is set, worker i is bound to a single CPU: the i-th CPU
+// (modulo its size) of thread_options.cpu_set() if specified, otherwise CPU i
+// modulo the number of hardware threads. Pinning is only supported on Linux.
+//
+// Sample usage:
+//
+// {
+//   WorkStealingThreadPool pool("testpool", num_workers);
+//   pool.StartWorkers();
+//   for (int i = 0; i < N; ++i) {
+//     pool.Schedule([i]() { DoWork(i); });
+//   }
+// }
+//
+class WorkStealingThreadPool {
+ public:
+  WorkStealingThreadPool(const std::string& name_prefix, int num_threads);
+  WorkStealingThreadPool(const ThreadOptions& thread_options,
+                         const std::string& name_prefix, int num_threads,
+                         bool pin_threads = false);
+  WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+  WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+  // Waits for all scheduled tasks to complete. May be called without having
+  // called StartWorkers().
+  ~WorkStealingThreadPool();
+
+  // REQUIRES: StartWorkers has not been called
+  // Actually start the worker threads.
+  void StartWorkers();
+
+  // REQUIRES: StartWorkers has been called
+  // Adds the callback to a task queue. Eventually a worker will run it.
+  void Schedule(std::function<void()> callback);
+
+  // Provided for debugging and testing only.
+  int num_threads() const { return num_threads_; }
+
+  // Standard thread options.  Use this accessor to get them.
+  const ThreadOptions& thread_options() const { return thread_options_; }
+
+  // Number of tasks that were run by a worker other than the one whose deque
+  // they were pushed onto. Provided for debugging and testing only.
+  int64_t num_steals() const {
+    return num_steals_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  using Task = std::function<void()>;
+  struct Worker;
+
+  // Capacity of each per-worker deque. Tasks pushed onto a full deque spill
+  // into the injection queue.
+  static constexpr int64_t kDequeCapacity = 1024;
+
+  void RunWorker(int index);
+  void ConfigureWorkerThread(int index);
+  // Tries to find a task for worker "index" without blocking.
+  Task* FindTask(int index);
+  Task* StealFromOthers(int index);
+  Task* PopInjected();
+  // Wakes up a sleeping worker, if any.
+  void NotifyOne();
+  bool HasPendingTasks();
+
+  const std::string name_prefix_;
+  const ThreadOptions thread_options_;
+  const int num_threads_;
+  const bool pin_threads_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+
+  // Number of tasks scheduled but not yet picked up by a worker.
+  std::atomic<int64_t> num_pending_{0};
+  std::atomic<int> num_sleeping_{0};
+  std::atomic<int64_t> num_steals_{0};
+
+  absl::Mutex injection_mutex_;
+  std::deque<Task*> injected_ ABSL_GUARDED_BY(injection_mutex_);
+
+  absl::Mutex sleep_mutex_;
+  absl::CondVar sleep_cv_;
+  bool stopped_ ABSL_GUARDED_BY(sleep_mutex_) = false;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_DEPS_WORK_STEALING_THREAD_POOL_H_
@@ -0,0 +1,156 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/deps/work_stealing_thread_pool.h"
+
+#include <atomic>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(WorkStealingDequeTest, PushPopIsLifo) {
+  internal::WorkStealingDeque<int> deque(4);
+  int items[4] = {0, 1, 2, 3};
+  for (int& item : items) {
+    ASSERT_TRUE(deque.Push(&item));
+  }
+  EXPECT_FALSE(deque.Push(&items[0]));
+  EXPECT_EQ(deque.Pop(), &items[3]);
+  EXPECT_EQ(deque.Steal(), &items[0]);
+  EXPECT_EQ(deque.Pop(), &items[2]);
+  EXPECT_EQ(deque.Pop(), &items[1]);
+  EXPECT_EQ(deque.Pop(), nullptr);
+  EXPECT_EQ(deque.Steal(), nullptr);
+  EXPECT_TRUE(deque.Empty());
+}
+
+TEST(WorkStealingDequeTest, ConcurrentStealsTakeEachItemOnce) {
+  constexpr int kNumItems = 100000;
+  constexpr int kNumThieves = 4;
+  internal::WorkStealingDeque<int> deque(256);
+  std::vector<int> items(kNumItems);
+  std::vector<std::atomic<int>> taken(kNumItems);
+  for (auto& count : taken) count.store(0);
+  std::atomic<bool> done{false};
+  auto record = [&](int* item) { taken[item - items.data()].fetch_add(1); };
+
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < kNumThieves; ++i) {
+    thieves.emplace_back([&] {
+      while (!done.load() || !deque.Empty()) {
+        if (int* item = deque.Steal()) record(item);
+      }
+    });
+  }
+  for (int i = 0; i < kNumItems; ++i) {
+    while (!deque.Push(&items[i])) {
+      if (int* item = deque.Pop()) record(item);
+    }
+    if (i % 3 == 0) {
+      if (int* item = deque.Pop()) record(item);
+    }
+  }
+  while (int* item = deque.Pop()) record(item);
+  done.store(true);
+  for (auto& thief : thieves) thief.join();
+
+  for (int i = 0; i < kNumItems; ++i) {
+    ASSERT_EQ(taken[i].load(), 1) << "item " << i;
+  }
+}
+
+TEST(WorkStealingThreadPoolTest, DestroyWithoutStart) {
+  WorkStealingThreadPool thread_pool("testpool", 10);
+}
+
+TEST(WorkStealingThreadPoolTest, EmptyThread) {
+  WorkStealingThreadPool thread_pool("testpool", 0);
+  ASSERT_EQ(1, thread_pool.num_threads());
+  thread_pool.StartWorkers();
+}
+
+TEST(WorkStealingThreadPoolTest, MultiThreads) {
+  std::atomic<int> n{1000};
+  {
+    WorkStealingThreadPool thread_pool("testpool", 10);
+    ASSERT_EQ(10, thread_pool.num_threads());
+    thread_pool.StartWorkers();
+    for (int i = 0; i < 1000; ++i) {
+      thread_pool.Schedule([&n]() { --n; });
+    }
+  }
+  EXPECT_EQ(0, n.load());
+}
+
+TEST(WorkStealingThreadPoolTest, TasksScheduledFromWorkersAreStolen) {
+  constexpr int kFanOut = 2000;
+  std::atomic<int> n{0};
+  absl::BlockingCounter counter(kFanOut);
+  WorkStealingThreadPool thread_pool("testpool", 4);
+  thread_pool.StartWorkers();
+  // All child tasks land on a single worker's deque; the other workers can
+  // only get to them by stealing.
+  thread_pool.Schedule([&] {
+    for (int i = 0; i < kFanOut; ++i) {
+      thread_pool.Schedule([&] {
+        ++n;
+        absl::SleepFor(absl::Microseconds(10));
+        counter.DecrementCount();
+      });
+    }
+  });
+  counter.Wait();
+  EXPECT_EQ(kFanOut, n.load());
+  EXPECT_GT(thread_pool.num_steals(), 0);
+}
+
+TEST(WorkStealingThreadPoolTest, SpillsWhenDequeIsFull) {
+  constexpr int kNumTasks = 10000;
+  std::atomic<int> n{0};
+  {
+    WorkStealingThreadPool thread_pool("testpool", 1);
+    thread_pool.StartWorkers();
+    thread_pool.Schedule([&] {
+      for (int i = 0; i < kNumTasks; ++i) {
+        thread_pool.Schedule([&n] { ++n; });
+      }
+    });
+  }
+  EXPECT_EQ(kNumTasks, n.load());
+}
+
+TEST(WorkStealingThreadPoolTest, CreateWithPinnedThreads) {
+  ThreadOptions thread_options = ThreadOptions().set_cpu_set({0});
+  std::atomic<int> n{0};
+  {
+    WorkStealingThreadPool thread_pool(thread_options, "testpool", 4,
+                                       /*pin_threads=*/true);
+    ASSERT_EQ(1, thread_pool.thread_options().cpu_set().size());
+    thread_pool.StartWorkers();
+    for (int i = 0; i < 100; ++i) {
+      thread_pool.Schedule([&n] { ++n; });
+    }
+  }
+  EXPECT_EQ(100, n.load());
+}
+
+}  // namespace
+}  // namespace mediapipe
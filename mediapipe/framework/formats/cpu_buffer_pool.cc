@@ -0,0 +1,169 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/formats/cpu_buffer_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/log/absl_log.h"
+#include "absl/numeric/bits.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/port/aligned_malloc_and_free.h"  // IWYU pragma: keep
+
+namespace mediapipe {
+namespace {
+
+constexpr size_t kMinBucketSize = 64;
+
+void FreeBuffers(const std::vector<void*>& buffers) {
+  for (void* buffer : buffers) {
+    aligned_free(buffer);
+  }
+}
+
+}  // namespace
+
+CpuBufferPool::~CpuBufferPool() {
+  std::vector<void*> trimmed;
+  {
+    absl::MutexLock lock(&mutex_);
+    ABSL_LOG_IF(ERROR, stats_.num_in_use > 0)
+        << "CpuBufferPool destroyed with " << stats_.num_in_use
+        << " buffers in use.";
+    TrimAvailableLocked(0, &trimmed);
+  }
+  FreeBuffers(trimmed);
+}
+
+size_t CpuBufferPool::BucketSize(size_t bytes) {
+  if (bytes <= kMinBucketSize) return kMinBucketSize;
+  const size_t step = absl::bit_floor(bytes) / 4;
+  return (bytes + step - 1) / step * step;
+}
+
+CpuBufferPool::BucketKey CpuBufferPool::GetBucketKey(size_t bytes,
+                                                     size_t alignment) {
+  alignment = std::max(alignment, alignof(std::max_align_t));
+  ABSL_DCHECK(absl::has_single_bit(alignment))
+      << "Alignment must be a power of two: " << alignment;
+  // aligned_malloc may require the size to be a multiple of the alignment.
+  const size_t size =
+      (BucketSize(bytes) + alignment - 1) / alignment * alignment;
+  return {size, alignment};
+}
+
+void* CpuBufferPool::Allocate(size_t bytes, size_t alignment) {
+  const BucketKey key = GetBucketKey(bytes, alignment);
+  {
+    absl::MutexLock lock(&mutex_);
+    Bucket& bucket = buckets_[key];
+    if (!bucket.available.empty()) {
+      void* buffer = bucket.available.back();
+      bucket.available.pop_back();
+      ++bucket.in_use_count;
+      ++stats_.num_reuses;
+      ++stats_.num_in_use;
+      --stats_.num_available;
+      stats_.bytes_in_use += key.first;
+      stats_.bytes_available -= key.first;
+      return buffer;
+    }
+  }
+
+  // The system allocation is done without holding the lock.
+  void* buffer = aligned_malloc(key.first, key.second);
+  if (buffer == nullptr) return nullptr;
+
+  absl::MutexLock lock(&mutex_);
+  ++buckets_[key].in_use_count;
+  ++stats_.num_allocations;
+  ++stats_.num_in_use;
+  stats_.bytes_in_use += key.first;
+  return buffer;
+}
+
+void CpuBufferPool::Release(void* buffer, size_t bytes, size_t alignment) {
+  if (buffer == nullptr) return;
+  const BucketKey key = GetBucketKey(bytes, alignment);
+  bool keep = false;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = buckets_.find(key);
+    ABSL_CHECK(it != buckets_.end() && it->second.in_use_count > 0)
+        << "Buffer of " << bytes << " bytes was not allocated by this pool.";
+    Bucket& bucket = it->second;
+    --bucket.in_use_count;
+    --stats_.num_in_use;
+    stats_.bytes_in_use -= key.first;
+
+    // Like ReusablePool::TrimAvailable, keep at most keep_count buffers of the
+    // same bucket around, counting the ones that are still in use.
+    const size_t keep_count =
+        std::max(options_.keep_count - bucket.in_use_count, 0);
+    keep = bucket.available.size() < keep_count &&
+           stats_.bytes_available + key.first <= options_.max_available_bytes;
+    if (keep) {
+      bucket.available.push_back(buffer);
+      ++stats_.num_available;
+      stats_.bytes_available += key.first;
+    } else {
+      ++stats_.num_trimmed;
+    }
+  }
+  if (!keep) {
+    aligned_free(buffer);
+  }
+}
+
+void CpuBufferPool::TrimAvailable(size_t max_available_bytes) {
+  std::vector<void*> trimmed;
+  {
+    absl::MutexLock lock(&mutex_);
+    TrimAvailableLocked(max_available_bytes, &trimmed);
+  }
+  // The trimmed buffers are freed without holding the lock.
+  FreeBuffers(trimmed);
+}
+
+void CpuBufferPool::TrimAvailableLocked(size_t max_available_bytes,
+                                        std::vector<void*>* trimmed) {
+  for (auto it = buckets_.begin();
+       it != buckets_.end() && stats_.bytes_available > max_available_bytes;) {
+    Bucket& bucket = it->second;
+    const size_t size = it->first.first;
+    while (!bucket.available.empty() &&
+           stats_.bytes_available > max_available_bytes) {
+      trimmed->push_back(bucket.available.back());
+      bucket.available.pop_back();
+      --stats_.num_available;
+      ++stats_.num_trimmed;
+      stats_.bytes_available -= size;
+    }
+    if (bucket.available.empty() && bucket.in_use_count == 0) {
+      buckets_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+CpuBufferPool::Stats CpuBufferPool::GetStats() const {
+  absl::MutexLock lock(&mutex_);
+  return stats_;
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,111 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_FORMATS_CPU_BUFFER_POOL_H_
+#define MEDIAPIPE_FRAMEWORK_FORMATS_CPU_BUFFER_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace mediapipe {
+
+struct CpuBufferPoolOptions {
+  // Maximum number of buffers of the same bucket to keep around, including
+  // the ones that are in use, as in MultiPoolOptions::keep_count.
+  int keep_count = 2;
+
+  // Maximum number of bytes held by idle buffers across all buckets. Buffers
+  // returned to a full pool are freed right away.
+  size_t max_available_bytes = 64 << 20;
+};
+
+// Thread-safe pool of raw CPU buffers, used to back the CPU storage of Tensors
+// created with a MemoryManager.
+//
+// Requested sizes are rounded up to buckets with four steps per power of two,
+// so that tensors of slightly different sizes (e.g. dynamic shapes) share
+// buffers while wasting at most 25% of the memory.
+class CpuBufferPool {
+ public:
+  struct Stats {
+    // Number of buffers that had to be allocated from the system.
+    int64_t num_allocations = 0;
+    // Number of buffers that were served from the pool.
+    int64_t num_reuses = 0;
+    // Number of returned buffers that were freed instead of being kept.
+    int64_t num_trimmed = 0;
+    int num_in_use = 0;
+    int num_available = 0;
+    size_t bytes_in_use = 0;
+    size_t bytes_available = 0;
+  };
+
+  CpuBufferPool() = default;
+  explicit CpuBufferPool(const CpuBufferPoolOptions& options)
+      : options_(options) {}
+  ~CpuBufferPool();
+
+  CpuBufferPool(const CpuBufferPool&) = delete;
+  CpuBufferPool& operator=(const CpuBufferPool&) = delete;
+
+  // Returns a buffer of at least `bytes` bytes aligned to `alignment` bytes
+  // (at least alignof(std::max_align_t)), or nullptr if the allocation failed.
+  // The buffer must be returned with Release() using the same `bytes` and
+  // `alignment`.
+  void* Allocate(size_t bytes, size_t alignment = 0);
+
+  // Returns a buffer obtained from Allocate() to the pool.
+  void Release(void* buffer, size_t bytes, size_t alignment = 0);
+
+  // Frees idle buffers until at most `max_available_bytes` bytes remain
+  // pooled, e.g. in response to memory pressure.
+  void TrimAvailable(size_t max_available_bytes = 0);
+
+  Stats GetStats() const;
+
+  // Returns the size of the buffers that serve requests of `bytes` bytes.
+  static size_t BucketSize(size_t bytes);
+
+ private:
+  // (bucket size, alignment).
+  using BucketKey = std::pair<size_t, size_t>;
+  struct Bucket {
+    int in_use_count = 0;
+    std::vector<void*> available;
+  };
+
+  static BucketKey GetBucketKey(size_t bytes, size_t alignment);
+
+  // Moves idle buffers into `trimmed` until at most `max_available_bytes`
+  // bytes remain pooled.
+  void TrimAvailableLocked(size_t max_available_bytes,
+                           std::vector<void*>* trimmed)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const CpuBufferPoolOptions options_;
+
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<BucketKey, Bucket> buckets_ ABSL_GUARDED_BY(mutex_);
+  Stats stats_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_FORMATS_CPU_BUFFER_POOL_H_
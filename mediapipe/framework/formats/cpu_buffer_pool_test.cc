@@ -0,0 +1,114 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/formats/cpu_buffer_pool.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr size_t kBytes = 1000;
+
+TEST(CpuBufferPoolTest, RoundsSizesUpToBuckets) {
+  EXPECT_EQ(CpuBufferPool::BucketSize(1), 64);
+  EXPECT_EQ(CpuBufferPool::BucketSize(64), 64);
+  EXPECT_EQ(CpuBufferPool::BucketSize(65), 80);
+  EXPECT_EQ(CpuBufferPool::BucketSize(1000), 1024);
+  EXPECT_EQ(CpuBufferPool::BucketSize(1024), 1024);
+  EXPECT_EQ(CpuBufferPool::BucketSize(1025), 1280);
+}
+
+TEST(CpuBufferPoolTest, ReusesReleasedBuffer) {
+  CpuBufferPool pool;
+  void* buffer = pool.Allocate(kBytes);
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(pool.GetStats().num_in_use, 1);
+  pool.Release(buffer, kBytes);
+  EXPECT_EQ(pool.GetStats().num_available, 1);
+
+  // A request of a different size in the same bucket gets the same buffer.
+  void* reused = pool.Allocate(kBytes + 20);
+  EXPECT_EQ(reused, buffer);
+  pool.Release(reused, kBytes + 20);
+
+  const CpuBufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(stats.num_allocations, 1);
+  EXPECT_EQ(stats.num_reuses, 1);
+  EXPECT_EQ(stats.num_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_available, 1024);
+}
+
+TEST(CpuBufferPoolTest, HonorsAlignment) {
+  CpuBufferPool pool;
+  for (size_t alignment : {16, 64, 256}) {
+    void* buffer = pool.Allocate(kBytes, alignment);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer) % alignment, 0);
+    pool.Release(buffer, kBytes, alignment);
+  }
+  // Buffers of different alignments are not shared.
+  EXPECT_EQ(pool.GetStats().num_allocations, 3);
+}
+
+TEST(CpuBufferPoolTest, KeepsAtMostKeepCountBuffers) {
+  CpuBufferPool pool(CpuBufferPoolOptions{.keep_count = 2});
+  std::vector<void*> buffers;
+  for (int i = 0; i < 3; ++i) {
+    buffers.push_back(pool.Allocate(kBytes));
+  }
+  for (void* buffer : buffers) {
+    pool.Release(buffer, kBytes);
+  }
+  const CpuBufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(stats.num_available, 2);
+  EXPECT_EQ(stats.num_trimmed, 1);
+}
+
+TEST(CpuBufferPoolTest, KeepsAtMostMaxAvailableBytes) {
+  CpuBufferPool pool(CpuBufferPoolOptions{.max_available_bytes = 1024});
+  void* small = pool.Allocate(kBytes);
+  void* large = pool.Allocate(2 * kBytes);
+  pool.Release(small, kBytes);
+  pool.Release(large, 2 * kBytes);
+  const CpuBufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(stats.num_available, 1);
+  EXPECT_EQ(stats.bytes_available, 1024);
+  EXPECT_EQ(stats.num_trimmed, 1);
+}
+
+TEST(CpuBufferPoolTest, TrimAvailable) {
+  CpuBufferPool pool;
+  void* buffer_a = pool.Allocate(kBytes);
+  void* buffer_b = pool.Allocate(4 * kBytes);
+  pool.Release(buffer_a, kBytes);
+  pool.Release(buffer_b, 4 * kBytes);
+  EXPECT_EQ(pool.GetStats().bytes_available, 5 * 1024);
+
+  pool.TrimAvailable(4 * 1024);
+  EXPECT_LE(pool.GetStats().bytes_available, 4 * 1024);
+  pool.TrimAvailable();
+  const CpuBufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(stats.num_available, 0);
+  EXPECT_EQ(stats.bytes_available, 0);
+  EXPECT_EQ(stats.num_trimmed, 2);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -14,16 +14,16 @@
 
 #include "mediapipe/framework/formats/image_frame_pool.h"
 
+#include <algorithm>
+
 #include "absl/synchronization/mutex.h"
 
 namespace mediapipe {
 
 ImageFramePool::ImageFramePool(int width, int height,
-                               ImageFormat::Format format, int keep_count)
-    : width_(width),
-      height_(height),
-      format_(format),
-      keep_count_(keep_count) {}
+                               ImageFormat::Format format,
+                               const ImageFramePoolOptions& options)
+    : width_(width), height_(height), format_(format), options_(options) {}
 
 ImageFrameSharedPtr ImageFramePool::GetBuffer() {
   std::unique_ptr<ImageFrame> buffer;
@@ -31,16 +31,18 @@ ImageFrameSharedPtr ImageFramePool::GetBuffer() {
   {
     absl::MutexLock lock(&mutex_);
     if (available_.empty()) {
-      // Fix alignment at 4 for best compatability with OpenGL.
-      buffer = std::make_unique<ImageFrame>(
-          format_, width_, height_, ImageFrame::kGlDefaultAlignmentBoundary);
+      buffer = std::make_unique<ImageFrame>(format_, width_, height_,
+                                            options_.alignment_boundary);
       if (!buffer) return nullptr;
+      ++stats_.num_allocations;
     } else {
       buffer = std::move(available_.back());
       available_.pop_back();
+      ++stats_.num_reuses;
     }
 
     ++in_use_count_;
+    stats_.max_in_use = std::max(stats_.max_in_use, in_use_count_);
   }
 
   // Return a shared_ptr with a custom deleter that adds the buffer back
@@ -62,6 +64,11 @@ std::pair<int, int> ImageFramePool::GetInUseAndAvailableCounts() {
   return {in_use_count_, available_.size()};
 }
 
+ImageFramePool::Stats ImageFramePool::GetStats() {
+  absl::MutexLock lock(&mutex_);
+  return stats_;
+}
+
 void ImageFramePool::Return(ImageFrame* buf) {
   std::vector<std::unique_ptr<ImageFrame>> trimmed;
   {
@@ -75,7 +82,11 @@ void ImageFramePool::Return(ImageFrame* buf) {
 
 void ImageFramePool::TrimAvailable(
     std::vector<std::unique_ptr<ImageFrame>>* trimmed) {
-  int keep = std::max(keep_count_ - in_use_count_, 0);
+  const int keep_count =
+      options_.keep_max_in_use
+          ? std::max(options_.keep_count, stats_.max_in_use)
+          : options_.keep_count;
+  int keep = std::max(keep_count - in_use_count_, 0);
   if (available_.size() > keep) {
     auto trim_it = std::next(available_.begin(), keep);
     if (trimmed) {
@@ -18,6 +18,8 @@
 #ifndef MEDIAPIPE_FRAMEWORK_FORMATS_IMAGE_FRAME_POOL_H_
 #define MEDIAPIPE_FRAMEWORK_FORMATS_IMAGE_FRAME_POOL_H_
 
+#include <cstdint>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -28,6 +30,18 @@ namespace mediapipe {
 
 using ImageFrameSharedPtr = std::shared_ptr<ImageFrame>;
 
+struct ImageFramePoolOptions {
+  // The number of buffers to keep around for reuse.
+  int keep_count = 2;
+  // The alignment of the rows of the buffers. Fixed at 4 by default for best
+  // compatibility with OpenGL.
+  uint32_t alignment_boundary = ImageFrame::kGlDefaultAlignmentBoundary;
+  // If true, the pool keeps up to as many buffers as were ever in use at once
+  // when that exceeds keep_count. A stream holding a steady number of frames
+  // in flight then stops allocating once warmed up.
+  bool keep_max_in_use = false;
+};
+
 class ImageFramePool : public std::enable_shared_from_this<ImageFramePool> {
  public:
   // Creates a pool. This pool will manage buffers of the specified dimensions,
@@ -37,10 +51,25 @@ class ImageFramePool : public std::enable_shared_from_this<ImageFramePool> {
   static std::shared_ptr<ImageFramePool> Create(int width, int height,
                                                 ImageFormat::Format format,
                                                 int keep_count) {
+    return Create(width, height, format,
+                  ImageFramePoolOptions{.keep_count = keep_count});
+  }
+  static std::shared_ptr<ImageFramePool> Create(
+      int width, int height, ImageFormat::Format format,
+      const ImageFramePoolOptions& options) {
     return std::shared_ptr<ImageFramePool>(
-        new ImageFramePool(width, height, format, keep_count));
+        new ImageFramePool(width, height, format, options));
   }
 
+  struct Stats {
+    // Buffers obtained from the available ones (pool hits).
+    int64_t num_reuses = 0;
+    // Buffers that had to be allocated (pool misses).
+    int64_t num_allocations = 0;
+    // The largest number of buffers in use at once.
+    int max_in_use = 0;
+  };
+
   // Obtains a buffers. May either be reused or created anew.
   ImageFrameSharedPtr GetBuffer();
 
@@ -51,9 +80,11 @@ class ImageFramePool : public std::enable_shared_from_this<ImageFramePool> {
   // This method is meant for testing.
   std::pair<int, int> GetInUseAndAvailableCounts();
 
+  Stats GetStats();
+
  private:
   ImageFramePool(int width, int height, ImageFormat::Format format,
-                 int keep_count);
+                 const ImageFramePoolOptions& options);
 
   // Return a buffer to the pool.
   void Return(ImageFrame* buf);
@@ -66,10 +97,11 @@ class ImageFramePool : public std::enable_shared_from_this<ImageFramePool> {
   const int width_;
   const int height_;
   const ImageFormat::Format format_;
-  const int keep_count_;
+  const ImageFramePoolOptions options_;
 
   absl::Mutex mutex_;
   int in_use_count_ ABSL_GUARDED_BY(mutex_) = 0;
+  Stats stats_ ABSL_GUARDED_BY(mutex_);
   std::vector<std::unique_ptr<ImageFrame>> available_ ABSL_GUARDED_BY(mutex_);
 };
 
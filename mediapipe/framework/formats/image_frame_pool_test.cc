@@ -14,6 +14,8 @@
 
 #include "mediapipe/framework/formats/image_frame_pool.h"
 
+#include <vector>
+
 #include "absl/memory/memory.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
@@ -92,6 +94,45 @@ TEST_F(ImageFramePoolTest, DeleteNotLast) {
   EXPECT_EQ(Pair(kKeepCount - 1, 1), pool_->GetInUseAndAvailableCounts());
 }
 
+TEST_F(ImageFramePoolTest, GetStats) {
+  auto buffer = pool_->GetBuffer();
+  buffer = nullptr;
+  buffer = pool_->GetBuffer();
+  auto other_buffer = pool_->GetBuffer();
+  ImageFramePool::Stats stats = pool_->GetStats();
+  EXPECT_EQ(stats.num_reuses, 1);
+  EXPECT_EQ(stats.num_allocations, 2);
+  EXPECT_EQ(stats.max_in_use, 2);
+}
+
+TEST(ImageFramePoolOptionsTest, KeepMaxInUse) {
+  auto pool = ImageFramePool::Create(
+      kWidth, kHeight, kFormat,
+      ImageFramePoolOptions{.keep_count = 1, .keep_max_in_use = true});
+  std::vector<ImageFrameSharedPtr> buffers(3);
+  for (auto& buffer : buffers) buffer = pool->GetBuffer();
+  buffers.clear();
+  EXPECT_EQ(Pair(0, 3), pool->GetInUseAndAvailableCounts());
+
+  // Steady state with 3 buffers in flight: no more allocations.
+  for (int i = 0; i < 10; ++i) {
+    buffers.push_back(pool->GetBuffer());
+    if (buffers.size() == 3) buffers.erase(buffers.begin());
+  }
+  EXPECT_EQ(pool->GetStats().num_allocations, 3);
+}
+
+TEST(ImageFramePoolOptionsTest, AlignmentBoundary) {
+  auto pool = ImageFramePool::Create(
+      kWidth + 1, kHeight, ImageFormat::SRGB,
+      ImageFramePoolOptions{
+          .alignment_boundary = ImageFrame::kDefaultAlignmentBoundary});
+  auto buffer = pool->GetBuffer();
+  EXPECT_TRUE(buffer->IsAligned(ImageFrame::kDefaultAlignmentBoundary));
+  EXPECT_EQ(buffer->WidthStep(),
+            ImageFrame(ImageFormat::SRGB, kWidth + 1, kHeight).WidthStep());
+}
+
 TEST(ImageFrameBufferPoolStaticTest, BufferCanOutlivePool) {
   auto pool = ImageFramePool::Create(kWidth, kHeight, kFormat, kKeepCount);
   auto buffer = pool->GetBuffer();
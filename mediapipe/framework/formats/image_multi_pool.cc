@@ -14,6 +14,9 @@
 
 #include "mediapipe/framework/formats/image_multi_pool.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <tuple>
 
 #include "absl/log/absl_check.h"
@@ -115,8 +118,11 @@ Image ImageMultiPool::GetBufferFromSimplePool(
 
 ImageMultiPool::SimplePoolCpu ImageMultiPool::MakeSimplePoolCpu(
     IBufferSpec spec) {
-  return ImageFramePool::Create(spec.width, spec.height, spec.format,
-                                kKeepCount);
+  return ImageFramePool::Create(
+      spec.width, spec.height, spec.format,
+      ImageFramePoolOptions{.keep_count = kKeepCount,
+                            .alignment_boundary = spec.alignment_boundary,
+                            .keep_max_in_use = spec.keep_max_in_use});
 }
 
 Image ImageMultiPool::GetBufferFromSimplePool(
@@ -158,34 +164,72 @@ Image ImageMultiPool::GetBuffer(int width, int height, bool use_gpu,
   } else  // NOLINT(readability/braces)
 #endif    // !MEDIAPIPE_DISABLE_GPU
   {
-    absl::MutexLock lock(&mutex_cpu_);
     IBufferSpec key(width, height, format);
-    auto pool_it = pools_cpu_.find(key);
-    if (pool_it == pools_cpu_.end()) {
-      // Discard the least recently used pool in LRU cache.
-      if (pools_cpu_.size() >= kMaxPoolCount) {
-        auto old_spec = buffer_specs_cpu_.front();  // Front has LRU.
-        buffer_specs_cpu_.pop_front();
-        pools_cpu_.erase(old_spec);
-      }
-      buffer_specs_cpu_.push_back(key);  // Push new spec to back.
-      std::tie(pool_it, std::ignore) = pools_cpu_.emplace(
-          std::piecewise_construct, std::forward_as_tuple(key),
-          std::forward_as_tuple(MakeSimplePoolCpu(key)));
-    } else {
-      // Find and move current 'key' spec to back, keeping others in same order.
-      auto specs_it = buffer_specs_cpu_.begin();
-      while (specs_it != buffer_specs_cpu_.end()) {
-        if (*specs_it == key) {
-          buffer_specs_cpu_.erase(specs_it);
-          break;
-        }
-        ++specs_it;
+    return GetBufferFromSimplePool(key, GetSimplePoolCpu(key));
+  }
+}
+
+ImageMultiPool::SimplePoolCpu ImageMultiPool::GetSimplePoolCpu(
+    const IBufferSpec& key) {
+  absl::MutexLock lock(&mutex_cpu_);
+  auto pool_it = pools_cpu_.find(key);
+  if (pool_it == pools_cpu_.end()) {
+    // Discard the least recently used pool in LRU cache.
+    if (pools_cpu_.size() >= kMaxPoolCount) {
+      auto old_spec = buffer_specs_cpu_.front();  // Front has LRU.
+      buffer_specs_cpu_.pop_front();
+      auto old_pool_it = pools_cpu_.find(old_spec);
+      AddStats(old_pool_it->second->GetStats(), &evicted_cpu_stats_);
+      pools_cpu_.erase(old_pool_it);
+    }
+    buffer_specs_cpu_.push_back(key);  // Push new spec to back.
+    std::tie(pool_it, std::ignore) = pools_cpu_.emplace(
+        std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(MakeSimplePoolCpu(key)));
+  } else {
+    // Find and move current 'key' spec to back, keeping others in same order.
+    auto specs_it = buffer_specs_cpu_.begin();
+    while (specs_it != buffer_specs_cpu_.end()) {
+      if (*specs_it == key) {
+        buffer_specs_cpu_.erase(specs_it);
+        break;
       }
-      buffer_specs_cpu_.push_back(key);
+      ++specs_it;
     }
-    return GetBufferFromSimplePool(pool_it->first, pool_it->second);
+    buffer_specs_cpu_.push_back(key);
+  }
+  return pool_it->second;
+}
+
+std::unique_ptr<ImageFrame> ImageMultiPool::GetImageFrame(
+    int width, int height, ImageFormat::Format format,
+    uint32_t alignment_boundary) {
+  const IBufferSpec key(width, height, format, alignment_boundary,
+                        /*keep_max=*/true);
+  ImageFrameSharedPtr buffer = GetSimplePoolCpu(key)->GetBuffer();
+  const int width_step = buffer->WidthStep();
+  uint8_t* pixel_data = buffer->MutablePixelData();
+  // The returned frame borrows the pixel data of the pooled one, which goes
+  // back to the pool when the returned frame releases it.
+  return std::make_unique<ImageFrame>(
+      format, width, height, width_step, pixel_data,
+      [buffer = std::move(buffer)](uint8_t*) mutable { buffer.reset(); });
+}
+
+ImageFramePool::Stats ImageMultiPool::GetCpuStats() {
+  absl::MutexLock lock(&mutex_cpu_);
+  ImageFramePool::Stats stats = evicted_cpu_stats_;
+  for (const auto& [spec, pool] : pools_cpu_) {
+    AddStats(pool->GetStats(), &stats);
   }
+  return stats;
+}
+
+void ImageMultiPool::AddStats(const ImageFramePool::Stats& stats,
+                              ImageFramePool::Stats* total) {
+  total->num_reuses += stats.num_reuses;
+  total->num_allocations += stats.num_allocations;
+  total->max_in_use = std::max(total->max_in_use, stats.max_in_use);
 }
 
 ImageMultiPool::~ImageMultiPool() {
@@ -22,8 +22,10 @@
 #ifndef MEDIAPIPE_FRAMEWORK_FORMATS_IMAGE_MULTI_POOL_H_
 #define MEDIAPIPE_FRAMEWORK_FORMATS_IMAGE_MULTI_POOL_H_
 
+#include <cstdint>
 #include <deque>
 #include <limits>
+#include <memory>
 #include <unordered_map>
 
 #include "absl/synchronization/mutex.h"
@@ -57,6 +59,21 @@ class ImageMultiPool {
   Image GetBuffer(int width, int height, bool use_gpu,
                   ImageFormat::Format format /*= ImageFormat::SRGBA*/);
 
+  // Obtains a CPU ImageFrame laid out like
+  // ImageFrame(format, width, height, alignment_boundary). Its pixel data may
+  // either be reused or created anew, and goes back to the pool when the frame
+  // is destroyed. The frame can be sent and consumed like any other
+  // ImageFrame. Unlike GetBuffer, the pool keeps as many frames of each layout
+  // as were ever in use at once.
+  std::unique_ptr<ImageFrame> GetImageFrame(
+      int width, int height, ImageFormat::Format format,
+      uint32_t alignment_boundary = ImageFrame::kDefaultAlignmentBoundary);
+
+  // Returns the reuse statistics of the CPU buffers, summed over all sizes,
+  // including the pools that were dropped. max_in_use is the largest one of
+  // any single size.
+  ImageFramePool::Stats GetCpuStats();
+
 #if !MEDIAPIPE_DISABLE_GPU
 #ifdef __APPLE__
   // TODO: add tests for the texture cache registration.
@@ -76,14 +93,23 @@ class ImageMultiPool {
   }
 
   struct IBufferSpec {
-    IBufferSpec(int w, int h, mediapipe::ImageFormat::Format f)
-        : width(w), height(h), format(f) {}
+    IBufferSpec(int w, int h, mediapipe::ImageFormat::Format f,
+                uint32_t alignment = ImageFrame::kGlDefaultAlignmentBoundary,
+                bool keep_max = false)
+        : width(w),
+          height(h),
+          format(f),
+          alignment_boundary(alignment),
+          keep_max_in_use(keep_max) {}
     int width;
     int height;
     mediapipe::ImageFormat::Format format;
-    // Note: alignment should be added here if ImageFrameBufferPool is changed
-    // to allow for customizable alignment sizes (currently fixed at 4 for best
-    // compatability with OpenGL).
+    // Only used by CPU buffers. Fixed at 4 for Images, for best compatibility
+    // with OpenGL.
+    uint32_t alignment_boundary;
+    // Only used by CPU buffers, see ImageFramePoolOptions. Set for the pools
+    // of GetImageFrame, so Images keep the former pool size.
+    bool keep_max_in_use;
   };
 
   struct IBufferSpecHash {
@@ -93,10 +119,9 @@ class ImageMultiPool {
       constexpr int kWidth = std::numeric_limits<size_t>::digits;
       return std::hash<std::size_t>{}(
           spec.width ^ RotateLeftN(spec.height, kWidth / 2) ^
-          RotateLeftN(static_cast<uint32_t>(spec.format), kWidth / 4));
-      // Note: alignment should be added here if ImageFrameBufferPool is changed
-      // to allow for customizable alignment sizes (currently fixed at 4 for
-      // best compatability with OpenGL).
+          RotateLeftN(static_cast<uint32_t>(spec.format), kWidth / 4) ^
+          RotateLeftN(spec.alignment_boundary, kWidth * 3 / 4) ^
+          RotateLeftN(spec.keep_max_in_use, kWidth - 1));
     }
   };
 
@@ -121,6 +146,10 @@ class ImageMultiPool {
   typedef std::shared_ptr<ImageFramePool> SimplePoolCpu;
   SimplePoolCpu MakeSimplePoolCpu(IBufferSpec spec);
   Image GetBufferFromSimplePool(IBufferSpec spec, const SimplePoolCpu& pool);
+  // Returns the pool for `key`, creating it if needed.
+  SimplePoolCpu GetSimplePoolCpu(const IBufferSpec& key);
+  static void AddStats(const ImageFramePool::Stats& stats,
+                       ImageFramePool::Stats* total);
 
   absl::Mutex mutex_cpu_;
   std::unordered_map<IBufferSpec, SimplePoolCpu, IBufferSpecHash> pools_cpu_
@@ -128,6 +157,8 @@ class ImageMultiPool {
   // A queue of IBufferSpecs to keep track of the age of each IBufferSpec added
   // to the pool.
   std::deque<IBufferSpec> buffer_specs_cpu_;
+  // The statistics of the CPU pools that were dropped.
+  ImageFramePool::Stats evicted_cpu_stats_ ABSL_GUARDED_BY(mutex_cpu_);
 
 #if !MEDIAPIPE_DISABLE_GPU
 #ifdef __APPLE__
@@ -142,7 +173,9 @@ class ImageMultiPool {
 inline bool operator==(const ImageMultiPool::IBufferSpec& lhs,
                        const ImageMultiPool::IBufferSpec& rhs) {
   return lhs.width == rhs.width && lhs.height == rhs.height &&
-         lhs.format == rhs.format;
+         lhs.format == rhs.format &&
+         lhs.alignment_boundary == rhs.alignment_boundary &&
+         lhs.keep_max_in_use == rhs.keep_max_in_use;
 }
 inline bool operator!=(const ImageMultiPool::IBufferSpec& lhs,
                        const ImageMultiPool::IBufferSpec& rhs) {
@@ -0,0 +1,109 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/formats/image_multi_pool.h"
+
+#include <memory>
+#include <vector>
+
+#include "mediapipe/framework/formats/image.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(ImageMultiPoolTest, GetImageFrameReusesPixelData) {
+  ImageMultiPool pool;
+  std::unique_ptr<ImageFrame> frame =
+      pool.GetImageFrame(101, 50, ImageFormat::SRGB);
+  const ImageFrame expected_layout(ImageFormat::SRGB, 101, 50);
+  EXPECT_EQ(frame->Format(), ImageFormat::SRGB);
+  EXPECT_EQ(frame->Width(), 101);
+  EXPECT_EQ(frame->Height(), 50);
+  EXPECT_EQ(frame->WidthStep(), expected_layout.WidthStep());
+  const uint8_t* pixel_data = frame->PixelData();
+  frame = nullptr;
+
+  frame = pool.GetImageFrame(101, 50, ImageFormat::SRGB);
+  EXPECT_EQ(frame->PixelData(), pixel_data);
+  ImageFramePool::Stats stats = pool.GetCpuStats();
+  EXPECT_EQ(stats.num_reuses, 1);
+  EXPECT_EQ(stats.num_allocations, 1);
+}
+
+TEST(ImageMultiPoolTest, GetImageFrameKeysOnSizeAndFormat) {
+  ImageMultiPool pool;
+  pool.GetImageFrame(64, 64, ImageFormat::SRGB);
+  pool.GetImageFrame(64, 64, ImageFormat::SRGBA);
+  pool.GetImageFrame(32, 64, ImageFormat::SRGB);
+  pool.GetImageFrame(64, 64, ImageFormat::SRGB);
+  ImageFramePool::Stats stats = pool.GetCpuStats();
+  EXPECT_EQ(stats.num_reuses, 1);
+  EXPECT_EQ(stats.num_allocations, 3);
+}
+
+TEST(ImageMultiPoolTest, GetImageFrameKeysOnAlignment) {
+  ImageMultiPool pool;
+  std::unique_ptr<ImageFrame> frame =
+      pool.GetImageFrame(30, 10, ImageFormat::SRGB, /*alignment_boundary=*/1);
+  EXPECT_EQ(frame->WidthStep(), 90);
+  frame = pool.GetImageFrame(30, 10, ImageFormat::SRGB);
+  EXPECT_EQ(frame->WidthStep(), 96);
+  EXPECT_EQ(pool.GetCpuStats().num_allocations, 2);
+}
+
+TEST(ImageMultiPoolTest, GetImageFrameKeepsMaxInUse) {
+  ImageMultiPool pool;
+  std::vector<std::unique_ptr<ImageFrame>> frames;
+  for (int i = 0; i < 3; ++i) {
+    frames.push_back(pool.GetImageFrame(64, 64, ImageFormat::SRGB));
+  }
+  frames.clear();
+  for (int i = 0; i < 3; ++i) {
+    frames.push_back(pool.GetImageFrame(64, 64, ImageFormat::SRGB));
+  }
+  ImageFramePool::Stats stats = pool.GetCpuStats();
+  EXPECT_EQ(stats.num_reuses, 3);
+  EXPECT_EQ(stats.num_allocations, 3);
+}
+
+TEST(ImageMultiPoolTest, GetBufferKeepsFixedCount) {
+  ImageMultiPool pool;
+  std::vector<Image> images;
+  for (int i = 0; i < 3; ++i) {
+    images.push_back(pool.GetBuffer(64, 64, /*use_gpu=*/false,
+                                    ImageFormat::SRGB));
+  }
+  images.clear();
+  for (int i = 0; i < 3; ++i) {
+    images.push_back(pool.GetBuffer(64, 64, /*use_gpu=*/false,
+                                    ImageFormat::SRGB));
+  }
+  ImageFramePool::Stats stats = pool.GetCpuStats();
+  EXPECT_EQ(stats.num_reuses, 2);
+  EXPECT_EQ(stats.num_allocations, 4);
+}
+
+TEST(ImageMultiPoolTest, FrameCanOutlivePool) {
+  auto pool = std::make_unique<ImageMultiPool>();
+  std::unique_ptr<ImageFrame> frame =
+      pool->GetImageFrame(64, 64, ImageFormat::GRAY8);
+  pool = nullptr;
+  frame->SetToZero();
+  frame = nullptr;
+}
+
+}  // namespace
+}  // namespace mediapipe
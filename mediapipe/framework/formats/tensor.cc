@@ -136,7 +136,7 @@ MtlBufferView MtlBufferView::GetReadView(const Tensor& tensor,
       FATAL, !(tensor.valid_ & (Tensor::kValidCpu | Tensor::kValidMetalBuffer)))
       << "Tensor conversion between different GPU backing formats is not "
          "supported yet.";
-  auto lock(std::make_unique<absl::MutexLock>(&tensor.view_mutex_));
+  tensor_internal::ViewLock lock(&tensor.view_mutex_);
   tensor.valid_ |= Tensor::kValidMetalBuffer;
   AllocateMtlBuffer(tensor, [command_buffer device]);
   return {tensor.mtl_resources_->metal_buffer, std::move(lock)};
@@ -152,7 +152,7 @@ MtlBufferView MtlBufferView::GetWriteView(const Tensor& tensor,
 
 MtlBufferView MtlBufferView::GetWriteView(const Tensor& tensor,
                                           id<MTLDevice> device) {
-  auto lock(std::make_unique<absl::MutexLock>(&tensor.view_mutex_));
+  tensor_internal::ViewLock lock(&tensor.view_mutex_);
   tensor.valid_ = Tensor::kValidMetalBuffer;
   AllocateMtlBuffer(tensor, device);
   return {tensor.mtl_resources_->metal_buffer, std::move(lock)};
@@ -183,7 +183,7 @@ Tensor::OpenGlTexture2dView Tensor::GetOpenGlTexture2dReadView() const {
   ABSL_LOG_IF(FATAL, !(valid_ & (kValidCpu | kValidOpenGlTexture2d)))
       << "Tensor conversion between different GPU backing formats is not "
          "supported yet.";
-  auto lock = std::make_unique<absl::MutexLock>(&view_mutex_);
+  tensor_internal::ViewLock lock(&view_mutex_);
   AllocateOpenGlTexture2d();
   if (!(valid_ & kValidOpenGlTexture2d)) {
     const int padded_size =
@@ -232,7 +232,7 @@ Tensor::OpenGlTexture2dView Tensor::GetOpenGlTexture2dReadView() const {
 }
 
 Tensor::OpenGlTexture2dView Tensor::GetOpenGlTexture2dWriteView() const {
-  auto lock = std::make_unique<absl::MutexLock>(&view_mutex_);
+  tensor_internal::ViewLock lock(&view_mutex_);
   AllocateOpenGlTexture2d();
 #ifdef __EMSCRIPTEN__
   // On web, we may have to change type from float to half-float
@@ -354,7 +354,7 @@ Tensor::OpenGlBufferView Tensor::GetOpenGlBufferReadView() const {
                                  kValidOpenGlBuffer)))
       << "Tensor conversion between different GPU backing formats is not "
          "supported yet.";
-  auto lock(std::make_unique<absl::MutexLock>(&view_mutex_));
+  tensor_internal::ViewLock lock(&view_mutex_);
   AllocateOpenGlBuffer();
   if (!(valid_ & kValidOpenGlBuffer)) {
     // If the call succeeds then AHWB -> SSBO are synchronized so any usage of
@@ -388,7 +388,7 @@ Tensor::OpenGlBufferView Tensor::GetOpenGlBufferReadView() const {
 
 Tensor::OpenGlBufferView Tensor::GetOpenGlBufferWriteView(
     uint64_t source_location_hash) const {
-  auto lock(std::make_unique<absl::MutexLock>(&view_mutex_));
+  tensor_internal::ViewLock lock(&view_mutex_);
   TrackAhwbUsage(source_location_hash);
   if ((valid_ & kValidOpenGlBuffer) && gl_context_ != nullptr &&
       !gl_context_->IsCurrent() && GlContext::IsAnyContextCurrent()) {
@@ -448,6 +448,7 @@ void Tensor::Move(Tensor* src) {
   element_type_ = src->element_type();
   src->element_type_ = ElementType::kNone;  // Mark as invalidated.
   cpu_buffer_ = std::exchange(src->cpu_buffer_, nullptr);
+  cpu_buffer_pool_ = std::move(src->cpu_buffer_pool_);
   ahwb_tracking_key_ = src->ahwb_tracking_key_;
   mtl_resources_ = std::move(src->mtl_resources_);
   MoveAhwbStuff(src);
@@ -479,6 +480,9 @@ Tensor::Tensor(ElementType element_type, const Shape& shape,
       shape_(shape),
       memory_alignment_(memory_alignment),
       mtl_resources_(std::make_unique<MtlResources>()) {
+  if (memory_manager) {
+    cpu_buffer_pool_ = memory_manager->GetCpuBufferPool();
+  }
 #ifdef MEDIAPIPE_TENSOR_USE_AHWB
   if (memory_manager) {
     hardware_buffer_pool_ = memory_manager->GetAndroidHardwareBufferPool();
@@ -493,6 +497,9 @@ Tensor::Tensor(ElementType element_type, const Shape& shape,
       quantization_parameters_(quantization_parameters),
       memory_alignment_(memory_alignment),
       mtl_resources_(std::make_unique<MtlResources>()) {
+  if (memory_manager) {
+    cpu_buffer_pool_ = memory_manager->GetCpuBufferPool();
+  }
 #ifdef MEDIAPIPE_TENSOR_USE_AHWB
   if (memory_manager) {
     hardware_buffer_pool_ = memory_manager->GetAndroidHardwareBufferPool();
@@ -702,7 +709,7 @@ absl::Status Tensor::ReadBackGpuToCpu() const {
 }
 
 Tensor::CpuReadView Tensor::GetCpuReadView() const {
-  auto lock = std::make_unique<absl::MutexLock>(&view_mutex_);
+  tensor_internal::ViewLock lock(&view_mutex_);
   ABSL_LOG_IF(FATAL, valid_ == kValidNone)
       << "Tensor must be written prior to read from.";
 #ifdef MEDIAPIPE_TENSOR_USE_AHWB
@@ -727,7 +734,7 @@ Tensor::CpuReadView Tensor::GetCpuReadView() const {
 
 Tensor::CpuWriteView Tensor::GetCpuWriteView(
     uint64_t source_location_hash) const {
-  auto lock = std::make_unique<absl::MutexLock>(&view_mutex_);
+  tensor_internal::ViewLock lock(&view_mutex_);
   TrackAhwbUsage(source_location_hash);
   ABSL_CHECK_OK(AllocateCpuBuffer()) << "AllocateCpuBuffer failed.";
   if (valid_ != 0) {
@@ -767,7 +774,11 @@ absl::Status Tensor::AllocateCpuBuffer() const {
     // memory page which should match common alignment requirements.
     cpu_buffer_ = AllocateVirtualMemory(bytes());
 #else
-    if (memory_alignment_ > 0) {
+    if (cpu_buffer_pool_) {
+      // Pooled buffers are padded to multiples of memory_alignment_, which
+      // also covers the TfLite custom allocation requirement below.
+      cpu_buffer_ = cpu_buffer_pool_->Allocate(bytes(), memory_alignment_);
+    } else if (memory_alignment_ > 0) {
       // TODO b/339271330 - Investigate how aligned memory performs in
       // MP WebAssembly targets.
       // TfLite custom allocation requires at least memory_alignment_ bytes.
@@ -789,7 +800,9 @@ void Tensor::FreeCpuBuffer() const {
 #if MEDIAPIPE_METAL_ENABLED
   free(cpu_buffer_);
 #else
-  if (memory_alignment_ > 0) {
+  if (cpu_buffer_pool_) {
+    cpu_buffer_pool_->Release(cpu_buffer_, bytes(), memory_alignment_);
+  } else if (memory_alignment_ > 0) {
     aligned_free(cpu_buffer_);
   } else {
     free(cpu_buffer_);
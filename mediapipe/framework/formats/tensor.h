@@ -26,9 +26,11 @@
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/functional/any_invocable.h"
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/formats/cpu_buffer_pool.h"
 #include "mediapipe/framework/formats/tensor/internal.h"
 #include "mediapipe/framework/memory_manager.h"
 // Exports MEDIAPIPE_TENSOR_USE_AHWB macro.
@@ -75,6 +77,28 @@
 #endif  // MEDIAPIPE_USE_WEBGPU
 
 namespace mediapipe {
+namespace tensor_internal {
+
+// Holds the view mutex of a Tensor locked for the lifetime of a view. It is
+// stored inline in the view, so acquiring a view does not allocate.
+class ViewLock {
+ public:
+  explicit ViewLock(absl::Mutex* mutex) ABSL_NO_THREAD_SAFETY_ANALYSIS
+      : mutex_(mutex) {
+    mutex_->Lock();
+  }
+  ViewLock(ViewLock&& src) : mutex_(std::exchange(src.mutex_, nullptr)) {}
+  ViewLock& operator=(ViewLock&&) = delete;
+  ~ViewLock() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    if (mutex_) mutex_->Unlock();
+  }
+
+ private:
+  absl::Mutex* mutex_;
+};
+
+}  // namespace tensor_internal
+
 // Tensor is a container of multi-dimensional data that supports sharing the
 // content across different backends and APIs, currently: CPU / Metal / OpenGL.
 // Texture2DView is limited to 4 dimensions.
@@ -108,9 +132,8 @@ class Tensor {
     View& operator=(const View&) = delete;
 
    protected:
-    explicit View(std::unique_ptr<absl::MutexLock>&& lock)
-        : lock_(std::move(lock)) {}
-    std::unique_ptr<absl::MutexLock> lock_;
+    explicit View(tensor_internal::ViewLock&& lock) : lock_(std::move(lock)) {}
+    tensor_internal::ViewLock lock_;
   };
 
  public:
@@ -158,6 +181,8 @@ class Tensor {
   // memory_alignment must be power of 2, i.e. 2, 4, 8, 16, 64, etc.
   // If memory_alignment is 0, then the buffer will not be padded.
   // Note that memory_alignment is only applied to CPU storage (includes AHWBs).
+  // If memory_manager is set, the CPU storage is taken from its CpuBufferPool
+  // and returned to it when the tensor is destroyed.
   Tensor(ElementType element_type, const Shape& shape,
          MemoryManager* memory_manager = nullptr, int memory_alignment = 0);
   Tensor(ElementType element_type, const Shape& shape,
@@ -191,7 +216,7 @@ class Tensor {
 
    protected:
     friend class Tensor;
-    CpuView(T* buffer, std::unique_ptr<absl::MutexLock>&& lock,
+    CpuView(T* buffer, tensor_internal::ViewLock&& lock,
             absl::AnyInvocable<void()> release_callback = nullptr)
         : View(std::move(lock)),
           buffer_(buffer),
@@ -268,7 +293,7 @@ class Tensor {
     AHardwareBufferView(HardwareBuffer* hardware_buffer,
                         UniqueFd* write_complete_fence_fd,
                         TensorAhwbUsage* ahwb_usage,
-                        std::unique_ptr<absl::MutexLock>&& lock,
+                        tensor_internal::ViewLock&& lock,
                         bool is_write_view)
         : View(std::move(lock)),
           hardware_buffer_(hardware_buffer),
@@ -310,7 +335,7 @@ class Tensor {
 
    protected:
     friend class Tensor;
-    OpenGlTexture2dView(GLuint name, std::unique_ptr<absl::MutexLock>&& lock)
+    OpenGlTexture2dView(GLuint name, tensor_internal::ViewLock&& lock)
         : View(std::move(lock)), name_(name) {}
     GLuint name_;
   };
@@ -334,7 +359,7 @@ class Tensor {
     friend class Tensor;
 
     WebGpuTexture2dView(wgpu::Texture name,
-                        std::unique_ptr<absl::MutexLock>&& lock)
+                        tensor_internal::ViewLock&& lock)
         : View(std::move(lock)), name_(name) {}
 
     wgpu::Texture name_;
@@ -379,7 +404,7 @@ class Tensor {
 
     // NOTE: Update move constructor if adding params.
     OpenGlBufferView(bool is_write_view, GLuint name,
-                     std::unique_ptr<absl::MutexLock>&& lock, GLsync* ssbo_read,
+                     tensor_internal::ViewLock&& lock, GLsync* ssbo_read,
                      GlContext* gl_context,
                      std::shared_ptr<GlSyncPoint>* gl_write_read_sync)
         : View(std::move(lock)),
@@ -513,6 +538,9 @@ class Tensor {
   mutable absl::Mutex view_mutex_;
 
   mutable void* cpu_buffer_ = nullptr;
+  // Pools the CPU buffers of tensors created with a MemoryManager. Holding the
+  // shared_ptr to the pool ensures it outlives cpu_buffer_.
+  std::shared_ptr<CpuBufferPool> cpu_buffer_pool_;
   absl::Status AllocateCpuBuffer() const;
   void FreeCpuBuffer() const;
   // Forward declaration of the MtlResources provides compile-time verification
@@ -0,0 +1,101 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Measures the cost of acquiring and releasing CPU views of a Tensor, and of
+// allocating CPU tensors with and without a MemoryManager.
+//
+// $ bazel run -c opt mediapipe/framework/formats:tensor_benchmark
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "benchmark/benchmark.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/memory_manager.h"
+
+namespace mediapipe {
+namespace {
+
+void BM_GetCpuReadView(benchmark::State& state) {
+  Tensor tensor(Tensor::ElementType::kFloat32, Tensor::Shape{1, 16});
+  tensor.GetCpuWriteView().buffer<float>()[0] = 1.0f;
+  for (auto _ : state) {
+    auto view = tensor.GetCpuReadView();
+    benchmark::DoNotOptimize(view.buffer<float>());
+  }
+}
+BENCHMARK(BM_GetCpuReadView);
+
+// Reads all tensors of an inference output the way TensorsToDetections and
+// TensorsToLandmarks do: one read view per tensor per frame.
+void BM_GetCpuReadViewsOfOutputs(benchmark::State& state) {
+  std::vector<Tensor> tensors;
+  for (int i = 0; i < state.range(0); ++i) {
+    tensors.emplace_back(Tensor::ElementType::kFloat32, Tensor::Shape{1, 16});
+    tensors.back().GetCpuWriteView().buffer<float>()[0] = i;
+  }
+  for (auto _ : state) {
+    for (const Tensor& tensor : tensors) {
+      auto view = tensor.GetCpuReadView();
+      benchmark::DoNotOptimize(view.buffer<float>());
+    }
+  }
+}
+BENCHMARK(BM_GetCpuReadViewsOfOutputs)->Arg(2)->Arg(4);
+
+// Baseline: the heap-allocated lock that views used to own.
+void BM_HeapAllocatedMutexLock(benchmark::State& state) {
+  absl::Mutex mutex;
+  for (auto _ : state) {
+    auto lock = std::make_unique<absl::MutexLock>(&mutex);
+    benchmark::DoNotOptimize(lock.get());
+  }
+}
+BENCHMARK(BM_HeapAllocatedMutexLock);
+
+// Allocates and fills a 1xNxNx3 float tensor per iteration, as the converter
+// calculators do for every frame.
+// Args: tensor side.
+void RunTensorAllocation(benchmark::State& state,
+                         MemoryManager* memory_manager) {
+  const int side = state.range(0);
+  for (auto _ : state) {
+    Tensor tensor(Tensor::ElementType::kFloat32,
+                  Tensor::Shape{1, side, side, 3}, memory_manager,
+                  /*memory_alignment=*/64);
+    auto view = tensor.GetCpuWriteView();
+    std::memset(view.buffer<float>(), 0, tensor.bytes());
+    benchmark::DoNotOptimize(view.buffer<float>());
+  }
+  state.SetBytesProcessed(state.iterations() * side * side * 3 *
+                          sizeof(float));
+}
+
+void BM_AllocateTensor(benchmark::State& state) {
+  RunTensorAllocation(state, /*memory_manager=*/nullptr);
+}
+BENCHMARK(BM_AllocateTensor)->Arg(32)->Arg(256)->Arg(1024);
+
+void BM_AllocateTensorWithMemoryManager(benchmark::State& state) {
+  MemoryManager memory_manager;
+  RunTensorAllocation(state, &memory_manager);
+}
+BENCHMARK(BM_AllocateTensorWithMemoryManager)->Arg(32)->Arg(256)->Arg(1024);
+
+}  // namespace
+}  // namespace mediapipe
+
+BENCHMARK_MAIN();
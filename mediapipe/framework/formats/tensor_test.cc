@@ -5,6 +5,7 @@
 #include <utility>
 #include <vector>
 
+#include "mediapipe/framework/memory_manager.h"
 #include "mediapipe/framework/port.h"  // IWYU pragma: keep
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
@@ -71,6 +72,27 @@ TEST(Cpu, TestAlignedMemoryAllocation) {
   }
 }
 
+TEST(Cpu, TestPooledMemoryAllocation) {
+  MemoryManager memory_manager;
+  void* p1;
+  {
+    Tensor t1(Tensor::ElementType::kFloat32, Tensor::Shape{4, 3, 2, 3},
+              &memory_manager, /*memory_alignment=*/64);
+    auto v1 = t1.GetCpuWriteView();
+    p1 = v1.buffer<void>();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p1) % 64, 0);
+    EXPECT_EQ(memory_manager.GetCpuBufferPool()->GetStats().num_in_use, 1);
+  }
+  EXPECT_EQ(memory_manager.GetCpuBufferPool()->GetStats().num_available, 1);
+
+  // The buffer is moved along with the tensor and reused once it is released.
+  Tensor t2(Tensor::ElementType::kFloat32, Tensor::Shape{4, 3, 2, 3},
+            &memory_manager, /*memory_alignment=*/64);
+  Tensor t3(std::move(t2));
+  EXPECT_EQ(t3.GetCpuWriteView().buffer<void>(), p1);
+  EXPECT_EQ(memory_manager.GetCpuBufferPool()->GetStats().num_allocations, 1);
+}
+
 TEST(Cpu, TestTensorMove) {
   Tensor t1(Tensor::ElementType::kFloat32, Tensor::Shape{4, 3, 2, 3},
             Tensor::QuantizationParameters(0.5, 127));
@@ -98,6 +120,18 @@ TEST(Cpu, TestViewMove) {
   EXPECT_EQ(v1.buffer<float>(), nullptr);  // NOLINT
 }
 
+TEST(Cpu, TestMovedViewReleasesLockOnce) {
+  Tensor t(Tensor::ElementType::kFloat32, Tensor::Shape{2});
+  {
+    auto v1 = t.GetCpuWriteView();
+    Tensor::CpuWriteView v2(std::move(v1));
+    v2.buffer<float>()[0] = 1.0f;
+  }
+  // The lock was released by v2 only, so the tensor can be viewed again.
+  EXPECT_EQ(t.GetCpuReadView().buffer<float>()[0], 1.0f);
+  EXPECT_EQ(t.GetCpuReadView().buffer<float>()[0], 1.0f);
+}
+
 }  // namespace mediapipe
 
 int main(int argc, char** argv) {
@@ -0,0 +1,34 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_IMAGE_FRAME_POOL_SERVICE_H_
+#define MEDIAPIPE_FRAMEWORK_IMAGE_FRAME_POOL_SERVICE_H_
+
+#include "mediapipe/framework/formats/image_multi_pool.h"
+#include "mediapipe/framework/graph_service.h"
+
+namespace mediapipe {
+
+// Graph service to draw CPU output frames from pools shared by all calculators
+// of a graph, see ImageMultiPool::GetImageFrame. Calculators request it with
+// `cc->UseService(kImageFramePoolService).Optional()`, and allocate their
+// outputs as before unless the graph opts in by setting the service object
+// with CalculatorGraph::SetServiceObject. The object also reports the reuse
+// statistics.
+inline constexpr GraphService<ImageMultiPool> kImageFramePoolService(
+    "ImageFramePoolService");
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_IMAGE_FRAME_POOL_SERVICE_H_
@@ -15,6 +15,7 @@
 #include "mediapipe/framework/input_stream_handler.h"
 
 #include <functional>
+#include <list>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -26,6 +27,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/substitute.h"
+#include "absl/types/span.h"
 #include "mediapipe/framework/collection_item_id.h"
 #include "mediapipe/framework/mediapipe_profiling.h"
 #include "mediapipe/framework/port/ret_check.h"
@@ -254,7 +256,8 @@ bool InputStreamHandler::ScheduleInvocations(int max_allowance,
       }
       mediapipe::LogEvent(calculator_context->GetProfilingContext(),
                           TraceEvent(TraceEvent::READY_FOR_PROCESS)
-                              .set_node_id(calculator_context->NodeId()));
+                              .set_node_id(calculator_context->NodeId())
+                              .set_packet_ts(min_stream_timestamp));
     } else {
       ABSL_CHECK(node_readiness == NodeReadiness::kReadyForClose);
       // If any parallel invocations are in progress or a calculator context has
@@ -315,13 +318,15 @@ void LogQueuedPackets(CalculatorContext* context, InputStreamManager* stream,
   }
 }
 
-void InputStreamHandler::AddPackets(CollectionItemId id,
-                                    const std::list<Packet>& packets) {
-  LogQueuedPackets(GetCalculatorContext(calculator_context_manager_),
-                   input_stream_managers_.Get(id), packets.back());
+template <typename AddOrMoveFn>
+void InputStreamHandler::AddOrMovePackets(CollectionItemId id,
+                                          const Packet& queue_tail,
+                                          AddOrMoveFn add_or_move) {
+  InputStreamManager* stream = input_stream_managers_.Get(id);
+  LogQueuedPackets(GetCalculatorContext(calculator_context_manager_), stream,
+                   queue_tail);
   bool notify = false;
-  absl::Status result =
-      input_stream_managers_.Get(id)->AddPackets(packets, &notify);
+  absl::Status result = add_or_move(stream, &notify);
   if (!result.ok()) {
     error_callback_(result);
   }
@@ -330,19 +335,36 @@ void InputStreamHandler::AddPackets(CollectionItemId id,
   }
 }
 
+void InputStreamHandler::AddPackets(CollectionItemId id,
+                                    absl::Span<const Packet> packets) {
+  AddOrMovePackets(id, packets.back(),
+                   [&packets](InputStreamManager* stream, bool* notify) {
+                     return stream->AddPackets(packets, notify);
+                   });
+}
+
+void InputStreamHandler::MovePackets(CollectionItemId id,
+                                     absl::Span<Packet> packets) {
+  AddOrMovePackets(id, packets.back(),
+                   [&packets](InputStreamManager* stream, bool* notify) {
+                     return stream->MovePackets(packets, notify);
+                   });
+}
+
+void InputStreamHandler::AddPackets(CollectionItemId id,
+                                    const std::list<Packet>& packets) {
+  AddOrMovePackets(id, packets.back(),
+                   [&packets](InputStreamManager* stream, bool* notify) {
+                     return stream->AddPackets(packets, notify);
+                   });
+}
+
 void InputStreamHandler::MovePackets(CollectionItemId id,
                                      std::list<Packet>* packets) {
-  LogQueuedPackets(GetCalculatorContext(calculator_context_manager_),
-                   input_stream_managers_.Get(id), packets->back());
-  bool notify = false;
-  absl::Status result =
-      input_stream_managers_.Get(id)->MovePackets(packets, &notify);
-  if (!result.ok()) {
-    error_callback_(result);
-  }
-  if (notify) {
-    notification_();
-  }
+  AddOrMovePackets(id, packets->back(),
+                   [packets](InputStreamManager* stream, bool* notify) {
+                     return stream->MovePackets(packets, notify);
+                   });
 }
 
 void InputStreamHandler::SetNextTimestampBound(CollectionItemId id,
@@ -25,6 +25,7 @@
 #include <vector>
 
 // TODO: Move protos in another CL after the C++ code migration.
+#include "absl/types/span.h"
 #include "mediapipe/framework/calculator_context.h"
 #include "mediapipe/framework/calculator_context_manager.h"
 #include "mediapipe/framework/collection.h"
@@ -134,9 +135,15 @@ class InputStreamHandler {
 
   // Add packets into a particular stream.
   virtual void AddPackets(CollectionItemId id,
-                          const std::list<Packet>& packets);
+                          absl::Span<const Packet> packets);
+
+  // Moves packets into a particular stream. After the move, all packets in
+  // "packets" are empty.
+  virtual void MovePackets(CollectionItemId id, absl::Span<Packet> packets);
 
-  // Moves packets into a particular stream.
+  // Overloads of the above for packets held in a std::list.
+  virtual void AddPackets(CollectionItemId id,
+                          const std::list<Packet>& packets);
   virtual void MovePackets(CollectionItemId id, std::list<Packet>* packets);
 
   // Sets next timestamp bound in a particular stream.
@@ -296,6 +303,13 @@ class InputStreamHandler {
   std::function<void(absl::Status)> error_callback_;
 
  private:
+  // Logs "queue_tail", calls "add_or_move" with the stream manager of "id"
+  // and reports the result. Shared by the AddPackets() and MovePackets()
+  // overloads, so that none of them copies the packets into a temporary.
+  template <typename AddOrMoveFn>
+  void AddOrMovePackets(CollectionItemId id, const Packet& queue_tail,
+                        AddOrMoveFn add_or_move);
+
   // Indicates when to fill the input set. If true, every input set will be
   // prepared in FinalizeInputSet(). Otherwise, the input sets will be filled
   // in ScheduleInvocations() in the scheduling phase.
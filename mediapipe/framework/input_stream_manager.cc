@@ -14,6 +14,7 @@
 
 #include "mediapipe/framework/input_stream_manager.h"
 
+#include <algorithm>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -97,6 +98,16 @@ absl::Status InputStreamManager::MovePackets(std::list<Packet>* container,
   return AddOrMovePacketsInternal<std::list<Packet>&>(*container, notify);
 }
 
+absl::Status InputStreamManager::AddPackets(absl::Span<const Packet> packets,
+                                            bool* notify) {
+  return AddOrMovePacketsInternal<absl::Span<const Packet>>(packets, notify);
+}
+
+absl::Status InputStreamManager::MovePackets(absl::Span<Packet> packets,
+                                             bool* notify) {
+  return AddOrMovePacketsInternal<absl::Span<Packet>>(packets, notify);
+}
+
 template <typename Container>
 absl::Status InputStreamManager::AddOrMovePacketsInternal(Container container,
                                                           bool* notify) {
@@ -176,10 +187,10 @@ absl::Status InputStreamManager::AddOrMovePacketsInternal(Container container,
       VLOG(3) << "Input stream:" << name_
               << " has added packet at time: " << packet.Timestamp();
       if (std::is_const<
-              typename std::remove_reference<Container>::type>::value) {
-        queue_.emplace_back(packet);
+              typename std::remove_reference<decltype(packet)>::type>::value) {
+        queue_.push_back(packet);
       } else {
-        queue_.emplace_back(std::move(packet));
+        queue_.push_back(std::move(packet));
       }
     }
     queue_became_full = (!was_queue_full && max_queue_size_ != -1 &&
@@ -375,6 +386,9 @@ void InputStreamManager::SetMaxQueueSize(int max_queue_size) {
     was_full = (max_queue_size_ != -1 && queue_.size() >= max_queue_size_);
     max_queue_size_ = max_queue_size;
     is_full = (max_queue_size_ != -1 && queue_.size() >= max_queue_size_);
+    if (max_queue_size_ > 0) {
+      queue_.Reserve(std::min(max_queue_size_, kMaxPreallocatedQueueCapacity));
+    }
   }
 
   // QueueSizeCallback is called with no mutexes held.
@@ -387,6 +401,13 @@ void InputStreamManager::SetMaxQueueSize(int max_queue_size) {
   }
 }
 
+void InputStreamManager::ReserveQueueCapacity(int capacity) {
+  absl::MutexLock lock(&stream_mutex_);
+  if (capacity > 0) {
+    queue_.Reserve(capacity);
+  }
+}
+
 bool InputStreamManager::IsFull() const {
   absl::MutexLock lock(&stream_mutex_);
   return max_queue_size_ != -1 && queue_.size() >= max_queue_size_;
@@ -397,7 +418,8 @@ Timestamp InputStreamManager::GetMinTimestampAmongNLatest(int n) const {
   if (queue_.empty()) {
     return Timestamp::Unset();
   }
-  return (queue_.cend() - std::min((size_t)n, queue_.size()))->Timestamp();
+  return queue_[queue_.size() - std::min((size_t)n, queue_.size())]
+      .Timestamp();
 }
 
 void InputStreamManager::ErasePacketsEarlierThan(Timestamp timestamp) {
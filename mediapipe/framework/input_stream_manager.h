@@ -16,7 +16,6 @@
 #define MEDIAPIPE_FRAMEWORK_INPUT_STREAM_MANAGER_H_
 
 #include <cstdint>
-#include <deque>
 #include <functional>
 #include <list>
 #include <string>
@@ -24,6 +23,8 @@
 #include "absl/base/thread_annotations.h"
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "mediapipe/framework/deps/ring_buffer.h"
 #include "mediapipe/framework/packet.h"
 #include "mediapipe/framework/packet_type.h"
 #include "mediapipe/framework/timestamp.h"
@@ -98,6 +99,13 @@ class InputStreamManager {
   absl::Status MovePackets(std::list<Packet>* container, bool* notify)
       ABSL_LOCKS_EXCLUDED(stream_mutex_);
 
+  // Same as above, for a contiguous batch of packets. This is the form used by
+  // the framework to propagate packets from an OutputStreamShard.
+  absl::Status AddPackets(absl::Span<const Packet> packets, bool* notify)
+      ABSL_LOCKS_EXCLUDED(stream_mutex_);
+  absl::Status MovePackets(absl::Span<Packet> packets, bool* notify)
+      ABSL_LOCKS_EXCLUDED(stream_mutex_);
+
   // Closes the input stream.  This function can be called multiple times.
   void Close() ABSL_LOCKS_EXCLUDED(stream_mutex_);
 
@@ -159,8 +167,14 @@ class InputStreamManager {
   // Sets the maximum queue size for the stream. Used to determine when the
   // callbacks for becomes_full and becomes_not_full should be invoked. A value
   // of -1 means that there is no maximum queue size.
+  // The packet queue is preallocated to hold max_queue_size packets, up to
+  // kMaxPreallocatedQueueCapacity.
   void SetMaxQueueSize(int max_queue_size) ABSL_LOCKS_EXCLUDED(stream_mutex_);
 
+  // Preallocates the packet queue to hold at least "capacity" packets without
+  // allocating. Unlike SetMaxQueueSize(), this does not affect throttling.
+  void ReserveQueueCapacity(int capacity) ABSL_LOCKS_EXCLUDED(stream_mutex_);
+
   // If there are equal to or more than n packets in the queue, this function
   // returns the min timestamp of among the latest n packets of the queue.  If
   // there are fewer than n packets in the queue, this function returns
@@ -184,13 +198,18 @@ class InputStreamManager {
   // Adds or moves a list of timestamped packets. Sets "notify" to true if the
   // queue becomes non-empty. Returns an error if the packets have errors. Does
   // nothing if the input stream is closed.
-  // If the caller is AddPackets(), Container must be const reference.
-  // Otherwise, the caller must be MovePackets() and Container should be
-  // non-const reference.
+  // If the caller is AddPackets(), iterating over Container must yield const
+  // packets (e.g. a const reference or absl::Span<const Packet>). Otherwise,
+  // the caller must be MovePackets() and the packets are moved from.
   template <typename Container>
   absl::Status AddOrMovePacketsInternal(Container container, bool* notify)
       ABSL_LOCKS_EXCLUDED(stream_mutex_);
 
+  // Upper bound on the capacity preallocated by SetMaxQueueSize(), so that
+  // a large max_queue_size used only as a throttling threshold does not
+  // allocate memory up front.
+  static constexpr int kMaxPreallocatedQueueCapacity = 1024;
+
   // Returns true if the next timestamp bound reaches Timestamp::Done().
   bool IsDone() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(stream_mutex_);
 
@@ -198,7 +217,7 @@ class InputStreamManager {
   Timestamp MinTimestampOrBoundHelper() const;
 
   mutable absl::Mutex stream_mutex_;
-  std::deque<Packet> queue_ ABSL_GUARDED_BY(stream_mutex_);
+  RingBuffer<Packet> queue_ ABSL_GUARDED_BY(stream_mutex_);
   // The number of packets added to queue_.  Used to verify a packet at
   // Timestamp::PostStream() is the only Packet in the stream.
   int64_t num_packets_added_ ABSL_GUARDED_BY(stream_mutex_);
@@ -0,0 +1,137 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Measures the latency of a packet hop from an OutputStreamShard through
+// OutputStreamManager::PropagateUpdatesToMirrors() into the InputStreamManager
+// of every mirror, and back out of the input queue.
+//
+// Arguments: packets output per propagation, number of mirrors.
+//
+// $ bazel run -c opt \
+//   mediapipe/framework:input_stream_manager_benchmark
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/status/status.h"
+#include "benchmark/benchmark.h"
+#include "mediapipe/framework/input_stream_handler.h"
+#include "mediapipe/framework/input_stream_manager.h"
+#include "mediapipe/framework/mediapipe_options.pb.h"
+#include "mediapipe/framework/output_stream_manager.h"
+#include "mediapipe/framework/output_stream_shard.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/packet_type.h"
+#include "mediapipe/framework/timestamp.h"
+#include "mediapipe/framework/tool/tag_map_helper.h"
+
+namespace mediapipe {
+namespace {
+
+// An output stream with "num_mirrors" downstream input streams, each read by
+// its own DefaultInputStreamHandler.
+class PacketHopFixture {
+ public:
+  explicit PacketHopFixture(int num_mirrors) {
+    packet_type_.Set<int>();
+    ABSL_CHECK_OK(output_stream_manager_.Initialize("out", &packet_type_));
+    output_stream_manager_.PrepareForRun([](absl::Status status) {
+      ABSL_CHECK_OK(status);
+    });
+    output_stream_shard_.SetSpec(output_stream_manager_.Spec());
+    output_stream_manager_.ResetShard(&output_stream_shard_);
+
+    std::shared_ptr<tool::TagMap> tag_map = tool::CreateTagMap(1).value();
+    input_stream_managers_ =
+        std::make_unique<InputStreamManager[]>(num_mirrors);
+    for (int i = 0; i < num_mirrors; ++i) {
+      auto handler = InputStreamHandlerRegistry::CreateByName(
+          "DefaultInputStreamHandler", tag_map, /*cc_manager=*/nullptr,
+          MediaPipeOptions(), /*calculator_run_in_parallel=*/false);
+      ABSL_CHECK_OK(handler.status());
+      input_stream_handlers_.push_back(std::move(handler).value());
+      InputStreamHandler* input_stream_handler =
+          input_stream_handlers_.back().get();
+      ABSL_CHECK_OK(input_stream_managers_[i].Initialize(
+          "in", &packet_type_, /*back_edge=*/false));
+      ABSL_CHECK_OK(input_stream_handler->InitializeInputStreamManagers(
+          &input_stream_managers_[i]));
+      output_stream_manager_.AddMirror(input_stream_handler,
+                                       tag_map->BeginId());
+      input_stream_handler->PrepareForRun(
+          /*headers_ready_callback=*/[] {}, /*notification_callback=*/[] {},
+          /*schedule_callback=*/[](CalculatorContext*) {},
+          /*error_callback=*/[](absl::Status status) {
+            ABSL_CHECK_OK(status);
+          });
+      input_stream_handler->SetQueueSizeCallbacks(
+          [](InputStreamManager*, bool*) {}, [](InputStreamManager*, bool*) {});
+      input_stream_handler->SetMaxQueueSize(100);
+    }
+    num_mirrors_ = num_mirrors;
+  }
+
+  // Outputs "batch_size" packets, propagates them, and consumes them from
+  // every input stream.
+  void Hop(int batch_size) {
+    const int64_t first = next_timestamp_;
+    for (int i = 0; i < batch_size; ++i) {
+      output_stream_shard_.AddPacket(packet_.At(Timestamp(next_timestamp_++)));
+    }
+    const Timestamp bound = output_stream_manager_.ComputeOutputTimestampBound(
+        output_stream_shard_, Timestamp(first));
+    output_stream_manager_.PropagateUpdatesToMirrors(bound,
+                                                     &output_stream_shard_);
+    output_stream_manager_.ResetShard(&output_stream_shard_);
+    for (int i = 0; i < num_mirrors_; ++i) {
+      int num_packets_dropped;
+      bool stream_is_done;
+      for (int64_t t = first; t < next_timestamp_; ++t) {
+        benchmark::DoNotOptimize(input_stream_managers_[i].PopPacketAtTimestamp(
+            Timestamp(t), &num_packets_dropped, &stream_is_done));
+      }
+    }
+  }
+
+ private:
+  PacketType packet_type_;
+  OutputStreamManager output_stream_manager_;
+  OutputStreamShard output_stream_shard_;
+  std::vector<std::unique_ptr<InputStreamHandler>> input_stream_handlers_;
+  std::unique_ptr<InputStreamManager[]> input_stream_managers_;
+  int num_mirrors_ = 0;
+  Packet packet_ = MakePacket<int>(0);
+  int64_t next_timestamp_ = 0;
+};
+
+void BM_PacketHop(benchmark::State& state) {
+  const int batch_size = state.range(0);
+  PacketHopFixture fixture(/*num_mirrors=*/state.range(1));
+  for (auto _ : state) {
+    fixture.Hop(batch_size);
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+BENCHMARK(BM_PacketHop)
+    ->ArgNames({"batch", "mirrors"})
+    ->ArgsProduct({{1, 8, 64}, {1, 4}});
+
+}  // namespace
+}  // namespace mediapipe
+
+BENCHMARK_MAIN();
@@ -14,9 +14,13 @@
 
 #include "mediapipe/framework/input_stream_manager.h"
 
+#include <cstdint>
+#include <list>
 #include <memory>
+#include <vector>
 
 #include "absl/memory/memory.h"
+#include "absl/types/span.h"
 #include "mediapipe/framework/input_stream_shard.h"
 #include "mediapipe/framework/lifetime_tracker.h"
 #include "mediapipe/framework/packet.h"
@@ -125,6 +129,61 @@ TEST_F(InputStreamManagerTest, MovePackets) {
   }
 }
 
+TEST_F(InputStreamManagerTest, AddPacketsFromSpan) {
+  std::vector<Packet> packets;
+  packets.push_back(MakePacket<std::string>("packet 1").At(Timestamp(10)));
+  packets.push_back(MakePacket<std::string>("packet 2").At(Timestamp(20)));
+
+  MP_ASSERT_OK(input_stream_manager_->AddPackets(absl::MakeConstSpan(packets),
+                                                 &notify_));  // Notification
+  EXPECT_TRUE(notify_);
+  EXPECT_EQ(2, input_stream_manager_->QueueSize());
+  for (const Packet& original_packet : packets) {
+    EXPECT_FALSE(original_packet.IsEmpty());
+  }
+}
+
+TEST_F(InputStreamManagerTest, MovePacketsFromSpan) {
+  std::vector<Packet> packets;
+  packets.push_back(MakePacket<std::string>("packet 1").At(Timestamp(10)));
+  packets.push_back(MakePacket<std::string>("packet 2").At(Timestamp(20)));
+
+  MP_ASSERT_OK(input_stream_manager_->MovePackets(absl::MakeSpan(packets),
+                                                  &notify_));  // Notification
+  EXPECT_TRUE(notify_);
+  EXPECT_EQ(2, input_stream_manager_->QueueSize());
+  for (const Packet& original_packet : packets) {
+    EXPECT_TRUE(original_packet.IsEmpty());
+  }
+  EXPECT_EQ(Timestamp(10), input_stream_manager_->QueueHead().Timestamp());
+}
+
+// The queue keeps packets in order when it wraps around and when it grows
+// beyond its preallocated capacity.
+TEST_F(InputStreamManagerTest, QueueGrowsBeyondReservedCapacity) {
+  input_stream_manager_->ReserveQueueCapacity(4);
+  int64_t next_timestamp = 0;
+  for (int round = 0; round < 3; ++round) {
+    std::vector<Packet> packets;
+    for (int i = 0; i < 3; ++i) {
+      packets.push_back(MakePacket<std::string>("packet")
+                            .At(Timestamp(++next_timestamp)));
+    }
+    MP_ASSERT_OK(
+        input_stream_manager_->MovePackets(absl::MakeSpan(packets), &notify_));
+  }
+  EXPECT_EQ(9, input_stream_manager_->QueueSize());
+  EXPECT_EQ(Timestamp(7),
+            input_stream_manager_->GetMinTimestampAmongNLatest(3));
+  for (int64_t expected = 1; expected <= next_timestamp; ++expected) {
+    Packet packet = input_stream_manager_->PopPacketAtTimestamp(
+        Timestamp(expected), &num_packets_dropped_, &stream_is_done_);
+    EXPECT_EQ(Timestamp(expected), packet.Timestamp());
+    EXPECT_EQ(0, num_packets_dropped_);
+  }
+  EXPECT_TRUE(input_stream_manager_->IsEmpty());
+}
+
 // InputStreamManager should reject the four timestamps that are not allowed in
 // a stream: Timestamp::Unset(), Timestamp::Unstarted(),
 // Timestamp::OneOverPostStream(), and Timestamp::Done().
@@ -799,9 +858,12 @@ TEST_F(InputStreamManagerTest, InputReleaseTest) {
   };
 
   input_stream_manager_->SetMaxQueueSize(3);
-  MP_ASSERT_OK(input_stream_manager_->AddPackets({new_packet()}, &notify_));
-  MP_ASSERT_OK(input_stream_manager_->AddPackets({new_packet()}, &notify_));
-  MP_ASSERT_OK(input_stream_manager_->AddPackets({new_packet()}, &notify_));
+  MP_ASSERT_OK(input_stream_manager_->AddPackets(
+      std::list<Packet>{new_packet()}, &notify_));
+  MP_ASSERT_OK(input_stream_manager_->AddPackets(
+      std::list<Packet>{new_packet()}, &notify_));
+  MP_ASSERT_OK(input_stream_manager_->AddPackets(
+      std::list<Packet>{new_packet()}, &notify_));
   EXPECT_EQ(3, tracker.live_count());
 
   popped_packet_ = input_stream_manager_->PopPacketAtTimestamp(
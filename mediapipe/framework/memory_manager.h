@@ -16,6 +16,7 @@
 
 #include <memory>
 
+#include "mediapipe/framework/formats/cpu_buffer_pool.h"
 // Defines MEDIAPIPE_TENSOR_USE_AHWB
 #include "mediapipe/framework/port.h"
 
@@ -52,14 +53,29 @@ namespace mediapipe {
 // 3) Pass Calculator::memory_manager_ to the Tensor class constructor:
 //       Tensor tensor(Tensor::ElementType::kFloat32,
 //                     Tensor::Shape{kTensorSize}, &memory_manager_);
+//
+// The CPU storage of such tensors is taken from, and returned to, the
+// CpuBufferPool on destruction.
 class MemoryManager {
  public:
-  MemoryManager() {
+  MemoryManager() : cpu_buffer_pool_(std::make_shared<CpuBufferPool>()) {
+#ifdef MEDIAPIPE_TENSOR_USE_AHWB
+    hardware_buffer_pool_ = std::make_shared<HardwareBufferPool>();
+#endif
+  }
+
+  explicit MemoryManager(const CpuBufferPoolOptions& cpu_buffer_pool_options)
+      : cpu_buffer_pool_(
+            std::make_shared<CpuBufferPool>(cpu_buffer_pool_options)) {
 #ifdef MEDIAPIPE_TENSOR_USE_AHWB
     hardware_buffer_pool_ = std::make_shared<HardwareBufferPool>();
 #endif
   }
 
+  std::shared_ptr<CpuBufferPool> GetCpuBufferPool() const {
+    return cpu_buffer_pool_;
+  }
+
 #ifdef MEDIAPIPE_TENSOR_USE_AHWB
   std::shared_ptr<HardwareBufferPool> GetAndroidHardwareBufferPool() const {
     return hardware_buffer_pool_;
@@ -68,10 +84,12 @@ class MemoryManager {
 
 #ifdef MEDIAPIPE_TENSOR_USE_AHWB
   explicit MemoryManager(const MultiPoolOptions& options)
-      : hardware_buffer_pool_(std::make_shared<HardwareBufferPool>(options)) {}
+      : cpu_buffer_pool_(std::make_shared<CpuBufferPool>()),
+        hardware_buffer_pool_(std::make_shared<HardwareBufferPool>(options)) {}
 #endif
 
  private:
+  std::shared_ptr<CpuBufferPool> cpu_buffer_pool_;
 #ifdef MEDIAPIPE_TENSOR_USE_AHWB
   std::shared_ptr<HardwareBufferPool> hardware_buffer_pool_;
 #endif
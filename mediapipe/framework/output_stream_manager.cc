@@ -14,11 +14,12 @@
 
 #include "mediapipe/framework/output_stream_manager.h"
 
-#include <list>
+#include <vector>
 
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "mediapipe/framework/input_stream_handler.h"
 #include "mediapipe/framework/port/status_builder.h"
 
@@ -169,7 +170,8 @@ Timestamp OutputStreamManager::ComputeOutputTimestampBound(
 void OutputStreamManager::PropagateUpdatesToMirrors(
     Timestamp next_timestamp_bound, OutputStreamShard* output_stream_shard) {
   ABSL_CHECK(output_stream_shard);
-  std::list<Packet>* packets_to_propagate = output_stream_shard->OutputQueue();
+  std::vector<Packet>* packets_to_propagate =
+      output_stream_shard->OutputQueue();
   {
     if (next_timestamp_bound != Timestamp::Unset()) {
       absl::MutexLock lock(&stream_mutex_);
@@ -196,11 +198,11 @@ void OutputStreamManager::PropagateUpdatesToMirrors(
       // If the stream is the last element in mirrors_, moves packets from
       // output_queue_. Otherwise, copies the packets.
       if (idx == mirror_count - 1) {
-        mirror.input_stream_handler->MovePackets(mirror.id,
-                                                 packets_to_propagate);
+        mirror.input_stream_handler->MovePackets(
+            mirror.id, absl::MakeSpan(*packets_to_propagate));
       } else {
-        mirror.input_stream_handler->AddPackets(mirror.id,
-                                                *packets_to_propagate);
+        mirror.input_stream_handler->AddPackets(
+            mirror.id, absl::MakeConstSpan(*packets_to_propagate));
       }
     }
     if (set_bound) {
@@ -15,8 +15,8 @@
 #ifndef MEDIAPIPE_FRAMEWORK_OUTPUT_STREAM_SHARD_H_
 #define MEDIAPIPE_FRAMEWORK_OUTPUT_STREAM_SHARD_H_
 
-#include <list>
 #include <string>
+#include <vector>
 
 #include "absl/log/absl_check.h"
 #include "mediapipe/framework/output_stream.h"
@@ -106,8 +106,8 @@ class OutputStreamShard : public OutputStream {
   absl::Status AddPacketInternal(T&& packet);
 
   // Returns a pointer to the output queue.
-  std::list<Packet>* OutputQueue() { return &output_queue_; }
-  const std::list<Packet>* OutputQueue() const { return &output_queue_; }
+  std::vector<Packet>* OutputQueue() { return &output_queue_; }
+  const std::vector<Packet>* OutputQueue() const { return &output_queue_; }
 
   // Resets data members.
   void Reset(Timestamp next_timestamp_bound, bool close);
@@ -115,7 +115,9 @@ class OutputStreamShard : public OutputStream {
   // A pointer to the output stream spec object, which is owned by the output
   // stream manager.
   OutputStreamSpec* output_stream_spec_;
-  std::list<Packet> output_queue_;
+  // Packets output since the last propagation. A vector keeps its capacity
+  // across Reset() calls, so steady-state output does not allocate.
+  std::vector<Packet> output_queue_;
   bool closed_;
   Timestamp next_timestamp_bound_;
   // Equal to next_timestamp_bound_ only if the bound has been explicitly set
@@ -39,6 +39,7 @@
 #include "absl/synchronization/mutex.h"
 #include "google/protobuf/message.h"
 #include "google/protobuf/message_lite.h"
+#include "mediapipe/framework/deps/block_pool.h"
 #include "mediapipe/framework/deps/no_destructor.h"
 #include "mediapipe/framework/deps/registration.h"
 #include "mediapipe/framework/port.h"
@@ -60,6 +61,10 @@ class Packet;
 
 namespace packet_internal {
 class HolderBase;
+template <typename T>
+class Holder;
+template <typename T, typename... Args>
+std::shared_ptr<Holder<T>> MakeHolder(Args&&... args);
 
 Packet Create(HolderBase* holder);
 Packet Create(HolderBase* holder, Timestamp timestamp);
@@ -380,7 +385,9 @@ template <typename T,
           typename std::enable_if<!std::is_array<T>::value>::type* = nullptr,
           typename... Args>
 Packet MakePacket(Args&&... args) {  // NOLINT(build/c++11)
-  return Adopt(new T(std::forward<Args>(args)...));
+  return packet_internal::Create(
+      packet_internal::MakeHolder<T>(std::forward<Args>(args)...),
+      Timestamp::Unset());
 }
 
 // Version for arrays. We have to use reinterpret_cast because new T[N]
@@ -420,10 +427,21 @@ std::shared_ptr<const T> SharedPtrWithPacket(const Packet& packet) {
 //// Implementation details.
 namespace packet_internal {
 
-template <typename T>
-class Holder;
 template <typename T>
 class ForeignHolder;
+template <typename T>
+class PooledHolder;
+
+// Payloads up to this size, which are created in place by MakePacket, are
+// stored inline in their holder, in a block from the BlockPool.
+inline constexpr size_t kMaxPooledPayloadSize = 256;
+
+template <typename T>
+inline constexpr bool kUsePooledHolder =
+    !std::is_array<T>::value && !std::is_const<T>::value &&
+    std::is_move_constructible<T>::value &&
+    sizeof(T) <= kMaxPooledPayloadSize &&
+    alignof(T) <= BlockPool::kBlockAlignment;
 
 class HolderBase {
  public:
@@ -467,6 +485,9 @@ class HolderBase {
   GetVectorOfProtoMessageLite() const = 0;
 
   virtual bool HasForeignOwner() const { return false; }
+
+  // True if the payload is stored inside the holder itself.
+  virtual bool HasInlinePayload() const { return false; }
 };
 
 // Two helper functions to get the proto base pointers.
@@ -569,6 +590,11 @@ class Holder : public HolderBase, private HolderPayloadRegistrator<T> {
       return InternalError(
           "Foreign holder can't release data ptr without ownership.");
     }
+    if constexpr (kUsePooledHolder<T>) {
+      if (HasInlinePayload()) {
+        return static_cast<PooledHolder<T>*>(this)->MovePayloadToHeap();
+      }
+    }
     // Casts away constness to make the data mutable after the release.
     std::unique_ptr<T> data_ptr(const_cast<T*>(ptr_));
     ptr_ = nullptr;
@@ -655,6 +681,48 @@ class ForeignHolder : public Holder<T> {
   absl::AnyInvocable<void()> cleanup_;
 };
 
+// Like Holder, but stores the payload inline, and is meant to be allocated
+// together with its shared_ptr control block from the BlockPool (see
+// MakeHolder). A packet created this way costs no system allocation once the
+// pool is warm.
+template <typename T>
+class PooledHolder : public Holder<T> {
+ public:
+  template <typename... Args>
+  explicit PooledHolder(Args&&... args)
+      : Holder<T>(nullptr), payload_(std::forward<Args>(args)...) {
+    this->ptr_ = &payload_;
+  }
+
+  ~PooledHolder() override {
+    // payload_ is destroyed as a member; don't let ~Holder delete it.
+    this->ptr_ = nullptr;
+  }
+
+  bool HasInlinePayload() const final { return true; }
+
+  // Moves the payload into a heap-allocated object, for Holder::Release().
+  // The moved-from payload is destroyed along with the holder.
+  std::unique_ptr<T> MovePayloadToHeap() {
+    return std::make_unique<T>(std::move(payload_));
+  }
+
+ private:
+  T payload_;
+};
+
+// Returns a holder owning a T constructed from "args". Small payloads are
+// stored inline in a pooled allocation; see kUsePooledHolder.
+template <typename T, typename... Args>
+std::shared_ptr<Holder<T>> MakeHolder(Args&&... args) {
+  if constexpr (kUsePooledHolder<T>) {
+    return std::allocate_shared<PooledHolder<T>>(
+        BlockPoolAllocator<PooledHolder<T>>(), std::forward<Args>(args)...);
+  } else {
+    return std::make_shared<Holder<T>>(new T(std::forward<Args>(args)...));
+  }
+}
+
 template <typename T>
 Holder<T>* HolderBase::AsMutable() const {
   if (PayloadIsOfType<T>()) {
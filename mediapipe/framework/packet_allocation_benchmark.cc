@@ -0,0 +1,230 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Counts heap allocations made while creating packets, comparing MakePacket,
+// which stores small payloads in pooled holders, with Adopt(new T), which
+// allocates the payload, the holder and the shared_ptr control block
+// separately. Also counts allocations per frame for a graph that mimics the
+// packet traffic of the hand tracking post-processing subgraphs (detections,
+// ROI rects, landmarks, presence scores and a FINISHED timestamp signal).
+//
+// $ bazel run -c opt \
+//   mediapipe/framework:packet_allocation_benchmark
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "benchmark/benchmark.h"
+#include "mediapipe/framework/api2/node.h"
+#include "mediapipe/framework/api2/port.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/detection.pb.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+
+namespace {
+std::atomic<int64_t> num_allocations{0};
+}  // namespace
+
+void* operator new(size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) throw std::bad_alloc();
+  return ptr;
+}
+void* operator new[](size_t size) { return ::operator new(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+namespace mediapipe {
+namespace {
+
+using ::mediapipe::api2::Input;
+using ::mediapipe::api2::Node;
+using ::mediapipe::api2::Output;
+
+// Reports the average number of allocations per iteration since "start".
+void ReportAllocations(benchmark::State& state, int64_t start,
+                       int64_t items_per_iteration) {
+  const double allocations = num_allocations.load() - start;
+  state.counters["allocs_per_item"] =
+      allocations / (state.iterations() * items_per_iteration);
+}
+
+template <typename T>
+void BM_MakePacket(benchmark::State& state) {
+  const int64_t start = num_allocations.load();
+  for (auto _ : state) {
+    Packet packet = MakePacket<T>().At(Timestamp(1));
+    Packet copy = packet;
+    benchmark::DoNotOptimize(copy);
+  }
+  ReportAllocations(state, start, 1);
+}
+
+template <typename T>
+void BM_AdoptPacket(benchmark::State& state) {
+  const int64_t start = num_allocations.load();
+  for (auto _ : state) {
+    Packet packet = Adopt(new T()).At(Timestamp(1));
+    Packet copy = packet;
+    benchmark::DoNotOptimize(copy);
+  }
+  ReportAllocations(state, start, 1);
+}
+
+BENCHMARK_TEMPLATE(BM_MakePacket, Timestamp);
+BENCHMARK_TEMPLATE(BM_MakePacket, float);
+BENCHMARK_TEMPLATE(BM_MakePacket, NormalizedRect);
+BENCHMARK_TEMPLATE(BM_MakePacket, std::vector<Detection>);
+BENCHMARK_TEMPLATE(BM_AdoptPacket, Timestamp);
+BENCHMARK_TEMPLATE(BM_AdoptPacket, float);
+BENCHMARK_TEMPLATE(BM_AdoptPacket, NormalizedRect);
+BENCHMARK_TEMPLATE(BM_AdoptPacket, std::vector<Detection>);
+
+// Turns palm detections into a hand ROI.
+class DetectionsToRoiNode : public Node {
+ public:
+  static constexpr Input<std::vector<Detection>> kDetections{"DETECTIONS"};
+  static constexpr Output<NormalizedRect> kRoi{"ROI"};
+  MEDIAPIPE_NODE_CONTRACT(kDetections, kRoi);
+
+  absl::Status Process(CalculatorContext* cc) override {
+    const std::vector<Detection>& detections = *kDetections(cc);
+    NormalizedRect roi;
+    if (!detections.empty()) {
+      const auto& box = detections[0].location_data().relative_bounding_box();
+      roi.set_x_center(box.xmin() + box.width() / 2);
+      roi.set_y_center(box.ymin() + box.height() / 2);
+      roi.set_width(box.width());
+      roi.set_height(box.height());
+    }
+    kRoi(cc).Send(std::move(roi));
+    return absl::OkStatus();
+  }
+};
+MEDIAPIPE_REGISTER_NODE(DetectionsToRoiNode);
+
+// Stands in for hand landmark inference and post-processing.
+class RoiToLandmarksNode : public Node {
+ public:
+  static constexpr Input<NormalizedRect> kRoi{"ROI"};
+  static constexpr Output<NormalizedLandmarkList> kLandmarks{"LANDMARKS"};
+  static constexpr Output<float> kPresence{"PRESENCE"};
+  static constexpr Output<NormalizedRect> kNextRoi{"NEXT_ROI"};
+  MEDIAPIPE_NODE_CONTRACT(kRoi, kLandmarks, kPresence, kNextRoi);
+
+  absl::Status Process(CalculatorContext* cc) override {
+    const NormalizedRect& roi = *kRoi(cc);
+    NormalizedLandmarkList landmarks;
+    for (int i = 0; i < 21; ++i) {
+      NormalizedLandmark* landmark = landmarks.add_landmark();
+      landmark->set_x(roi.x_center());
+      landmark->set_y(roi.y_center());
+    }
+    kLandmarks(cc).Send(std::move(landmarks));
+    kPresence(cc).Send(0.9f);
+    kNextRoi(cc).Send(roi);
+    return absl::OkStatus();
+  }
+};
+MEDIAPIPE_REGISTER_NODE(RoiToLandmarksNode);
+
+// Emits the FINISHED signal that flow limiters wait for.
+class FrameDoneNode : public Node {
+ public:
+  static constexpr Input<NormalizedLandmarkList> kLandmarks{"LANDMARKS"};
+  static constexpr Input<float> kPresence{"PRESENCE"};
+  static constexpr Input<NormalizedRect> kNextRoi{"NEXT_ROI"};
+  static constexpr Output<Timestamp> kFinished{"FINISHED"};
+  MEDIAPIPE_NODE_CONTRACT(kLandmarks, kPresence, kNextRoi, kFinished);
+
+  absl::Status Process(CalculatorContext* cc) override {
+    kFinished(cc).Send(cc->InputTimestamp());
+    return absl::OkStatus();
+  }
+};
+MEDIAPIPE_REGISTER_NODE(FrameDoneNode);
+
+void BM_HandTrackingLikeGraph(benchmark::State& state) {
+  CalculatorGraphConfig config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "detections"
+    num_threads: 1
+    node {
+      calculator: "DetectionsToRoiNode"
+      input_stream: "DETECTIONS:detections"
+      output_stream: "ROI:roi"
+    }
+    node {
+      calculator: "RoiToLandmarksNode"
+      input_stream: "ROI:roi"
+      output_stream: "LANDMARKS:landmarks"
+      output_stream: "PRESENCE:presence"
+      output_stream: "NEXT_ROI:next_roi"
+    }
+    node {
+      calculator: "FrameDoneNode"
+      input_stream: "LANDMARKS:landmarks"
+      input_stream: "PRESENCE:presence"
+      input_stream: "NEXT_ROI:next_roi"
+      output_stream: "FINISHED:finished"
+    }
+  )pb");
+  CalculatorGraph graph;
+  ABSL_CHECK_OK(graph.Initialize(config));
+  ABSL_CHECK_OK(graph.StartRun({}));
+
+  Detection detection;
+  auto* box =
+      detection.mutable_location_data()->mutable_relative_bounding_box();
+  box->set_xmin(0.25f);
+  box->set_ymin(0.25f);
+  box->set_width(0.5f);
+  box->set_height(0.5f);
+
+  int64_t t = 0;
+  // Warm up the graph and the packet pools.
+  for (; t < 100; ++t) {
+    ABSL_CHECK_OK(graph.AddPacketToInputStream(
+        "detections",
+        MakePacket<std::vector<Detection>>(2, detection).At(Timestamp(t))));
+    ABSL_CHECK_OK(graph.WaitUntilIdle());
+  }
+  const int64_t start = num_allocations.load();
+  for (auto _ : state) {
+    ABSL_CHECK_OK(graph.AddPacketToInputStream(
+        "detections",
+        MakePacket<std::vector<Detection>>(2, detection).At(Timestamp(t++))));
+    ABSL_CHECK_OK(graph.WaitUntilIdle());
+  }
+  ReportAllocations(state, start, 1);
+  ABSL_CHECK_OK(graph.CloseAllInputStreams());
+  ABSL_CHECK_OK(graph.WaitUntilDone());
+}
+BENCHMARK(BM_HandTrackingLikeGraph)->UseRealTime();
+
+}  // namespace
+}  // namespace mediapipe
+
+BENCHMARK_MAIN();
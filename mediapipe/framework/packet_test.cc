@@ -14,6 +14,7 @@
 
 #include "mediapipe/framework/packet.h"
 
+#include <cstdint>
 #include <initializer_list>
 #include <map>
 #include <memory>
@@ -26,6 +27,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/deps/block_pool.h"
 #include "mediapipe/framework/packet_test.pb.h"
 #include "mediapipe/framework/port/core_proto_inc.h"
 #include "mediapipe/framework/port/gmock.h"
@@ -559,5 +561,73 @@ TEST(PacketTest, SharedPtrWithPacketOwnership) {
   EXPECT_EQ(exist, false);
 }
 
+
+// Counts live instances, including moved-from ones.
+class Counted {
+ public:
+  explicit Counted(int* live, int value = 0) : live_(live), value_(value) {
+    ++*live_;
+  }
+  Counted(Counted&& other) : live_(other.live_), value_(other.value_) {
+    ++*live_;
+  }
+  ~Counted() { --*live_; }
+  int value() const { return value_; }
+
+ private:
+  int* live_;
+  int value_;
+};
+
+TEST(PacketTest, MakePacketStoresSmallPayloadsInline) {
+  static_assert(packet_internal::kUsePooledHolder<int>);
+  static_assert(packet_internal::kUsePooledHolder<std::vector<float>>);
+  static_assert(!packet_internal::kUsePooledHolder<MyClass>);
+  static_assert(!packet_internal::kUsePooledHolder<int[3]>);
+
+  Packet packet = MakePacket<std::vector<int>>(3, 7);
+  EXPECT_TRUE(packet_internal::GetHolder(packet)->HasInlinePayload());
+  EXPECT_EQ(packet.Get<std::vector<int>>(), std::vector<int>({7, 7, 7}));
+  Packet adopted = Adopt(new std::vector<int>(3, 7));
+  EXPECT_FALSE(packet_internal::GetHolder(adopted)->HasInlinePayload());
+}
+
+TEST(PacketTest, PooledPayloadIsDestroyedWithLastPacket) {
+  int live = 0;
+  Packet packet = MakePacket<Counted>(&live, 5).At(Timestamp(1));
+  Packet copy = packet;
+  EXPECT_EQ(live, 1);
+  packet = Packet();
+  EXPECT_EQ(live, 1);
+  EXPECT_EQ(copy.Get<Counted>().value(), 5);
+  copy = Packet();
+  EXPECT_EQ(live, 0);
+}
+
+TEST(PacketTest, ConsumePooledPayload) {
+  int live = 0;
+  Packet packet = MakePacket<Counted>(&live, 42);
+  absl::StatusOr<std::unique_ptr<Counted>> result = packet.Consume<Counted>();
+  MP_ASSERT_OK(result);
+  EXPECT_TRUE(packet.IsEmpty());
+  EXPECT_EQ((*result)->value(), 42);
+  // Only the moved-to object is left once the holder is gone.
+  EXPECT_EQ(live, 1);
+  result->reset();
+  EXPECT_EQ(live, 0);
+}
+
+TEST(PacketTest, MakePacketDoesNotAllocateOnceWarm) {
+  std::vector<Packet> packets;
+  for (int i = 0; i < 10; ++i) packets.push_back(MakePacket<float>(i));
+  packets.clear();
+  const int64_t num_system_allocations = BlockPool::NumSystemAllocations();
+  for (int round = 0; round < 100; ++round) {
+    for (int i = 0; i < 10; ++i) packets.push_back(MakePacket<float>(i));
+    packets.clear();
+  }
+  EXPECT_EQ(BlockPool::NumSystemAllocations(), num_system_allocations);
+}
+
 }  // namespace
 }  // namespace mediapipe
@@ -44,6 +44,8 @@ namespace {
 const int kDefaultLogIntervalCount = 10;
 const int kDefaultLogFileCount = 2;
 const char kDefaultLogFilePrefix[] = "mediapipe_trace_";
+// The interval between log outputs when only sampled profiles are written.
+const absl::Duration kDefaultLogInterval = absl::Milliseconds(500);
 
 // The number of recent timestamps tracked for each input stream.
 const int kPacketInfoRecentCount = 400;
@@ -74,19 +76,39 @@ bool IsTracerEnabled(const ProfilerConfig& profiler_config) {
   return profiler_config.trace_enabled();
 }
 
+// Returns true if only 1 in sampling_period timestamps is profiled.
+bool IsSamplingEnabled(const ProfilerConfig& profiler_config) {
+  return profiler_config.sampling_period() > 1;
+}
+
 // Returns true if trace events are written to a log file.
 // Note that for now, file output is only for graph-trace and not for
-// calculator-profile.
+// calculator-profile, except in sampling mode.
 bool IsTraceLogEnabled(const ProfilerConfig& profiler_config) {
-  return IsTracerEnabled(profiler_config) &&
+  return (IsTracerEnabled(profiler_config) ||
+          (IsProfilerEnabled(profiler_config) &&
+           IsSamplingEnabled(profiler_config))) &&
          !profiler_config.trace_log_disabled();
 }
 
-// Returns true if trace events are written periodically.
+// Returns the interval between log outputs.
+absl::Duration GetLogInterval(const ProfilerConfig& profiler_config,
+                              GraphTracer* tracer) {
+  if (tracer) {
+    return tracer->GetTraceLogInterval();
+  }
+  return profiler_config.trace_log_interval_usec()
+             ? absl::Microseconds(profiler_config.trace_log_interval_usec())
+             : kDefaultLogInterval;
+}
+
+// Returns true if trace events or sampled profiles are written periodically.
 bool IsTraceIntervalEnabled(const ProfilerConfig& profiler_config,
                             GraphTracer* tracer) {
-  return IsTraceLogEnabled(profiler_config) && tracer &&
-         absl::ToInt64Microseconds(tracer->GetTraceLogInterval()) != -1;
+  return IsTraceLogEnabled(profiler_config) &&
+         (tracer || IsSamplingEnabled(profiler_config)) &&
+         absl::ToInt64Microseconds(GetLogInterval(profiler_config, tracer)) !=
+             -1;
 }
 
 using PacketInfoMap =
@@ -170,6 +192,12 @@ void GraphProfiler::Initialize(
   if (IsTracerEnabled(profiler_config_)) {
     packet_tracer_ = absl::make_unique<GraphTracer>(profiler_config_);
   }
+  sampling_period_ = profiler_config_.sampling_period();
+  if (IsSamplingEnabled(profiler_config_)) {
+    sampled_process_runtimes_ = std::make_unique<StripedTimeHistograms>(
+        validated_graph_config.CalculatorInfos().size(), interval_size_usec,
+        num_intervals);
+  }
   for (int node_id = 0;
        node_id < validated_graph_config.CalculatorInfos().size(); ++node_id) {
     std::string node_name =
@@ -194,6 +222,7 @@ void GraphProfiler::Initialize(
     auto iter = calculator_profiles_.insert({node_name, profile});
     ABSL_CHECK(iter.second) << absl::Substitute(
         "Calculator \"$0\" has already been added.", node_name);
+    node_ids_[node_name] = node_id;
   }
   profile_builder_ = std::make_unique<GraphProfileBuilder>(this);
   graph_id_ = ++next_instance_id_;
@@ -227,6 +256,9 @@ void GraphProfiler::Resume() {
 
 void GraphProfiler::Reset() {
   absl::WriterMutexLock lock(&profiler_mutex_);
+  if (sampled_process_runtimes_) {
+    sampled_process_runtimes_->Reset();
+  }
   for (auto iter = calculator_profiles_.begin();
        iter != calculator_profiles_.end(); ++iter) {
     CalculatorProfile* calculator_profile = &iter->second;
@@ -244,7 +276,8 @@ void GraphProfiler::Reset() {
 absl::Status GraphProfiler::Start(mediapipe::Executor* executor) {
   // If specified, start periodic profile output while the graph runs.
   Resume();
-  if (is_tracing_ && IsTraceIntervalEnabled(profiler_config_, tracer()) &&
+  if ((is_tracing_ || is_profiling_) &&
+      IsTraceIntervalEnabled(profiler_config_, tracer()) &&
       executor != nullptr) {
     // Inform the user via logging the path to the trace logs.
     MP_ASSIGN_OR_RETURN(std::string trace_log_path, GetTraceLogPath());
@@ -267,12 +300,12 @@ absl::Status GraphProfiler::Start(mediapipe::Executor* executor) {
       if (!self) {
         return;
       }
-      absl::Time deadline =
-          self->clock_->TimeNow() + self->tracer()->GetTraceLogInterval();
+      const absl::Duration interval =
+          GetLogInterval(self->profiler_config_, self->tracer());
+      absl::Time deadline = self->clock_->TimeNow() + interval;
       while (self->is_running_) {
         self->clock_->SleepUntil(deadline);
-        deadline =
-            self->clock_->TimeNow() + self->tracer()->GetTraceLogInterval();
+        deadline = self->clock_->TimeNow() + interval;
         if (self->is_running_) {
           self->WriteProfile().IgnoreError();
         }
@@ -294,6 +327,15 @@ absl::Status GraphProfiler::Stop() {
 }
 
 void GraphProfiler::LogEvent(const TraceEvent& event) {
+  // In sampling mode, skip the events of timestamps that are not profiled.
+  if (sampling_period_ > 1) {
+    Timestamp timestamp =
+        event.input_ts != Timestamp::Unset() ? event.input_ts : event.packet_ts;
+    if (timestamp.IsRangeValue() && !IsSampledTimestamp(timestamp)) {
+      return;
+    }
+  }
+
   // Record event info in the event trace log.
 
   if (packet_tracer_) {
@@ -347,6 +389,11 @@ absl::Status GraphProfiler::GetCalculatorProfiles(
       << "GetCalculatorProfiles can only be called after Initialize()";
   for (auto& entry : calculator_profiles_) {
     profiles->push_back(entry.second);
+    if (sampled_process_runtimes_) {
+      sampled_process_runtimes_->AddTo(
+          node_ids_.at(entry.first),
+          profiles->back().mutable_process_runtime());
+    }
   }
   return absl::OkStatus();
 }
@@ -550,6 +597,20 @@ int64_t GraphProfiler::AddInputStreamTimeSamples(
 void GraphProfiler::AddProcessSample(
     const CalculatorContext& calculator_context, int64_t start_time_usec,
     int64_t end_time_usec) {
+  // In sampling mode, Process() runtimes are recorded without locking.
+  // is_profiling_ is atomic, as Pause() and Resume() also write it without
+  // profiler_mutex_, and the histograms are updated with atomic counters.
+  if (sampled_process_runtimes_) {
+    if (!is_profiling_) {
+      return;
+    }
+    sampled_process_runtimes_->AddSample(calculator_context.NodeId(),
+                                         end_time_usec - start_time_usec);
+    if (!profiler_config_.enable_stream_latency()) {
+      return;
+    }
+  }
+
   absl::ReaderMutexLock lock(&profiler_mutex_);
   if (!is_profiling_) {
     return;
@@ -563,8 +624,10 @@ void GraphProfiler::AddProcessSample(
   CalculatorProfile* calculator_profile = &profile_iter->second;
 
   // Update Process() runtime.
-  AddTimeSample(start_time_usec, end_time_usec,
-                calculator_profile->mutable_process_runtime());
+  if (!sampled_process_runtimes_) {
+    AddTimeSample(start_time_usec, end_time_usec,
+                  calculator_profile->mutable_process_runtime());
+  }
 
   if (profiler_config_.enable_stream_latency()) {
     int64_t min_source_process_start_usec = AddStreamLatencies(
@@ -691,6 +754,9 @@ absl::Status GraphProfiler::CaptureProfile(
     } else {
       tracer()->GetLog(previous_log_end_time_, end_time, trace);
     }
+    if (profiler_config_.critical_path_enabled()) {
+      tracer()->GetCriticalPaths(previous_log_end_time_, end_time, result);
+    }
   }
   previous_log_end_time_ = end_time;
 
@@ -724,8 +790,8 @@ absl::Status GraphProfiler::WriteProfile() {
   MP_RETURN_IF_ERROR(CaptureProfile(&profile, PopulateGraphConfig::kNo));
 
   // If there are no trace events, skip log writing.
-  const GraphTrace& trace = *profile.graph_trace().rbegin();
-  if (is_tracing_ && trace.calculator_trace().empty()) {
+  if (is_tracing_ && profile.graph_trace_size() > 0 &&
+      profile.graph_trace().rbegin()->calculator_trace().empty()) {
     return absl::OkStatus();
   }
 
@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/time/time.h"
 #include "mediapipe/framework/calculator.pb.h"
 #include "mediapipe/framework/calculator_context.h"
@@ -32,6 +33,7 @@
 #include "mediapipe/framework/executor.h"
 #include "mediapipe/framework/profiler/graph_tracer.h"
 #include "mediapipe/framework/profiler/sharded_map.h"
+#include "mediapipe/framework/profiler/striped_time_histograms.h"
 #include "mediapipe/framework/validated_graph_config.h"
 
 namespace mediapipe {
@@ -98,6 +100,13 @@ enum class PopulateGraphConfig { kNo, kFull };
 //
 // The profiler uses the synchronized monotonic clock by default.
 // The client can overwrite this by calling SetClock().
+//
+// With ProfilerConfig.sampling_period set to N > 1, only 1 in N packet
+// timestamps is profiled and traced, and Process() runtimes are recorded in
+// lock-free StripedTimeHistograms. The profiles are written periodically to
+// trace_log_path, so that profiling can stay enabled in production. The
+// process_runtime counts and total then cover only the sampled timestamps,
+// about 1 in N of the Process() calls, and are not scaled by N.
 class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
  public:
   GraphProfiler();
@@ -181,7 +190,11 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
                           GraphProfiler* profiler)
         : calculator_method_(event_type),
           calculator_context_(*calculator_context),
-          profiler_(profiler) {
+          profiler_(profiler),
+          is_sampled_(profiler->IsSampled(event_type, *calculator_context)) {
+      if (!is_sampled_) {
+        return;
+      }
       start_time_usec_ = profiler_->TimeNowUsec();
       if (profiler_->is_tracing_) {
         absl::Time time_now = absl::FromUnixMicros(start_time_usec_);
@@ -191,6 +204,9 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
     }
 
     inline ~Scope() {
+      if (!is_sampled_) {
+        return;
+      }
       int64_t end_time_usec;
       if (profiler_->is_profiling_ || profiler_->is_tracing_) {
         end_time_usec = profiler_->TimeNowUsec();
@@ -227,6 +243,7 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
     const GraphTrace::EventType calculator_method_;
     const CalculatorContext& calculator_context_;
     GraphProfiler* profiler_;
+    const bool is_sampled_;
     int64_t start_time_usec_;
   };
 
@@ -299,8 +316,8 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
                                     int64_t start_time_usec,
                                     CalculatorProfile* calculator_profile);
 
-  // Updates the Process() data for calculator.
-  // Requires ReaderLock for is_profiling_.
+  // Updates the Process() data for calculator. Takes a ReaderLock, except
+  // for the runtimes recorded in sampling mode.
   void AddProcessSample(const CalculatorContext& calculator_context,
                         int64_t start_time_usec, int64_t end_time_usec)
       ABSL_LOCKS_EXCLUDED(profiler_mutex_);
@@ -313,6 +330,23 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
   // Helper method to get the clock time in microsecond.
   int64_t TimeNowUsec() { return ToUnixMicros(clock_->TimeNow()); }
 
+  // Returns true if a packet timestamp is among the 1 in sampling_period
+  // timestamps that are profiled. The choice depends only on the timestamp,
+  // so that all calculators profile the same timestamps.
+  bool IsSampledTimestamp(Timestamp timestamp) const {
+    uint64_t hash = static_cast<uint64_t>(timestamp.Value()) *
+                    uint64_t{0x9E3779B97F4A7C15};
+    return (hash >> 32) % sampling_period_ == 0;
+  }
+
+  // Returns true if a calculator method call is profiled and traced.
+  // Open() and Close() are always profiled.
+  bool IsSampled(GraphTrace::EventType event_type,
+                 const CalculatorContext& calculator_context) const {
+    return sampling_period_ <= 1 || event_type != GraphTrace::PROCESS ||
+           IsSampledTimestamp(calculator_context.InputTimestamp());
+  }
+
  private:
   // The settings for this tracer.
   ProfilerConfig profiler_config_;
@@ -322,6 +356,7 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
   std::atomic_bool is_initialized_;
 
   // If true, the profiler is profiling. Otherwise, it is paused.
+  // Atomic so that it can be read without profiler_mutex_.
   std::atomic_bool is_profiling_;
 
   // If true, the tracer records timing events.
@@ -330,6 +365,14 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
   // Stores all the calculator profiles with the calculator name as the key.
   using CalculatorProfileMap = ShardedMap<std::string, CalculatorProfile>;
   CalculatorProfileMap calculator_profiles_;
+
+  // Profiles 1 in sampling_period_ timestamps, if greater than 1.
+  int sampling_period_ = 0;
+  // In sampling mode, the Process() runtimes indexed by node id. These are
+  // merged into calculator_profiles_ when profiles are collected.
+  std::unique_ptr<StripedTimeHistograms> sampled_process_runtimes_;
+  // The node id of each calculator name.
+  absl::flat_hash_map<std::string, int> node_ids_;
   // Stores the production time of a packet, based on profiler's clock.
   using PacketInfoMap =
       ShardedMap<std::string, std::list<std::pair<int64_t, PacketInfo>>>;
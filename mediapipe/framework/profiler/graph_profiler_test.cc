@@ -229,6 +229,10 @@ class GraphProfilerTestPeer : public testing::Test {
     }
   }
 
+  bool IsSampledTimestamp(Timestamp timestamp) {
+    return profiler_.IsSampledTimestamp(timestamp);
+  }
+
   std::vector<CalculatorProfile> Profiles() {
     std::vector<CalculatorProfile> result;
     MP_EXPECT_OK(profiler_.GetCalculatorProfiles(&result));
@@ -1184,6 +1188,56 @@ TEST_F(GraphProfilerTestPeer, AddProcessSampleWithStreamLatency) {
   ASSERT_NE(GetPacketInfo(GetPacketsInfoMap(), {"stream_1", 100}), nullptr);
 }
 
+// Tests that with sampling_period set, Process() runtimes are recorded only
+// for the sampled timestamps, while Open() is always recorded.
+TEST_F(GraphProfilerTestPeer, AddProcessSampleWithSampling) {
+  InitializeProfilerWithGraphConfig(R"(
+    profiler_config {
+      enable_profiler: true
+      sampling_period: 4
+      trace_log_disabled: true
+    }
+    input_stream: "input_stream"
+    node {
+      calculator: "DummyTestCalculator"
+      input_stream: "input_stream"
+      output_stream: "output_stream"
+    })");
+  std::shared_ptr<mediapipe::SimulationClock> simulation_clock(
+      new SimulationClock());
+  simulation_clock->ThreadStart();
+  profiler_.SetClock(simulation_clock);
+
+  {
+    TestContextBuilder context(kDummyTestCalculatorName, /*node_id=*/0,
+                               {"input_stream"}, {"output_stream"});
+    GraphProfiler::Scope profiler_scope(GraphTrace::OPEN, context.get(),
+                                        &profiler_);
+    simulation_clock->Sleep(absl::Microseconds(10));
+  }
+  int num_sampled = 0;
+  for (int t = 0; t < 1000; ++t) {
+    num_sampled += IsSampledTimestamp(Timestamp(t)) ? 1 : 0;
+    TestContextBuilder context(kDummyTestCalculatorName, /*node_id=*/0,
+                               {"input_stream"}, {"output_stream"});
+    context.AddInputs({MakePacket<std::string>("5").At(Timestamp(t))});
+    GraphProfiler::Scope profiler_scope(GraphTrace::PROCESS, context.get(),
+                                        &profiler_);
+    simulation_clock->Sleep(absl::Microseconds(100));
+  }
+
+  std::vector<CalculatorProfile> profiles = Profiles();
+  simulation_clock->ThreadFinish();
+
+  // About 1 in 4 timestamps are sampled.
+  EXPECT_GT(num_sampled, 200);
+  EXPECT_LT(num_sampled, 300);
+  ASSERT_EQ(profiles.size(), 1);
+  EXPECT_EQ(profiles[0].open_runtime(), 10);
+  EXPECT_EQ(profiles[0].process_runtime().count(0), num_sampled);
+  EXPECT_EQ(profiles[0].process_runtime().total(), num_sampled * 100);
+}
+
 // This test shows that CalculatorGraph::GetCalculatorProfiles and
 // GraphProfiler::AddProcessSample() can be called in parallel.
 // Without the GraphProfiler::profiler_mutex_ this test should
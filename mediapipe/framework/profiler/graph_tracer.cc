@@ -139,6 +139,13 @@ void GraphTracer::GetLog(absl::Time begin_time, absl::Time end_time,
   trace_builder_.Clear();
 }
 
+void GraphTracer::GetCriticalPaths(absl::Time begin_time, absl::Time end_time,
+                                   GraphProfile* result) {
+  absl::MutexLock lock(trace_builder_mutex());
+  trace_builder_.CreateCriticalPaths(trace_buffer_, begin_time, end_time,
+                                     result);
+}
+
 const TraceBuffer& GraphTracer::GetTraceBuffer() { return trace_buffer_; }
 
 Timestamp GraphTracer::GetOutputTimestamp(const CalculatorContext* context) {
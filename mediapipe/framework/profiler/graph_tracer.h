@@ -78,6 +78,11 @@ class GraphTracer {
   // Returns trace events between begin_time and end_time exclusive.
   void GetLog(absl::Time begin_time, absl::Time end_time, GraphTrace* result);
 
+  // Appends the critical paths of the timestamps traced between begin_time
+  // and end_time exclusive, see TraceBuilder::CreateCriticalPaths.
+  void GetCriticalPaths(absl::Time begin_time, absl::Time end_time,
+                        GraphProfile* result);
+
   // Returns the logged TraceEvents.
   const TraceBuffer& GetTraceBuffer();
 
@@ -329,6 +329,139 @@ TEST_F(GraphTracerTest, GraphTrace) {
   EXPECT_EQ(4, trace.calculator_trace().size());
 }
 
+TEST_F(GraphTracerTest, CriticalPath) {
+  // Define the GraphTracer, and a chain of two calculators.
+  SetUpGraphTracer();
+  SetUpCalculatorContext("PCalculator_1", /*node_id=*/0, {"input_stream"},
+                         {"mid_stream"});
+  SetUpCalculatorContext("PCalculator_2", /*node_id=*/1, {"mid_stream"},
+                         {"output_stream"});
+  const std::string input_stream = "input_stream";
+  auto time_at = [&](int64_t usec) {
+    return start_time_ + absl::Microseconds(usec);
+  };
+
+  // A packet enters the graph and waits for PCalculator_1.
+  tracer_->LogEvent(TraceEvent(GraphTrace::PROCESS)
+                        .set_event_time(time_at(0))
+                        .set_is_finish(true)
+                        .set_input_ts(start_timestamp_)
+                        .set_stream_id(&input_stream)
+                        .set_packet_ts(start_timestamp_));
+  tracer_->LogEvent(TraceEvent(GraphTrace::PACKET_QUEUED)
+                        .set_event_time(time_at(100))
+                        .set_node_id(0)
+                        .set_input_ts(start_timestamp_)
+                        .set_stream_id(&input_stream)
+                        .set_packet_ts(start_timestamp_));
+  tracer_->LogEvent(TraceEvent(GraphTrace::READY_FOR_PROCESS)
+                        .set_event_time(time_at(300))
+                        .set_node_id(0)
+                        .set_packet_ts(start_timestamp_));
+  LogInputPackets("PCalculator_1", GraphTrace::PROCESS, time_at(1000),
+                  {MakePacket<std::string>("hello").At(start_timestamp_)});
+  LogOutputPackets("PCalculator_1", GraphTrace::PROCESS, time_at(3000),
+                   {{MakePacket<std::string>("mid").At(start_timestamp_)}});
+
+  // No PACKET_QUEUED event is logged for PCalculator_2, so its input packet
+  // is assumed to arrive when PCalculator_1 finishes.
+  tracer_->LogEvent(TraceEvent(GraphTrace::READY_FOR_PROCESS)
+                        .set_event_time(time_at(3500))
+                        .set_node_id(1)
+                        .set_packet_ts(start_timestamp_));
+  LogInputPackets("PCalculator_2", GraphTrace::PROCESS, time_at(4000),
+                  {MakePacket<std::string>("mid").At(start_timestamp_)});
+  LogOutputPackets("PCalculator_2", GraphTrace::PROCESS, time_at(9000),
+                   {{MakePacket<std::string>("out").At(start_timestamp_)}});
+
+  // Validate the critical path and the wait events added to the GraphTrace.
+  GraphProfile profile;
+  profile.add_graph_trace();
+  tracer_->GetCriticalPaths(absl::InfinitePast(), absl::InfiniteFuture(),
+                            &profile);
+  EXPECT_THAT(profile,
+              EqualsProto(mediapipe::ParseTextProtoOrDie<GraphProfile>(R"pb(
+                graph_trace {
+                  calculator_trace {
+                    node_id: 0
+                    input_timestamp: 0
+                    event_type: INPUT_QUEUE_WAIT
+                    start_time: 100
+                    finish_time: 300
+                    input_trace { packet_timestamp: 0 stream_id: 1 }
+                  }
+                  calculator_trace {
+                    node_id: 0
+                    input_timestamp: 0
+                    event_type: SCHEDULER_WAIT
+                    start_time: 300
+                    finish_time: 1000
+                    input_trace { packet_timestamp: 0 stream_id: 1 }
+                  }
+                  calculator_trace {
+                    node_id: 1
+                    input_timestamp: 0
+                    event_type: INPUT_QUEUE_WAIT
+                    start_time: 3000
+                    finish_time: 3500
+                    input_trace { packet_timestamp: 0 stream_id: 2 }
+                  }
+                  calculator_trace {
+                    node_id: 1
+                    input_timestamp: 0
+                    event_type: SCHEDULER_WAIT
+                    start_time: 3500
+                    finish_time: 4000
+                    input_trace { packet_timestamp: 0 stream_id: 2 }
+                  }
+                }
+                critical_path {
+                  input_timestamp: 0
+                  step {
+                    node_id: 0
+                    input_timestamp: 0
+                    stream_id: 1
+                    queue_time: 100
+                    ready_time: 300
+                    start_time: 1000
+                    finish_time: 3000
+                    queue_wait_usec: 200
+                    scheduler_wait_usec: 700
+                    execution_usec: 2000
+                  }
+                  step {
+                    node_id: 1
+                    input_timestamp: 0
+                    stream_id: 2
+                    queue_time: 3000
+                    ready_time: 3500
+                    start_time: 4000
+                    finish_time: 9000
+                    queue_wait_usec: 500
+                    scheduler_wait_usec: 500
+                    execution_usec: 5000
+                  }
+                  queue_wait_usec: 700
+                  scheduler_wait_usec: 1200
+                  execution_usec: 7000
+                  total_usec: 8900
+                }
+                stream_queue_profiles {
+                  node_id: 0
+                  stream_id: 1
+                  num_packets: 1
+                  total_queue_wait_usec: 200
+                  max_queue_wait_usec: 200
+                }
+                stream_queue_profiles {
+                  node_id: 1
+                  stream_id: 2
+                  num_packets: 1
+                  total_queue_wait_usec: 500
+                  max_queue_wait_usec: 500
+                })pb")));
+}
+
 // Tests showing GraphTracer logging packet latencies.
 class GraphTracerE2ETest : public ::testing::Test {
  protected:
@@ -0,0 +1,99 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/profiler/striped_time_histograms.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "absl/log/absl_check.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr int64_t kCacheLineSize = 64;
+constexpr int64_t kCountersPerCacheLine =
+    kCacheLineSize / sizeof(std::atomic<int64_t>);
+
+// Returns the stripe of the current thread.
+int CurrentStripe() {
+  static std::atomic<int> next_thread_index{0};
+  thread_local int thread_index =
+      next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  return thread_index % StripedTimeHistograms::kNumStripes;
+}
+
+}  // namespace
+
+StripedTimeHistograms::StripedTimeHistograms(int num_histograms,
+                                             int64_t interval_size_usec,
+                                             int64_t num_intervals)
+    : num_histograms_(num_histograms),
+      interval_size_usec_(interval_size_usec),
+      num_intervals_(num_intervals),
+      stripe_size_((num_histograms * (num_intervals + 1) +
+                    kCountersPerCacheLine - 1) /
+                   kCountersPerCacheLine * kCountersPerCacheLine) {
+  ABSL_CHECK_GT(interval_size_usec_, 0);
+  ABSL_CHECK_GT(num_intervals_, 0);
+  const int64_t num_counters =
+      stripe_size_ * kNumStripes + kCountersPerCacheLine;
+  storage_ = std::make_unique<std::atomic<int64_t>[]>(num_counters);
+  const uintptr_t address = reinterpret_cast<uintptr_t>(storage_.get());
+  const uintptr_t aligned_address =
+      (address + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize;
+  counters_ = storage_.get() + (aligned_address - address) /
+                                   sizeof(std::atomic<int64_t>);
+  Reset();
+}
+
+std::atomic<int64_t>* StripedTimeHistograms::Counters(int stripe,
+                                                      int index) const {
+  return counters_ + stripe * stripe_size_ + index * (num_intervals_ + 1);
+}
+
+void StripedTimeHistograms::AddSample(int index, int64_t time_usec) {
+  if (index < 0 || index >= num_histograms_ || time_usec < 0) {
+    return;
+  }
+  const int64_t interval =
+      std::min(time_usec / interval_size_usec_, num_intervals_ - 1);
+  std::atomic<int64_t>* counters = Counters(CurrentStripe(), index);
+  counters[0].fetch_add(time_usec, std::memory_order_relaxed);
+  counters[1 + interval].fetch_add(1, std::memory_order_relaxed);
+}
+
+void StripedTimeHistograms::AddTo(int index, TimeHistogram* result) const {
+  ABSL_CHECK_EQ(result->count_size(), num_intervals_);
+  for (int stripe = 0; stripe < kNumStripes; ++stripe) {
+    const std::atomic<int64_t>* counters = Counters(stripe, index);
+    result->set_total(result->total() +
+                      counters[0].load(std::memory_order_relaxed));
+    for (int i = 0; i < num_intervals_; ++i) {
+      const int64_t count = counters[1 + i].load(std::memory_order_relaxed);
+      result->set_count(i, result->count(i) + count);
+    }
+  }
+}
+
+void StripedTimeHistograms::Reset() {
+  for (int64_t i = 0; i < stripe_size_ * kNumStripes; ++i) {
+    counters_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace mediapipe
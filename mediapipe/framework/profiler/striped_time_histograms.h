@@ -0,0 +1,70 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_PROFILER_STRIPED_TIME_HISTOGRAMS_H_
+#define MEDIAPIPE_FRAMEWORK_PROFILER_STRIPED_TIME_HISTOGRAMS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "mediapipe/framework/calculator_profile.pb.h"
+
+namespace mediapipe {
+
+// A fixed set of time histograms that many threads can update without locks.
+//
+// Each thread records samples in its own stripe of counters, so concurrent
+// updates do not contend on a mutex or share cache lines. Readers add up the
+// stripes. Threads beyond kNumStripes share stripes, which stays correct
+// because the counters are atomic.
+//
+// The histogram intervals follow TimeHistogram: "num_intervals" intervals of
+// "interval_size_usec", the last one extending to +inf.
+class StripedTimeHistograms {
+ public:
+  static constexpr int kNumStripes = 16;
+
+  StripedTimeHistograms(int num_histograms, int64_t interval_size_usec,
+                        int64_t num_intervals);
+
+  // Records a time sample in histogram "index". Lock-free.
+  void AddSample(int index, int64_t time_usec);
+
+  // Adds the samples recorded in histogram "index" to "result", which must
+  // have the same number of intervals. The counts and the total are added as
+  // recorded; callers that record only some events do not get them scaled.
+  void AddTo(int index, TimeHistogram* result) const;
+
+  // Discards all samples.
+  void Reset();
+
+ private:
+  // Returns the first counter of histogram "index" in stripe "stripe".
+  // The first counter holds the total time, followed by one per interval.
+  std::atomic<int64_t>* Counters(int stripe, int index) const;
+
+  const int num_histograms_;
+  const int64_t interval_size_usec_;
+  const int64_t num_intervals_;
+  // The number of counters per stripe, padded to whole cache lines.
+  const int64_t stripe_size_;
+  std::unique_ptr<std::atomic<int64_t>[]> storage_;
+  // The counters, aligned to a cache line within storage_.
+  std::atomic<int64_t>* counters_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_PROFILER_STRIPED_TIME_HISTOGRAMS_H_
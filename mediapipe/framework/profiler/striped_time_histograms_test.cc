@@ -0,0 +1,109 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/profiler/striped_time_histograms.h"
+
+#include <cstdint>
+
+#include "mediapipe/framework/calculator_profile.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/threadpool.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+
+// Returns an empty TimeHistogram with "num_intervals" intervals.
+TimeHistogram EmptyHistogram(int num_intervals) {
+  TimeHistogram result;
+  result.set_num_intervals(num_intervals);
+  result.mutable_count()->Resize(num_intervals, 0);
+  return result;
+}
+
+TEST(StripedTimeHistogramsTest, AddsSamplesToIntervals) {
+  StripedTimeHistograms histograms(/*num_histograms=*/2,
+                                   /*interval_size_usec=*/100,
+                                   /*num_intervals=*/3);
+  histograms.AddSample(0, 50);
+  histograms.AddSample(0, 150);
+  histograms.AddSample(0, 5000);
+  histograms.AddSample(1, 120);
+
+  TimeHistogram histogram_0 = EmptyHistogram(3);
+  histograms.AddTo(0, &histogram_0);
+  EXPECT_EQ(histogram_0.total(), 5200);
+  EXPECT_THAT(histogram_0.count(), ElementsAre(1, 1, 1));
+
+  TimeHistogram histogram_1 = EmptyHistogram(3);
+  histograms.AddTo(1, &histogram_1);
+  EXPECT_EQ(histogram_1.total(), 120);
+  EXPECT_THAT(histogram_1.count(), ElementsAre(0, 1, 0));
+}
+
+TEST(StripedTimeHistogramsTest, IgnoresInvalidSamples) {
+  StripedTimeHistograms histograms(1, 100, 1);
+  histograms.AddSample(0, -5);
+  histograms.AddSample(1, 5);
+  histograms.AddSample(-1, 5);
+
+  TimeHistogram histogram = EmptyHistogram(1);
+  histograms.AddTo(0, &histogram);
+  EXPECT_EQ(histogram.total(), 0);
+  EXPECT_THAT(histogram.count(), ElementsAre(0));
+}
+
+TEST(StripedTimeHistogramsTest, Reset) {
+  StripedTimeHistograms histograms(1, 100, 2);
+  histograms.AddSample(0, 10);
+  histograms.Reset();
+  histograms.AddSample(0, 300);
+
+  TimeHistogram histogram = EmptyHistogram(2);
+  histograms.AddTo(0, &histogram);
+  EXPECT_EQ(histogram.total(), 300);
+  EXPECT_THAT(histogram.count(), ElementsAre(0, 1));
+}
+
+TEST(StripedTimeHistogramsTest, AddsSamplesFromManyThreads) {
+  constexpr int kNumThreads = 2 * StripedTimeHistograms::kNumStripes;
+  constexpr int kSamplesPerThread = 1000;
+  StripedTimeHistograms histograms(2, 10, 2);
+  {
+    ThreadPool pool(kNumThreads);
+    pool.StartWorkers();
+    for (int t = 0; t < kNumThreads; ++t) {
+      pool.Schedule([&histograms, t] {
+        for (int i = 0; i < kSamplesPerThread; ++i) {
+          histograms.AddSample(t % 2, i % 20);
+        }
+      });
+    }
+  }
+
+  for (int index = 0; index < 2; ++index) {
+    TimeHistogram histogram = EmptyHistogram(2);
+    histograms.AddTo(index, &histogram);
+    // Each thread adds 0..19 fifty times: 500 samples below 10 usec and 500
+    // samples at or above 10 usec, totaling 9500 usec.
+    EXPECT_EQ(histogram.total(), kNumThreads / 2 * 9500);
+    EXPECT_THAT(histogram.count(), ElementsAre(kNumThreads / 2 * 500,
+                                               kNumThreads / 2 * 500));
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
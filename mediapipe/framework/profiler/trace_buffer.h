@@ -112,6 +112,8 @@ struct TraceEvent {
       GraphTrace::GPU_TASK_INVOKE_ADVANCED;
   static constexpr EventType TPU_TASK_INVOKE_ASYNC =
       GraphTrace::TPU_TASK_INVOKE_ASYNC;
+  static constexpr EventType INPUT_QUEUE_WAIT = GraphTrace::INPUT_QUEUE_WAIT;
+  static constexpr EventType SCHEDULER_WAIT = GraphTrace::SCHEDULER_WAIT;
 };
 
 // Packet trace log buffer.
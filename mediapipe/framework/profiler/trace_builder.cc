@@ -19,12 +19,15 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/container/node_hash_map.h"
 #include "mediapipe/framework/calculator_profile.pb.h"
 #include "mediapipe/framework/packet.h"
@@ -92,6 +95,10 @@ void BasicTraceEventTypes(TraceEventRegistry* result) {
        "interpreter."},
       {TraceEvent::TPU_TASK_INVOKE_ASYNC,
        "CPU timing for async initiation of a TPU task."},
+      {TraceEvent::INPUT_QUEUE_WAIT,
+       "A critical-path packet waiting in an input queue."},
+      {TraceEvent::SCHEDULER_WAIT,
+       "A critical-path calculator waiting for an executor."},
   };
   for (const TraceEventType& t : basic_types) {
     (*result)[t.event_type()] = t;
@@ -119,6 +126,19 @@ class StringIdMap {
     pointer_id_map_[id] = string_id->second;
     return string_id->second;
   }
+  // Returns the int32 identifier for a string object pointer, or 0 if the
+  // string has none. Unlike operator[], never assigns a new identifier.
+  int32_t Find(const std::string* id) const {
+    if (id == nullptr) {
+      return 0;
+    }
+    auto pointer_id = pointer_id_map_.find(id);
+    if (pointer_id != pointer_id_map_.end()) {
+      return pointer_id->second;
+    }
+    auto string_id = string_id_map_.find(*id);
+    return string_id == string_id_map_.end() ? 0 : string_id->second;
+  }
   void clear() { pointer_id_map_.clear(), string_id_map_.clear(); }
   const absl::node_hash_map<std::string, int32_t>& map() {
     return string_id_map_;
@@ -191,16 +211,8 @@ class TraceBuilder::Impl {
 
   void CreateTrace(const TraceBuffer& buffer, absl::Time begin_time,
                    absl::Time end_time, GraphTrace* result) {
-    // Snapshot recent TraceEvents
-    std::vector<TraceEvent> snapshot;
-    snapshot.reserve(10000);
-    TraceBuffer::iterator buffer_end = buffer.end();
-    for (auto iter = buffer.begin(); iter < buffer_end; ++iter) {
-      TraceEvent event = *iter;
-      if (event.event_time >= begin_time && event.event_time < end_time) {
-        snapshot.push_back(event);
-      }
-    }
+    std::vector<TraceEvent> snapshot =
+        SnapshotEvents(buffer, begin_time, end_time);
     SetBaseTime(snapshot);
 
     // Index TraceEvents by task-id and stream-hop-id.
@@ -242,16 +254,8 @@ class TraceBuilder::Impl {
 
   void CreateLog(const TraceBuffer& buffer, absl::Time begin_time,
                  absl::Time end_time, GraphTrace* result) {
-    // Snapshot recent TraceEvents
-    std::vector<TraceEvent> snapshot;
-    snapshot.reserve(10000);
-    TraceBuffer::iterator buffer_end = buffer.end();
-    for (auto iter = buffer.begin(); iter < buffer_end; ++iter) {
-      TraceEvent event = *iter;
-      if (event.event_time >= begin_time && event.event_time < end_time) {
-        snapshot.push_back(event);
-      }
-    }
+    std::vector<TraceEvent> snapshot =
+        SnapshotEvents(buffer, begin_time, end_time);
     SetBaseTime(snapshot);
 
     // Log each TraceEvent.
@@ -266,12 +270,300 @@ class TraceBuilder::Impl {
     }
   }
 
+  void CreateCriticalPaths(const TraceBuffer& buffer, absl::Time begin_time,
+                           absl::Time end_time, GraphProfile* result) {
+    std::vector<TraceEvent> snapshot =
+        SnapshotEvents(buffer, begin_time, end_time);
+    SetBaseTime(snapshot);
+
+    // Index the timing of each calculator invocation, the producer of each
+    // packet, and the arrival of each packet in an input queue.
+    absl::flat_hash_map<TaskKey, TaskTiming> tasks;
+    absl::flat_hash_map<HopKey, TaskKey> producers;
+    absl::flat_hash_map<QueueKey, absl::Time> queue_times;
+    absl::flat_hash_map<TaskKey, absl::Time> ready_times;
+    for (const TraceEvent& event : snapshot) {
+      if (event.event_type == TraceEvent::PROCESS) {
+        TaskKey task_key{event.node_id, event.input_ts.Value()};
+        TaskTiming& task = tasks[task_key];
+        task.node_id = event.node_id;
+        task.input_ts = event.input_ts;
+        if (event.is_finish) {
+          task.finish_time = std::min(task.finish_time, event.event_time);
+          int32_t stream_id = stream_id_map_.Find(event.stream_id);
+          if (stream_id != 0) {
+            producers[HopKey{stream_id, event.packet_ts.Value()}] = task_key;
+          }
+        } else {
+          task.start_time = std::min(task.start_time, event.event_time);
+          task.inputs.push_back(&event);
+        }
+      } else if (event.event_type == TraceEvent::READY_FOR_PROCESS) {
+        KeepEarliest(TaskKey{event.node_id, event.packet_ts.Value()},
+                     event.event_time, &ready_times);
+      } else if (event.event_type == TraceEvent::PACKET_QUEUED) {
+        int32_t stream_id = stream_id_map_.Find(event.stream_id);
+        if (stream_id != 0) {
+          KeepEarliest(
+              QueueKey{event.node_id, stream_id, event.packet_ts.Value()},
+              event.event_time, &queue_times);
+        }
+      }
+    }
+
+    // Split the latency of each invocation into queue, scheduler and
+    // execution time, and accumulate the queue wait of each input stream.
+    absl::flat_hash_map<std::pair<int, int32_t>, StreamQueueProfile>
+        stream_profiles;
+    for (auto& [task_key, task] : tasks) {
+      // Source nodes and graph inputs log only finish events, and calculators
+      // without outputs log only start events.
+      if (task.start_time == absl::InfiniteFuture()) {
+        task.start_time = task.finish_time;
+      }
+      if (task.finish_time == absl::InfiniteFuture()) {
+        task.finish_time = task.start_time;
+      }
+      task.queue_time = task.start_time;
+      task.ready_time = task.start_time;
+      if (task.inputs.empty()) {
+        continue;
+      }
+      auto ready = ready_times.find(task_key);
+      if (ready != ready_times.end()) {
+        task.ready_time = std::min(ready->second, task.start_time);
+      }
+      absl::Time last_arrival = absl::InfinitePast();
+      for (const TraceEvent* input : task.inputs) {
+        int32_t stream_id = stream_id_map_.Find(input->stream_id);
+        absl::Time arrival = ArrivalTime(task, *input, stream_id, tasks,
+                                         producers, queue_times);
+        // Packets from earlier timestamps, such as back edges, do not link
+        // this invocation to the critical path of its own timestamp.
+        if (input->packet_ts == task.input_ts && arrival > last_arrival) {
+          last_arrival = arrival;
+          task.critical_input = input;
+        }
+        StreamQueueProfile& profile =
+            stream_profiles[{task.node_id, stream_id}];
+        int64_t wait = std::max<int64_t>(
+            0, absl::ToInt64Microseconds(task.ready_time - arrival));
+        profile.set_num_packets(profile.num_packets() + 1);
+        profile.set_total_queue_wait_usec(profile.total_queue_wait_usec() +
+                                          wait);
+        profile.set_max_queue_wait_usec(
+            std::max(profile.max_queue_wait_usec(), wait));
+      }
+      if (task.critical_input != nullptr) {
+        task.queue_time = last_arrival;
+        task.ready_time = std::max(task.ready_time, task.queue_time);
+      }
+    }
+
+    // The critical path of each timestamp ends at the last invocation to
+    // finish, and follows the last input packet to arrive back to its source.
+    absl::flat_hash_map<int64_t, const TaskTiming*> last_tasks;
+    for (const auto& [task_key, task] : tasks) {
+      if (task.node_id < 0) continue;
+      const TaskTiming*& last = last_tasks[task.input_ts.Value()];
+      if (last == nullptr || task.finish_time > last->finish_time) {
+        last = &task;
+      }
+    }
+    std::vector<int64_t> timestamps;
+    for (const auto& [ts, task] : last_tasks) timestamps.push_back(ts);
+    std::sort(timestamps.begin(), timestamps.end());
+
+    GraphTrace* trace = result->graph_trace_size() > 0
+                            ? result->mutable_graph_trace(
+                                  result->graph_trace_size() - 1)
+                            : nullptr;
+    for (int64_t ts : timestamps) {
+      std::vector<const TaskTiming*> path;
+      absl::flat_hash_set<const TaskTiming*> visited;
+      for (const TaskTiming* task = last_tasks[ts];
+           task != nullptr && visited.insert(task).second;) {
+        path.push_back(task);
+        task = ProducerTask(*task, tasks, producers);
+      }
+      std::reverse(path.begin(), path.end());
+      BuildCriticalPath(ts, path, result->add_critical_path(), trace);
+    }
+
+    std::vector<std::pair<int, int32_t>> stream_keys;
+    for (const auto& [key, profile] : stream_profiles) {
+      stream_keys.push_back(key);
+    }
+    std::sort(stream_keys.begin(), stream_keys.end());
+    for (const auto& key : stream_keys) {
+      StreamQueueProfile* profile = result->add_stream_queue_profiles();
+      *profile = std::move(stream_profiles[key]);
+      profile->set_node_id(key.first);
+      profile->set_stream_id(key.second);
+    }
+  }
+
   void Clear() {
     task_events_.clear();
     hop_events_.clear();
   }
 
  private:
+  // A calculator invocation identified by node_id and input_ts.
+  using TaskKey = std::pair<int, int64_t>;
+  // A packet identified by stream_id and packet_ts.
+  using HopKey = std::pair<int32_t, int64_t>;
+  // A packet arriving at an input stream, by node_id, stream_id and packet_ts.
+  using QueueKey = std::tuple<int, int32_t, int64_t>;
+
+  // The timing of one calculator invocation, gathered from its TraceEvents.
+  struct TaskTiming {
+    int node_id = -1;
+    Timestamp input_ts = Timestamp::Unset();
+    absl::Time queue_time = absl::InfiniteFuture();
+    absl::Time ready_time = absl::InfiniteFuture();
+    absl::Time start_time = absl::InfiniteFuture();
+    absl::Time finish_time = absl::InfiniteFuture();
+    // The PROCESS input events, one for each input packet.
+    std::vector<const TraceEvent*> inputs;
+    // The input event of the last packet to arrive at the input queues.
+    const TraceEvent* critical_input = nullptr;
+  };
+
+  // Returns the TraceEvents between begin_time and end_time exclusive.
+  static std::vector<TraceEvent> SnapshotEvents(const TraceBuffer& buffer,
+                                                absl::Time begin_time,
+                                                absl::Time end_time) {
+    std::vector<TraceEvent> snapshot;
+    snapshot.reserve(10000);
+    TraceBuffer::iterator buffer_end = buffer.end();
+    for (auto iter = buffer.begin(); iter < buffer_end; ++iter) {
+      TraceEvent event = *iter;
+      if (event.event_time >= begin_time && event.event_time < end_time) {
+        snapshot.push_back(event);
+      }
+    }
+    return snapshot;
+  }
+
+  // Records the earliest time seen for a key.
+  template <typename Key>
+  static void KeepEarliest(const Key& key, absl::Time time,
+                           absl::flat_hash_map<Key, absl::Time>* times) {
+    auto [iter, inserted] = times->try_emplace(key, time);
+    if (!inserted) {
+      iter->second = std::min(iter->second, time);
+    }
+  }
+
+  // Returns the time an input packet was added to the input queue of a task.
+  // Only the last packet of each batch added is logged as PACKET_QUEUED, so
+  // the finish time of the producer is used for the others.
+  static absl::Time ArrivalTime(
+      const TaskTiming& task, const TraceEvent& input, int32_t stream_id,
+      const absl::flat_hash_map<TaskKey, TaskTiming>& tasks,
+      const absl::flat_hash_map<HopKey, TaskKey>& producers,
+      const absl::flat_hash_map<QueueKey, absl::Time>& queue_times) {
+    absl::Time arrival = task.start_time;
+    auto queued = queue_times.find(
+        QueueKey{task.node_id, stream_id, input.packet_ts.Value()});
+    if (queued != queue_times.end()) {
+      arrival = queued->second;
+    } else {
+      auto producer =
+          producers.find(HopKey{stream_id, input.packet_ts.Value()});
+      if (producer != producers.end()) {
+        auto producer_task = tasks.find(producer->second);
+        if (producer_task != tasks.end()) {
+          arrival = producer_task->second.finish_time;
+        }
+      }
+    }
+    return std::min(arrival, task.start_time);
+  }
+
+  // Returns the invocation that output the critical input of a task, or
+  // nullptr if it is a graph input or was not traced.
+  const TaskTiming* ProducerTask(
+      const TaskTiming& task,
+      const absl::flat_hash_map<TaskKey, TaskTiming>& tasks,
+      const absl::flat_hash_map<HopKey, TaskKey>& producers) {
+    if (task.critical_input == nullptr) {
+      return nullptr;
+    }
+    auto producer = producers.find(
+        HopKey{stream_id_map_.Find(task.critical_input->stream_id),
+               task.critical_input->packet_ts.Value()});
+    if (producer == producers.end()) {
+      return nullptr;
+    }
+    auto producer_task = tasks.find(producer->second);
+    if (producer_task == tasks.end() || producer_task->second.node_id < 0) {
+      return nullptr;
+    }
+    return &producer_task->second;
+  }
+
+  // Constructs the CriticalPath for one timestamp, and adds the queue and
+  // scheduler waits of its steps to the GraphTrace.
+  void BuildCriticalPath(int64_t ts, const std::vector<const TaskTiming*>& path,
+                         CriticalPath* result, GraphTrace* trace) {
+    result->set_input_timestamp(LogTimestamp(Timestamp(ts)));
+    for (const TaskTiming* task : path) {
+      CriticalPath::Step* step = result->add_step();
+      step->set_node_id(task->node_id);
+      step->set_input_timestamp(LogTimestamp(task->input_ts));
+      if (task->critical_input != nullptr) {
+        step->set_stream_id(
+            stream_id_map_.Find(task->critical_input->stream_id));
+      }
+      step->set_queue_time(LogTime(task->queue_time));
+      step->set_ready_time(LogTime(task->ready_time));
+      step->set_start_time(LogTime(task->start_time));
+      step->set_finish_time(LogTime(task->finish_time));
+      step->set_queue_wait_usec(step->ready_time() - step->queue_time());
+      step->set_scheduler_wait_usec(step->start_time() - step->ready_time());
+      step->set_execution_usec(step->finish_time() - step->start_time());
+      result->set_queue_wait_usec(result->queue_wait_usec() +
+                                  step->queue_wait_usec());
+      result->set_scheduler_wait_usec(result->scheduler_wait_usec() +
+                                      step->scheduler_wait_usec());
+      result->set_execution_usec(result->execution_usec() +
+                                 step->execution_usec());
+      if (trace != nullptr) {
+        AddWaitTrace(*step, GraphTrace::INPUT_QUEUE_WAIT, step->queue_time(),
+                     step->ready_time(), trace);
+        AddWaitTrace(*step, GraphTrace::SCHEDULER_WAIT, step->ready_time(),
+                     step->start_time(), trace);
+      }
+    }
+    if (result->step_size() > 0) {
+      result->set_total_usec(result->step(result->step_size() - 1)
+                                 .finish_time() -
+                             result->step(0).queue_time());
+    }
+  }
+
+  // Adds a waiting interval of a critical path step to the GraphTrace.
+  static void AddWaitTrace(const CriticalPath::Step& step,
+                           GraphTrace::EventType event_type, int64_t start_time,
+                           int64_t finish_time, GraphTrace* trace) {
+    if (finish_time <= start_time) {
+      return;
+    }
+    GraphTrace::CalculatorTrace* result = trace->add_calculator_trace();
+    result->set_node_id(step.node_id());
+    result->set_input_timestamp(step.input_timestamp());
+    result->set_event_type(event_type);
+    result->set_start_time(start_time);
+    result->set_finish_time(finish_time);
+    if (step.has_stream_id()) {
+      GraphTrace::StreamTrace* stream_trace = result->add_input_trace();
+      stream_trace->set_stream_id(step.stream_id());
+      stream_trace->set_packet_timestamp(step.input_timestamp());
+    }
+  }
+
   // Calculate the base timestamp and time.
   void SetBaseTime(const std::vector<TraceEvent>& snapshot) {
     if (base_time_ == std::numeric_limits<int64_t>::max()) {
@@ -420,6 +712,12 @@ void TraceBuilder::CreateLog(const TraceBuffer& buffer, absl::Time begin_time,
                              absl::Time end_time, GraphTrace* result) {
   impl_->CreateLog(buffer, begin_time, end_time, result);
 }
+void TraceBuilder::CreateCriticalPaths(const TraceBuffer& buffer,
+                                       absl::Time begin_time,
+                                       absl::Time end_time,
+                                       GraphProfile* result) {
+  impl_->CreateCriticalPaths(buffer, begin_time, end_time, result);
+}
 void TraceBuilder::Clear() { impl_->Clear(); }
 
 // Defined here since constexpr requires out-of-class definition until C++17.
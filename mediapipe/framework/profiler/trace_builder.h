@@ -43,6 +43,15 @@ class TraceBuilder {
   void CreateLog(const TraceBuffer& buffer, absl::Time begin_time,
                  absl::Time end_time, GraphTrace* result);
 
+  // Appends the critical path of each timestamp traced between begin_time and
+  // end_time exclusive to "result", along with the input queue waiting times
+  // of each stream. The waits on the critical paths are also appended as
+  // events to the last GraphTrace in "result", if any. Stream ids refer to
+  // the stream names already written by CreateTrace or CreateLog; packets on
+  // other streams are not linked and are reported with stream id 0.
+  void CreateCriticalPaths(const TraceBuffer& buffer, absl::Time begin_time,
+                           absl::Time end_time, GraphProfile* result);
+
   // Resets the TraceBuilder to begin building a new trace.
   void Clear();
 
@@ -103,10 +103,21 @@ absl::Status Scheduler::SetNonDefaultExecutor(const std::string& name,
   queue->SetIdleCallback(std::bind(&Scheduler::QueueIdleStateChanged, this,
                                    std::placeholders::_1));
   queue->SetExecutor(executor);
+  queue->SetQueueType(queue_type_, num_nodes_);
   scheduler_queues_.push_back(queue);
   return absl::OkStatus();
 }
 
+void Scheduler::SetQueueType(SchedulerQueueConfig::Type type, int num_nodes) {
+  ABSL_CHECK_EQ(state_, STATE_NOT_STARTED)
+      << "SetQueueType must not be called after the scheduler has started";
+  queue_type_ = type;
+  num_nodes_ = num_nodes;
+  for (auto queue : scheduler_queues_) {
+    queue->SetQueueType(type, num_nodes);
+  }
+}
+
 void Scheduler::SetQueuesRunning(bool running) {
   for (auto queue : scheduler_queues_) {
     queue->SetRunning(running);
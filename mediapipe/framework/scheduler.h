@@ -58,6 +58,12 @@ class Scheduler {
   absl::Status SetNonDefaultExecutor(const std::string& name,
                                      Executor* executor);
 
+  // Selects the item container of every scheduler queue, see
+  // SchedulerQueueConfig. num_nodes is the number of calculator nodes in the
+  // graph. Queues of executors set later get the same container. Must be
+  // called before the scheduler is started.
+  void SetQueueType(SchedulerQueueConfig::Type type, int num_nodes);
+
   // Resets the data members at the beginning of each graph run.
   void Reset();
 
@@ -266,6 +272,11 @@ class Scheduler {
   // Holds pointers to all queues used by the scheduler, for convenience.
   std::vector<SchedulerQueue*> scheduler_queues_;
 
+  // Item container of the scheduler queues and the number of calculator nodes
+  // it is sized for, as set by SetQueueType.
+  SchedulerQueueConfig::Type queue_type_ = SchedulerQueueConfig::PRIORITY_QUEUE;
+  int num_nodes_ = 0;
+
   // Priority queue of source nodes ordered by layer and then source process
   // order. This stores the set of sources that are yet to be run.
   std::priority_queue<SchedulerQueue::Item> sources_queue_
@@ -14,11 +14,20 @@
 
 #include "mediapipe/framework/scheduler_queue.h"
 
+#include <atomic>
 #include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
 #include <queue>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
+#include "absl/numeric/bits.h"
 #include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/calculator_node.h"
 #include "mediapipe/framework/executor.h"
@@ -85,21 +94,241 @@ bool SchedulerQueue::Item::operator<(const SchedulerQueue::Item& that) const {
   }
 }
 
+class SchedulerQueue::ItemQueue {
+ public:
+  virtual ~ItemQueue() = default;
+  virtual void Push(Item item) = 0;
+  // Removes and returns the highest priority item.
+  // REQUIRES: an item has been pushed and not yet popped.
+  virtual Item Pop() = 0;
+  virtual int Size() = 0;
+  virtual void Clear() = 0;
+};
+
+// A std::priority_queue guarded by a mutex.
+class SchedulerQueue::PriorityItemQueue : public SchedulerQueue::ItemQueue {
+ public:
+  void Push(Item item) override {
+    absl::MutexLock lock(&mutex_);
+    queue_.push(std::move(item));
+  }
+
+  Item Pop() override {
+    absl::MutexLock lock(&mutex_);
+    ABSL_CHECK(!queue_.empty())
+        << "Called RunNextTask when the queue is empty. "
+           "This should not happen.";
+    Item item = queue_.top();
+    queue_.pop();
+    return item;
+  }
+
+  int Size() override {
+    absl::MutexLock lock(&mutex_);
+    return queue_.size();
+  }
+
+  void Clear() override {
+    absl::MutexLock lock(&mutex_);
+    while (!queue_.empty()) {
+      queue_.pop();
+    }
+  }
+
+ private:
+  absl::Mutex mutex_;
+  std::priority_queue<Item> queue_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Keeps ProcessNode items of non-source nodes, which make up nearly all of the
+// traffic, in one shard per node. A bitmap with one bit per node records which
+// shards are non-empty; since non-sources run in decreasing id order, Pop
+// takes from the shard of the highest set bit. Adding and taking items of
+// different nodes therefore only share the atomic bitmap words.
+//
+// OpenNode items and source items are ordered by more than the node id, and
+// are rare, so each of these two bands keeps a mutex-guarded priority queue.
+//
+// The order matches Item::operator< for items that are in the queue at the
+// same time, except that a concurrent Pop may miss an item whose Push has not
+// completed yet, in which case it returns the next best item.
+class SchedulerQueue::ShardedItemQueue : public SchedulerQueue::ItemQueue {
+ public:
+  explicit ShardedItemQueue(int num_nodes)
+      : shards_(num_nodes), bitmap_((num_nodes + 63) / 64) {
+    for (auto& word : bitmap_) {
+      word.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  void Push(Item item) override {
+    size_.fetch_add(1, std::memory_order_relaxed);
+    if (item.IsOpenNode()) {
+      open_items_.Push(std::move(item));
+    } else if (item.IsSource()) {
+      source_items_.Push(std::move(item));
+    } else {
+      const int id = item.Id();
+      ABSL_CHECK_LT(id, shards_.size());
+      Shard& shard = shards_[id];
+      absl::MutexLock lock(&shard.mutex);
+      shard.items.push_back(std::move(item));
+      if (shard.items.size() == 1) {
+        bitmap_[id / 64].fetch_or(Bit(id), std::memory_order_release);
+      }
+    }
+  }
+
+  Item Pop() override {
+    // Pop is only called for an item that has been pushed, so one of the
+    // bands is bound to have it; retry if it was taken by a concurrent Pop
+    // (which then took another item meant for us). That item may have been
+    // pushed after this sweep read the bitmap, so a retry normally succeeds
+    // right away; yield in case its Push has not completed yet.
+    for (int attempt = 0;; ++attempt) {
+      if (attempt > 0) Backoff(attempt);
+      if (open_items_.MaybeNonEmpty()) {
+        std::optional<Item> item = open_items_.TryPop();
+        if (item) return Popped(std::move(*item));
+      }
+      for (int w = bitmap_.size() - 1; w >= 0; --w) {
+        uint64_t bits = bitmap_[w].load(std::memory_order_acquire);
+        while (bits != 0) {
+          const int bit = 63 - absl::countl_zero(bits);
+          std::optional<Item> item = TryPopShard(w * 64 + bit);
+          if (item) return Popped(std::move(*item));
+          bits &= ~(uint64_t{1} << bit);
+        }
+      }
+      if (source_items_.MaybeNonEmpty()) {
+        std::optional<Item> item = source_items_.TryPop();
+        if (item) return Popped(std::move(*item));
+      }
+    }
+  }
+
+  int Size() override { return size_.load(std::memory_order_relaxed); }
+
+  void Clear() override {
+    open_items_.Clear();
+    source_items_.Clear();
+    for (int id = 0; id < shards_.size(); ++id) {
+      absl::MutexLock lock(&shards_[id].mutex);
+      shards_[id].items.clear();
+    }
+    for (auto& word : bitmap_) {
+      word.store(0, std::memory_order_relaxed);
+    }
+    size_.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  struct Shard {
+    absl::Mutex mutex;
+    // Items of a single node have equal priority and are run in FIFO order.
+    std::deque<Item> items ABSL_GUARDED_BY(mutex);
+  };
+
+  // A mutex-guarded priority queue with a lock-free emptiness hint.
+  class Band {
+   public:
+    void Push(Item item) {
+      absl::MutexLock lock(&mutex_);
+      queue_.push(std::move(item));
+      size_.store(queue_.size(), std::memory_order_release);
+    }
+
+    bool MaybeNonEmpty() const {
+      return size_.load(std::memory_order_acquire) > 0;
+    }
+
+    std::optional<Item> TryPop() {
+      absl::MutexLock lock(&mutex_);
+      if (queue_.empty()) return std::nullopt;
+      Item item = queue_.top();
+      queue_.pop();
+      size_.store(queue_.size(), std::memory_order_release);
+      return item;
+    }
+
+    void Clear() {
+      absl::MutexLock lock(&mutex_);
+      while (!queue_.empty()) {
+        queue_.pop();
+      }
+      size_.store(0, std::memory_order_release);
+    }
+
+   private:
+    absl::Mutex mutex_;
+    std::priority_queue<Item> queue_ ABSL_GUARDED_BY(mutex_);
+    std::atomic<int> size_{0};
+  };
+
+  static uint64_t Bit(int id) { return uint64_t{1} << (id % 64); }
+
+  // Retries right away at first, then yields between sweeps. The missing
+  // item is one whose Push is under way, so the wait is short and a sleep
+  // would only add to the latency of the task.
+  static void Backoff(int attempt) {
+    constexpr int kNumSpins = 4;
+    if (attempt >= kNumSpins) std::this_thread::yield();
+  }
+
+  std::optional<Item> TryPopShard(int id) {
+    Shard& shard = shards_[id];
+    absl::MutexLock lock(&shard.mutex);
+    if (shard.items.empty()) return std::nullopt;
+    Item item = std::move(shard.items.front());
+    shard.items.pop_front();
+    if (shard.items.empty()) {
+      bitmap_[id / 64].fetch_and(~Bit(id), std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  Item Popped(Item item) {
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    return item;
+  }
+
+  Band open_items_;
+  Band source_items_;
+  std::vector<Shard> shards_;
+  std::vector<std::atomic<uint64_t>> bitmap_;
+  std::atomic<int> size_{0};
+};
+
+SchedulerQueue::SchedulerQueue(absl::string_view queue_name,
+                               SchedulerShared* shared)
+    : queue_name_(queue_name),
+      queue_(std::make_unique<PriorityItemQueue>()),
+      shared_(shared) {}
+
+SchedulerQueue::~SchedulerQueue() = default;
+
+void SchedulerQueue::SetQueueType(SchedulerQueueConfig::Type type,
+                                  int num_nodes) {
+  ABSL_CHECK_EQ(queue_->Size(), 0);
+  switch (type) {
+    case SchedulerQueueConfig::SHARDED:
+      queue_ = std::make_unique<ShardedItemQueue>(num_nodes);
+      break;
+    default:
+      queue_ = std::make_unique<PriorityItemQueue>();
+      break;
+  }
+}
+
 void SchedulerQueue::Reset() {
   absl::MutexLock lock(&mutex_);
-  num_pending_tasks_ = 0;
+  num_unfinished_tasks_ = 0;
   num_tasks_to_add_ = 0;
   running_count_ = 0;
 }
 
 void SchedulerQueue::SetExecutor(Executor* executor) { executor_ = executor; }
 
-bool SchedulerQueue::IsIdle() {
-  VLOG(3) << "Scheduler queue (" << queue_name_ << ") empty: " << queue_.empty()
-          << ", # of pending tasks: " << num_pending_tasks_;
-  return queue_.empty() && num_pending_tasks_ == 0;
-}
-
 void SchedulerQueue::SetRunning(bool running) {
   absl::MutexLock lock(&mutex_);
   running_count_ += running ? 1 : -1;
@@ -131,30 +360,30 @@ void SchedulerQueue::AddNodeForOpen(CalculatorNode* node) {
 
 void SchedulerQueue::AddItemToQueue(Item&& item) {
   const CalculatorNode* node = item.Node();
-  bool was_idle;
+  const bool was_idle = num_unfinished_tasks_.fetch_add(1) == 0;
+  if (was_idle && idle_callback_) {
+    // Became not idle.
+    idle_callback_(false);
+  }
+  // Note: the item must only become visible to other threads after calling
+  // idle_callback_(false) above. Another thread could otherwise submit and
+  // run its task and report the queue idle first. This ensures that we never
+  // get an idle_callback_(true) that is not preceded by the corresponding
+  // idle_callback_(false). See the comments on SetIdleCallback for details.
+  queue_->Push(std::move(item));
+  VLOG(4) << node->DebugName() << " was added to the scheduler queue ("
+          << queue_name_ << ")";
+
   int tasks_to_add = 0;
   {
     absl::MutexLock lock(&mutex_);
-    was_idle = IsIdle();
-    queue_.push(item);
     ++num_tasks_to_add_;
-    VLOG(4) << node->DebugName() << " was added to the scheduler queue ("
-            << queue_name_ << ")";
-
     // Now grab the tasks to execute while still holding the lock. This will
     // gather any waiting tasks, in addition to the one we just added.
     if (running_count_ > 0) {
       tasks_to_add = GetTasksToSubmitToExecutor();
     }
   }
-  if (was_idle && idle_callback_) {
-    // Became not idle.
-    idle_callback_(false);
-  }
-  // Note: this should be done after calling idle_callback_(false) above.
-  // This ensures that we never get an idle_callback_(true) that is not
-  // preceded by the corresponding idle_callback_(false). See the comments on
-  // SetIdleCallback for details.
   while (tasks_to_add > 0) {
     executor_->AddTask(this);
     --tasks_to_add;
@@ -162,9 +391,8 @@ void SchedulerQueue::AddItemToQueue(Item&& item) {
 }
 
 int SchedulerQueue::GetTasksToSubmitToExecutor() {
-  int tasks_to_add = num_tasks_to_add_;
+  const int tasks_to_add = num_tasks_to_add_;
   num_tasks_to_add_ = 0;
-  num_pending_tasks_ += tasks_to_add;
   return tasks_to_add;
 }
 
@@ -186,24 +414,12 @@ void SchedulerQueue::SubmitWaitingTasksToExecutor() {
 }
 
 void SchedulerQueue::RunNextTask() {
-  CalculatorNode* node;
-  CalculatorContext* calculator_context;
-  bool is_open_node;
-  {
-    absl::MutexLock lock(&mutex_);
-
-    ABSL_CHECK(!queue_.empty())
-        << "Called RunNextTask when the queue is empty. "
-           "This should not happen.";
-
-    node = queue_.top().Node();
-    calculator_context = queue_.top().Context();
-    is_open_node = queue_.top().IsOpenNode();
-    queue_.pop();
-
-    ABSL_CHECK(!node->Closed())
-        << "Scheduled a node that was closed. This should not happen.";
-  }
+  const Item item = queue_->Pop();
+  CalculatorNode* node = item.Node();
+  CalculatorContext* calculator_context = item.Context();
+  const bool is_open_node = item.IsOpenNode();
+  ABSL_CHECK(!node->Closed())
+      << "Scheduled a node that was closed. This should not happen.";
 
   // On iOS, calculators may rely on the existence of an autorelease pool
   // (either directly, or because system code they call does). We do not
@@ -219,13 +435,11 @@ void SchedulerQueue::RunNextTask() {
     }
   }
 
-  bool is_idle;
-  {
-    absl::MutexLock lock(&mutex_);
-    ABSL_DCHECK_GT(num_pending_tasks_, 0);
-    --num_pending_tasks_;
-    is_idle = IsIdle();
-  }
+  const int num_unfinished_tasks = num_unfinished_tasks_.fetch_sub(1);
+  ABSL_DCHECK_GT(num_unfinished_tasks, 0);
+  const bool is_idle = num_unfinished_tasks == 1;
+  VLOG(3) << "Scheduler queue (" << queue_name_
+          << ") # of unfinished tasks: " << num_unfinished_tasks - 1;
   if (is_idle && idle_callback_) {
     // Became idle.
     idle_callback_(true);
@@ -303,17 +517,17 @@ void SchedulerQueue::OpenCalculatorNode(CalculatorNode* node) {
 }
 
 void SchedulerQueue::CleanupAfterRun() {
-  bool was_idle;
+  int num_tasks_to_add;
   {
     absl::MutexLock lock(&mutex_);
-    was_idle = IsIdle();
-    ABSL_CHECK_EQ(num_pending_tasks_, 0);
-    ABSL_CHECK_EQ(num_tasks_to_add_, queue_.size());
-    num_tasks_to_add_ = 0;
-    while (!queue_.empty()) {
-      queue_.pop();
-    }
+    num_tasks_to_add = GetTasksToSubmitToExecutor();
   }
+  const int num_unfinished_tasks = num_unfinished_tasks_.exchange(0);
+  const bool was_idle = num_unfinished_tasks == 0;
+  // No task may be pending on the executor at this point.
+  ABSL_CHECK_EQ(num_unfinished_tasks, num_tasks_to_add);
+  ABSL_CHECK_EQ(num_tasks_to_add, queue_->Size());
+  queue_->Clear();
   if (!was_idle && idle_callback_) {
     // Became idle.
     idle_callback_(true);
@@ -15,15 +15,17 @@
 #ifndef MEDIAPIPE_FRAMEWORK_SCHEDULER_QUEUE_H_
 #define MEDIAPIPE_FRAMEWORK_SCHEDULER_QUEUE_H_
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
-#include <queue>
+#include <memory>
 #include <string>
 #include <utility>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/calculator.pb.h"
 #include "mediapipe/framework/calculator_context.h"
 #include "mediapipe/framework/executor.h"
 #include "mediapipe/framework/scheduler_shared.h"
@@ -35,6 +37,12 @@ class CalculatorNode;
 namespace internal {
 
 // Manages a priority queue of nodes to be run on the associated executor.
+//
+// Items are kept in a container selected with SetQueueType: a mutex-guarded
+// priority queue by default, or a container sharded by node (see
+// SchedulerQueueConfig). The running state and the count of tasks to submit
+// are guarded by mutex_, which is only held to update them, not to access the
+// container or to run tasks.
 class SchedulerQueue : public TaskQueue {
  public:
   // Callback to be invoked when the queue's idle state changes.
@@ -55,6 +63,10 @@ class SchedulerQueue : public TaskQueue {
 
     bool IsOpenNode() const { return is_open_node_; }
 
+    bool IsSource() const { return is_source_; }
+
+    int Id() const { return id_; }
+
     // This comparison is meant to be used with a std::priority_queue. Since
     // the priority queue returns higher priority items first, this function
     // means "this is lower priority than that", i.e. "this runs after that".
@@ -76,8 +88,13 @@ class SchedulerQueue : public TaskQueue {
     bool is_open_node_ = false;  // True if the task should run OpenNode().
   };
 
-  explicit SchedulerQueue(absl::string_view queue_name, SchedulerShared* shared)
-      : queue_name_(queue_name), shared_(shared) {}
+  SchedulerQueue(absl::string_view queue_name, SchedulerShared* shared);
+  ~SchedulerQueue() override;
+
+  // Selects the container holding the queued items. num_nodes bounds the node
+  // ids that can be added. Must be called before the scheduler is started.
+  // The default is SchedulerQueueConfig::PRIORITY_QUEUE.
+  void SetQueueType(SchedulerQueueConfig::Type type, int num_nodes);
 
   // Sets the executor that will run the nodes. Must be called before the
   // scheduler is started.
@@ -108,10 +125,10 @@ class SchedulerQueue : public TaskQueue {
   // queue was not running.
   void SetRunning(bool running) ABSL_LOCKS_EXCLUDED(mutex_);
 
-  // Gets the number of tasks that need to be submitted to the executor, and
-  // updates num_pending_tasks_. If this method is called and returns a
-  // non-zero value, the executor's AddTask method *must* be called for each
-  // task returned, but it can be called without holding the lock.
+  // Takes the number of tasks that need to be submitted to the executor. If
+  // this method returns a non-zero value, the executor's AddTask method *must*
+  // be called for each task returned, but it can be called without holding
+  // the lock.
   int GetTasksToSubmitToExecutor() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   // Submits tasks that are waiting (e.g. that were added while the queue was
@@ -122,29 +139,29 @@ class SchedulerQueue : public TaskQueue {
   // not already running. Note that if the node was running, then it will be
   // rescheduled upon completion (after checking dependencies), so this call is
   // not lost.
-  void AddNode(CalculatorNode* node, CalculatorContext* cc)
-      ABSL_LOCKS_EXCLUDED(mutex_);
+  void AddNode(CalculatorNode* node, CalculatorContext* cc);
 
   // Adds a node to the scheduler queue for an OpenNode() call.
-  void AddNodeForOpen(CalculatorNode* node) ABSL_LOCKS_EXCLUDED(mutex_);
+  void AddNodeForOpen(CalculatorNode* node);
 
   // Adds an Item to queue_.
-  void AddItemToQueue(Item&& item);
+  void AddItemToQueue(Item&& item) ABSL_LOCKS_EXCLUDED(mutex_);
 
   void CleanupAfterRun() ABSL_LOCKS_EXCLUDED(mutex_);
 
  private:
+  // Container of queued items. Implementations are thread-safe.
+  class ItemQueue;
+  class PriorityItemQueue;
+  class ShardedItemQueue;
+
   // Used internally by RunNextTask. Invokes ProcessNode or CloseNode, followed
   // by EndScheduling.
-  void RunCalculatorNode(CalculatorNode* node, CalculatorContext* cc)
-      ABSL_LOCKS_EXCLUDED(mutex_);
+  void RunCalculatorNode(CalculatorNode* node, CalculatorContext* cc);
 
   // Used internally by RunNextTask. Invokes OpenNode, followed by
   // CheckIfBecameReady.
-  void OpenCalculatorNode(CalculatorNode* node) ABSL_LOCKS_EXCLUDED(mutex_);
-
-  // Checks whether the queue has no queued nodes or pending tasks.
-  bool IsIdle() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void OpenCalculatorNode(CalculatorNode* node);
 
   // Queue name for logging purposes.
   const std::string queue_name_;
@@ -160,14 +177,19 @@ class SchedulerQueue : public TaskQueue {
   // Invariant: running_count_ <= 1.
   int running_count_ ABSL_GUARDED_BY(mutex_) = 0;
 
-  // Number of tasks added to the Executor and not yet complete.
-  int num_pending_tasks_ ABSL_GUARDED_BY(mutex_);
+  // Number of tasks that need to be added to the Executor. Checking
+  // running_count_ and taking these tasks happen under one lock, so no task is
+  // submitted after SetRunning(false) returns.
+  int num_tasks_to_add_ ABSL_GUARDED_BY(mutex_) = 0;
 
-  // Number of tasks that need to be added to the Executor.
-  int num_tasks_to_add_ ABSL_GUARDED_BY(mutex_);
+  // Number of items added to the queue whose task has not completed yet, i.e.
+  // the number of tasks still to be added to the Executor plus the number of
+  // tasks added to the Executor and not yet complete. The queue is idle when
+  // this is zero; the transitions from and to zero drive idle_callback_.
+  std::atomic<int> num_unfinished_tasks_{0};
 
   // Queue of nodes that need to be run.
-  std::priority_queue<Item> queue_ ABSL_GUARDED_BY(mutex_);
+  std::unique_ptr<ItemQueue> queue_;
 
   SchedulerShared* const shared_;
 
@@ -0,0 +1,140 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/executor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+// Number of nodes in the test graph. More than 64, so that the nodes of the
+// sharded queue span two words of its bitmap.
+constexpr int kNumNodes = 70;
+
+// Appends "Open:<node name>" to the log in Open() and the node name to the
+// log in Process().
+class RecordingCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    cc->Inputs().Index(0).Set<int>();
+    cc->InputSidePackets().Tag("LOG").Set<std::vector<std::string>*>();
+    return absl::OkStatus();
+  }
+
+  absl::Status Open(CalculatorContext* cc) override {
+    log_ = cc->InputSidePackets().Tag("LOG").Get<std::vector<std::string>*>();
+    log_->push_back(absl::StrCat("Open:", cc->NodeName()));
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    log_->push_back(cc->NodeName());
+    return absl::OkStatus();
+  }
+
+ private:
+  std::vector<std::string>* log_ = nullptr;
+};
+REGISTER_CALCULATOR(RecordingCalculator);
+
+// Holds the scheduled tasks until RunPendingTasks() runs them on the calling
+// thread. All the nodes that become ready in between are in the scheduler
+// queue at the same time, so the tasks run them in priority order.
+class ManualExecutor : public Executor {
+ public:
+  void Schedule(std::function<void()> task) override {
+    tasks_.push_back(std::move(task));
+  }
+
+  void RunPendingTasks() {
+    while (!tasks_.empty()) {
+      std::function<void()> task = std::move(tasks_.front());
+      tasks_.pop_front();
+      task();
+    }
+  }
+
+ private:
+  std::deque<std::function<void()>> tasks_;
+};
+
+std::string NodeName(int id) { return absl::StrCat("node_", id); }
+
+class SchedulerQueueTest
+    : public ::testing::TestWithParam<SchedulerQueueConfig::Type> {};
+
+TEST_P(SchedulerQueueTest, RunsNodesInPriorityOrder) {
+  CalculatorGraphConfig config;
+  config.add_input_stream("in");
+  config.add_input_side_packet("log");
+  config.mutable_scheduler_queue()->set_type(GetParam());
+  for (int id = 0; id < kNumNodes; ++id) {
+    CalculatorGraphConfig::Node* node = config.add_node();
+    node->set_name(NodeName(id));
+    node->set_calculator("RecordingCalculator");
+    node->add_input_stream("in");
+    node->add_input_side_packet("LOG:log");
+  }
+  auto executor = std::make_shared<ManualExecutor>();
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.SetExecutor("", executor));
+  MP_ASSERT_OK(graph.Initialize(config));
+  std::vector<std::string> log;
+  MP_ASSERT_OK(graph.StartRun(
+      {{"log", MakePacket<std::vector<std::string>*>(&log)}}));
+
+  // OpenNode() runs in increasing node id order.
+  executor->RunPendingTasks();
+  std::vector<std::string> expected_log;
+  for (int id = 0; id < kNumNodes; ++id) {
+    expected_log.push_back(absl::StrCat("Open:", NodeName(id)));
+  }
+  EXPECT_THAT(log, ElementsAreArray(expected_log));
+
+  // ProcessNode() of non-source nodes runs in decreasing node id order.
+  log.clear();
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "in", MakePacket<int>(0).At(Timestamp(0))));
+  executor->RunPendingTasks();
+  expected_log.clear();
+  for (int id = kNumNodes - 1; id >= 0; --id) {
+    expected_log.push_back(NodeName(id));
+  }
+  EXPECT_THAT(log, ElementsAreArray(expected_log));
+
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  executor->RunPendingTasks();
+  MP_ASSERT_OK(graph.WaitUntilDone());
+}
+
+INSTANTIATE_TEST_SUITE_P(QueueTypes, SchedulerQueueTest,
+                         ::testing::Values(SchedulerQueueConfig::PRIORITY_QUEUE,
+                                           SchedulerQueueConfig::SHARDED));
+
+}  // namespace
+}  // namespace mediapipe
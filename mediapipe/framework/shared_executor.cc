@@ -0,0 +1,262 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/shared_executor.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/absl_check.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/port/status_builder.h"
+#include "mediapipe/framework/shared_executor.pb.h"
+#include "mediapipe/util/cpu_util.h"
+
+namespace mediapipe {
+
+namespace {
+
+// Weight of the latest task in the moving average of the task processing time.
+constexpr double kAverageTaskUsecAlpha = 0.125;
+
+struct PoolRegistry {
+  absl::Mutex mutex;
+  absl::flat_hash_map<std::string, std::weak_ptr<SharedExecutorPool>> pools
+      ABSL_GUARDED_BY(mutex);
+};
+
+PoolRegistry& GetPoolRegistry() {
+  static PoolRegistry* registry = new PoolRegistry();
+  return *registry;
+}
+
+}  // namespace
+
+// static
+std::shared_ptr<SharedExecutorPool> SharedExecutorPool::Create(
+    const std::string& name_prefix, int num_threads) {
+  return Create(ThreadOptions(), name_prefix, num_threads);
+}
+
+// static
+std::shared_ptr<SharedExecutorPool> SharedExecutorPool::Create(
+    const ThreadOptions& thread_options, const std::string& name_prefix,
+    int num_threads) {
+  return std::shared_ptr<SharedExecutorPool>(
+      new SharedExecutorPool(thread_options, name_prefix, num_threads));
+}
+
+// static
+std::shared_ptr<SharedExecutorPool> SharedExecutorPool::GetOrCreate(
+    const std::string& pool_name, const ThreadOptions& thread_options,
+    int num_threads) {
+  PoolRegistry& registry = GetPoolRegistry();
+  absl::MutexLock lock(&registry.mutex);
+  std::weak_ptr<SharedExecutorPool>& entry = registry.pools[pool_name];
+  if (std::shared_ptr<SharedExecutorPool> pool = entry.lock()) {
+    if (pool->num_threads() != num_threads) {
+      VLOG(1) << "Shared executor pool \"" << pool_name << "\" already has "
+              << pool->num_threads() << " threads; ignoring num_threads "
+              << num_threads << ".";
+    }
+    return pool;
+  }
+  const std::string& name_prefix = thread_options.name_prefix().empty()
+                                       ? pool_name
+                                       : thread_options.name_prefix();
+  std::shared_ptr<SharedExecutorPool> pool =
+      Create(thread_options, name_prefix, num_threads);
+  entry = pool;
+  return pool;
+}
+
+SharedExecutorPool::SharedExecutorPool(const ThreadOptions& thread_options,
+                                       const std::string& name_prefix,
+                                       int num_threads)
+    : thread_pool_(thread_options, name_prefix, num_threads) {
+  thread_pool_.StartWorkers();
+  VLOG(2) << "Started shared executor pool \"" << name_prefix << "\" with "
+          << num_threads << " threads.";
+}
+
+SharedExecutorPool::~SharedExecutorPool() {
+  VLOG(2) << "Terminating shared executor pool.";
+}
+
+std::unique_ptr<SharedExecutor> SharedExecutorPool::CreateExecutor(
+    ExecutorOptions options) {
+  return std::unique_ptr<SharedExecutor>(
+      new SharedExecutor(shared_from_this(), std::move(options)));
+}
+
+void SharedExecutorPool::AddClient(Client* client) {
+  VLOG(2) << "Attaching executor \"" << client->options.name
+          << "\" to shared executor pool with weight "
+          << client->options.weight << ".";
+  absl::MutexLock lock(&mutex_);
+  client->virtual_time = virtual_time_;
+  clients_.push_back(client);
+}
+
+void SharedExecutorPool::RemoveClient(Client* client) {
+  absl::MutexLock lock(&mutex_);
+  mutex_.Await(absl::Condition(
+      +[](Client* client) {
+        return client->tasks.empty() && client->num_running == 0;
+      },
+      client));
+  clients_.erase(std::find(clients_.begin(), clients_.end(), client));
+  VLOG(2) << "Detached executor \"" << client->options.name
+          << "\" from shared executor pool after running "
+          << client->num_tasks_run << " tasks for " << client->total_run_time
+          << ", with a maximum queue wait of " << client->max_queue_wait
+          << ".";
+}
+
+void SharedExecutorPool::Schedule(Client* client, std::function<void()> task) {
+  {
+    absl::MutexLock lock(&mutex_);
+    if (client->tasks.empty() && client->num_running == 0) {
+      // An idle client resumes at the current virtual time, so that it does
+      // not get ahead of the busy clients for the time it was idle.
+      client->virtual_time = std::max(client->virtual_time, virtual_time_);
+    }
+    client->tasks.push_back({std::move(task), absl::Now()});
+  }
+  thread_pool_.Schedule([this] { RunNextTask(); });
+}
+
+SharedExecutorPool::Client* SharedExecutorPool::PickClient(absl::Time now) {
+  Client* fair_pick = nullptr;
+  Client* overdue_pick = nullptr;
+  absl::Time overdue_deadline = absl::InfiniteFuture();
+  for (Client* client : clients_) {
+    if (client->tasks.empty()) continue;
+    if (client->options.latency_slo > absl::ZeroDuration()) {
+      const absl::Time deadline =
+          client->tasks.front().enqueue_time + client->options.latency_slo;
+      if (deadline <= now && deadline < overdue_deadline) {
+        overdue_pick = client;
+        overdue_deadline = deadline;
+      }
+    }
+    if (fair_pick == nullptr ||
+        client->virtual_time < fair_pick->virtual_time) {
+      fair_pick = client;
+    }
+  }
+  return overdue_pick != nullptr ? overdue_pick : fair_pick;
+}
+
+void SharedExecutorPool::RunNextTask() {
+  Client* client;
+  PendingTask pending;
+  double charged_usec;
+  const absl::Time start_time = absl::Now();
+  {
+    absl::MutexLock lock(&mutex_);
+    client = PickClient(start_time);
+    // There is exactly one call per scheduled task, so a task is pending.
+    ABSL_CHECK(client != nullptr);
+    pending = std::move(client->tasks.front());
+    client->tasks.pop_front();
+    ++client->num_running;
+    virtual_time_ = std::max(virtual_time_, client->virtual_time);
+    charged_usec = client->average_task_usec;
+    client->virtual_time += charged_usec * client->inverse_weight;
+  }
+
+  pending.task();
+
+  const absl::Time end_time = absl::Now();
+  const double run_usec = absl::ToDoubleMicroseconds(end_time - start_time);
+  absl::MutexLock lock(&mutex_);
+  client->virtual_time += (run_usec - charged_usec) * client->inverse_weight;
+  client->average_task_usec +=
+      kAverageTaskUsecAlpha * (run_usec - client->average_task_usec);
+  --client->num_running;
+  ++client->num_tasks_run;
+  client->total_run_time += end_time - start_time;
+  client->max_queue_wait =
+      std::max(client->max_queue_wait, start_time - pending.enqueue_time);
+}
+
+// static
+absl::StatusOr<Executor*> SharedExecutor::Create(
+    const MediaPipeOptions& extendable_options) {
+  auto& options = extendable_options.GetExtension(SharedExecutorOptions::ext);
+  if (options.weight() <= 0) {
+    return mediapipe::InvalidArgumentErrorBuilder(MEDIAPIPE_LOC)
+           << "The weight field in SharedExecutorOptions should be positive "
+              "but is "
+           << options.weight();
+  }
+  if (options.latency_slo_usec() < 0) {
+    return mediapipe::InvalidArgumentErrorBuilder(MEDIAPIPE_LOC)
+           << "The latency_slo_usec field in SharedExecutorOptions should not "
+              "be negative but is "
+           << options.latency_slo_usec();
+  }
+  int num_threads = options.num_threads();
+  if (num_threads <= 0) {
+    num_threads = NumCPUCores();
+  }
+  ThreadOptions thread_options;
+  if (options.has_thread_name_prefix()) {
+    thread_options.set_name_prefix(options.thread_name_prefix());
+  }
+  std::shared_ptr<SharedExecutorPool> pool = SharedExecutorPool::GetOrCreate(
+      options.pool_name(), thread_options, num_threads);
+  SharedExecutorPool::ExecutorOptions executor_options;
+  // The ExecutorConfig name is not passed to executor factories, so the pool
+  // name identifies the executor.
+  executor_options.name = options.pool_name();
+  executor_options.weight = options.weight();
+  executor_options.latency_slo = absl::Microseconds(options.latency_slo_usec());
+  return pool->CreateExecutor(std::move(executor_options)).release();
+}
+
+SharedExecutor::SharedExecutor(std::shared_ptr<SharedExecutorPool> pool,
+                               SharedExecutorPool::ExecutorOptions options)
+    : pool_(std::move(pool)) {
+  ABSL_CHECK_GT(options.weight, 0);
+  client_.inverse_weight = 1.0 / options.weight;
+  client_.options = std::move(options);
+  pool_->AddClient(&client_);
+}
+
+SharedExecutor::~SharedExecutor() { pool_->RemoveClient(&client_); }
+
+void SharedExecutor::Schedule(std::function<void()> task) {
+  pool_->Schedule(&client_, std::move(task));
+}
+
+SharedExecutor::Stats SharedExecutor::GetStats() const {
+  absl::MutexLock lock(&pool_->mutex_);
+  Stats stats;
+  stats.num_tasks_run = client_.num_tasks_run;
+  stats.total_run_time = client_.total_run_time;
+  stats.max_queue_wait = client_.max_queue_wait;
+  return stats;
+}
+
+REGISTER_EXECUTOR(SharedExecutor);
+
+}  // namespace mediapipe
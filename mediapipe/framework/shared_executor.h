@@ -0,0 +1,174 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_SHARED_EXECUTOR_H_
+#define MEDIAPIPE_FRAMEWORK_SHARED_EXECUTOR_H_
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/deps/thread_options.h"
+#include "mediapipe/framework/executor.h"
+#include "mediapipe/framework/port/statusor.h"
+#include "mediapipe/framework/port/threadpool.h"
+
+namespace mediapipe {
+
+class SharedExecutor;
+
+// A pool of worker threads shared by the executors of several graphs.
+//
+// Each SharedExecutor attached to the pool has its own task queue. Idle
+// workers pick the next task with weighted fair queuing: every executor has a
+// virtual time that advances by the processing time of its tasks divided by
+// its weight, and the executor with the smallest virtual time runs next. An
+// executor that was idle resumes at the current virtual time of the pool, so
+// it cannot save up credit. A task whose executor has a latency hint and that
+// has waited longer than that hint runs first, earliest deadline first.
+//
+// Sample usage:
+//
+//   auto pool = SharedExecutorPool::Create("cameras", 16);
+//   for (CalculatorGraph& graph : graphs) {
+//     MP_RETURN_IF_ERROR(graph.SetExecutor("", pool->CreateExecutor({})));
+//   }
+//
+// Graphs can also attach to a named process-wide pool through an
+// ExecutorConfig of type "SharedExecutor"; see SharedExecutorOptions.
+class SharedExecutorPool
+    : public std::enable_shared_from_this<SharedExecutorPool> {
+ public:
+  struct ExecutorOptions {
+    // Identifies the executor in the log messages of the pool.
+    std::string name;
+    // Share of the processing time relative to the other executors.
+    double weight = 1.0;
+    // See SharedExecutorOptions.latency_slo_usec. Zero means no hint.
+    absl::Duration latency_slo = absl::ZeroDuration();
+  };
+
+  // Creates a pool that is not registered under any name.
+  static std::shared_ptr<SharedExecutorPool> Create(
+      const std::string& name_prefix, int num_threads);
+  static std::shared_ptr<SharedExecutorPool> Create(
+      const ThreadOptions& thread_options, const std::string& name_prefix,
+      int num_threads);
+
+  // Returns the process-wide pool registered as "pool_name", creating it if
+  // no executor currently uses it. The thread options and num_threads are
+  // ignored if the pool exists already. The pool is destroyed when the last
+  // executor attached to it and the last returned pointer are released.
+  static std::shared_ptr<SharedExecutorPool> GetOrCreate(
+      const std::string& pool_name, const ThreadOptions& thread_options,
+      int num_threads);
+
+  SharedExecutorPool(const SharedExecutorPool&) = delete;
+  SharedExecutorPool& operator=(const SharedExecutorPool&) = delete;
+
+  // Waits for all scheduled tasks to complete.
+  ~SharedExecutorPool();
+
+  // Returns a new executor that runs its tasks on this pool.
+  std::unique_ptr<SharedExecutor> CreateExecutor(ExecutorOptions options);
+
+  int num_threads() const { return thread_pool_.num_threads(); }
+
+ private:
+  friend class SharedExecutor;
+
+  struct PendingTask {
+    std::function<void()> task;
+    absl::Time enqueue_time;
+  };
+
+  // The queue and scheduling state of one SharedExecutor.
+  struct Client {
+    ExecutorOptions options;
+    double inverse_weight = 1.0;
+    // Virtual time, in weighted microseconds of processing time.
+    double virtual_time = 0;
+    // Moving average of the processing time of the client's tasks, in
+    // microseconds. Charged when a task starts, and corrected with the actual
+    // processing time when it finishes, so that a client cannot take all the
+    // workers at once.
+    double average_task_usec = 1;
+    std::deque<PendingTask> tasks;
+    int num_running = 0;
+    int64_t num_tasks_run = 0;
+    absl::Duration total_run_time;
+    absl::Duration max_queue_wait;
+  };
+
+  SharedExecutorPool(const ThreadOptions& thread_options,
+                     const std::string& name_prefix, int num_threads);
+
+  void AddClient(Client* client);
+  // Waits for the tasks of "client" to complete and detaches it.
+  void RemoveClient(Client* client);
+  void Schedule(Client* client, std::function<void()> task);
+  // Runs the next task chosen by the fair queuing policy. Called once per
+  // scheduled task on a worker thread.
+  void RunNextTask();
+  Client* PickClient(absl::Time now) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  absl::Mutex mutex_;
+  std::vector<Client*> clients_ ABSL_GUARDED_BY(mutex_);
+  // The virtual time of the most recently started task.
+  double virtual_time_ ABSL_GUARDED_BY(mutex_) = 0;
+
+  // Declared last so that the workers are joined before the other members
+  // are destroyed.
+  ThreadPool thread_pool_;
+};
+
+// An executor that runs its tasks on a SharedExecutorPool. It can be used by
+// a single CalculatorGraph, like any other executor. The destructor waits for
+// the executor's pending tasks, so it must not be destroyed from one of them.
+class SharedExecutor : public Executor {
+ public:
+  struct Stats {
+    int64_t num_tasks_run = 0;
+    absl::Duration total_run_time;
+    absl::Duration max_queue_wait;
+  };
+
+  static absl::StatusOr<Executor*> Create(
+      const MediaPipeOptions& extendable_options);
+
+  ~SharedExecutor() override;
+  void Schedule(std::function<void()> task) override;
+
+  Stats GetStats() const;
+  const std::shared_ptr<SharedExecutorPool>& pool() const { return pool_; }
+
+ private:
+  friend class SharedExecutorPool;
+
+  SharedExecutor(std::shared_ptr<SharedExecutorPool> pool,
+                 SharedExecutorPool::ExecutorOptions options);
+
+  const std::shared_ptr<SharedExecutorPool> pool_;
+  SharedExecutorPool::Client client_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_SHARED_EXECUTOR_H_
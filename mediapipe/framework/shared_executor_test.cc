@@ -0,0 +1,225 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/shared_executor.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/shared_executor.pb.h"
+#include "mediapipe/framework/tool/sink.h"
+
+namespace mediapipe {
+namespace {
+
+void SpinFor(absl::Duration duration) {
+  const absl::Time deadline = absl::Now() + duration;
+  while (absl::Now() < deadline) {
+  }
+}
+
+// Runs the tasks of a single-threaded pool in a controlled order: blocks the
+// worker with a task of a separate executor until Release() is called.
+class BlockedPool {
+ public:
+  BlockedPool() : pool_(SharedExecutorPool::Create("test", 1)) {
+    gate_executor_ = pool_->CreateExecutor({.name = "gate"});
+    gate_executor_->Schedule([this] { release_.WaitForNotification(); });
+  }
+
+  ~BlockedPool() {
+    if (!release_.HasBeenNotified()) release_.Notify();
+  }
+
+  SharedExecutorPool& pool() { return *pool_; }
+  void Release() { release_.Notify(); }
+
+ private:
+  std::shared_ptr<SharedExecutorPool> pool_;
+  absl::Notification release_;
+  std::unique_ptr<SharedExecutor> gate_executor_;
+};
+
+TEST(SharedExecutorTest, CreateRequiresPositiveWeight) {
+  MediaPipeOptions options;
+  options.MutableExtension(SharedExecutorOptions::ext)->set_weight(0);
+  EXPECT_FALSE(SharedExecutor::Create(options).ok());
+}
+
+TEST(SharedExecutorTest, RunsAllScheduledTasks) {
+  constexpr int kNumTasks = 1000;
+  absl::BlockingCounter counter(2 * kNumTasks);
+  auto pool = SharedExecutorPool::Create("test", 4);
+  EXPECT_EQ(pool->num_threads(), 4);
+  auto executor_a = pool->CreateExecutor({.name = "a"});
+  auto executor_b = pool->CreateExecutor({.name = "b"});
+  for (int i = 0; i < kNumTasks; ++i) {
+    executor_a->Schedule([&counter] { counter.DecrementCount(); });
+    executor_b->Schedule([&counter] { counter.DecrementCount(); });
+  }
+  counter.Wait();
+}
+
+TEST(SharedExecutorTest, ReportsStats) {
+  auto pool = SharedExecutorPool::Create("test", 1);
+  auto executor = pool->CreateExecutor({.name = "a"});
+  for (int i = 0; i < 10; ++i) {
+    executor->Schedule([] { SpinFor(absl::Microseconds(100)); });
+  }
+  // With one worker, the earlier tasks are accounted for when this one runs,
+  // and this one may be too by the time GetStats() is called.
+  absl::Notification done;
+  executor->Schedule([&done] { done.Notify(); });
+  done.WaitForNotification();
+  SharedExecutor::Stats stats = executor->GetStats();
+  EXPECT_GE(stats.num_tasks_run, 10);
+  EXPECT_GE(stats.total_run_time, absl::Milliseconds(1));
+}
+
+TEST(SharedExecutorTest, SharesProcessingTimeByWeight) {
+  constexpr int kNumTasks = 40;
+  std::vector<std::string> order;
+  absl::Mutex mutex;
+  absl::BlockingCounter counter(2 * kNumTasks);
+  {
+    BlockedPool blocked_pool;
+    auto heavy = blocked_pool.pool().CreateExecutor({.weight = 3});
+    auto light = blocked_pool.pool().CreateExecutor({.weight = 1});
+    auto make_task = [&](std::string name) {
+      return [&, name] {
+        SpinFor(absl::Milliseconds(1));
+        absl::MutexLock lock(&mutex);
+        order.push_back(name);
+        counter.DecrementCount();
+      };
+    };
+    for (int i = 0; i < kNumTasks; ++i) {
+      heavy->Schedule(make_task("heavy"));
+      light->Schedule(make_task("light"));
+    }
+    blocked_pool.Release();
+    counter.Wait();
+  }
+
+  // While both executors have pending tasks, "heavy" gets three times the
+  // processing time of "light".
+  int num_heavy = 0;
+  for (int i = 0; i < kNumTasks; ++i) {
+    if (order[i] == "heavy") ++num_heavy;
+  }
+  EXPECT_GE(num_heavy, 26);
+  EXPECT_LE(num_heavy, 34);
+}
+
+TEST(SharedExecutorTest, RunsOverdueTasksFirst) {
+  std::vector<std::string> order;
+  absl::Mutex mutex;
+  absl::BlockingCounter counter(11);
+  {
+    BlockedPool blocked_pool;
+    auto bulk = blocked_pool.pool().CreateExecutor({.weight = 100});
+    auto interactive = blocked_pool.pool().CreateExecutor(
+        {.latency_slo = absl::Microseconds(1)});
+    auto make_task = [&](std::string name) {
+      return [&, name] {
+        absl::MutexLock lock(&mutex);
+        order.push_back(name);
+        counter.DecrementCount();
+      };
+    };
+    for (int i = 0; i < 10; ++i) {
+      bulk->Schedule(make_task("bulk"));
+    }
+    interactive->Schedule(make_task("interactive"));
+    absl::SleepFor(absl::Milliseconds(1));
+    blocked_pool.Release();
+    counter.Wait();
+  }
+  ASSERT_EQ(order.size(), 11);
+  EXPECT_EQ(order[0], "interactive");
+}
+
+TEST(SharedExecutorTest, GetOrCreateReturnsTheSamePool) {
+  auto pool =
+      SharedExecutorPool::GetOrCreate("shared_test", ThreadOptions(), 2);
+  EXPECT_EQ(SharedExecutorPool::GetOrCreate("shared_test", ThreadOptions(), 3),
+            pool);
+  EXPECT_EQ(pool->num_threads(), 2);
+  EXPECT_NE(SharedExecutorPool::GetOrCreate("other_test", ThreadOptions(), 2),
+            pool);
+}
+
+TEST(SharedExecutorTest, GraphsShareThePoolNamedInTheConfig) {
+  CalculatorGraphConfig config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "in"
+        executor {
+          type: "SharedExecutor"
+          options {
+            [mediapipe.SharedExecutorOptions.ext] {
+              pool_name: "graph_test"
+              num_threads: 2
+            }
+          }
+        }
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "in"
+          output_stream: "out"
+        }
+      )pb");
+  std::vector<Packet> out_a;
+  std::vector<Packet> out_b;
+  CalculatorGraphConfig config_a = config;
+  CalculatorGraphConfig config_b = config;
+  tool::AddVectorSink("out", &config_a, &out_a);
+  tool::AddVectorSink("out", &config_b, &out_b);
+  CalculatorGraph graph_a;
+  CalculatorGraph graph_b;
+  MP_ASSERT_OK(graph_a.Initialize(config_a));
+  MP_ASSERT_OK(graph_b.Initialize(config_b));
+  MP_ASSERT_OK(graph_a.StartRun({}));
+  MP_ASSERT_OK(graph_b.StartRun({}));
+  // Both graphs hold the pool, so it is not recreated with 4 threads.
+  EXPECT_EQ(
+      SharedExecutorPool::GetOrCreate("graph_test", ThreadOptions(), 4)
+          ->num_threads(),
+      2);
+  for (int i = 0; i < 10; ++i) {
+    MP_ASSERT_OK(graph_a.AddPacketToInputStream(
+        "in", MakePacket<int>(i).At(Timestamp(i))));
+    MP_ASSERT_OK(graph_b.AddPacketToInputStream(
+        "in", MakePacket<int>(i).At(Timestamp(i))));
+  }
+  MP_ASSERT_OK(graph_a.CloseAllInputStreams());
+  MP_ASSERT_OK(graph_b.CloseAllInputStreams());
+  MP_ASSERT_OK(graph_a.WaitUntilDone());
+  MP_ASSERT_OK(graph_b.WaitUntilDone());
+  EXPECT_EQ(out_a.size(), 10);
+  EXPECT_EQ(out_b.size(), 10);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -22,6 +22,7 @@
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "mediapipe/framework/calculator_context_manager.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/collection_item_id.h"
@@ -159,18 +160,31 @@ NodeReadiness FixedSizeInputStreamHandler::GetNodeReadiness(
   return result;
 }
 
+void FixedSizeInputStreamHandler::AddPackets(
+    CollectionItemId id, absl::Span<const Packet> packets) {
+  InputStreamHandler::AddPackets(id, packets);
+  EraseSurplusIfNotPending();
+}
+
+void FixedSizeInputStreamHandler::MovePackets(CollectionItemId id,
+                                              absl::Span<Packet> packets) {
+  InputStreamHandler::MovePackets(id, packets);
+  EraseSurplusIfNotPending();
+}
+
 void FixedSizeInputStreamHandler::AddPackets(CollectionItemId id,
                                              const std::list<Packet>& packets) {
   InputStreamHandler::AddPackets(id, packets);
-  absl::MutexLock lock(&erase_mutex_);
-  if (!pending_) {
-    EraseSurplusPackets(false);
-  }
+  EraseSurplusIfNotPending();
 }
 
 void FixedSizeInputStreamHandler::MovePackets(CollectionItemId id,
                                               std::list<Packet>* packets) {
   InputStreamHandler::MovePackets(id, packets);
+  EraseSurplusIfNotPending();
+}
+
+void FixedSizeInputStreamHandler::EraseSurplusIfNotPending() {
   absl::MutexLock lock(&erase_mutex_);
   if (!pending_) {
     EraseSurplusPackets(false);
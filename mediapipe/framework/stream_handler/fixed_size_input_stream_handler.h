@@ -21,6 +21,7 @@
 
 #include "absl/base/thread_annotations.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "mediapipe/framework/calculator_context_manager.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/collection_item_id.h"
@@ -83,11 +84,20 @@ class FixedSizeInputStreamHandler : public DefaultInputStreamHandler {
 
   NodeReadiness GetNodeReadiness(Timestamp* min_stream_timestamp) override;
 
+  void AddPackets(CollectionItemId id,
+                  absl::Span<const Packet> packets) override;
+
+  void MovePackets(CollectionItemId id, absl::Span<Packet> packets) override;
+
   void AddPackets(CollectionItemId id,
                   const std::list<Packet>& packets) override;
 
   void MovePackets(CollectionItemId id, std::list<Packet>* packets) override;
 
+  // Drops surplus packets after packets are queued, unless an input set is
+  // pending.
+  void EraseSurplusIfNotPending();
+
   void FillInputSet(Timestamp input_timestamp,
                     InputStreamShardSet* input_set) override;
 
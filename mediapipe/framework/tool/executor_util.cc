@@ -18,31 +18,52 @@
 
 #include "mediapipe/framework/mediapipe_options.pb.h"
 #include "mediapipe/framework/thread_pool_executor.pb.h"
+#include "mediapipe/framework/work_stealing_executor.pb.h"
 
 namespace mediapipe {
 namespace tool {
 
-void EnsureMinimumDefaultExecutorStackSize(const int32_t min_stack_size,
-                                           CalculatorGraphConfig* config) {
-  mediapipe::ExecutorConfig* default_executor_config = nullptr;
+namespace {
+
+constexpr char kThreadPoolExecutorType[] = "ThreadPoolExecutor";
+constexpr char kWorkStealingExecutorType[] = "WorkStealingExecutor";
+
+// Returns the ExecutorConfig of the default executor, adding one if needed.
+mediapipe::ExecutorConfig* GetOrAddDefaultExecutorConfig(
+    CalculatorGraphConfig* config) {
   for (mediapipe::ExecutorConfig& executor_config :
        *config->mutable_executor()) {
     if (executor_config.name().empty()) {
-      default_executor_config = &executor_config;
-      break;
+      return &executor_config;
     }
   }
-  if (!default_executor_config) {
-    default_executor_config = config->add_executor();
-    if (config->num_threads()) {
-      default_executor_config->mutable_options()
-          ->MutableExtension(mediapipe::ThreadPoolExecutorOptions::ext)
-          ->set_num_threads(config->num_threads());
-      config->clear_num_threads();
+  mediapipe::ExecutorConfig* default_executor_config = config->add_executor();
+  if (config->num_threads()) {
+    default_executor_config->mutable_options()
+        ->MutableExtension(mediapipe::ThreadPoolExecutorOptions::ext)
+        ->set_num_threads(config->num_threads());
+    config->clear_num_threads();
+  }
+  return default_executor_config;
+}
+
+}  // namespace
+
+void EnsureMinimumDefaultExecutorStackSize(const int32_t min_stack_size,
+                                           CalculatorGraphConfig* config) {
+  mediapipe::ExecutorConfig* default_executor_config =
+      GetOrAddDefaultExecutorConfig(config);
+  if (default_executor_config->type() == kWorkStealingExecutorType) {
+    mediapipe::WorkStealingExecutorOptions* extension =
+        default_executor_config->mutable_options()->MutableExtension(
+            mediapipe::WorkStealingExecutorOptions::ext);
+    if (extension->stack_size() < min_stack_size) {
+      extension->set_stack_size(min_stack_size);
     }
+    return;
   }
   if (default_executor_config->type().empty() ||
-      default_executor_config->type() == "ThreadPoolExecutor") {
+      default_executor_config->type() == kThreadPoolExecutorType) {
     mediapipe::ThreadPoolExecutorOptions* extension =
         default_executor_config->mutable_options()->MutableExtension(
             mediapipe::ThreadPoolExecutorOptions::ext);
@@ -52,5 +73,40 @@ void EnsureMinimumDefaultExecutorStackSize(const int32_t min_stack_size,
   }
 }
 
+void UseWorkStealingDefaultExecutor(CalculatorGraphConfig* config) {
+  mediapipe::ExecutorConfig* default_executor_config =
+      GetOrAddDefaultExecutorConfig(config);
+  if (!default_executor_config->type().empty() &&
+      default_executor_config->type() != kThreadPoolExecutorType) {
+    return;
+  }
+  mediapipe::MediaPipeOptions* options =
+      default_executor_config->mutable_options();
+  const mediapipe::ThreadPoolExecutorOptions thread_pool_options =
+      options->GetExtension(mediapipe::ThreadPoolExecutorOptions::ext);
+  options->ClearExtension(mediapipe::ThreadPoolExecutorOptions::ext);
+  mediapipe::WorkStealingExecutorOptions* work_stealing_options =
+      options->MutableExtension(mediapipe::WorkStealingExecutorOptions::ext);
+  if (thread_pool_options.num_threads() > 0) {
+    work_stealing_options->set_num_threads(thread_pool_options.num_threads());
+  }
+  if (thread_pool_options.has_stack_size()) {
+    work_stealing_options->set_stack_size(thread_pool_options.stack_size());
+  }
+  if (thread_pool_options.has_nice_priority_level()) {
+    work_stealing_options->set_nice_priority_level(
+        thread_pool_options.nice_priority_level());
+  }
+  if (thread_pool_options.has_require_processor_performance()) {
+    work_stealing_options->set_require_processor_performance(
+        thread_pool_options.require_processor_performance());
+  }
+  if (thread_pool_options.has_thread_name_prefix()) {
+    work_stealing_options->set_thread_name_prefix(
+        thread_pool_options.thread_name_prefix());
+  }
+  default_executor_config->set_type(kWorkStealingExecutorType);
+}
+
 }  // namespace tool
 }  // namespace mediapipe
@@ -29,6 +29,14 @@ namespace tool {
 // this.
 void EnsureMinimumDefaultExecutorStackSize(int32_t min_stack_size,
                                            CalculatorGraphConfig* config);
+
+// Makes the default executor a WorkStealingExecutor.
+//
+// If the default executor is configured with an unspecified type or as a
+// ThreadPoolExecutor, its ThreadPoolExecutorOptions (or the graph-level
+// num_threads) are carried over to WorkStealingExecutorOptions. Does nothing if
+// the default executor already has a different type.
+void UseWorkStealingDefaultExecutor(CalculatorGraphConfig* config);
 }  // namespace tool
 }  // namespace mediapipe
 
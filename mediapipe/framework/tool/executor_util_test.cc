@@ -118,4 +118,88 @@ TEST(GraphTest, MinimumDefaultExecutorStackSizeNumThreads) {
   EXPECT_THAT(config, EqualsProto(expected_config));
 }
 
+TEST(GraphTest, MinimumDefaultExecutorStackSizeWorkStealingExecutor) {
+  CalculatorGraphConfig config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        executor {
+          type: "WorkStealingExecutor"
+          options {
+            [mediapipe.WorkStealingExecutorOptions.ext] { num_threads: 2 }
+          }
+        }
+      )pb");
+  CalculatorGraphConfig expected_config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        executor {
+          type: "WorkStealingExecutor"
+          options {
+            [mediapipe.WorkStealingExecutorOptions.ext] {
+              num_threads: 2
+              stack_size: 131072
+            }
+          }
+        }
+      )pb");
+  tool::EnsureMinimumDefaultExecutorStackSize(131072, &config);
+  EXPECT_THAT(config, EqualsProto(expected_config));
+}
+
+TEST(GraphTest, UseWorkStealingDefaultExecutorCarriesOverOptions) {
+  CalculatorGraphConfig config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        executor {
+          options {
+            [mediapipe.ThreadPoolExecutorOptions.ext] {
+              num_threads: 4
+              stack_size: 131072
+              thread_name_prefix: "worker"
+            }
+          }
+        }
+      )pb");
+  CalculatorGraphConfig expected_config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        executor {
+          type: "WorkStealingExecutor"
+          options {
+            [mediapipe.WorkStealingExecutorOptions.ext] {
+              num_threads: 4
+              stack_size: 131072
+              thread_name_prefix: "worker"
+            }
+          }
+        }
+      )pb");
+  tool::UseWorkStealingDefaultExecutor(&config);
+  EXPECT_THAT(config, EqualsProto(expected_config));
+}
+
+TEST(GraphTest, UseWorkStealingDefaultExecutorNumThreads) {
+  CalculatorGraphConfig config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        num_threads: 3
+      )pb");
+  CalculatorGraphConfig expected_config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        executor {
+          type: "WorkStealingExecutor"
+          options {
+            [mediapipe.WorkStealingExecutorOptions.ext] { num_threads: 3 }
+          }
+        }
+      )pb");
+  tool::UseWorkStealingDefaultExecutor(&config);
+  EXPECT_THAT(config, EqualsProto(expected_config));
+}
+
+TEST(GraphTest, UseWorkStealingDefaultExecutorKeepsOtherTypes) {
+  CalculatorGraphConfig config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        executor { type: "ApplicationThreadExecutor" }
+      )pb");
+  CalculatorGraphConfig expected_config = config;
+  tool::UseWorkStealingDefaultExecutor(&config);
+  EXPECT_THAT(config, EqualsProto(expected_config));
+}
+
 }  // namespace mediapipe
@@ -0,0 +1,94 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/tool/metrics_exporter.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/log/absl_check.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/port/file_helpers.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe::tool {
+
+absl::Status FileMetricsSink::Write(absl::string_view metrics) {
+  const std::string temp_path = absl::StrCat(path_, ".tmp");
+  MP_RETURN_IF_ERROR(file::SetContents(temp_path, metrics));
+  if (std::rename(temp_path.c_str(), path_.c_str()) != 0) {
+    return absl::UnavailableError(
+        absl::StrCat("Failed to rename ", temp_path, " to ", path_));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status LatestMetricsSink::Write(absl::string_view metrics) {
+  absl::MutexLock lock(&mutex_);
+  metrics_ = std::string(metrics);
+  return absl::OkStatus();
+}
+
+std::string LatestMetricsSink::Get() const {
+  absl::MutexLock lock(&mutex_);
+  return metrics_;
+}
+
+MetricsExporter::MetricsExporter()
+    : thread_pool_("MetricsExporter", /*num_threads=*/1) {}
+
+MetricsExporter::~MetricsExporter() { Stop(); }
+
+absl::Status MetricsExporter::StartInBackground(
+    absl::Duration interval, std::shared_ptr<MetricsSink> sink,
+    absl::AnyInvocable<absl::StatusOr<std::string>()> get_metrics_fn) {
+  RET_CHECK(!is_running_.HasBeenNotified());
+  RET_CHECK(sink != nullptr);
+  RET_CHECK_GT(interval, absl::ZeroDuration());
+  sink_ = std::move(sink);
+  get_metrics_fn_ = std::move(get_metrics_fn);
+  ABSL_CHECK_EQ(thread_pool_.num_threads(), 1);
+  thread_pool_.StartWorkers();
+  thread_pool_.Schedule([this, interval]() {
+    is_running_.Notify();
+    while (!shutdown_signal_.HasBeenNotified()) {
+      const auto metrics = get_metrics_fn_();
+      if (!metrics.ok()) {
+        ABSL_LOG(DFATAL) << "Failed to get graph metrics: " << metrics.status();
+        return;
+      }
+      const absl::Status status = sink_->Write(*metrics);
+      if (!status.ok()) {
+        ABSL_LOG_EVERY_N_SEC(WARNING, 60)
+            << "Failed to export graph metrics: " << status;
+      }
+      shutdown_signal_.WaitForNotificationWithTimeout(interval);
+    }
+  });
+  is_running_.WaitForNotification();
+  return absl::OkStatus();
+}
+
+void MetricsExporter::Stop() { shutdown_signal_.Notify(); }
+
+}  // namespace mediapipe::tool
@@ -0,0 +1,94 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_TOOL_METRICS_EXPORTER_H_
+#define MEDIAPIPE_FRAMEWORK_TOOL_METRICS_EXPORTER_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/port/threadpool.h"
+
+namespace mediapipe::tool {
+
+// Receives the metrics of a graph as OpenMetrics text.
+class MetricsSink {
+ public:
+  virtual ~MetricsSink() = default;
+
+  // Receives a complete metrics exposition, ending with "# EOF".
+  virtual absl::Status Write(absl::string_view metrics) = 0;
+};
+
+// Writes each metrics exposition to a file, replacing the previous one, for
+// file based collectors such as the node_exporter textfile collector.
+class FileMetricsSink : public MetricsSink {
+ public:
+  explicit FileMetricsSink(std::string path) : path_(std::move(path)) {}
+
+  // Writes to a temporary file that is then renamed to "path", so readers
+  // never see a partial exposition.
+  absl::Status Write(absl::string_view metrics) override;
+
+ private:
+  const std::string path_;
+};
+
+// Keeps the latest metrics exposition in memory, for example to serve it
+// from an HTTP handler.
+class LatestMetricsSink : public MetricsSink {
+ public:
+  absl::Status Write(absl::string_view metrics) override;
+
+  // Returns the latest metrics exposition, or an empty string if none.
+  std::string Get() const;
+
+ private:
+  mutable absl::Mutex mutex_;
+  std::string metrics_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Periodically collects the graph metrics and writes them to a MetricsSink.
+class MetricsExporter {
+ public:
+  MetricsExporter();
+  ~MetricsExporter();
+
+  // Starts the exporter in the background. Can be called only once.
+  absl::Status StartInBackground(
+      absl::Duration interval, std::shared_ptr<MetricsSink> sink,
+      absl::AnyInvocable<absl::StatusOr<std::string>()> get_metrics_fn);
+
+ private:
+  void Stop();
+
+  absl::Notification shutdown_signal_;
+  absl::Notification is_running_;
+  std::shared_ptr<MetricsSink> sink_;
+  absl::AnyInvocable<absl::StatusOr<std::string>()> get_metrics_fn_;
+  ThreadPool thread_pool_;
+};
+
+}  // namespace mediapipe::tool
+
+#endif  // MEDIAPIPE_FRAMEWORK_TOOL_METRICS_EXPORTER_H_
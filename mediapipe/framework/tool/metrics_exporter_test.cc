@@ -0,0 +1,89 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/tool/metrics_exporter.h"
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/port/file_helpers.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe::tool {
+namespace {
+
+// Records the first exposition it receives.
+class NotifyingMetricsSink : public MetricsSink {
+ public:
+  absl::Status Write(absl::string_view metrics) override {
+    if (!written_.HasBeenNotified()) {
+      metrics_ = std::string(metrics);
+      written_.Notify();
+    }
+    return absl::OkStatus();
+  }
+
+  absl::Notification written_;
+  std::string metrics_;
+};
+
+TEST(MetricsExporterTest, ShouldExportMetrics) {
+  auto sink = std::make_shared<NotifyingMetricsSink>();
+  MetricsExporter exporter;
+  MP_ASSERT_OK(exporter.StartInBackground(
+      absl::Milliseconds(10), sink,
+      []() { return std::string("mediapipe_counter_total 1\n# EOF\n"); }));
+  ASSERT_TRUE(sink->written_.WaitForNotificationWithTimeout(absl::Seconds(10)));
+  EXPECT_EQ(sink->metrics_, "mediapipe_counter_total 1\n# EOF\n");
+}
+
+TEST(MetricsExporterTest, ShouldRejectSecondStart) {
+  MetricsExporter exporter;
+  auto sink = std::make_shared<LatestMetricsSink>();
+  auto get_metrics = []() { return std::string("# EOF\n"); };
+  MP_ASSERT_OK(
+      exporter.StartInBackground(absl::Seconds(1), sink, get_metrics));
+  EXPECT_FALSE(
+      exporter.StartInBackground(absl::Seconds(1), sink, get_metrics).ok());
+}
+
+TEST(MetricsExporterTest, LatestMetricsSinkKeepsLastWrite) {
+  LatestMetricsSink sink;
+  EXPECT_EQ(sink.Get(), "");
+  MP_ASSERT_OK(sink.Write("first\n# EOF\n"));
+  MP_ASSERT_OK(sink.Write("second\n# EOF\n"));
+  EXPECT_EQ(sink.Get(), "second\n# EOF\n");
+}
+
+TEST(MetricsExporterTest, FileMetricsSinkReplacesFile) {
+  const std::string path =
+      absl::StrCat(getenv("TEST_TMPDIR"), "/mediapipe_metrics.prom");
+  FileMetricsSink sink(path);
+  MP_ASSERT_OK(sink.Write("first\n# EOF\n"));
+  MP_ASSERT_OK(sink.Write("second\n# EOF\n"));
+  std::string contents;
+  MP_ASSERT_OK(file::GetContents(path, &contents));
+  EXPECT_EQ(contents, "second\n# EOF\n");
+}
+
+}  // namespace
+}  // namespace mediapipe::tool
@@ -0,0 +1,117 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/tool/open_metrics_utils.h"
+
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
+#include "absl/strings/string_view.h"
+#include "mediapipe/framework/calculator_profile.pb.h"
+#include "mediapipe/framework/graph_runtime_info.pb.h"
+
+namespace mediapipe::tool {
+namespace {
+
+constexpr char kProcessRuntime[] = "mediapipe_calculator_process_runtime_usec";
+constexpr char kQueueSize[] = "mediapipe_input_stream_queue_size";
+constexpr char kPacketsAdded[] = "mediapipe_input_stream_packets_added";
+constexpr char kCounter[] = "mediapipe_counter";
+
+// Escapes a label value as required by the OpenMetrics text format.
+std::string EscapeLabel(absl::string_view value) {
+  return absl::StrReplaceAll(value,
+                             {{"\\", "\\\\"}, {"\"", "\\\""}, {"\n", "\\n"}});
+}
+
+void AppendMetricFamily(absl::string_view name, absl::string_view type,
+                        absl::string_view help, std::string* out) {
+  absl::StrAppend(out, "# TYPE ", name, " ", type, "\n", "# HELP ", name, " ",
+                  help, "\n");
+}
+
+// Appends the cumulative buckets, count and sum of a TimeHistogram. Each
+// histogram interval [i * size, (i + 1) * size) becomes the bucket
+// le=(i + 1) * size, and the last interval becomes the +Inf bucket.
+void AppendHistogram(absl::string_view labels, const TimeHistogram& histogram,
+                     std::string* out) {
+  int64_t cumulative_count = 0;
+  for (int i = 0; i < histogram.count_size(); ++i) {
+    cumulative_count += histogram.count(i);
+    const std::string bound =
+        i + 1 < histogram.count_size()
+            ? absl::StrCat((i + 1) * histogram.interval_size_usec())
+            : "+Inf";
+    absl::StrAppend(out, kProcessRuntime, "_bucket{", labels, ",le=\"", bound,
+                    "\"} ", cumulative_count, "\n");
+  }
+  absl::StrAppend(out, kProcessRuntime, "_count{", labels, "} ",
+                  cumulative_count, "\n");
+  absl::StrAppend(out, kProcessRuntime, "_sum{", labels, "} ",
+                  histogram.total(), "\n");
+}
+
+}  // namespace
+
+std::string GetOpenMetricsString(const GraphMetrics& metrics) {
+  std::string out;
+  if (!metrics.calculator_profiles.empty()) {
+    AppendMetricFamily(kProcessRuntime, "histogram",
+                       "Calculator::Process() runtime in microseconds.", &out);
+    for (const CalculatorProfile& profile : metrics.calculator_profiles) {
+      if (!profile.has_process_runtime()) continue;
+      AppendHistogram(
+          absl::StrCat("calculator=\"", EscapeLabel(profile.name()), "\""),
+          profile.process_runtime(), &out);
+    }
+  }
+
+  AppendMetricFamily(kQueueSize, "gauge",
+                     "Number of packets queued in a calculator input stream.",
+                     &out);
+  for (const auto& calculator : metrics.runtime_info.calculator_infos()) {
+    for (const auto& stream : calculator.input_stream_infos()) {
+      absl::StrAppend(&out, kQueueSize, "{calculator=\"",
+                      EscapeLabel(calculator.calculator_name()),
+                      "\",stream=\"", EscapeLabel(stream.stream_name()),
+                      "\"} ", stream.queue_size(), "\n");
+    }
+  }
+
+  AppendMetricFamily(kPacketsAdded, "counter",
+                     "Number of packets added to a calculator input stream.",
+                     &out);
+  for (const auto& calculator : metrics.runtime_info.calculator_infos()) {
+    for (const auto& stream : calculator.input_stream_infos()) {
+      absl::StrAppend(&out, kPacketsAdded, "_total{calculator=\"",
+                      EscapeLabel(calculator.calculator_name()),
+                      "\",stream=\"", EscapeLabel(stream.stream_name()),
+                      "\"} ", stream.number_of_packets_added(), "\n");
+    }
+  }
+
+  if (!metrics.counters.empty()) {
+    AppendMetricFamily(kCounter, "counter", "MediaPipe graph counters.", &out);
+    for (const auto& [name, value] : metrics.counters) {
+      absl::StrAppend(&out, kCounter, "_total{name=\"", EscapeLabel(name),
+                      "\"} ", value, "\n");
+    }
+  }
+  absl::StrAppend(&out, "# EOF\n");
+  return out;
+}
+
+}  // namespace mediapipe::tool
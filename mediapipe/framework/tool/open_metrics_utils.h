@@ -0,0 +1,49 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_TOOL_OPEN_METRICS_UTILS_H_
+#define MEDIAPIPE_FRAMEWORK_TOOL_OPEN_METRICS_UTILS_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/calculator_profile.pb.h"
+#include "mediapipe/framework/graph_runtime_info.pb.h"
+
+namespace mediapipe::tool {
+
+// The metrics of a running graph, as collected by
+// CalculatorGraph::GetOpenMetrics().
+struct GraphMetrics {
+  // The input stream queues of each calculator.
+  GraphRuntimeInfo runtime_info;
+  // The Process() runtimes of each calculator. Empty if the profiler is off.
+  std::vector<CalculatorProfile> calculator_profiles;
+  // The values of the graph counters, such as the frames dropped by a
+  // FlowLimiterCalculator or the throttling of graph input streams.
+  std::map<std::string, int64_t> counters;
+};
+
+// Renders graph metrics in the OpenMetrics text format:
+//   mediapipe_calculator_process_runtime_usec: histogram per calculator.
+//   mediapipe_input_stream_queue_size: gauge per calculator input stream.
+//   mediapipe_input_stream_packets_added: counter per calculator input stream.
+//   mediapipe_counter: counter per graph counter, labeled by counter name.
+std::string GetOpenMetricsString(const GraphMetrics& metrics);
+
+}  // namespace mediapipe::tool
+
+#endif  // MEDIAPIPE_FRAMEWORK_TOOL_OPEN_METRICS_UTILS_H_
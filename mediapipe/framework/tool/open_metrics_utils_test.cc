@@ -0,0 +1,83 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/tool/open_metrics_utils.h"
+
+#include "mediapipe/framework/calculator_profile.pb.h"
+#include "mediapipe/framework/graph_runtime_info.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+
+namespace mediapipe::tool {
+namespace {
+
+TEST(OpenMetricsUtilsTest, ShouldRenderGraphMetrics) {
+  GraphMetrics metrics;
+  metrics.runtime_info = ParseTextProtoOrDie<GraphRuntimeInfo>(R"pb(
+    calculator_infos {
+      calculator_name: "FlowLimiterCalculator"
+      input_stream_infos {
+        stream_name: "input_video"
+        queue_size: 3
+        number_of_packets_added: 10
+      }
+    }
+  )pb");
+  metrics.calculator_profiles.push_back(ParseTextProtoOrDie<CalculatorProfile>(
+      R"pb(
+        name: "FlowLimiterCalculator"
+        process_runtime {
+          total: 2500
+          interval_size_usec: 1000
+          num_intervals: 3
+          count: [ 1, 0, 2 ]
+        }
+      )pb"));
+  metrics.counters["FlowLimiterCalculator-dropped_frames"] = 4;
+  metrics.counters["CalculatorGraph-throttled_graph_input_streams"] = 2;
+
+  EXPECT_EQ(
+      GetOpenMetricsString(metrics),
+      R"(# TYPE mediapipe_calculator_process_runtime_usec histogram
+# HELP mediapipe_calculator_process_runtime_usec Calculator::Process() runtime in microseconds.
+mediapipe_calculator_process_runtime_usec_bucket{calculator="FlowLimiterCalculator",le="1000"} 1
+mediapipe_calculator_process_runtime_usec_bucket{calculator="FlowLimiterCalculator",le="2000"} 1
+mediapipe_calculator_process_runtime_usec_bucket{calculator="FlowLimiterCalculator",le="+Inf"} 3
+mediapipe_calculator_process_runtime_usec_count{calculator="FlowLimiterCalculator"} 3
+mediapipe_calculator_process_runtime_usec_sum{calculator="FlowLimiterCalculator"} 2500
+# TYPE mediapipe_input_stream_queue_size gauge
+# HELP mediapipe_input_stream_queue_size Number of packets queued in a calculator input stream.
+mediapipe_input_stream_queue_size{calculator="FlowLimiterCalculator",stream="input_video"} 3
+# TYPE mediapipe_input_stream_packets_added counter
+# HELP mediapipe_input_stream_packets_added Number of packets added to a calculator input stream.
+mediapipe_input_stream_packets_added_total{calculator="FlowLimiterCalculator",stream="input_video"} 10
+# TYPE mediapipe_counter counter
+# HELP mediapipe_counter MediaPipe graph counters.
+mediapipe_counter_total{name="CalculatorGraph-throttled_graph_input_streams"} 2
+mediapipe_counter_total{name="FlowLimiterCalculator-dropped_frames"} 4
+# EOF
+)");
+}
+
+TEST(OpenMetricsUtilsTest, ShouldEscapeLabelValues) {
+  GraphMetrics metrics;
+  metrics.counters["say \"hi\"\\"] = 1;
+  EXPECT_THAT(GetOpenMetricsString(metrics),
+              testing::HasSubstr(
+                  R"(mediapipe_counter_total{name="say \"hi\"\\"} 1)"));
+}
+
+}  // namespace
+}  // namespace mediapipe::tool
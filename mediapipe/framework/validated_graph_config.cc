@@ -671,18 +671,26 @@ absl::Status ValidatedGraphConfig::AddInputStreamsForNode(
   const int node_index = node_type_info->Node().index;
   const PacketTypeSet& input_stream_types = node_type_info->InputStreamTypes();
   std::vector<bool> is_back_edge;  // Indexed by CollectionItemId.
+  std::vector<int> queue_capacity;  // Indexed by CollectionItemId.
   if (!config_.node(node_index).input_stream_info().empty()) {
     is_back_edge.resize(input_stream_types.NumEntries(), false);
+    queue_capacity.resize(input_stream_types.NumEntries(), 0);
     for (const auto& input_stream_info :
          config_.node(node_index).input_stream_info()) {
-      if (input_stream_info.back_edge()) {
+      if (input_stream_info.back_edge() ||
+          input_stream_info.queue_capacity() > 0) {
         std::string tag;
         int index;
         MP_RETURN_IF_ERROR(
             tool::ParseTagIndex(input_stream_info.tag_index(), &tag, &index));
         CollectionItemId id = input_stream_types.GetId(tag, index);
         RET_CHECK(id.IsValid());
-        is_back_edge[id.value()] = true;
+        if (input_stream_info.back_edge()) {
+          is_back_edge[id.value()] = true;
+        }
+        if (input_stream_info.queue_capacity() > 0) {
+          queue_capacity[id.value()] = input_stream_info.queue_capacity();
+        }
       }
     }
   }
@@ -693,6 +701,8 @@ absl::Status ValidatedGraphConfig::AddInputStreamsForNode(
     input_streams_.emplace_back();
     auto& edge_info = input_streams_.back();
     edge_info.back_edge = !is_back_edge.empty() && is_back_edge[id.value()];
+    edge_info.queue_capacity =
+        queue_capacity.empty() ? 0 : queue_capacity[id.value()];
 
     auto iter = stream_to_producer_.find(name);
     if (iter != stream_to_producer_.end()) {
@@ -195,6 +195,9 @@ struct EdgeInfo {
   std::string name;
   PacketType* packet_type = nullptr;
   bool back_edge = false;  // Only applicable to input streams.
+  // Preallocated input queue capacity, or 0 for the default.  Only applicable
+  // to input streams.
+  int queue_capacity = 0;
 };
 
 // This class is used to validate and canonicalize a CalculatorGraphConfig.
@@ -0,0 +1,63 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_WORK_STEALING_EXECUTOR_H_
+#define MEDIAPIPE_FRAMEWORK_WORK_STEALING_EXECUTOR_H_
+
+#include <cstdint>
+#include <functional>
+
+#include "mediapipe/framework/deps/thread_options.h"
+#include "mediapipe/framework/deps/work_stealing_thread_pool.h"
+#include "mediapipe/framework/executor.h"
+#include "mediapipe/framework/port/statusor.h"
+
+namespace mediapipe {
+
+// A multithreaded executor based on a work-stealing thread pool.
+//
+// Tasks added from the executor's own worker threads (which is where the
+// scheduler adds most of them, when a calculator's outputs make downstream
+// nodes ready) are queued without taking any shared lock. Select it in the
+// graph config with executor type "WorkStealingExecutor" and
+// WorkStealingExecutorOptions.
+class WorkStealingExecutor : public Executor {
+ public:
+  static absl::StatusOr<Executor*> Create(
+      const MediaPipeOptions& extendable_options);
+
+  explicit WorkStealingExecutor(int num_threads);
+  ~WorkStealingExecutor() override;
+  void Schedule(std::function<void()> task) override;
+
+  // For testing.
+  int num_threads() const { return thread_pool_.num_threads(); }
+  int64_t num_steals() const { return thread_pool_.num_steals(); }
+  // Returns the thread stack size (in bytes).
+  size_t stack_size() const { return stack_size_; }
+
+ private:
+  WorkStealingExecutor(const ThreadOptions& thread_options, int num_threads,
+                       bool pin_threads);
+
+  // Saves the value of the stack size option and starts the thread pool.
+  void Start();
+
+  WorkStealingThreadPool thread_pool_;
+  size_t stack_size_ = 0;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_WORK_STEALING_EXECUTOR_H_
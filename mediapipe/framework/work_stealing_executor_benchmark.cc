@@ -0,0 +1,122 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Compares WorkStealingExecutor with ThreadPoolExecutor on synthetic graphs
+// made of many cheap calculators:
+// - "wide" graphs fan one input stream out to N pass-through nodes,
+// - "deep" graphs chain N pass-through nodes.
+//
+// $ bazel run -c opt \
+//   mediapipe/framework:work_stealing_executor_benchmark
+
+#include <string>
+
+#include "absl/log/absl_check.h"
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/thread_pool_executor.pb.h"
+#include "mediapipe/framework/work_stealing_executor.pb.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr int kNumPacketsPerIteration = 100;
+
+enum ExecutorType { kThreadPool = 0, kWorkStealing = 1 };
+
+void SetDefaultExecutor(ExecutorType type, int num_threads,
+                        CalculatorGraphConfig* config) {
+  ExecutorConfig* executor = config->add_executor();
+  if (type == kWorkStealing) {
+    executor->set_type("WorkStealingExecutor");
+    executor->mutable_options()
+        ->MutableExtension(WorkStealingExecutorOptions::ext)
+        ->set_num_threads(num_threads);
+  } else {
+    executor->set_type("ThreadPoolExecutor");
+    executor->mutable_options()
+        ->MutableExtension(ThreadPoolExecutorOptions::ext)
+        ->set_num_threads(num_threads);
+  }
+}
+
+CalculatorGraphConfig WideGraph(int width) {
+  CalculatorGraphConfig config;
+  config.add_input_stream("in");
+  for (int i = 0; i < width; ++i) {
+    auto* node = config.add_node();
+    node->set_calculator("PassThroughCalculator");
+    node->add_input_stream("in");
+    node->add_output_stream(absl::StrCat("out", i));
+  }
+  return config;
+}
+
+CalculatorGraphConfig DeepGraph(int depth) {
+  CalculatorGraphConfig config;
+  config.add_input_stream("s0");
+  for (int i = 0; i < depth; ++i) {
+    auto* node = config.add_node();
+    node->set_calculator("PassThroughCalculator");
+    node->add_input_stream(absl::StrCat("s", i));
+    node->add_output_stream(absl::StrCat("s", i + 1));
+  }
+  return config;
+}
+
+void RunGraph(benchmark::State& state, CalculatorGraphConfig config,
+              const std::string& input_stream) {
+  const auto type = static_cast<ExecutorType>(state.range(0));
+  const int num_threads = state.range(2);
+  SetDefaultExecutor(type, num_threads, &config);
+  CalculatorGraph graph;
+  ABSL_CHECK_OK(graph.Initialize(config));
+  ABSL_CHECK_OK(graph.StartRun({}));
+  int64_t t = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < kNumPacketsPerIteration; ++i, ++t) {
+      ABSL_CHECK_OK(graph.AddPacketToInputStream(
+          input_stream, MakePacket<int>(i).At(Timestamp(t))));
+    }
+    ABSL_CHECK_OK(graph.WaitUntilIdle());
+  }
+  ABSL_CHECK_OK(graph.CloseAllInputStreams());
+  ABSL_CHECK_OK(graph.WaitUntilDone());
+  state.SetItemsProcessed(state.iterations() * kNumPacketsPerIteration *
+                          state.range(1));
+  state.SetLabel(type == kWorkStealing ? "WorkStealingExecutor"
+                                       : "ThreadPoolExecutor");
+}
+
+// Args: {executor type, graph width or depth, num threads}.
+void BM_WideGraph(benchmark::State& state) {
+  RunGraph(state, WideGraph(state.range(1)), "in");
+}
+
+void BM_DeepGraph(benchmark::State& state) {
+  RunGraph(state, DeepGraph(state.range(1)), "s0");
+}
+
+BENCHMARK(BM_WideGraph)
+    ->ArgsProduct({{kThreadPool, kWorkStealing}, {16, 64}, {4, 16, 32}})
+    ->UseRealTime();
+BENCHMARK(BM_DeepGraph)
+    ->ArgsProduct({{kThreadPool, kWorkStealing}, {16, 64}, {4, 16, 32}})
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace mediapipe
+
+BENCHMARK_MAIN();
@@ -0,0 +1,105 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/work_stealing_executor.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/tool/sink.h"
+#include "mediapipe/framework/work_stealing_executor.pb.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(WorkStealingExecutorTest, CreateRequiresPositiveStackSize) {
+  MediaPipeOptions options;
+  options.MutableExtension(WorkStealingExecutorOptions::ext)
+      ->set_stack_size(-1);
+  EXPECT_FALSE(WorkStealingExecutor::Create(options).ok());
+}
+
+TEST(WorkStealingExecutorTest, CreateDefaultsToNumCores) {
+  MediaPipeOptions options;
+  options.MutableExtension(WorkStealingExecutorOptions::ext);
+  MP_ASSERT_OK_AND_ASSIGN(Executor * executor,
+                          WorkStealingExecutor::Create(options));
+  std::unique_ptr<WorkStealingExecutor> work_stealing_executor(
+      static_cast<WorkStealingExecutor*>(executor));
+  EXPECT_GT(work_stealing_executor->num_threads(), 0);
+}
+
+TEST(WorkStealingExecutorTest, RunsAllScheduledTasks) {
+  constexpr int kNumTasks = 1000;
+  absl::BlockingCounter counter(kNumTasks);
+  WorkStealingExecutor executor(4);
+  EXPECT_EQ(4, executor.num_threads());
+  for (int i = 0; i < kNumTasks; ++i) {
+    executor.Schedule([&counter] { counter.DecrementCount(); });
+  }
+  counter.Wait();
+}
+
+// Runs a graph that fans a single input out to many pass-through nodes on the
+// default executor configured as a WorkStealingExecutor.
+TEST(WorkStealingExecutorTest, RunsWideGraph) {
+  constexpr int kWidth = 16;
+  constexpr int kNumPackets = 100;
+  CalculatorGraphConfig config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    executor {
+      type: "WorkStealingExecutor"
+      options {
+        [mediapipe.WorkStealingExecutorOptions.ext] { num_threads: 4 }
+      }
+    }
+  )pb");
+  std::vector<std::vector<Packet>> outputs(kWidth);
+  for (int i = 0; i < kWidth; ++i) {
+    auto* node = config.add_node();
+    node->set_calculator("PassThroughCalculator");
+    node->add_input_stream("in");
+    node->add_output_stream(absl::StrCat("out", i));
+    tool::AddVectorSink(absl::StrCat("out", i), &config, &outputs[i]);
+  }
+
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config));
+  MP_ASSERT_OK(graph.StartRun({}));
+  for (int t = 0; t < kNumPackets; ++t) {
+    MP_ASSERT_OK(
+        graph.AddPacketToInputStream("in", MakePacket<int>(t).At(Timestamp(t))));
+  }
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+
+  for (int i = 0; i < kWidth; ++i) {
+    ASSERT_EQ(kNumPackets, outputs[i].size());
+    for (int t = 0; t < kNumPackets; ++t) {
+      EXPECT_EQ(t, outputs[i][t].Get<int>());
+      EXPECT_EQ(Timestamp(t), outputs[i][t].Timestamp());
+    }
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
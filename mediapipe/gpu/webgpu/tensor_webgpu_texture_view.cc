@@ -54,7 +54,7 @@ Tensor::WebGpuTexture2dView Tensor::GetWebGpuTexture2dReadView(
     const WebGpuService& service) const {
   ABSL_QCHECK_NE(valid_, kValidNone)
       << "Tensor must be written prior to read from.";
-  auto lock = std::make_unique<absl::MutexLock>(&view_mutex_);
+  tensor_internal::ViewLock lock(&view_mutex_);
   if (!(valid_ & kValidWebGpuTexture2d)) {
     ABSL_QCHECK(valid_ & kValidCpu)
         << "Cannot get a WebGPU read view into a tensor that is neither a "
@@ -84,7 +84,7 @@ Tensor::WebGpuTexture2dView Tensor::GetWebGpuTexture2dWriteView(
   const wgpu::Device& device = service.device();
   ABSL_QCHECK(device)
       << "WebGpuTexture2dView: a valid wgpu device must be provided.";
-  auto lock = std::make_unique<absl::MutexLock>(&view_mutex_);
+  tensor_internal::ViewLock lock(&view_mutex_);
   // TODO: MLDrift expects 4-channel textures for writing output, this
   // may be possible to change in the future.
   wgpu::TextureFormat format;
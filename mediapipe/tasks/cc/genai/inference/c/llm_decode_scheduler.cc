@@ -0,0 +1,288 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/tasks/cc/genai/inference/c/llm_decode_scheduler.h"
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "mediapipe/tasks/cc/genai/inference/c/llm_inference_engine.h"
+
+namespace mediapipe::tasks::genai {
+
+bool LlmDecodeRequest::Reserve() {
+  absl::MutexLock lock(&mutex_);
+  if (!done_) {
+    return false;
+  }
+  done_ = false;
+  cancelled_ = false;
+  return true;
+}
+
+void LlmDecodeRequest::Release() { MarkDone(); }
+
+void LlmDecodeRequest::MarkDone() {
+  absl::MutexLock lock(&mutex_);
+  done_ = true;
+}
+
+void LlmDecodeRequest::WaitUntilDone() {
+  absl::MutexLock lock(&mutex_);
+  mutex_.Await(absl::Condition(&done_));
+}
+
+LlmPredictionStats LlmDecodeRequest::GetPredictionStats() {
+  absl::MutexLock lock(&mutex_);
+  return LlmPredictionStats{
+      .num_prompt_tokens = timings_.num_prompt_tokens,
+      .num_output_tokens = timings_.num_output_tokens,
+      .time_to_first_token_ms =
+          absl::ToDoubleMilliseconds(timings_.time_to_first_token),
+      .mean_inter_token_latency_ms =
+          timings_.num_output_tokens > 1
+              ? absl::ToDoubleMilliseconds(timings_.inter_token_latency_sum) /
+                    (timings_.num_output_tokens - 1)
+              : 0.0,
+      .max_inter_token_latency_ms =
+          absl::ToDoubleMilliseconds(timings_.max_inter_token_latency),
+  };
+}
+
+LlmDecodeScheduler::LlmDecodeScheduler(std::unique_ptr<LlmBatchModel> model,
+                                       size_t max_num_request_tokens)
+    : model_(std::move(model)),
+      max_num_request_tokens_(max_num_request_tokens),
+      rows_(model_->batch_size()) {
+  pthread_create(&worker_, nullptr, RunWorker, this);
+}
+
+LlmDecodeScheduler::~LlmDecodeScheduler() {
+  {
+    absl::MutexLock lock(&mutex_);
+    shutdown_ = true;
+  }
+  pthread_join(worker_, nullptr);
+}
+
+void LlmDecodeScheduler::Enqueue(LlmDecodeRequest* request) {
+  ABSL_CHECK(!request->prompt_ids.empty());
+  {
+    absl::MutexLock lock(&request->mutex_);
+    request->timings_ = LlmDecodeRequest::Timings{
+        .num_prompt_tokens = request->prompt_ids.size(),
+        .start_time = absl::Now()};
+  }
+  absl::MutexLock lock(&mutex_);
+  queue_.push_back(request);
+}
+
+void* LlmDecodeScheduler::RunWorker(void* args) {
+  static_cast<LlmDecodeScheduler*>(args)->Run();
+  return nullptr;
+}
+
+void LlmDecodeScheduler::Run() {
+  while (true) {
+    const bool idle =
+        std::all_of(rows_.begin(), rows_.end(),
+                    [](const Row& row) { return row.request == nullptr; });
+    if (idle && !WaitForRequests()) {
+      return;
+    }
+    FinishCancelledRequests();
+    if (idle) {
+      const std::vector<LlmDecodeRequest*> batch = TakeBatch();
+      if (!batch.empty()) {
+        Prefill(batch);
+      }
+      continue;
+    }
+    if (model_->SupportsStaggeredRows()) {
+      StartQueuedRequests();
+    }
+    Decode();
+  }
+}
+
+bool LlmDecodeScheduler::WaitForRequests() {
+  absl::MutexLock lock(&mutex_);
+  auto has_work = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return shutdown_ || !queue_.empty();
+  };
+  mutex_.Await(absl::Condition(&has_work));
+  return !queue_.empty();
+}
+
+void LlmDecodeScheduler::FinishCancelledRequests() {
+  for (Row& row : rows_) {
+    if (row.request != nullptr && row.request->cancelled_) {
+      Finish(row, /*cancelled=*/true);
+    }
+  }
+  std::vector<LlmDecodeRequest*> cancelled;
+  {
+    absl::MutexLock lock(&mutex_);
+    for (auto it = queue_.begin(); it != queue_.end();) {
+      if ((*it)->cancelled_) {
+        cancelled.push_back(*it);
+        it = queue_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (LlmDecodeRequest* request : cancelled) {
+    request->OnDone(/*cancelled=*/true);
+    request->MarkDone();
+  }
+}
+
+std::vector<LlmDecodeRequest*> LlmDecodeScheduler::TakeBatch() {
+  std::vector<LlmDecodeRequest*> batch;
+  size_t min_prompt_size = 0;
+  size_t max_prompt_size = 0;
+  absl::MutexLock lock(&mutex_);
+  for (auto it = queue_.begin();
+       it != queue_.end() && batch.size() < rows_.size();) {
+    const size_t prompt_size = (*it)->prompt_ids.size();
+    bool fits = batch.empty();
+    if (!fits && model_->SupportsStaggeredRows()) {
+      // Shorter prompts start later, and their rows need room for the whole
+      // request.
+      fits = std::max(max_prompt_size, prompt_size) -
+                 std::min(min_prompt_size, prompt_size) +
+                 max_num_request_tokens_ <=
+             model_->max_num_tokens();
+    } else if (!fits) {
+      fits = prompt_size == max_prompt_size;
+    }
+    if (!fits) {
+      ++it;
+      continue;
+    }
+    min_prompt_size =
+        batch.empty() ? prompt_size : std::min(min_prompt_size, prompt_size);
+    max_prompt_size = std::max(max_prompt_size, prompt_size);
+    batch.push_back(*it);
+    it = queue_.erase(it);
+  }
+  return batch;
+}
+
+void LlmDecodeScheduler::Prefill(const std::vector<LlmDecodeRequest*>& batch) {
+  // Unused rows repeat the first prompt.
+  std::vector<std::vector<int>> prompts(rows_.size(), batch[0]->prompt_ids);
+  for (size_t i = 0; i < batch.size(); ++i) {
+    prompts[i] = batch[i]->prompt_ids;
+    rows_[i] = Row{.request = batch[i],
+                   .num_prompt_tokens_added = batch[i]->prompt_ids.size()};
+  }
+  const absl::StatusOr<std::vector<int>> token_ids = model_->Prefill(prompts);
+  ABSL_CHECK_OK(token_ids) << "Failed to process the prompts.";
+  ABSL_CHECK_EQ(token_ids->size(), rows_.size());
+  const absl::Time token_time = absl::Now();
+  for (size_t i = 0; i < rows_.size(); ++i) {
+    rows_[i].next_token_id = (*token_ids)[i];
+    if (rows_[i].request != nullptr) {
+      AddToken(rows_[i], (*token_ids)[i], token_time);
+    }
+  }
+}
+
+void LlmDecodeScheduler::StartQueuedRequests() {
+  for (int i = 0; i < rows_.size(); ++i) {
+    if (rows_[i].request != nullptr) continue;
+    if (model_->time_step() + max_num_request_tokens_ >
+        model_->max_num_tokens()) {
+      return;
+    }
+    LlmDecodeRequest* request;
+    {
+      absl::MutexLock lock(&mutex_);
+      if (queue_.empty()) return;
+      request = queue_.front();
+      queue_.pop_front();
+    }
+    ABSL_CHECK_OK(model_->StartRow(i));
+    rows_[i].request = request;
+    rows_[i].num_prompt_tokens_added = 0;
+  }
+}
+
+void LlmDecodeScheduler::Decode() {
+  std::vector<int> input_ids;
+  input_ids.reserve(rows_.size());
+  for (Row& row : rows_) {
+    if (row.request != nullptr &&
+        row.num_prompt_tokens_added < row.request->prompt_ids.size()) {
+      input_ids.push_back(
+          row.request->prompt_ids[row.num_prompt_tokens_added++]);
+    } else {
+      // Free rows keep decoding, and their tokens are dropped.
+      input_ids.push_back(row.next_token_id);
+    }
+  }
+  const absl::StatusOr<std::vector<int>> token_ids = model_->Step(input_ids);
+  ABSL_CHECK_OK(token_ids) << "Failed to generate output.";
+  ABSL_CHECK_EQ(token_ids->size(), rows_.size());
+  const absl::Time token_time = absl::Now();
+  for (size_t i = 0; i < rows_.size(); ++i) {
+    Row& row = rows_[i];
+    row.next_token_id = (*token_ids)[i];
+    if (row.request != nullptr &&
+        row.num_prompt_tokens_added == row.request->prompt_ids.size()) {
+      AddToken(row, (*token_ids)[i], token_time);
+    }
+  }
+}
+
+void LlmDecodeScheduler::AddToken(Row& row, int token_id, absl::Time time) {
+  LlmDecodeRequest* request = row.request;
+  {
+    absl::MutexLock lock(&request->mutex_);
+    LlmDecodeRequest::Timings& timings = request->timings_;
+    if (timings.num_output_tokens == 0) {
+      timings.time_to_first_token = time - timings.start_time;
+    } else {
+      const absl::Duration latency = time - timings.last_token_time;
+      timings.inter_token_latency_sum += latency;
+      timings.max_inter_token_latency =
+          std::max(timings.max_inter_token_latency, latency);
+    }
+    timings.last_token_time = time;
+    ++timings.num_output_tokens;
+  }
+  if (!request->OnToken(token_id)) {
+    Finish(row, /*cancelled=*/false);
+  }
+}
+
+void LlmDecodeScheduler::Finish(Row& row, bool cancelled) {
+  LlmDecodeRequest* request = std::exchange(row.request, nullptr);
+  request->OnDone(cancelled);
+  request->MarkDone();
+}
+
+}  // namespace mediapipe::tasks::genai
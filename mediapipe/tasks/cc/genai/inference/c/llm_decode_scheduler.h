@@ -0,0 +1,190 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_TASKS_GENAI_INFERENCE_C_LLM_DECODE_SCHEDULER_H_
+#define MEDIAPIPE_TASKS_GENAI_INFERENCE_C_LLM_DECODE_SCHEDULER_H_
+
+#include <pthread.h>
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "mediapipe/tasks/cc/genai/inference/c/llm_inference_engine.h"
+
+namespace mediapipe::tasks::genai {
+
+// The model run by a LlmDecodeScheduler. Each batch row holds one token
+// sequence, and all rows advance by one token per Step(). The methods are
+// only called by the worker thread of the scheduler.
+class LlmBatchModel {
+ public:
+  virtual ~LlmBatchModel() = default;
+
+  // Number of batch rows.
+  virtual int batch_size() const = 0;
+
+  // Number of token positions of a row, prompt included.
+  virtual size_t max_num_tokens() const = 0;
+
+  // Number of token positions the rows have used since the last Prefill().
+  virtual size_t time_step() const = 0;
+
+  // Whether the rows can start at different time steps. If so, Prefill()
+  // accepts prompts of different lengths and StartRow() is supported.
+  virtual bool SupportsStaggeredRows() const = 0;
+
+  // Starts a new sequence in every row with the prompt of the row, and
+  // returns the next token id of each row. The prompts end at the same time
+  // step, so shorter prompts start later.
+  virtual absl::StatusOr<std::vector<int>> Prefill(
+      const std::vector<std::vector<int>>& prompts) = 0;
+
+  // Starts a new sequence in `row` at the current time step, with the token
+  // that the next Step() passes to the row.
+  virtual absl::Status StartRow(int row) = 0;
+
+  // Adds `token_ids`, one per row, and returns the next token id of each row.
+  virtual absl::StatusOr<std::vector<int>> Step(
+      const std::vector<int>& token_ids) = 0;
+};
+
+// A prediction run by a LlmDecodeScheduler. Derived classes handle the
+// generated tokens and must call WaitUntilDone() in their destructor.
+class LlmDecodeRequest {
+ public:
+  virtual ~LlmDecodeRequest() = default;
+
+  // Reserves the request for a new prediction. Returns false if the previous
+  // prediction is not done yet. A reserved request is either passed to
+  // LlmDecodeScheduler::Enqueue() or given back with Release().
+  bool Reserve();
+  void Release();
+
+  // Blocks until the current prediction, if any, is done.
+  void WaitUntilDone();
+
+  // Stops the current prediction before its next decode step.
+  void Cancel() { cancelled_ = true; }
+
+  // Timing statistics of the current or last prediction.
+  LlmPredictionStats GetPredictionStats();
+
+  // Token ids of the prompt, at least one. Set before Enqueue().
+  std::vector<int> prompt_ids;
+
+ protected:
+  // Handles the next generated token. Returns whether the prediction goes on.
+  virtual bool OnToken(int token_id) = 0;
+
+  // Called once the prediction stops, either because OnToken() returned false
+  // or because it was `cancelled`. The request is done when this returns.
+  virtual void OnDone(bool cancelled) = 0;
+
+ private:
+  friend class LlmDecodeScheduler;
+
+  // Per-token timing of a prediction, from Enqueue() to the last generated
+  // token.
+  struct Timings {
+    size_t num_prompt_tokens = 0;
+    size_t num_output_tokens = 0;
+    absl::Time start_time;
+    absl::Time last_token_time;
+    absl::Duration time_to_first_token;
+    absl::Duration inter_token_latency_sum;
+    absl::Duration max_inter_token_latency;
+  };
+
+  void MarkDone();
+
+  std::atomic<bool> cancelled_ = false;
+
+  absl::Mutex mutex_;
+  // False while the request is reserved, queued or decoding.
+  bool done_ ABSL_GUARDED_BY(mutex_) = true;
+  Timings timings_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Runs the predictions of LlmDecodeRequests on a single worker thread, with
+// one batched model invocation per decode step. When the model is idle,
+// queued requests are prefilled together into its batch rows. A request
+// leaves its row as soon as it stops, and if the model supports staggered
+// rows, a queued request takes the free row right away: it feeds its prompt
+// one token per step while the other rows keep decoding. A row must fit a
+// whole request from the time step it starts at, so queued requests wait for
+// the batch to drain once the model is past `max_num_tokens() -
+// max_num_request_tokens`. Without staggered rows, only requests whose prompts
+// have the same number of tokens share a batch, and they all start at once.
+class LlmDecodeScheduler {
+ public:
+  // Starts the worker thread. A request uses at most `max_num_request_tokens`
+  // token positions, prompt included.
+  LlmDecodeScheduler(std::unique_ptr<LlmBatchModel> model,
+                     size_t max_num_request_tokens);
+  // Finishes the queued and running requests.
+  ~LlmDecodeScheduler();
+
+  // Queues a reserved request, which must stay alive until it is done.
+  void Enqueue(LlmDecodeRequest* request);
+
+ private:
+  struct Row {
+    // Null if the row is free.
+    LlmDecodeRequest* request = nullptr;
+    // Number of prompt tokens passed to the model.
+    size_t num_prompt_tokens_added = 0;
+    // The token id to pass to the model once the prompt is added.
+    int next_token_id = 0;
+  };
+
+  static void* RunWorker(void* args);
+  void Run();
+
+  // Waits for queued requests. Returns false on shutdown.
+  bool WaitForRequests();
+  // Ends the cancelled requests in the rows and in the queue.
+  void FinishCancelledRequests();
+  // Removes the requests to prefill from the queue.
+  std::vector<LlmDecodeRequest*> TakeBatch();
+  void Prefill(const std::vector<LlmDecodeRequest*>& batch);
+  // Moves queued requests into free rows of the running batch.
+  void StartQueuedRequests();
+  void Decode();
+
+  // Passes the generated `token_id` to the request of `row`.
+  void AddToken(Row& row, int token_id, absl::Time time);
+  void Finish(Row& row, bool cancelled);
+
+  const std::unique_ptr<LlmBatchModel> model_;
+  const size_t max_num_request_tokens_;
+  // Only accessed by the worker.
+  std::vector<Row> rows_;
+
+  absl::Mutex mutex_;
+  std::deque<LlmDecodeRequest*> queue_ ABSL_GUARDED_BY(mutex_);
+  bool shutdown_ ABSL_GUARDED_BY(mutex_) = false;
+  pthread_t worker_;
+};
+
+}  // namespace mediapipe::tasks::genai
+
+#endif  // MEDIAPIPE_TASKS_GENAI_INFERENCE_C_LLM_DECODE_SCHEDULER_H_
@@ -0,0 +1,357 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/tasks/cc/genai/inference/c/llm_decode_scheduler.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/tasks/cc/genai/inference/c/llm_inference_engine.h"
+
+namespace mediapipe::tasks::genai {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Ge;
+using ::testing::IsEmpty;
+using ::testing::Pair;
+using ::testing::SizeIs;
+
+// Generates the token id `100 * row + time step` and records its calls.
+class FakeBatchModel : public LlmBatchModel {
+ public:
+  FakeBatchModel(int batch_size, size_t max_num_tokens,
+                 bool supports_staggered_rows)
+      : batch_size_(batch_size),
+        max_num_tokens_(max_num_tokens),
+        supports_staggered_rows_(supports_staggered_rows),
+        inputs_(batch_size) {}
+
+  int batch_size() const override { return batch_size_; }
+  size_t max_num_tokens() const override { return max_num_tokens_; }
+  size_t time_step() const override { return time_step_; }
+  bool SupportsStaggeredRows() const override {
+    return supports_staggered_rows_;
+  }
+
+  absl::StatusOr<std::vector<int>> Prefill(
+      const std::vector<std::vector<int>>& prompts) override {
+    prefills_.push_back(prompts);
+    time_step_ = 0;
+    for (const std::vector<int>& prompt : prompts) {
+      time_step_ = std::max(time_step_, prompt.size());
+    }
+    return NextTokenIds();
+  }
+
+  absl::Status StartRow(int row) override {
+    started_rows_.push_back({row, time_step_});
+    return absl::OkStatus();
+  }
+
+  absl::StatusOr<std::vector<int>> Step(
+      const std::vector<int>& token_ids) override {
+    for (int row = 0; row < batch_size_; ++row) {
+      inputs_[row].push_back(token_ids[row]);
+    }
+    ++time_step_;
+    return NextTokenIds();
+  }
+
+  // The prompts of each Prefill().
+  const std::vector<std::vector<std::vector<int>>>& prefills() const {
+    return prefills_;
+  }
+  // The row and time step of each StartRow().
+  const std::vector<std::pair<int, size_t>>& started_rows() const {
+    return started_rows_;
+  }
+  // The token ids passed to each row by Step().
+  const std::vector<std::vector<int>>& inputs() const { return inputs_; }
+
+ private:
+  std::vector<int> NextTokenIds() const {
+    std::vector<int> token_ids;
+    for (int row = 0; row < batch_size_; ++row) {
+      token_ids.push_back(100 * row + time_step_);
+    }
+    return token_ids;
+  }
+
+  const int batch_size_;
+  const size_t max_num_tokens_;
+  const bool supports_staggered_rows_;
+  size_t time_step_ = 0;
+  std::vector<std::vector<std::vector<int>>> prefills_;
+  std::vector<std::pair<int, size_t>> started_rows_;
+  std::vector<std::vector<int>> inputs_;
+};
+
+// Stops after `num_tokens` tokens.
+class FakeRequest : public LlmDecodeRequest {
+ public:
+  FakeRequest(std::vector<int> prompt, size_t num_tokens)
+      : num_tokens_(num_tokens) {
+    prompt_ids = std::move(prompt);
+  }
+  ~FakeRequest() override { WaitUntilDone(); }
+
+  // Called with each token on the worker thread.
+  std::function<void(int)> on_token;
+
+  // Read once the request is done.
+  std::vector<int> token_ids;
+  bool cancelled = false;
+
+ protected:
+  bool OnToken(int token_id) override {
+    token_ids.push_back(token_id);
+    if (on_token) on_token(token_id);
+    return token_ids.size() < num_tokens_;
+  }
+
+  void OnDone(bool cancelled) override { this->cancelled = cancelled; }
+
+ private:
+  const size_t num_tokens_;
+};
+
+TEST(LlmDecodeSchedulerTest, PrefillsPromptsOfDifferentLengthsTogether) {
+  auto model = std::make_unique<FakeBatchModel>(
+      /*batch_size=*/2, /*max_num_tokens=*/16,
+      /*supports_staggered_rows=*/true);
+  FakeBatchModel* fake_model = model.get();
+  LlmDecodeScheduler scheduler(std::move(model), /*max_num_request_tokens=*/8);
+  FakeRequest first({1}, 1);
+  FakeRequest request_a({1, 2, 3}, 2);
+  FakeRequest request_b({4, 5}, 2);
+  // Queued while the model is busy.
+  first.on_token = [&](int) {
+    ASSERT_TRUE(request_a.Reserve());
+    scheduler.Enqueue(&request_a);
+    ASSERT_TRUE(request_b.Reserve());
+    scheduler.Enqueue(&request_b);
+  };
+  ASSERT_TRUE(first.Reserve());
+  scheduler.Enqueue(&first);
+  // The requests are reserved before `first` is done.
+  first.WaitUntilDone();
+  request_a.WaitUntilDone();
+  request_b.WaitUntilDone();
+
+  ASSERT_THAT(fake_model->prefills(), SizeIs(2));
+  EXPECT_THAT(fake_model->prefills()[1],
+              ElementsAre(ElementsAre(1, 2, 3), ElementsAre(4, 5)));
+  EXPECT_THAT(request_a.token_ids, ElementsAre(3, 4));
+  EXPECT_THAT(request_b.token_ids, ElementsAre(103, 104));
+  EXPECT_THAT(fake_model->started_rows(), IsEmpty());
+}
+
+TEST(LlmDecodeSchedulerTest, StartsQueuedRequestInFreeRow) {
+  auto model = std::make_unique<FakeBatchModel>(
+      /*batch_size=*/2, /*max_num_tokens=*/16,
+      /*supports_staggered_rows=*/true);
+  FakeBatchModel* fake_model = model.get();
+  LlmDecodeScheduler scheduler(std::move(model), /*max_num_request_tokens=*/8);
+  FakeRequest request_a({1, 2, 3}, 5);
+  FakeRequest request_b({7, 8}, 2);
+  std::vector<LlmDecodeRequest*> done_order;
+  request_a.on_token = [&](int) {
+    if (request_a.token_ids.size() == 1) {
+      ASSERT_TRUE(request_b.Reserve());
+      scheduler.Enqueue(&request_b);
+    } else if (request_a.token_ids.size() == 5) {
+      done_order.push_back(&request_a);
+    }
+  };
+  request_b.on_token = [&](int) {
+    if (request_b.token_ids.size() == 2) done_order.push_back(&request_b);
+  };
+  ASSERT_TRUE(request_a.Reserve());
+  scheduler.Enqueue(&request_a);
+  // Request B is reserved before request A is done.
+  request_a.WaitUntilDone();
+  request_b.WaitUntilDone();
+
+  // Request B joins at time step 3, feeds its prompt and decodes while
+  // request A keeps decoding.
+  EXPECT_THAT(fake_model->prefills(), SizeIs(1));
+  EXPECT_THAT(fake_model->started_rows(), ElementsAre(Pair(1, 3)));
+  EXPECT_THAT(request_a.token_ids, ElementsAre(3, 4, 5, 6, 7));
+  EXPECT_THAT(request_b.token_ids, ElementsAre(105, 106));
+  ASSERT_THAT(fake_model->inputs()[1], SizeIs(Ge(3)));
+  EXPECT_EQ(fake_model->inputs()[1][0], 7);
+  EXPECT_EQ(fake_model->inputs()[1][1], 8);
+  EXPECT_EQ(fake_model->inputs()[1][2], 105);
+  EXPECT_THAT(done_order, ElementsAre(&request_b, &request_a));
+}
+
+TEST(LlmDecodeSchedulerTest, WaitsForBatchWithoutRoomForRequest) {
+  auto model = std::make_unique<FakeBatchModel>(
+      /*batch_size=*/2, /*max_num_tokens=*/10,
+      /*supports_staggered_rows=*/true);
+  FakeBatchModel* fake_model = model.get();
+  LlmDecodeScheduler scheduler(std::move(model), /*max_num_request_tokens=*/8);
+  FakeRequest request_a({1, 2, 3}, 4);
+  FakeRequest request_b({7}, 1);
+  request_a.on_token = [&](int) {
+    if (request_a.token_ids.size() == 1) {
+      ASSERT_TRUE(request_b.Reserve());
+      scheduler.Enqueue(&request_b);
+    }
+  };
+  ASSERT_TRUE(request_a.Reserve());
+  scheduler.Enqueue(&request_a);
+  // Request B is reserved before request A is done.
+  request_a.WaitUntilDone();
+  request_b.WaitUntilDone();
+
+  EXPECT_THAT(fake_model->started_rows(), IsEmpty());
+  ASSERT_THAT(fake_model->prefills(), SizeIs(2));
+  EXPECT_THAT(fake_model->prefills()[1][0], ElementsAre(7));
+  EXPECT_THAT(request_a.token_ids, SizeIs(4));
+  EXPECT_THAT(request_b.token_ids, ElementsAre(1));
+}
+
+TEST(LlmDecodeSchedulerTest, BatchesPromptsOfSameLengthWithoutStaggeredRows) {
+  auto model = std::make_unique<FakeBatchModel>(
+      /*batch_size=*/2, /*max_num_tokens=*/16,
+      /*supports_staggered_rows=*/false);
+  FakeBatchModel* fake_model = model.get();
+  LlmDecodeScheduler scheduler(std::move(model), /*max_num_request_tokens=*/8);
+  FakeRequest first({1}, 1);
+  FakeRequest request_a({1, 2, 3}, 2);
+  FakeRequest request_b({4, 5}, 2);
+  FakeRequest request_c({6, 7, 8}, 2);
+  first.on_token = [&](int) {
+    for (FakeRequest* request : {&request_a, &request_b, &request_c}) {
+      ASSERT_TRUE(request->Reserve());
+      scheduler.Enqueue(request);
+    }
+  };
+  ASSERT_TRUE(first.Reserve());
+  scheduler.Enqueue(&first);
+  first.WaitUntilDone();
+  for (FakeRequest* request : {&request_a, &request_b, &request_c}) {
+    request->WaitUntilDone();
+  }
+
+  EXPECT_THAT(fake_model->started_rows(), IsEmpty());
+  ASSERT_THAT(fake_model->prefills(), SizeIs(3));
+  EXPECT_THAT(fake_model->prefills()[1],
+              ElementsAre(ElementsAre(1, 2, 3), ElementsAre(6, 7, 8)));
+  EXPECT_THAT(fake_model->prefills()[2],
+              ElementsAre(ElementsAre(4, 5), ElementsAre(4, 5)));
+  EXPECT_THAT(request_b.token_ids, ElementsAre(2, 3));
+}
+
+TEST(LlmDecodeSchedulerTest, CancelsQueuedRequest) {
+  auto model = std::make_unique<FakeBatchModel>(
+      /*batch_size=*/1, /*max_num_tokens=*/16,
+      /*supports_staggered_rows=*/true);
+  FakeBatchModel* fake_model = model.get();
+  LlmDecodeScheduler scheduler(std::move(model), /*max_num_request_tokens=*/8);
+  FakeRequest request_a({1, 2}, 3);
+  FakeRequest request_b({3}, 3);
+  request_a.on_token = [&](int) {
+    if (request_a.token_ids.size() == 1) {
+      ASSERT_TRUE(request_b.Reserve());
+      scheduler.Enqueue(&request_b);
+      request_b.Cancel();
+    }
+  };
+  ASSERT_TRUE(request_a.Reserve());
+  scheduler.Enqueue(&request_a);
+  // Request B is reserved before request A is done.
+  request_a.WaitUntilDone();
+  request_b.WaitUntilDone();
+
+  EXPECT_FALSE(request_a.cancelled);
+  EXPECT_THAT(request_a.token_ids, SizeIs(3));
+  EXPECT_TRUE(request_b.cancelled);
+  EXPECT_THAT(request_b.token_ids, IsEmpty());
+  EXPECT_THAT(fake_model->prefills(), SizeIs(1));
+  EXPECT_THAT(fake_model->started_rows(), IsEmpty());
+  EXPECT_EQ(request_b.GetPredictionStats().num_output_tokens, 0);
+}
+
+TEST(LlmDecodeSchedulerTest, CancelsDecodingRequest) {
+  auto model = std::make_unique<FakeBatchModel>(
+      /*batch_size=*/2, /*max_num_tokens=*/16,
+      /*supports_staggered_rows=*/true);
+  LlmDecodeScheduler scheduler(std::move(model), /*max_num_request_tokens=*/8);
+  FakeRequest request_a({1, 2}, 8);
+  FakeRequest request_b({3, 4}, 4);
+  request_a.on_token = [&](int) {
+    if (request_a.token_ids.size() == 2) request_a.Cancel();
+  };
+  ASSERT_TRUE(request_a.Reserve());
+  ASSERT_TRUE(request_b.Reserve());
+  scheduler.Enqueue(&request_a);
+  scheduler.Enqueue(&request_b);
+  request_a.WaitUntilDone();
+  request_b.WaitUntilDone();
+
+  // The cancelled request stops before the next step, and the other row
+  // keeps decoding.
+  EXPECT_TRUE(request_a.cancelled);
+  EXPECT_THAT(request_a.token_ids, ElementsAre(2, 3));
+  EXPECT_EQ(request_a.GetPredictionStats().num_output_tokens, 2);
+  EXPECT_FALSE(request_b.cancelled);
+  EXPECT_THAT(request_b.token_ids, SizeIs(4));
+}
+
+TEST(LlmDecodeSchedulerTest, RecordsPredictionStats) {
+  auto model = std::make_unique<FakeBatchModel>(
+      /*batch_size=*/1, /*max_num_tokens=*/16,
+      /*supports_staggered_rows=*/true);
+  LlmDecodeScheduler scheduler(std::move(model), /*max_num_request_tokens=*/8);
+  FakeRequest request({1, 2, 3}, 4);
+  // Each step takes at least as long as handling its token.
+  request.on_token = [](int) { absl::SleepFor(absl::Milliseconds(2)); };
+  ASSERT_TRUE(request.Reserve());
+  scheduler.Enqueue(&request);
+  request.WaitUntilDone();
+
+  const LlmPredictionStats stats = request.GetPredictionStats();
+  EXPECT_EQ(stats.num_prompt_tokens, 3);
+  EXPECT_EQ(stats.num_output_tokens, 4);
+  EXPECT_GE(stats.time_to_first_token_ms, 0.0);
+  EXPECT_GE(stats.mean_inter_token_latency_ms, 2.0);
+  EXPECT_GE(stats.max_inter_token_latency_ms,
+            stats.mean_inter_token_latency_ms);
+}
+
+TEST(LlmDecodeSchedulerTest, RejectsReservingBusyRequest) {
+  FakeRequest request({1}, 1);
+  ASSERT_TRUE(request.Reserve());
+  EXPECT_FALSE(request.Reserve());
+  request.Release();
+  EXPECT_TRUE(request.Reserve());
+  request.Release();
+}
+
+}  // namespace
+}  // namespace mediapipe::tasks::genai
@@ -157,6 +157,31 @@ typedef struct {
 
   // Optional setting to prefer specific backend instead.
   LlmPreferredBackend preferred_backend;
+
+  // Maximum number of sessions whose decode steps are run together in one
+  // batched model invocation. Used by CPU only. A session that starts while
+  // the batch is running takes a free batch slot and joins at the next decode
+  // step, as long as the batch has used at most `max_num_tokens` steps;
+  // otherwise it waits for the batch to finish. To leave room for this, each
+  // slot of a batch with more than one slot holds 2 * `max_num_tokens` tokens,
+  // so the key/value cache takes up to 2 * `max_num_batched_sessions` times
+  // the memory of a single session. Models that cannot start slots at
+  // different steps only batch sessions that start while the model is idle
+  // and whose prompts have the same number of tokens. Setting this value to 0
+  // keeps the batch size of the model.
+  size_t max_num_batched_sessions;
+
+  // Memory budget in megabytes for the key/value state of previous prompts,
+  // which lets prompts sharing a prefix with them (e.g. a system prompt)
+  // skip processing that prefix. Used by CPU only. Setting this value to 0
+  // disables the cache.
+  size_t prefix_cache_size_mb;
+
+  // Data type the key/value cache is stored in. Used by CPU only, which
+  // supports kLlmActivationDataTypeFloat16 to halve the memory of the cache.
+  // kLlmActivationDataTypeDefault and kLlmActivationDataTypeFloat32 keep it in
+  // float32.
+  LlmActivationDataType kv_cache_data_type;
 } LlmModelSettings;
 
 // LlmPromptTemplates defines the prompt templates for the session.
@@ -245,6 +270,23 @@ typedef struct {
   bool done;
 } LlmResponseContext;
 
+// Timing statistics of the current or last prediction of a session.
+typedef struct {
+  // Number of prompt tokens, including the start token.
+  size_t num_prompt_tokens;
+
+  // Number of tokens generated so far.
+  size_t num_output_tokens;
+
+  // Time from the start of the prediction to the first generated token. This
+  // includes waiting for other sessions and processing the prompt.
+  double time_to_first_token_ms;
+
+  // Mean and maximum time between consecutive generated tokens.
+  double mean_inter_token_latency_ms;
+  double max_inter_token_latency_ms;
+} LlmPredictionStats;
+
 // Frees all context within the LlmResponseContext.
 ODML_EXPORT void LlmInferenceEngine_CloseResponseContext(
     LlmResponseContext* response_context);
@@ -312,6 +354,12 @@ ODML_EXPORT int LlmInferenceEngine_Session_PredictAsync(
 ODML_EXPORT int LlmInferenceEngine_Session_PendingProcessCancellation(
     LlmInferenceEngine_Session* session, char** error_msg);
 
+// Returns the timing statistics of the current or last prediction of the
+// session. Used by CPU only.
+ODML_EXPORT int LlmInferenceEngine_Session_GetPredictionStats(
+    LlmInferenceEngine_Session* session, LlmPredictionStats* stats_out,
+    char** error_msg);
+
 // Clone the provided session.
 ODML_EXPORT int LlmInferenceEngine_Session_Clone(
     LlmInferenceEngine_Session* session,
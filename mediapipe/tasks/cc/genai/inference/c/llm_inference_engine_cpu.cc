@@ -42,6 +42,7 @@
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status_macros.h"
 #include "mediapipe/tasks/cc/core/model_asset_bundle_resources.h"
+#include "mediapipe/tasks/cc/genai/inference/c/llm_decode_scheduler.h"
 #include "mediapipe/tasks/cc/genai/inference/c/llm_inference_engine.h"
 #include "mediapipe/tasks/cc/genai/inference/proto/llm_params.pb.h"
 #include "mediapipe/tasks/cc/genai/inference/proto/transformer_params.pb.h"
@@ -50,6 +51,7 @@
 #include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/graph_builder.h"
 #include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/llm.h"
 #include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/llm_builder_factory.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/llm_prefix_cache.h"
 #include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/llm_weights.h"
 // clang-format off
 #include "mediapipe/tasks/cc/genai/inference/utils/llm_utils/scoped_file.h"
@@ -66,10 +68,17 @@
 
 namespace {
 
+using ::mediapipe::tasks::genai::LlmBatchModel;
+using ::mediapipe::tasks::genai::LlmDecodeRequest;
+using ::mediapipe::tasks::genai::LlmDecodeScheduler;
 using ::mediapipe::tasks::genai::llm_utils::ScopedFile;
 
 constexpr int kCheckLastKChars = 10;
 
+// Number of tokens the KV cache of the xnn_utils model grows by, so that short
+// sessions do not hold the cache for `max_num_tokens`.
+constexpr size_t kKvCacheBlockSize = 256;
+
 struct TfLiteLlm {
   std::unique_ptr<tflite::Interpreter> interpreter;
   std::unique_ptr<mediapipe::tasks::core::ModelAssetBundleResources> resources;
@@ -83,8 +92,11 @@ struct LlmInferenceEngineCpu_Engine {
   const int start_token_id;
   const std::vector<std::string> stop_tokens;
   const size_t max_num_tokens;
+  LlmDecodeScheduler* const scheduler;
 
   ~LlmInferenceEngineCpu_Engine() {
+    // Finishes the queued sessions before the model goes away.
+    delete scheduler;
     delete tokenizer;
     delete bytes_to_unicode_mapper;
     delete unicode_to_bytes_mapper;
@@ -96,7 +108,12 @@ struct LlmInferenceEngineCpu_Engine {
   };
 };
 
-struct LlmInferenceEngineCpu_Session {
+struct LlmInferenceEngineCpu_Session : public LlmDecodeRequest {
+  explicit LlmInferenceEngineCpu_Session(
+      const LlmInferenceEngineCpu_Engine* engine)
+      : engine(engine) {}
+  ~LlmInferenceEngineCpu_Session() override { WaitUntilDone(); };
+
   const LlmInferenceEngineCpu_Engine* engine;
   std::string prompt;
   int timestep;
@@ -104,9 +121,10 @@ struct LlmInferenceEngineCpu_Session {
   std::string final_output;
   std::function<void(std::string)> cpu_callback;
   bool early_stop;
-  pthread_t work_id;
-  int next_token_id;
-  ~LlmInferenceEngineCpu_Session() { pthread_join(work_id, nullptr); };
+
+ protected:
+  bool OnToken(int token_id) override;
+  void OnDone(bool cancelled) override;
 };
 
 absl::StatusOr<std::unique_ptr<absl::flat_hash_map<unsigned char, int>>>
@@ -174,149 +192,247 @@ std::string MapUnicodeToBytes(
   return converted_output;
 }
 
-void* next_token_function(void* args) {
-  struct LlmInferenceEngineCpu_Session* cpu_session =
-      (struct LlmInferenceEngineCpu_Session*)args;
-  if (cpu_session->timestep < cpu_session->engine->max_num_tokens) {
-    if (cpu_session->early_stop) {
-      return nullptr;
-    }
-
-    auto token_ids_per_step = std::vector<int>();
-    if (std::holds_alternative<mediapipe::tasks::genai::xnn_utils::Llm*>(
-            cpu_session->engine->llm)) {
-      auto status = std::get<mediapipe::tasks::genai::xnn_utils::Llm*>(
-                        cpu_session->engine->llm)
-                        ->GetNextToken(&token_ids_per_step);
-      if (!status.ok()) {
-        ABSL_LOG(FATAL) << "Failed to generate output: " << status;
-      }
-    } else {
-      auto llm = std::get<TfLiteLlm*>(cpu_session->engine->llm);
-      auto* decode_runner = llm->interpreter->GetSignatureRunner("decode");
-      ABSL_CHECK_EQ(decode_runner->AllocateTensors(), kTfLiteOk);
-      TfLiteTensor* decode_input = decode_runner->input_tensor("args_0");
-      TfLiteTensor* decode_input_pos = decode_runner->input_tensor("args_1");
-      decode_input->data.i64[0] =
-          static_cast<int64_t>(cpu_session->next_token_id);
-      decode_input_pos->data.i64[0] =
-          static_cast<int64_t>(cpu_session->timestep);
-
-      // logits->dims->data[0] = batch size
-      // logits->dims->data[1] = sequence length
-      // logits->dims->data[2] = vocab size
-      const TfLiteTensor* logits = decode_runner->output_tensor("output_0");
-
-      ABSL_CHECK_EQ(decode_runner->Invoke(), kTfLiteOk);
-
-      auto max_logit_it = std::max_element(
-          logits->data.f, logits->data.f + logits->dims->data[2]);
-      token_ids_per_step.push_back(std::distance(logits->data.f, max_logit_it));
-    }
+// Appends the generated `token_id` to the output of `cpu_session` and invokes
+// its callback with the text that is ready.
+void ProcessNextToken(LlmInferenceEngineCpu_Session* cpu_session,
+                      int token_id) {
+  ++cpu_session->timestep;
+  if (cpu_session->timestep >= cpu_session->engine->max_num_tokens) {
+    cpu_session->early_stop = true;
+  }
 
-    // For future multithreading support.
-    if (cpu_session->early_stop) {
-      return nullptr;
-    }
+  std::string token = cpu_session->engine->tokenizer->IdToPiece(token_id);
+  if (cpu_session->engine->unicode_to_bytes_mapper != nullptr) {
+    token =
+        MapUnicodeToBytes(token, cpu_session->engine->unicode_to_bytes_mapper);
+  } else {
+    token = absl::StrReplaceAll(token, {{"▁", " "}});
+  }
+  cpu_session->last_10_char.append(token);
 
-    if (cpu_session->timestep >= cpu_session->engine->max_num_tokens) {
+  int stop_index;
+  for (const auto& stop_token : cpu_session->engine->stop_tokens) {
+    stop_index = cpu_session->last_10_char.find(stop_token);
+    if (stop_index != std::string::npos) {
       cpu_session->early_stop = true;
+      cpu_session->last_10_char =
+          cpu_session->last_10_char.substr(0, stop_index);
+      break;
     }
+  }
 
-    cpu_session->next_token_id = token_ids_per_step[0];
-
-    std::string token =
-        cpu_session->engine->tokenizer->IdToPiece(token_ids_per_step[0]);
-    if (cpu_session->engine->unicode_to_bytes_mapper != nullptr) {
-      token = MapUnicodeToBytes(token,
-                                cpu_session->engine->unicode_to_bytes_mapper);
-    } else {
-      token = absl::StrReplaceAll(token, {{"▁", " "}});
-    }
-    cpu_session->last_10_char.append(token);
-
-    int stop_index;
-    for (const auto& stop_token : cpu_session->engine->stop_tokens) {
-      stop_index = cpu_session->last_10_char.find(stop_token);
-      if (stop_index != std::string::npos) {
-        cpu_session->early_stop = true;
-        cpu_session->last_10_char =
-            cpu_session->last_10_char.substr(0, stop_index);
-        break;
-      }
-    }
+  std::string ready_char = "";
+  if (cpu_session->early_stop) {
+    ready_char = cpu_session->last_10_char;
+  } else if (cpu_session->last_10_char.size() > kCheckLastKChars) {
+    ready_char = cpu_session->last_10_char.substr(
+        0, cpu_session->last_10_char.size() - kCheckLastKChars);
+    cpu_session->last_10_char = cpu_session->last_10_char.substr(
+        cpu_session->last_10_char.size() - kCheckLastKChars);
+  }
+  cpu_session->final_output.append(ready_char);
 
-    std::string ready_char = "";
-    if (cpu_session->early_stop) {
-      ready_char = cpu_session->last_10_char;
-    } else if (cpu_session->last_10_char.size() > kCheckLastKChars) {
-      ready_char = cpu_session->last_10_char.substr(
-          0, cpu_session->last_10_char.size() - kCheckLastKChars);
-      cpu_session->last_10_char = cpu_session->last_10_char.substr(
-          cpu_session->last_10_char.size() - kCheckLastKChars);
-    }
-    cpu_session->final_output.append(ready_char);
+  cpu_session->cpu_callback(ready_char);
+}
 
-    cpu_session->cpu_callback(ready_char);
+bool LlmInferenceEngineCpu_Session::OnToken(int token_id) {
+  ProcessNextToken(this, token_id);
+  return !early_stop;
+}
 
-    ++cpu_session->timestep;
+void LlmInferenceEngineCpu_Session::OnDone(bool cancelled) {
+  if (cancelled) {
+    // Flush the text held back for stop token matching with the final
+    // callback.
+    early_stop = true;
+    final_output.append(last_10_char);
+    cpu_callback(last_10_char);
+    last_10_char.clear();
+  }
+}
 
-    next_token_function(args);
+// Runs the batch rows of a xnn_utils::Llm. Prompts of different lengths
+// start at different time steps if the model supports it.
+class XnnLlmBatchModel : public LlmBatchModel {
+ public:
+  // `prefix_cache` is optional.
+  XnnLlmBatchModel(
+      mediapipe::tasks::genai::xnn_utils::Llm* llm,
+      std::unique_ptr<mediapipe::tasks::genai::xnn_utils::LlmPrefixCache>
+          prefix_cache)
+      : llm_(llm),
+        batch_size_(llm->GetLlmParams().batch_size_B),
+        max_num_tokens_(llm->GetLlmParams().seq_size_T),
+        prefix_cache_(std::move(prefix_cache)) {}
+
+  int batch_size() const override { return batch_size_; }
+  size_t max_num_tokens() const override { return max_num_tokens_; }
+  size_t time_step() const override { return llm_->TotalTokenSize(); }
+  bool SupportsStaggeredRows() const override {
+    return llm_->SupportsBatchStartPositions();
   }
-  return nullptr;
-};
 
-void* start_llm_function(void* args) {
-  struct LlmInferenceEngineCpu_Session* cpu_session =
-      (struct LlmInferenceEngineCpu_Session*)args;
+  absl::StatusOr<std::vector<int>> Prefill(
+      const std::vector<std::vector<int>>& prompts) override {
+    size_t max_prompt_size = 0;
+    for (const std::vector<int>& prompt_ids : prompts) {
+      max_prompt_size = std::max(max_prompt_size, prompt_ids.size());
+    }
+    const bool same_size =
+        std::all_of(prompts.begin(), prompts.end(), [&](const auto& ids) {
+          return ids.size() == max_prompt_size;
+        });
+    if (prefix_cache_ != nullptr && same_size) {
+      if (has_late_rows_) {
+        // The rows do not hold a prefix of their tokens.
+        MP_RETURN_IF_ERROR(llm_->SeekTimeStep(0));
+        has_late_rows_ = false;
+      }
+      // Only the part of the prompts after the restored prefix is processed.
+      MP_ASSIGN_OR_RETURN(const size_t num_restored,
+                          prefix_cache_->Restore(*llm_, prompts));
+      std::vector<std::vector<int>> batch_prompt_ids;
+      batch_prompt_ids.reserve(prompts.size());
+      for (const std::vector<int>& prompt_ids : prompts) {
+        batch_prompt_ids.emplace_back(prompt_ids.begin() + num_restored,
+                                      prompt_ids.end());
+      }
+      MP_RETURN_IF_ERROR(llm_->AddInputTokens(batch_prompt_ids));
+      MP_RETURN_IF_ERROR(prefix_cache_->Insert(*llm_));
+    } else {
+      MP_RETURN_IF_ERROR(llm_->SeekTimeStep(0));
+      has_late_rows_ = !same_size;
+      // Shorter prompts are padded in front, up to their start position.
+      std::vector<std::vector<int>> batch_prompt_ids;
+      batch_prompt_ids.reserve(prompts.size());
+      for (int row = 0; row < prompts.size(); ++row) {
+        const std::vector<int>& prompt_ids = prompts[row];
+        const size_t start = max_prompt_size - prompt_ids.size();
+        if (start > 0) {
+          MP_RETURN_IF_ERROR(llm_->SetBatchStartPosition(row, start));
+        }
+        std::vector<int>& ids = batch_prompt_ids.emplace_back(
+            start, prompt_ids.front());
+        ids.insert(ids.end(), prompt_ids.begin(), prompt_ids.end());
+      }
+      MP_RETURN_IF_ERROR(llm_->AddInputTokens(batch_prompt_ids));
+    }
+    return llm_->SampleNextTokens();
+  }
 
-  std::vector<int> prompt_ids = {};
+  absl::Status StartRow(int row) override {
+    has_late_rows_ = true;
+    return llm_->SetBatchStartPosition(row, llm_->TotalTokenSize());
+  }
 
-  std::string prompt;
-  if (cpu_session->engine->bytes_to_unicode_mapper != nullptr) {
-    prompt = MapBytesToUnicode(cpu_session->prompt,
-                               cpu_session->engine->bytes_to_unicode_mapper);
-  } else {
-    prompt = cpu_session->prompt;
+  absl::StatusOr<std::vector<int>> Step(
+      const std::vector<int>& token_ids) override {
+    std::vector<std::vector<int>> batch_token_ids;
+    batch_token_ids.reserve(token_ids.size());
+    for (int token_id : token_ids) {
+      batch_token_ids.push_back({token_id});
+    }
+    MP_RETURN_IF_ERROR(llm_->AddInputTokens(batch_token_ids));
+    return llm_->SampleNextTokens();
   }
 
-  auto status = cpu_session->engine->tokenizer->Encode(prompt, &prompt_ids);
+ private:
+  mediapipe::tasks::genai::xnn_utils::Llm* const llm_;
+  const int batch_size_;
+  const size_t max_num_tokens_;
+  const std::unique_ptr<mediapipe::tasks::genai::xnn_utils::LlmPrefixCache>
+      prefix_cache_;
+  // Whether some rows started after the first time step.
+  bool has_late_rows_ = false;
+};
 
-  if (!status.ok()) {
-    ABSL_LOG(FATAL) << "Failed to encode input: " << status;
-  }
-  prompt_ids.insert(prompt_ids.begin(), cpu_session->engine->start_token_id);
+// Runs the prefill and decode signatures of a TfLite model with batch size 1.
+class TfLiteLlmBatchModel : public LlmBatchModel {
+ public:
+  TfLiteLlmBatchModel(TfLiteLlm* llm, size_t max_num_tokens)
+      : llm_(llm), max_num_tokens_(max_num_tokens) {}
 
-  if (std::holds_alternative<mediapipe::tasks::genai::xnn_utils::Llm*>(
-          cpu_session->engine->llm)) {
-    auto llm = std::get<mediapipe::tasks::genai::xnn_utils::Llm*>(
-        cpu_session->engine->llm);
-    ABSL_CHECK_OK(llm->SeekTimeStep(0));
-    ABSL_CHECK_OK(llm->AddInputTokens({prompt_ids}));
-  } else {
-    auto llm = std::get<TfLiteLlm*>(cpu_session->engine->llm);
-    auto* prefill_runner = llm->interpreter->GetSignatureRunner("prefill");
+  int batch_size() const override { return 1; }
+  size_t max_num_tokens() const override { return max_num_tokens_; }
+  size_t time_step() const override { return time_step_; }
+  bool SupportsStaggeredRows() const override { return false; }
+
+  absl::StatusOr<std::vector<int>> Prefill(
+      const std::vector<std::vector<int>>& prompts) override {
+    RET_CHECK_EQ(prompts.size(), 1);
+    auto* prefill_runner = llm_->interpreter->GetSignatureRunner("prefill");
 
-    ABSL_CHECK_EQ(prefill_runner->AllocateTensors(), kTfLiteOk);
+    RET_CHECK_EQ(prefill_runner->AllocateTensors(), kTfLiteOk);
 
     TfLiteTensor* prefill_input = prefill_runner->input_tensor("args_0");
     TfLiteTensor* prefill_input_pos = prefill_runner->input_tensor("args_1");
     memset(prefill_input->data.data, 0, prefill_input->bytes);
     memset(prefill_input_pos->data.data, 0, prefill_input_pos->bytes);
-    cpu_session->next_token_id = prompt_ids.back();
-    prompt_ids.pop_back();
-    for (int i = 0; i < prompt_ids.size(); ++i) {
+    const std::vector<int>& prompt_ids = prompts[0];
+    for (int i = 0; i + 1 < prompt_ids.size(); ++i) {
       prefill_input->data.i64[i] = static_cast<int64_t>(prompt_ids[i]);
       prefill_input_pos->data.i64[i] = static_cast<int64_t>(i);
     }
-    ABSL_CHECK_EQ(prefill_runner->Invoke(), kTfLiteOk);
+    RET_CHECK_EQ(prefill_runner->Invoke(), kTfLiteOk);
+    time_step_ = prompt_ids.size() - 1;
+    // The last prompt token is decoded.
+    return Step({prompt_ids.back()});
   }
 
-  cpu_session->timestep = prompt_ids.size();
+  absl::Status StartRow(int row) override {
+    return absl::UnimplementedError("The rows cannot start later.");
+  }
 
-  next_token_function(args);
+  absl::StatusOr<std::vector<int>> Step(
+      const std::vector<int>& token_ids) override {
+    auto* decode_runner = llm_->interpreter->GetSignatureRunner("decode");
+    RET_CHECK_EQ(decode_runner->AllocateTensors(), kTfLiteOk);
+    TfLiteTensor* decode_input = decode_runner->input_tensor("args_0");
+    TfLiteTensor* decode_input_pos = decode_runner->input_tensor("args_1");
+    decode_input->data.i64[0] = static_cast<int64_t>(token_ids[0]);
+    decode_input_pos->data.i64[0] = static_cast<int64_t>(time_step_);
+
+    // logits->dims->data[0] = batch size
+    // logits->dims->data[1] = sequence length
+    // logits->dims->data[2] = vocab size
+    const TfLiteTensor* logits = decode_runner->output_tensor("output_0");
+
+    RET_CHECK_EQ(decode_runner->Invoke(), kTfLiteOk);
+    ++time_step_;
+
+    auto max_logit_it = std::max_element(
+        logits->data.f, logits->data.f + logits->dims->data[2]);
+    return std::vector<int>{
+        static_cast<int>(std::distance(logits->data.f, max_logit_it))};
+  }
 
-  return nullptr;
+ private:
+  TfLiteLlm* const llm_;
+  const size_t max_num_tokens_;
+  size_t time_step_ = 0;
+};
+
+absl::Status EncodePrompt(LlmInferenceEngineCpu_Session* cpu_session) {
+  std::string prompt;
+  if (cpu_session->engine->bytes_to_unicode_mapper != nullptr) {
+    prompt = MapBytesToUnicode(cpu_session->prompt,
+                               cpu_session->engine->bytes_to_unicode_mapper);
+  } else {
+    prompt = cpu_session->prompt;
+  }
+
+  cpu_session->prompt_ids.clear();
+  MP_RETURN_IF_ERROR(
+      cpu_session->engine->tokenizer->Encode(prompt, &cpu_session->prompt_ids));
+  cpu_session->prompt_ids.insert(cpu_session->prompt_ids.begin(),
+                                 cpu_session->engine->start_token_id);
+  if (cpu_session->prompt_ids.size() >= cpu_session->engine->max_num_tokens) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("The prompt has ", cpu_session->prompt_ids.size(),
+                     " tokens, which leaves no room for output tokens within ",
+                     cpu_session->engine->max_num_tokens, " tokens."));
+  }
+  return absl::OkStatus();
 }
 
 absl::StatusOr<std::unique_ptr<LlmInferenceEngineCpu_Engine>>
@@ -358,6 +474,28 @@ CreateXnnLlmCpuEngine(const LlmModelSettings* model_settings) {
 
   llm_params.seq_size_T = model_settings->max_num_tokens;
   llm_params.cache_dir = model_settings->cache_dir;
+  llm_params.kv_cache_block_size = kKvCacheBlockSize;
+  switch (model_settings->kv_cache_data_type) {
+    case kLlmActivationDataTypeDefault:
+    case kLlmActivationDataTypeFloat32:
+      break;
+    case kLlmActivationDataTypeFloat16:
+      llm_params.kv_cache_datatype = xnn_datatype_fp16;
+      break;
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrCat("Unsupported KV cache data type: ",
+                       model_settings->kv_cache_data_type));
+  }
+  if (model_settings->max_num_batched_sessions > 0) {
+    llm_params.batch_size_B = model_settings->max_num_batched_sessions;
+  }
+  if (llm_params.batch_size_B > 1) {
+    // Sessions join a running batch at its current time step, which they can
+    // do during the first `max_num_tokens` steps. This doubles the KV cache of
+    // each row, see LlmModelSettings::max_num_batched_sessions.
+    llm_params.seq_size_T = 2 * model_settings->max_num_tokens;
+  }
 
   auto weight_loader = std::make_unique<
       mediapipe::tasks::genai::xnn_utils::DefaultLlmWeightsLoader>(
@@ -387,6 +525,17 @@ CreateXnnLlmCpuEngine(const LlmModelSettings* model_settings) {
     MP_ASSIGN_OR_RETURN(unicode_to_bytes_mapper, CreateUnicodeToBytesMapper());
   }
 
+  std::unique_ptr<mediapipe::tasks::genai::xnn_utils::LlmPrefixCache>
+      prefix_cache;
+  if (model_settings->prefix_cache_size_mb > 0) {
+    prefix_cache =
+        std::make_unique<mediapipe::tasks::genai::xnn_utils::LlmPrefixCache>(
+            model_settings->prefix_cache_size_mb << 20);
+  }
+  auto scheduler = std::make_unique<LlmDecodeScheduler>(
+      std::make_unique<XnnLlmBatchModel>(llm.get(), std::move(prefix_cache)),
+      model_settings->max_num_tokens);
+
   std::unique_ptr<LlmInferenceEngineCpu_Engine> engine(
       new LlmInferenceEngineCpu_Engine{
           .tokenizer = tokenizer.release(),
@@ -398,6 +547,7 @@ CreateXnnLlmCpuEngine(const LlmModelSettings* model_settings) {
               std::vector<std::string>(llm_params_proto.stop_tokens().begin(),
                                        llm_params_proto.stop_tokens().end()),
           .max_num_tokens = model_settings->max_num_tokens,
+          .scheduler = scheduler.release(),
       });
 
   return engine;
@@ -487,6 +637,11 @@ CreateTfliteLlmCpuEngine(const LlmModelSettings* model_settings) {
 
   auto start_token_id = tokenizer->PieceToId(llm_parameters.start_token());
 
+  auto scheduler = std::make_unique<LlmDecodeScheduler>(
+      std::make_unique<TfLiteLlmBatchModel>(tflite_llm.get(),
+                                            model_settings->max_num_tokens),
+      model_settings->max_num_tokens);
+
   std::unique_ptr<LlmInferenceEngineCpu_Engine> engine(
       new LlmInferenceEngineCpu_Engine{
           .tokenizer = tokenizer.release(),
@@ -498,6 +653,7 @@ CreateTfliteLlmCpuEngine(const LlmModelSettings* model_settings) {
               std::vector<std::string>(llm_parameters.stop_tokens().begin(),
                                        llm_parameters.stop_tokens().end()),
           .max_num_tokens = model_settings->max_num_tokens,
+          .scheduler = scheduler.release(),
       });
 
   return engine;
@@ -519,8 +675,7 @@ absl::StatusOr<LlmInferenceEngine_Session*>
 LlmInferenceEngine_CreateSession_Helper(
     const LlmInferenceEngineCpu_Engine* engine,
     const LlmSessionConfig* session_config) {
-  std::unique_ptr<LlmInferenceEngineCpu_Session> session(
-      new LlmInferenceEngineCpu_Session{.engine = engine});
+  auto session = std::make_unique<LlmInferenceEngineCpu_Session>(engine);
 
   return session.release();
 }
@@ -606,8 +761,7 @@ int LlmInferenceEngine_Session_PredictSync(LlmInferenceEngine_Session* session,
   }
 
   auto cpu_session = reinterpret_cast<LlmInferenceEngineCpu_Session*>(session);
-  pthread_join(cpu_session->work_id, nullptr);
-  cpu_session->work_id = 0;
+  cpu_session->WaitUntilDone();
   auto final_output = cpu_session->final_output;
 
   char** result = (char**)malloc(sizeof(char*) * 1);
@@ -652,6 +806,14 @@ int LlmInferenceEngine_Session_PredictAsync(
     return static_cast<int>(absl::StatusCode::kInvalidArgument);
   }
 
+  // The worker uses the session state, including the callback, until the
+  // previous prediction is done. Claiming the session under the lock also
+  // rejects concurrent calls.
+  if (!cpu_session->Reserve()) {
+    *error_msg = strdup("Session is already predicting.");
+    return static_cast<int>(absl::StatusCode::kFailedPrecondition);
+  }
+
   cpu_session->cpu_callback = [=](std::string responses) -> void {
     char** result = (char**)malloc(sizeof(char*) * 1);
     if (result == nullptr) {
@@ -671,22 +833,45 @@ int LlmInferenceEngine_Session_PredictAsync(
     callback(callback_context, response_context.release());
   };
 
+  auto status = EncodePrompt(cpu_session);
+  if (!status.ok()) {
+    cpu_session->Release();
+    *error_msg = strdup(
+        absl::StrCat("Failed to encode input: ", status.ToString()).c_str());
+    return static_cast<int>(status.code());
+  }
+
   cpu_session->final_output = "";
   cpu_session->last_10_char = "";
   cpu_session->early_stop = false;
+  cpu_session->timestep = cpu_session->prompt_ids.size();
 
-  pthread_t work_id = 0;
-  cpu_session->work_id = work_id;
-  pthread_create(&cpu_session->work_id, nullptr, start_llm_function,
-                 cpu_session);
+  cpu_session->engine->scheduler->Enqueue(cpu_session);
 
   return 0;
 }
 
 int LlmInferenceEngine_Session_PendingProcessCancellation(
     LlmInferenceEngine_Session* session, char** error_msg) {
-  *error_msg = strdup("Not implemented");
-  return 12;
+  if (session == nullptr) {
+    *error_msg = strdup("Session is null.");
+    return static_cast<int>(absl::StatusCode::kInvalidArgument);
+  }
+  auto cpu_session = reinterpret_cast<LlmInferenceEngineCpu_Session*>(session);
+  cpu_session->Cancel();
+  return 0;
+}
+
+int LlmInferenceEngine_Session_GetPredictionStats(
+    LlmInferenceEngine_Session* session, LlmPredictionStats* stats_out,
+    char** error_msg) {
+  if (session == nullptr || stats_out == nullptr) {
+    *error_msg = strdup("Session or stats_out is null.");
+    return static_cast<int>(absl::StatusCode::kInvalidArgument);
+  }
+  auto cpu_session = reinterpret_cast<LlmInferenceEngineCpu_Session*>(session);
+  *stats_out = cpu_session->GetPredictionStats();
+  return 0;
 }
 
 int LlmInferenceEngine_Session_Clone(
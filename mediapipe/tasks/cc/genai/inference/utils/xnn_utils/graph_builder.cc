@@ -197,7 +197,12 @@ absl::StatusOr<std::unique_ptr<XnnGraph>> XnnGraphBuilder::Build() {
 
 absl::StatusOr<std::shared_ptr<Tensor>> XnnGraphBuilder::NewInput(
     Tensor::DimsType dims, absl::string_view tag) {
-  auto t = std::make_shared<Tensor>(std::move(dims), data_type_);
+  return NewInput(std::move(dims), data_type_, tag);
+}
+
+absl::StatusOr<std::shared_ptr<Tensor>> XnnGraphBuilder::NewInput(
+    Tensor::DimsType dims, xnn_datatype data_type, absl::string_view tag) {
+  auto t = std::make_shared<Tensor>(std::move(dims), data_type);
   t->AllocateBufferIfNeeded();
   t->tag = tag;
   MP_RETURN_IF_ERROR(MarkInput(t));
@@ -1339,6 +1344,24 @@ absl::StatusOr<std::shared_ptr<Tensor>> XnnGraphBuilder::Abs(
   return output;
 }
 
+absl::StatusOr<std::shared_ptr<Tensor>> XnnGraphBuilder::Convert(
+    std::shared_ptr<Tensor> input, xnn_datatype data_type) {
+  MP_ASSIGN_OR_RETURN(auto output, IntermediateTensor(input->dims, data_type,
+                                                     "convert_output"));
+
+  build_steps_.push_back([input,
+                          output](xnn_subgraph_t subgraph) -> absl::Status {
+    RET_CHECK_EQ(xnn_status_success,
+                 xnn_define_unary(subgraph, xnn_unary_convert,
+                                  /*params=*/nullptr,
+                                  input->tensor_id(subgraph),
+                                  output->tensor_id(subgraph),
+                                  /*flags=*/0));
+    return absl::OkStatus();
+  });
+  return output;
+}
+
 absl::StatusOr<std::shared_ptr<Tensor>> XnnGraphBuilder::Log(
     std::shared_ptr<Tensor> input) {
   MP_ASSIGN_OR_RETURN(auto output,
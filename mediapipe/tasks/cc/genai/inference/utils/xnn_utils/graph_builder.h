@@ -113,6 +113,9 @@ class XnnGraphBuilder {
   // New input or output tensor.
   absl::StatusOr<std::shared_ptr<Tensor>> NewInput(Tensor::DimsType dims,
                                                    absl::string_view tag = "");
+  absl::StatusOr<std::shared_ptr<Tensor>> NewInput(Tensor::DimsType dims,
+                                                   xnn_datatype data_type,
+                                                   absl::string_view tag = "");
   absl::Status MarkInput(std::shared_ptr<Tensor> t);
 
   // New static weight, populate value before Build()
@@ -138,6 +141,10 @@ class XnnGraphBuilder {
 
   absl::StatusOr<std::shared_ptr<Tensor>> Abs(std::shared_ptr<Tensor> input);
 
+  // Converts the elements to `data_type`, e.g. between fp32 and fp16.
+  absl::StatusOr<std::shared_ptr<Tensor>> Convert(std::shared_ptr<Tensor> input,
+                                                  xnn_datatype data_type);
+
   absl::StatusOr<std::shared_ptr<Tensor>> Log(std::shared_ptr<Tensor> input);
 
   absl::StatusOr<std::shared_ptr<Tensor>> CopySign(std::shared_ptr<Tensor> lhs,
@@ -52,6 +52,26 @@ namespace {
 using FeedForwardWeights = LlmWeights::FeedForwardWeights;
 using SelfAttentionWeights = LlmWeights::SelfAttentionWeights;
 
+// Returns a tensor of the same shape that points to the data of `tensor`.
+std::shared_ptr<Tensor> NewView(const std::shared_ptr<Tensor>& tensor) {
+  auto view = std::make_shared<Tensor>(tensor->dims, tensor->datatype);
+  view->Borrow(tensor);
+  return view;
+}
+
+// Points the KV-cache tensor `cache`, of shape [token, ...], to a new buffer
+// of `capacity` tokens, which starts with the first `num_tokens` tokens of its
+// current buffer. The dims of `cache` are left unchanged.
+void ReallocateKVCache(Tensor& cache, size_t num_tokens, size_t capacity) {
+  Tensor::DimsType dims = cache.dims;
+  dims[0] = capacity;
+  auto buffer = std::make_shared<Tensor>(std::move(dims), cache.datatype);
+  buffer->AllocateBufferIfNeeded();
+  std::memcpy(buffer->Data(), cache.Data(),
+              num_tokens * (cache.num_bytes() / cache.dims[0]));
+  cache.Borrow(buffer);
+}
+
 }  // namespace
 
 absl::StatusOr<std::unique_ptr<Llm>> Llm::CreateLlm(
@@ -129,10 +149,23 @@ absl::StatusOr<std::unique_ptr<Llm>> Llm::CreatePrefixDecodeLlm(
       .kv_cache = std::move(kv_cache),
   });
   llm->batch_prev_ids().resize(llm_params.batch_size_B);
+  llm->context_->batch_start_positions.resize(llm_params.batch_size_B);
+  if (llm_params.kv_cache_block_size > 0) {
+    // The cache grows from one block as tokens are added.
+    for (KVCache& cache : llm->kv_cache()) {
+      for (Tensor* tensor : {cache.k_cache.get(), cache.v_cache.get()}) {
+        Tensor::DimsType dims = tensor->dims;
+        dims[0] = llm_params.kv_cache_block_size;
+        ReallocateKVCache(*tensor, /*num_tokens=*/0, dims[0]);
+        tensor->Resize(std::move(dims));
+      }
+    }
+  }
 
   llm->pos_embedding_ = resource.pos_embedding;
   llm->segment_pos_ = resource.segment_pos;
   llm->atten_masks_ = resource.atten_mask;
+  llm->batch_atten_mask_ = resource.batch_atten_mask;
   llm->query_positions_ = resource.query_positions;
   llm->key_positions_ = resource.key_positions;
 
@@ -158,6 +191,14 @@ absl::Status Llm::ReshapeInputResource() {
         xnn_reshape_external_value(
             runtime_.get(), atten_masks_->tensor_id(owned_subgraph_.get()),
             atten_masks_->dims.size(), atten_masks_->dims.data()));
+    if (batch_atten_mask_) {
+      RET_CHECK_EQ(xnn_status_success,
+                   xnn_reshape_external_value(
+                       runtime_.get(),
+                       batch_atten_mask_->tensor_id(owned_subgraph_.get()),
+                       batch_atten_mask_->dims.size(),
+                       batch_atten_mask_->dims.data()));
+    }
     if (!llm_params_.skip_absolute_positional_embeddings) {
       RET_CHECK_EQ(
           xnn_status_success,
@@ -228,19 +269,29 @@ absl::StatusOr<Llm::Context> Llm::NewContext() const {
   std::shared_ptr<Tensor> new_pivot;
   return Llm::Context{
       .batch_prev_ids = std::vector<std::vector<int>>(batch_prev_ids().size()),
+      .batch_start_positions = std::vector<size_t>(batch_prev_ids().size()),
       .kv_cache =
           [this]() {
             std::vector<KVCache> kvs;
             if (!llm_params_.enable_kv_cache) return kvs;
             kvs.resize(kv_cache().size());
+            auto cache_dims = [this](const Tensor& cache) {
+              Tensor::DimsType dims = cache.dims;
+              if (llm_params_.kv_cache_block_size > 0) {
+                dims[0] = llm_params_.kv_cache_block_size;
+              }
+              return dims;
+            };
             for (size_t i = 0; i < kvs.size(); ++i) {
               auto& kv = kvs[i];
               const auto& current_kv = kv_cache()[i];
               kv.k_cache = std::make_shared<Tensor>(
-                  current_kv.k_cache->dims, current_kv.k_cache->datatype);
+                  cache_dims(*current_kv.k_cache),
+                  current_kv.k_cache->datatype);
               kv.k_cache->LoadFromVec({}).IgnoreError();
               kv.v_cache = std::make_shared<Tensor>(
-                  current_kv.v_cache->dims, current_kv.v_cache->datatype);
+                  cache_dims(*current_kv.v_cache),
+                  current_kv.v_cache->datatype);
               kv.v_cache->LoadFromVec({}).IgnoreError();
               kv.k_slice = std::make_shared<Tensor>(
                   current_kv.k_slice->dims, current_kv.k_slice->datatype);
@@ -257,23 +308,79 @@ absl::StatusOr<Llm::Context> Llm::NewContext() const {
 absl::Status Llm::LoadContext(
     /*absl_nullable - not yet supported*/ std::shared_ptr<Context> context) {
   if (!context || (context_ == context)) return absl::OkStatus();
-  // There are some metadata we'd like to keep with existing context, also we'd
-  // like to use pointer address to distinguish context. So the following logic
-  // is: 1) let existing context point to the buffer from new context; 2) move
-  // tensors from existing context to new context; 3) store new context.
-  {
-    for (size_t i = 0; i < kv_cache().size(); ++i) {
-      kv_cache()[i].k_cache->Borrow(context->kv_cache[i].k_cache);
-      kv_cache()[i].v_cache->Borrow(context->kv_cache[i].v_cache);
-      kv_cache()[i].k_slice->Borrow(context->kv_cache[i].k_slice);
-      kv_cache()[i].v_slice->Borrow(context->kv_cache[i].v_slice);
-    }
-    context->kv_cache = std::move(kv_cache());
+  RET_CHECK_EQ(context->kv_cache.size(), kv_cache().size());
+  // The KV-cache tensors of the existing context are defined in the graph, so
+  // they stay with the model. The following logic is: 1) give the existing
+  // context new tensors pointing to its buffers; 2) let the graph tensors
+  // point to the buffers from new context; 3) move the graph tensors to new
+  // context and store it.
+  for (size_t i = 0; i < kv_cache().size(); ++i) {
+    KVCache& graph_kv = kv_cache()[i];
+    const KVCache& new_kv = context->kv_cache[i];
+    KVCache existing_kv{
+        .k_cache = NewView(graph_kv.k_cache),
+        .v_cache = NewView(graph_kv.v_cache),
+        .k_slice = NewView(graph_kv.k_slice),
+        .v_slice = NewView(graph_kv.v_slice),
+    };
+    graph_kv.k_cache->Borrow(new_kv.k_cache).Resize(new_kv.k_cache->dims);
+    graph_kv.v_cache->Borrow(new_kv.v_cache).Resize(new_kv.v_cache->dims);
+    graph_kv.k_slice->Borrow(new_kv.k_slice);
+    graph_kv.v_slice->Borrow(new_kv.v_slice);
+    context->kv_cache[i] = std::exchange(graph_kv, std::move(existing_kv));
   }
   context_ = std::move(context);
   return absl::OkStatus();
 }
 
+Llm::Context Llm::CloneContext(Context& context) {
+  if (!context.kv_cache_owners) {
+    context.kv_cache_owners = std::make_shared<char>();
+  }
+  Context clone{
+      .batch_prev_ids = context.batch_prev_ids,
+      .batch_start_positions = context.batch_start_positions,
+      .kv_cache_owners = context.kv_cache_owners,
+  };
+  clone.kv_cache.reserve(context.kv_cache.size());
+  for (const KVCache& kv : context.kv_cache) {
+    clone.kv_cache.push_back(KVCache{
+        .k_cache = NewView(kv.k_cache),
+        .v_cache = NewView(kv.v_cache),
+        .k_slice = NewView(kv.k_slice),
+        .v_slice = NewView(kv.v_slice),
+    });
+  }
+  return clone;
+}
+
+absl::Status Llm::PrepareKVCache(size_t num_tokens) {
+  RET_CHECK_GT(num_tokens, 0);
+  const bool shared = context_->kv_cache_owners.use_count() > 1;
+  const size_t num_kept_tokens = std::min(TotalTokenSize(), num_tokens);
+  size_t capacity = std::max(num_tokens, llm_params_.seq_size_T);
+  if (const size_t block_size = llm_params_.kv_cache_block_size;
+      block_size > 0) {
+    capacity = (num_tokens + block_size - 1) / block_size * block_size;
+  }
+  for (KVCache& kv : kv_cache()) {
+    for (Tensor* cache : {kv.k_cache.get(), kv.v_cache.get()}) {
+      const size_t token_num_elements = cache->num_elements / cache->dims[0];
+      if (shared ||
+          num_tokens * token_num_elements > cache->elements_capacity) {
+        ReallocateKVCache(*cache, num_kept_tokens, capacity);
+      }
+      Tensor::DimsType dims = cache->dims;
+      dims[0] = num_tokens;
+      cache->Resize(std::move(dims));
+    }
+  }
+  if (shared) {
+    context_->kv_cache_owners = nullptr;
+  }
+  return absl::OkStatus();
+}
+
 absl::Status Llm::ReduceContextPrevIds(std::shared_ptr<Context> context,
                                        std::vector<int> batch_num_tokens) {
   ABSL_CHECK_EQ(batch_num_tokens.size(), context->batch_prev_ids.size());
@@ -319,6 +426,10 @@ absl::Status Llm::AddInputTokens(
   // Let builder re-populate the values of these tensors.
   MP_RETURN_IF_ERROR(builder_->InitAttentionMask(current_seq_len, input_seq_len,
                                                  *atten_masks_));
+  if (batch_atten_mask_) {
+    MP_RETURN_IF_ERROR(
+        InitBatchAttentionMask(current_seq_len + input_seq_len));
+  }
   if (!llm_params_.skip_absolute_positional_embeddings) {
     // Initialize the positional embedding data.
     MP_RETURN_IF_ERROR(builder_->InitPosEmbedding(
@@ -350,13 +461,10 @@ absl::Status Llm::AddInputTokens(
                      transformer_input()->tensor_id(owned_subgraph_.get()),
                      transformer_input()->dims.size(),
                      transformer_input()->dims.data()));
+    MP_RETURN_IF_ERROR(PrepareKVCache(current_seq_len + input_seq_len));
     for (auto& kv_cache : kv_cache()) {
       auto key = kv_cache.k_cache;
       auto value = kv_cache.v_cache;
-      key->Resize({current_seq_len + input_seq_len, llm_params_.batch_size_B,
-                   llm_params_.num_kv_heads, llm_params_.head_dim_H});
-      value->Resize({current_seq_len + input_seq_len, llm_params_.batch_size_B,
-                     llm_params_.num_kv_heads, llm_params_.head_dim_H});
       RET_CHECK_EQ(xnn_status_success,
                    xnn_reshape_external_value(
                        runtime_.get(), key->tensor_id(owned_subgraph_.get()),
@@ -401,10 +509,43 @@ absl::Status Llm::SeekTimeStep(size_t time_step) {
   for (auto& prev_ids : batch_prev_ids()) {
     prev_ids.resize(time_step);
   }
+  for (size_t& position : context_->batch_start_positions) {
+    position = std::min(position, time_step);
+  }
   return absl::OkStatus();
 }
 
-absl::Status Llm::GetNextToken(std::vector<int>* output_ids) {
+absl::Status Llm::SetBatchStartPosition(size_t batch, size_t position) {
+  if (!SupportsBatchStartPositions()) {
+    return absl::FailedPreconditionError(
+        "The batch rows of this model cannot start at different time steps.");
+  }
+  RET_CHECK_LT(batch, llm_params_.batch_size_B);
+  RET_CHECK_LT(position, llm_params_.seq_size_T);
+  std::vector<size_t>& positions = context_->batch_start_positions;
+  positions.resize(llm_params_.batch_size_B);
+  positions[batch] = position;
+  return absl::OkStatus();
+}
+
+absl::Status Llm::InitBatchAttentionMask(size_t seq_len) {
+  // Added to the attention mask, which stays finite.
+  constexpr float kMaskedValue = 0.1 * std::numeric_limits<float>::lowest();
+  const std::vector<size_t>& positions = context_->batch_start_positions;
+  batch_atten_mask_->Resize(
+      Tensor::DimsType{llm_params_.batch_size_B, 1, 1, seq_len});
+  float* values = batch_atten_mask_->DataAs<float>();
+  for (size_t batch = 0; batch < llm_params_.batch_size_B; ++batch) {
+    const size_t start =
+        batch < positions.size() ? std::min(positions[batch], seq_len) : 0;
+    std::fill(values, values + start, kMaskedValue);
+    std::fill(values + start, values + seq_len, 0.0f);
+    values += seq_len;
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<std::vector<int>> Llm::SampleNextTokens() {
   MP_ASSIGN_OR_RETURN(auto logits, ComputeLogits());
 
   MP_ASSIGN_OR_RETURN(std::vector<std::vector<int>> tokens,
@@ -415,9 +556,12 @@ absl::Status Llm::GetNextToken(std::vector<int>* output_ids) {
   for (int i = 0; i < tokens.size(); ++i) {
     output.push_back(tokens[i][0]);
   }
+  RET_CHECK_EQ(output.size(), llm_params_.batch_size_B);
+  return output;
+}
 
-  *output_ids = output;
-  RET_CHECK_EQ(output_ids->size(), llm_params_.batch_size_B);
+absl::Status Llm::GetNextToken(std::vector<int>* output_ids) {
+  MP_ASSIGN_OR_RETURN(*output_ids, SampleNextTokens());
 
   std::vector<std::vector<int>> next_token_ids(output_ids->size());
   for (size_t batch = 0; batch < llm_params_.batch_size_B; ++batch) {
@@ -519,6 +663,13 @@ LlmBuilder::PreProcess(std::shared_ptr<Tensor> token_embedding,
     MP_RETURN_IF_ERROR(
         InitSegmentPos(0, llm_params_.draft_size_G + 1, *resource.segment_pos));
   }
+  if (llm_params_.batch_size_B > 1 && llm_params_.enable_dynamic_shape &&
+      llm_params_.model_type == LlmParams::ModelType::CAUSAL) {
+    MP_ASSIGN_OR_RETURN(
+        resource.batch_atten_mask,
+        NewInput({llm_params_.batch_size_B, 1, 1, llm_params_.seq_size_T},
+                 "batch_atten_mask"));
+  }
   const float dim_scale = std::sqrt(llm_params_.model_dim_D);
   MP_ASSIGN_OR_RETURN(auto scaled_embedding,
                       ElementMul(token_embedding, dim_scale));
@@ -613,10 +764,17 @@ absl::StatusOr<std::shared_ptr<Tensor>> LlmBuilder::SelfAttentionExcludeNorm(
 
   MP_RETURN_IF_ERROR(BuildKVCache(key_proj_after_rope, v_proj, resource));
 
+  std::shared_ptr<Tensor> atten_mask = resource.atten_mask;
+  if (resource.batch_atten_mask) {
+    // [T, S] + [B, 1, 1, S] -> [B, 1, T, S]
+    MP_ASSIGN_OR_RETURN(atten_mask,
+                        ElementAdd(atten_mask, resource.batch_atten_mask));
+  }
+
   // encoded, [B, 1|T, N, H]
   MP_ASSIGN_OR_RETURN(auto kqv_merged,
                       DotAttention(query_proj_after_rope, key_proj_after_rope,
-                                   v_proj, resource.atten_mask, sa_weights));
+                                   v_proj, atten_mask, sa_weights));
 
   const size_t B = kqv_merged->dims[0];
   const size_t NH = kqv_merged->dims[2] * kqv_merged->dims[3];
@@ -987,49 +1145,56 @@ absl::Status LlmBuilder::BuildKVCache(std::shared_ptr<Tensor>& key,
     RET_CHECK_EQ(key->dims[0], llm_params_.batch_size_B);
     RET_CHECK_EQ(value->dims.size(), 4);
     RET_CHECK_EQ(value->dims[0], llm_params_.batch_size_B);
+    const xnn_datatype cache_datatype = llm_params_.kv_cache_datatype;
+    RET_CHECK(cache_datatype == xnn_datatype_fp32 ||
+              cache_datatype == xnn_datatype_fp16)
+            .SetCode(absl::StatusCode::kInvalidArgument)
+        << "Unsupported KV cache data type: " << cache_datatype;
     // Permute has memory copy, in some cases we can use reshape to mimic
     // permute, to avoid memory copy.
     const bool quick_reshape = (key->dims[0] == 1 || key->dims[1] == 1);
-    // BSNH -> SBNH
-    if (quick_reshape) {
-      MP_ASSIGN_OR_RETURN(
-          resource.cache->k_slice,
-          Reshape(key, {key->dims[1], llm_params_.batch_size_B,
-                        llm_params_.num_kv_heads, llm_params_.head_dim_H}));
-      MP_ASSIGN_OR_RETURN(
-          resource.cache->v_slice,
-          Reshape(value, {value->dims[1], llm_params_.batch_size_B,
-                          llm_params_.num_kv_heads, llm_params_.head_dim_H}));
-    } else {
-      MP_ASSIGN_OR_RETURN(resource.cache->k_slice, Permute(key, {1, 0, 2, 3}));
-      MP_ASSIGN_OR_RETURN(resource.cache->v_slice,
-                          Permute(value, {1, 0, 2, 3}));
+    // BSNH -> SBNH. The slices are written to the cache, so with a quick
+    // reshape they can be BSNH, which has the same memory layout.
+    std::shared_ptr<Tensor> k_slice = key;
+    std::shared_ptr<Tensor> v_slice = value;
+    if (!quick_reshape) {
+      MP_ASSIGN_OR_RETURN(k_slice, Permute(key, {1, 0, 2, 3}));
+      MP_ASSIGN_OR_RETURN(v_slice, Permute(value, {1, 0, 2, 3}));
+    }
+    if (cache_datatype != k_slice->datatype) {
+      MP_ASSIGN_OR_RETURN(k_slice, Convert(k_slice, cache_datatype));
+      MP_ASSIGN_OR_RETURN(v_slice, Convert(v_slice, cache_datatype));
     }
 
-    MP_ASSIGN_OR_RETURN(
-        resource.cache->k_cache,
-        NewInput(resource.cache->k_slice->dims, "prefix_k_cache"));
-    MP_ASSIGN_OR_RETURN(
-        resource.cache->v_cache,
-        NewInput(resource.cache->v_slice->dims, "prefix_v_cache"));
-    (resource.cache->k_slice = key)->MarkOutput().tag = "prefix_k_slice";
-    (resource.cache->v_slice = value)->MarkOutput().tag = "prefix_v_slice";
-
+    const Tensor::DimsType cache_dims = {key->dims[1], key->dims[0],
+                                         key->dims[2], key->dims[3]};
+    MP_ASSIGN_OR_RETURN(resource.cache->k_cache,
+                        NewInput(cache_dims, cache_datatype, "prefix_k_cache"));
+    MP_ASSIGN_OR_RETURN(resource.cache->v_cache,
+                        NewInput(cache_dims, cache_datatype, "prefix_v_cache"));
+    (resource.cache->k_slice = k_slice)->MarkOutput().tag = "prefix_k_slice";
+    (resource.cache->v_slice = v_slice)->MarkOutput().tag = "prefix_v_slice";
+
+    key = resource.cache->k_cache;
+    value = resource.cache->v_cache;
+    if (cache_datatype != data_type_) {
+      MP_ASSIGN_OR_RETURN(key, Convert(key, data_type_));
+      MP_ASSIGN_OR_RETURN(value, Convert(value, data_type_));
+    }
     // TBNH -> BTNH
     if (quick_reshape) {
       MP_ASSIGN_OR_RETURN(
-          key, Reshape(resource.cache->k_cache,
-                       {llm_params_.batch_size_B, 0, llm_params_.num_kv_heads,
-                        llm_params_.head_dim_H}));
+          key,
+          Reshape(key, {llm_params_.batch_size_B, 0,
+                        llm_params_.num_kv_heads, llm_params_.head_dim_H}));
       MP_ASSIGN_OR_RETURN(
-          value, Reshape(resource.cache->v_cache,
-                         {llm_params_.batch_size_B, 0, llm_params_.num_kv_heads,
-                          llm_params_.head_dim_H}));
+          value,
+          Reshape(value, {llm_params_.batch_size_B, 0,
+                          llm_params_.num_kv_heads, llm_params_.head_dim_H}));
     } else {
       // TODO - b/329445989: Consolidate this permute with DotAttention.
-      MP_ASSIGN_OR_RETURN(key, Permute(resource.cache->k_cache, {1, 0, 2, 3}));
-      MP_ASSIGN_OR_RETURN(value,
-                          Permute(resource.cache->v_cache, {1, 0, 2, 3}));
+      MP_ASSIGN_OR_RETURN(key, Permute(key, {1, 0, 2, 3}));
+      MP_ASSIGN_OR_RETURN(value, Permute(value, {1, 0, 2, 3}));
     }
   }
 
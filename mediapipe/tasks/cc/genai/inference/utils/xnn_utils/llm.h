@@ -70,7 +70,13 @@ class Llm : protected xnn_utils::XnnGraph {
   struct Context {
     // Previous ids, including prompt.
     std::vector<std::vector<int>> batch_prev_ids;
+    // The time step at which the sequence of each batch row starts, see
+    // SetBatchStartPosition().
+    std::vector<size_t> batch_start_positions;
     std::vector<KVCache> kv_cache;
+    // Held by all the contexts sharing the buffers of `kv_cache`, see
+    // CloneContext().
+    std::shared_ptr<const void> kv_cache_owners;
   };
 
   // Reduce the number of previous ids to effectively undo the last
@@ -117,6 +123,23 @@ class Llm : protected xnn_utils::XnnGraph {
   // the internal state.
   absl::Status SeekTimeStep(size_t time_step);
 
+  // Makes batch row `batch` attend only to the tokens from time step
+  // `position` on, so that the row can start a new sequence while the other
+  // rows continue theirs. SeekTimeStep() moves the start positions back to
+  // the new time step if needed. Requires SupportsBatchStartPositions().
+  absl::Status SetBatchStartPosition(size_t batch, size_t position);
+
+  // Whether the batch rows can start at different time steps. This holds for
+  // causal models with more than one batch row and a builder that does not
+  // override LlmBuilder::PreProcess().
+  bool SupportsBatchStartPositions() const {
+    return batch_atten_mask_ != nullptr;
+  }
+
+  // Samples the logits from ComputeLogits() and returns the sampled id of each
+  // batch row, without adding them.
+  absl::StatusOr<std::vector<int>> SampleNextTokens();
+
   // Samples the logits from ComputeLogits() and returns the sampled ids. This
   // also AddInputTokens() with the sampled ids.
   ABSL_DEPRECATED("Use ComputeLogits() and do your own sampling.")
@@ -142,9 +165,21 @@ class Llm : protected xnn_utils::XnnGraph {
 
   // If `context` is non-null, and different from existing context_, load the
   // context into the model.
+  // The previously loaded context keeps its KV cache and can be loaded again.
   virtual absl::Status LoadContext(
       /*absl_nullable - not yet supported*/ std::shared_ptr<Context> context);
 
+  // Creates a context with the same tokens as `context` without copying the
+  // KV cache. The buffers are shared until the model writes to the KV cache of
+  // one of the contexts, which then gets its own copy.
+  static Context CloneContext(Context& context);
+
+  // Makes the KV cache of the loaded context hold `num_tokens` tokens, keeping
+  // the ones already added, and ready to be written. This copies the buffers
+  // if they are shared with a cloned context, or if they are too small, in
+  // which case they grow by `LlmParams::kv_cache_block_size` tokens at a time.
+  absl::Status PrepareKVCache(size_t num_tokens);
+
   // protected:
   friend class PrefixDecodeLlm;
   friend class LlmTest;
@@ -181,12 +216,16 @@ class Llm : protected xnn_utils::XnnGraph {
       absl::Span<const std::vector<int>> batch_input_ids);
 
   absl::Status ReshapeInputResource();
+  // Sets `batch_atten_mask_` for `seq_len` tokens from the start positions of
+  // the context.
+  absl::Status InitBatchAttentionMask(size_t seq_len);
 
   LlmWeights weights_;
   LlmParams llm_params_;
 
   std::shared_ptr<Tensor> pos_embedding_;
   std::shared_ptr<Tensor> atten_masks_;
+  std::shared_ptr<Tensor> batch_atten_mask_;
   std::shared_ptr<Tensor> segment_pos_;
   std::shared_ptr<Tensor> query_positions_;
   std::shared_ptr<Tensor> key_positions_;
@@ -231,6 +270,10 @@ class LlmBuilder : protected XnnGraphBuilder {
   struct InputResource {
     std::shared_ptr<Tensor> pos_embedding;
     std::shared_ptr<Tensor> atten_mask;
+    // Masks the keys before the start position of each batch row, with shape
+    // [batch_B, 1, 1, seq_size_T]. Only set if the rows can start at
+    // different time steps, see Llm::SetBatchStartPosition().
+    std::shared_ptr<Tensor> batch_atten_mask;
     std::shared_ptr<Tensor> segment_pos;
     std::shared_ptr<Tensor> query_positions;
     std::shared_ptr<Tensor> key_positions;
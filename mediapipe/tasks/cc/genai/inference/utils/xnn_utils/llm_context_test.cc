@@ -0,0 +1,241 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/llm_utils/well_known_models.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/benchmark_weight_accessor.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/llm.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/llm_weights.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/xnn_tensor.h"
+#include "xnnpack.h"  // from @XNNPACK
+
+namespace mediapipe::tasks::genai::xnn_utils {
+namespace {
+
+using ::testing::FloatNear;
+using ::testing::Pointwise;
+
+const std::vector<int> kPrompt = {2, 17, 5, 99, 34};
+
+// A Gemma-like model small enough for tests, with random weights.
+absl::StatusOr<std::unique_ptr<Llm>> CreateTestLlm(
+    size_t kv_cache_block_size,
+    xnn_datatype kv_cache_datatype = xnn_datatype_fp32, size_t batch_size = 1) {
+  LlmParams params =
+      LlmParams::FromLLMParametersProto(llm_utils::GetGemma2BParams());
+  params.num_transformer_M = 2;
+  params.batch_size_B = batch_size;
+  params.seq_size_T = 32;
+  params.model_dim_D = 32;
+  params.hidden_dim_HD = 64;
+  params.head_dim_H = 8;
+  params.n_heads_N = 4;
+  params.num_kv_heads = 1;
+  params.voc_size_V = 128;
+  params.enable_kv_cache = true;
+  params.kv_cache_block_size = kv_cache_block_size;
+  params.kv_cache_datatype = kv_cache_datatype;
+  return Llm::CreateLlm(
+      std::make_unique<LlmWeightsLoader>(
+          std::make_unique<BenchmarkWeightAccessor>(xnn_datatype_fp32,
+                                                    /*seed=*/0),
+          params),
+      std::make_unique<LlmBuilder>(params));
+}
+
+absl::StatusOr<std::vector<float>> GetLogits(Llm& llm) {
+  MP_ASSIGN_OR_RETURN(auto logits, llm.ComputeLogits());
+  std::vector<float> values;
+  MP_RETURN_IF_ERROR(logits->DumpToVec(values, /*exact_match=*/false));
+  return values;
+}
+
+// Returns the logits after adding `ids` to a new context.
+absl::StatusOr<std::vector<float>> GetExpectedLogits(Llm& llm,
+                                                     std::vector<int> ids) {
+  MP_ASSIGN_OR_RETURN(Llm::Context context, llm.NewContext());
+  MP_RETURN_IF_ERROR(
+      llm.LoadContext(std::make_shared<Llm::Context>(std::move(context))));
+  MP_RETURN_IF_ERROR(llm.AddInputTokens({ids}));
+  return GetLogits(llm);
+}
+
+TEST(LlmContextTest, ClonedContextsDiverge) {
+  MP_ASSERT_OK_AND_ASSIGN(auto llm, CreateTestLlm(/*kv_cache_block_size=*/0));
+  std::vector<int> prompt_x = kPrompt;
+  prompt_x.push_back(40);
+  std::vector<int> prompt_y = kPrompt;
+  prompt_y.insert(prompt_y.end(), {50, 51});
+  MP_ASSERT_OK_AND_ASSIGN(const std::vector<float> expected_x,
+                          GetExpectedLogits(*llm, prompt_x));
+  MP_ASSERT_OK_AND_ASSIGN(const std::vector<float> expected_y,
+                          GetExpectedLogits(*llm, prompt_y));
+
+  MP_ASSERT_OK(llm->SeekTimeStep(0));
+  MP_ASSERT_OK(llm->AddInputTokens({kPrompt}));
+  std::shared_ptr<Llm::Context> context_x = llm->context_;
+  auto context_y =
+      std::make_shared<Llm::Context>(Llm::CloneContext(*context_x));
+  MP_ASSERT_OK(llm->AddInputTokens({{40}}));
+  MP_ASSERT_OK(llm->LoadContext(context_y));
+  MP_ASSERT_OK(llm->AddInputTokens({{50, 51}}));
+  MP_ASSERT_OK_AND_ASSIGN(std::vector<float> logits, GetLogits(*llm));
+  EXPECT_THAT(logits, Pointwise(FloatNear(1e-4), expected_y));
+
+  // The first context is unchanged by the second one.
+  MP_ASSERT_OK(llm->LoadContext(context_x));
+  EXPECT_EQ(llm->TotalTokenSize(), prompt_x.size());
+  MP_ASSERT_OK(llm->SeekTimeStep(kPrompt.size()));
+  MP_ASSERT_OK(llm->AddInputTokens({{40}}));
+  MP_ASSERT_OK_AND_ASSIGN(logits, GetLogits(*llm));
+  EXPECT_THAT(logits, Pointwise(FloatNear(1e-4), expected_x));
+}
+
+TEST(LlmContextTest, KVCacheGrowsInBlocks) {
+  MP_ASSERT_OK_AND_ASSIGN(auto llm, CreateTestLlm(/*kv_cache_block_size=*/0));
+  MP_ASSERT_OK_AND_ASSIGN(auto block_llm,
+                          CreateTestLlm(/*kv_cache_block_size=*/4));
+  const Tensor& k_cache = *block_llm->kv_cache()[0].k_cache;
+  const size_t token_num_elements = k_cache.num_elements / k_cache.dims[0];
+  EXPECT_EQ(k_cache.elements_capacity, 4 * token_num_elements);
+
+  std::vector<int> ids = kPrompt;
+  MP_ASSERT_OK(llm->AddInputTokens({ids}));
+  MP_ASSERT_OK(block_llm->AddInputTokens({ids}));
+  for (int step = 0; step < 6; ++step) {
+    MP_ASSERT_OK_AND_ASSIGN(const std::vector<float> expected,
+                            GetLogits(*llm));
+    MP_ASSERT_OK_AND_ASSIGN(const std::vector<float> actual,
+                            GetLogits(*block_llm));
+    EXPECT_THAT(actual, Pointwise(FloatNear(1e-4), expected));
+    MP_ASSERT_OK(llm->AddInputTokens({{60 + step}}));
+    MP_ASSERT_OK(block_llm->AddInputTokens({{60 + step}}));
+  }
+  // 11 tokens take 3 blocks.
+  EXPECT_EQ(block_llm->kv_cache()[0].k_cache->elements_capacity,
+            12 * token_num_elements);
+}
+
+TEST(LlmContextTest, Fp16KVCacheMatchesFp32) {
+  MP_ASSERT_OK_AND_ASSIGN(auto llm, CreateTestLlm(/*kv_cache_block_size=*/0));
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto fp16_llm,
+      CreateTestLlm(/*kv_cache_block_size=*/0, xnn_datatype_fp16));
+  const Tensor& k_cache = *llm->kv_cache()[0].k_cache;
+  const Tensor& fp16_k_cache = *fp16_llm->kv_cache()[0].k_cache;
+  EXPECT_EQ(fp16_k_cache.datatype, xnn_datatype_fp16);
+  EXPECT_EQ(fp16_k_cache.num_bytes() * 2, k_cache.num_bytes());
+
+  MP_ASSERT_OK(llm->AddInputTokens({kPrompt}));
+  MP_ASSERT_OK(fp16_llm->AddInputTokens({kPrompt}));
+  for (int step = 0; step < 3; ++step) {
+    MP_ASSERT_OK_AND_ASSIGN(const std::vector<float> expected,
+                            GetLogits(*llm));
+    MP_ASSERT_OK_AND_ASSIGN(const std::vector<float> actual,
+                            GetLogits(*fp16_llm));
+    EXPECT_THAT(actual, Pointwise(FloatNear(1e-2), expected));
+    MP_ASSERT_OK(llm->AddInputTokens({{60 + step}}));
+    MP_ASSERT_OK(fp16_llm->AddInputTokens({{60 + step}}));
+  }
+}
+
+// Returns the logits of batch row `batch` out of `logits` for all rows.
+std::vector<float> RowLogits(const std::vector<float>& logits, size_t batch,
+                             size_t batch_size) {
+  const size_t row_size = logits.size() / batch_size;
+  return std::vector<float>(logits.begin() + batch * row_size,
+                            logits.begin() + (batch + 1) * row_size);
+}
+
+TEST(LlmContextTest, BatchRowStartsNewSequence) {
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto llm, CreateTestLlm(/*kv_cache_block_size=*/0, xnn_datatype_fp32,
+                              /*batch_size=*/2));
+  ASSERT_TRUE(llm->SupportsBatchStartPositions());
+  MP_ASSERT_OK_AND_ASSIGN(auto single_llm,
+                          CreateTestLlm(/*kv_cache_block_size=*/0));
+  const std::vector<int> prompt_y = {7, 8, 9};
+
+  MP_ASSERT_OK(llm->AddInputTokens({kPrompt, kPrompt}));
+  // Row 1 starts over with `prompt_y`, one token per step, while row 0 goes
+  // on decoding.
+  MP_ASSERT_OK(llm->SetBatchStartPosition(1, llm->TotalTokenSize()));
+  std::vector<int> ids_x = kPrompt;
+  for (int id : prompt_y) {
+    ids_x.push_back(60 + id);
+    MP_ASSERT_OK(llm->AddInputTokens({{ids_x.back()}, {id}}));
+  }
+  MP_ASSERT_OK_AND_ASSIGN(const std::vector<float> logits, GetLogits(*llm));
+
+  MP_ASSERT_OK_AND_ASSIGN(const std::vector<float> expected_x,
+                          GetExpectedLogits(*single_llm, ids_x));
+  MP_ASSERT_OK_AND_ASSIGN(const std::vector<float> expected_y,
+                          GetExpectedLogits(*single_llm, prompt_y));
+  EXPECT_THAT(RowLogits(logits, 0, 2), Pointwise(FloatNear(1e-4), expected_x));
+  // The rotary embedding only depends on relative positions.
+  EXPECT_THAT(RowLogits(logits, 1, 2), Pointwise(FloatNear(1e-3), expected_y));
+}
+
+TEST(LlmContextTest, BatchRowsProcessPromptsOfDifferentLengths) {
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto llm, CreateTestLlm(/*kv_cache_block_size=*/0, xnn_datatype_fp32,
+                              /*batch_size=*/2));
+  MP_ASSERT_OK_AND_ASSIGN(auto single_llm,
+                          CreateTestLlm(/*kv_cache_block_size=*/0));
+  const std::vector<int> prompt_y = {7, 8, 9};
+  MP_ASSERT_OK_AND_ASSIGN(const std::vector<float> expected_x,
+                          GetExpectedLogits(*single_llm, kPrompt));
+  MP_ASSERT_OK_AND_ASSIGN(const std::vector<float> expected_y,
+                          GetExpectedLogits(*single_llm, prompt_y));
+
+  // The shorter prompt is padded in front, up to its start position.
+  const size_t start_y = kPrompt.size() - prompt_y.size();
+  std::vector<int> padded_y(start_y, 0);
+  padded_y.insert(padded_y.end(), prompt_y.begin(), prompt_y.end());
+  MP_ASSERT_OK(llm->SetBatchStartPosition(1, start_y));
+  MP_ASSERT_OK(llm->AddInputTokens({kPrompt, padded_y}));
+  MP_ASSERT_OK_AND_ASSIGN(std::vector<float> logits, GetLogits(*llm));
+  EXPECT_THAT(RowLogits(logits, 0, 2), Pointwise(FloatNear(1e-4), expected_x));
+  EXPECT_THAT(RowLogits(logits, 1, 2), Pointwise(FloatNear(1e-3), expected_y));
+
+  // Seeking back to the beginning also resets the start positions.
+  MP_ASSERT_OK(llm->SeekTimeStep(0));
+  MP_ASSERT_OK(llm->AddInputTokens({kPrompt, kPrompt}));
+  MP_ASSERT_OK_AND_ASSIGN(logits, GetLogits(*llm));
+  EXPECT_THAT(RowLogits(logits, 1, 2), Pointwise(FloatNear(1e-4), expected_x));
+}
+
+TEST(LlmContextTest, SingleRowRejectsBatchStartPosition) {
+  MP_ASSERT_OK_AND_ASSIGN(auto llm, CreateTestLlm(/*kv_cache_block_size=*/0));
+  EXPECT_FALSE(llm->SupportsBatchStartPositions());
+  EXPECT_EQ(llm->SetBatchStartPosition(0, 1).code(),
+            absl::StatusCode::kFailedPrecondition);
+}
+
+TEST(LlmContextTest, RejectsQuantizedKVCache) {
+  EXPECT_FALSE(
+      CreateTestLlm(/*kv_cache_block_size=*/0, xnn_datatype_qint8).ok());
+}
+
+}  // namespace
+}  // namespace mediapipe::tasks::genai::xnn_utils
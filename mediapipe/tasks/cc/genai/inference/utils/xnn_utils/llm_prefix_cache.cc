@@ -0,0 +1,188 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/llm_prefix_cache.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/llm.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/llm_weights.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/xnn_tensor.h"
+
+namespace mediapipe::tasks::genai::xnn_utils {
+namespace {
+
+size_t CommonPrefixSize(absl::Span<const int> a, absl::Span<const int> b) {
+  const size_t size = std::min(a.size(), b.size());
+  return std::mismatch(a.begin(), a.begin() + size, b.begin()).first -
+         a.begin();
+}
+
+// Byte layout of a KV-cache tensor of shape [token, batch, heads, head_dim].
+struct CacheLayout {
+  // Bytes of one token over all batch rows.
+  size_t token_stride;
+  // Bytes of one token of one batch row.
+  size_t row_size;
+};
+
+CacheLayout GetCacheLayout(const Tensor& cache) {
+  const size_t token_stride = cache.num_bytes() / cache.dims[0];
+  return {.token_stride = token_stride,
+          .row_size = token_stride / cache.dims[1]};
+}
+
+bool SupportsPrefixCache(Llm& llm) {
+  return !llm.kv_cache().empty() &&
+         llm.GetLlmParams().model_type == LlmParams::ModelType::CAUSAL;
+}
+
+}  // namespace
+
+absl::StatusOr<size_t> LlmPrefixCache::Restore(
+    Llm& llm, absl::Span<const std::vector<int>> batch_prompt_ids) {
+  std::vector<std::vector<int>>& batch_prev_ids = llm.batch_prev_ids();
+  RET_CHECK_EQ(batch_prompt_ids.size(), batch_prev_ids.size());
+  if (!SupportsPrefixCache(llm)) {
+    MP_RETURN_IF_ERROR(llm.SeekTimeStep(0));
+    return 0;
+  }
+
+  // Leaves at least one token of each prompt to compute the logits with.
+  size_t max_restored = std::numeric_limits<size_t>::max();
+  for (const std::vector<int>& prompt_ids : batch_prompt_ids) {
+    RET_CHECK(!prompt_ids.empty());
+    max_restored = std::min(max_restored, prompt_ids.size() - 1);
+  }
+
+  // The current state of the rows is reused in place.
+  size_t num_restored = max_restored;
+  for (size_t row = 0; row < batch_prompt_ids.size(); ++row) {
+    num_restored = std::min(
+        num_restored,
+        CommonPrefixSize(batch_prev_ids[row], batch_prompt_ids[row]));
+  }
+
+  auto best_entry = entries_.end();
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    size_t size = max_restored;
+    for (const std::vector<int>& prompt_ids : batch_prompt_ids) {
+      size = std::min(size, CommonPrefixSize(it->token_ids, prompt_ids));
+    }
+    if (size > num_restored) {
+      num_restored = size;
+      best_entry = it;
+    }
+  }
+
+  if (best_entry != entries_.end()) {
+    entries_.splice(entries_.begin(), entries_, best_entry);
+    const size_t entry_num_tokens = best_entry->token_ids.size();
+    const char* src = best_entry->data.data();
+    MP_RETURN_IF_ERROR(llm.PrepareKVCache(num_restored));
+    for (Llm::KVCache& kv_cache : llm.kv_cache()) {
+      for (Tensor* cache : {kv_cache.k_cache.get(), kv_cache.v_cache.get()}) {
+        const CacheLayout layout = GetCacheLayout(*cache);
+        char* dst = static_cast<char*>(cache->Data());
+        for (size_t row = 0; row < batch_prompt_ids.size(); ++row) {
+          for (size_t token = 0; token < num_restored; ++token) {
+            std::memcpy(
+                dst + token * layout.token_stride + row * layout.row_size,
+                src + token * layout.row_size, layout.row_size);
+          }
+        }
+        src += entry_num_tokens * layout.row_size;
+      }
+    }
+    RET_CHECK_EQ(src, best_entry->data.data() + best_entry->data.size());
+  }
+
+  for (size_t row = 0; row < batch_prompt_ids.size(); ++row) {
+    batch_prev_ids[row].assign(batch_prompt_ids[row].begin(),
+                               batch_prompt_ids[row].begin() + num_restored);
+  }
+  return num_restored;
+}
+
+absl::Status LlmPrefixCache::Insert(Llm& llm) {
+  if (!SupportsPrefixCache(llm)) {
+    return absl::OkStatus();
+  }
+  const std::vector<int>& token_ids = llm.batch_prev_ids()[0];
+  if (token_ids.empty()) {
+    return absl::OkStatus();
+  }
+  // Nothing to add if an entry already covers `token_ids`.
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (CommonPrefixSize(it->token_ids, token_ids) == token_ids.size()) {
+      entries_.splice(entries_.begin(), entries_, it);
+      return absl::OkStatus();
+    }
+  }
+
+  size_t data_size = 0;
+  for (const Llm::KVCache& kv_cache : llm.kv_cache()) {
+    for (const Tensor* cache :
+         {kv_cache.k_cache.get(), kv_cache.v_cache.get()}) {
+      RET_CHECK_GE(cache->dims[0], token_ids.size());
+      data_size += token_ids.size() * GetCacheLayout(*cache).row_size;
+    }
+  }
+  if (data_size + token_ids.size() * sizeof(int) > max_size_bytes_) {
+    return absl::OkStatus();
+  }
+
+  Entry entry{.token_ids = token_ids};
+  entry.data.resize(data_size);
+  char* dst = entry.data.data();
+  for (const Llm::KVCache& kv_cache : llm.kv_cache()) {
+    for (const Tensor* cache :
+         {kv_cache.k_cache.get(), kv_cache.v_cache.get()}) {
+      const CacheLayout layout = GetCacheLayout(*cache);
+      const char* src = static_cast<const char*>(cache->Data());
+      for (size_t token = 0; token < token_ids.size(); ++token) {
+        std::memcpy(dst, src + token * layout.token_stride, layout.row_size);
+        dst += layout.row_size;
+      }
+    }
+  }
+
+  // Entries that are prefixes of the new one are redundant.
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (CommonPrefixSize(it->token_ids, token_ids) == it->token_ids.size()) {
+      size_bytes_ -= EntrySize(*it);
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  size_bytes_ += EntrySize(entry);
+  entries_.push_front(std::move(entry));
+  while (size_bytes_ > max_size_bytes_) {
+    size_bytes_ -= EntrySize(entries_.back());
+    entries_.pop_back();
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace mediapipe::tasks::genai::xnn_utils
@@ -0,0 +1,80 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_TASKS_GENAI_INFERENCE_UTILS_XNN_UTILS_LLM_PREFIX_CACHE_H_
+#define MEDIAPIPE_TASKS_GENAI_INFERENCE_UTILS_XNN_UTILS_LLM_PREFIX_CACHE_H_
+
+#include <cstddef>
+#include <list>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/llm.h"
+
+namespace mediapipe::tasks::genai::xnn_utils {
+
+// Caches the KV-cache state of token id prefixes across prompts, so that
+// prompts sharing a prefix (e.g. a long system prompt) only need to process
+// the rest of the prompt:
+//
+//   MP_ASSIGN_OR_RETURN(size_t num_cached,
+//                       prefix_cache.Restore(llm, batch_prompt_ids));
+//   // Add batch_prompt_ids[i][num_cached:] with llm.AddInputTokens().
+//   MP_RETURN_IF_ERROR(prefix_cache.Insert(llm));
+//
+// Entries are snapshots of one batch row of the KV cache. The least recently
+// used entries are evicted to stay within the memory budget. Only causal
+// models are supported, as the attention of prefix models over the prompt
+// depends on the full prompt.
+class LlmPrefixCache {
+ public:
+  explicit LlmPrefixCache(size_t max_size_bytes)
+      : max_size_bytes_(max_size_bytes) {}
+
+  // Prepares `llm` to process `batch_prompt_ids`, one prompt per batch row,
+  // by restoring the longest prefix that all prompts share with either the
+  // current state of their row or a cached entry. At least the last token of
+  // each prompt is left to be processed. Returns the number of restored
+  // tokens, which is also the new `llm.TotalTokenSize()`.
+  absl::StatusOr<size_t> Restore(
+      Llm& llm, absl::Span<const std::vector<int>> batch_prompt_ids);
+
+  // Adds the current state of the first batch row of `llm` to the cache.
+  absl::Status Insert(Llm& llm);
+
+  // Bytes used by the cached entries.
+  size_t size_bytes() const { return size_bytes_; }
+
+ private:
+  struct Entry {
+    std::vector<int> token_ids;
+    // Keys and values of `token_ids`, laid out as [layer][key, value][token].
+    std::vector<char> data;
+  };
+
+  static size_t EntrySize(const Entry& entry) {
+    return entry.data.size() + entry.token_ids.size() * sizeof(int);
+  }
+
+  const size_t max_size_bytes_;
+  size_t size_bytes_ = 0;
+  // Most recently used first.
+  std::list<Entry> entries_;
+};
+
+}  // namespace mediapipe::tasks::genai::xnn_utils
+
+#endif  // MEDIAPIPE_TASKS_GENAI_INFERENCE_UTILS_XNN_UTILS_LLM_PREFIX_CACHE_H_
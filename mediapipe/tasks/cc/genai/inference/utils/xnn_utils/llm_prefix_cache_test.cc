@@ -0,0 +1,123 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/llm_prefix_cache.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/llm_utils/well_known_models.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/benchmark_weight_accessor.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/llm.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/llm_weights.h"
+#include "xnnpack.h"  // from @XNNPACK
+
+namespace mediapipe::tasks::genai::xnn_utils {
+namespace {
+
+using ::testing::FloatNear;
+using ::testing::Pointwise;
+
+const std::vector<int> kSystemPrompt = {2, 17, 5, 99, 34, 8, 61, 23};
+
+std::vector<int> WithSystemPrompt(const std::vector<int>& ids) {
+  std::vector<int> prompt = kSystemPrompt;
+  prompt.insert(prompt.end(), ids.begin(), ids.end());
+  return prompt;
+}
+
+// A Gemma-like model small enough for tests, with random weights.
+absl::StatusOr<std::unique_ptr<Llm>> CreateTestLlm() {
+  LlmParams params =
+      LlmParams::FromLLMParametersProto(llm_utils::GetGemma2BParams());
+  params.num_transformer_M = 2;
+  params.batch_size_B = 1;
+  params.seq_size_T = 32;
+  params.model_dim_D = 32;
+  params.hidden_dim_HD = 64;
+  params.head_dim_H = 8;
+  params.n_heads_N = 4;
+  params.num_kv_heads = 1;
+  params.voc_size_V = 128;
+  params.enable_kv_cache = true;
+  return Llm::CreateLlm(
+      std::make_unique<LlmWeightsLoader>(
+          std::make_unique<BenchmarkWeightAccessor>(xnn_datatype_fp32,
+                                                    /*seed=*/0),
+          params),
+      std::make_unique<LlmBuilder>(params));
+}
+
+absl::StatusOr<std::vector<float>> GetLogits(Llm& llm) {
+  MP_ASSIGN_OR_RETURN(auto logits, llm.ComputeLogits());
+  std::vector<float> values;
+  MP_RETURN_IF_ERROR(logits->DumpToVec(values, /*exact_match=*/false));
+  return values;
+}
+
+// Prefills `prompt` through `cache` and returns the number of restored tokens.
+absl::StatusOr<size_t> Prefill(Llm& llm, LlmPrefixCache& cache,
+                               const std::vector<int>& prompt) {
+  MP_ASSIGN_OR_RETURN(size_t num_restored, cache.Restore(llm, {prompt}));
+  MP_RETURN_IF_ERROR(llm.AddInputTokens(
+      {std::vector<int>(prompt.begin() + num_restored, prompt.end())}));
+  MP_RETURN_IF_ERROR(cache.Insert(llm));
+  return num_restored;
+}
+
+TEST(LlmPrefixCacheTest, RestoredPrefixMatchesFullPrefill) {
+  MP_ASSERT_OK_AND_ASSIGN(auto llm, CreateTestLlm());
+  const std::vector<int> prompt = WithSystemPrompt({40, 41, 42});
+  MP_ASSERT_OK(llm->SeekTimeStep(0));
+  MP_ASSERT_OK(llm->AddInputTokens({prompt}));
+  MP_ASSERT_OK_AND_ASSIGN(const std::vector<float> expected,
+                          GetLogits(*llm));
+
+  LlmPrefixCache cache(/*max_size_bytes=*/1 << 20);
+  // Reuses the current state of the model.
+  EXPECT_THAT(Prefill(*llm, cache, WithSystemPrompt({70, 71})),
+              IsOkAndHolds(kSystemPrompt.size()));
+  EXPECT_NE(cache.size_bytes(), 0);
+  EXPECT_THAT(Prefill(*llm, cache, {90, 91, 92}), IsOkAndHolds(0));
+  // Restores the system prompt from the cache.
+  EXPECT_THAT(Prefill(*llm, cache, prompt), IsOkAndHolds(kSystemPrompt.size()));
+  MP_ASSERT_OK_AND_ASSIGN(const std::vector<float> actual, GetLogits(*llm));
+  EXPECT_THAT(actual, Pointwise(FloatNear(1e-4), expected));
+}
+
+TEST(LlmPrefixCacheTest, EvictsLeastRecentlyUsedEntries) {
+  MP_ASSERT_OK_AND_ASSIGN(auto llm, CreateTestLlm());
+  LlmPrefixCache unbounded_cache(/*max_size_bytes=*/1 << 20);
+  MP_ASSERT_OK(Prefill(*llm, unbounded_cache, {1, 2, 3, 4}).status());
+  const size_t entry_size = unbounded_cache.size_bytes();
+
+  LlmPrefixCache cache(/*max_size_bytes=*/entry_size);
+  MP_ASSERT_OK(Prefill(*llm, cache, {1, 2, 3, 4}).status());
+  MP_ASSERT_OK(Prefill(*llm, cache, {5, 6, 7, 8}).status());
+  EXPECT_EQ(cache.size_bytes(), entry_size);
+  EXPECT_THAT(Prefill(*llm, cache, {1, 2, 3, 4, 5}), IsOkAndHolds(0));
+  // Entries that do not fit are not added.
+  LlmPrefixCache small_cache(/*max_size_bytes=*/entry_size - 1);
+  MP_ASSERT_OK(Prefill(*llm, small_cache, {1, 2, 3, 4}).status());
+  EXPECT_EQ(small_cache.size_bytes(), 0);
+}
+
+}  // namespace
+}  // namespace mediapipe::tasks::genai::xnn_utils
@@ -147,6 +147,14 @@ struct LlmParams {
   bool enable_dynamic_shape ABSL_DEPRECATED(
       "This is always enabled if enable_kv_cache is true.") = false;
 
+  // If greater than 0, the KV cache grows in blocks of this many tokens as
+  // tokens are added, instead of holding `seq_size_T` tokens from the start.
+  size_t kv_cache_block_size = 0;
+
+  // Data type the KV cache is stored in, either xnn_datatype_fp32 or
+  // xnn_datatype_fp16. The attention converts it to fp32 as it reads it.
+  xnn_datatype kv_cache_datatype = xnn_datatype_fp32;
+
   // If provided, the runtime will prepare cache at the provided directory.
   // Otherwise, cache will be prepared besides the original model.
   std::string cache_dir;
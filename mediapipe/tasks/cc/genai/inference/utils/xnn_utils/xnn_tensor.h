@@ -133,6 +133,9 @@ struct Tensor {
   virtual void* Data();
   const void* Data() const;
 
+  // The size of the tensor data in bytes.
+  size_t num_bytes() const { return ElementSize(num_elements); }
+
   // Access the tensor data as certain type.
   template <typename T>
   T* DataAs() {
@@ -191,7 +194,7 @@ struct Tensor {
   virtual absl::Status DefineInSubgraph(xnn_subgraph& subgraph, uint32_t flags);
 
   virtual size_t ElementSize(size_t num_elements) const {
-    return num_elements * 4;
+    return num_elements * (datatype == xnn_datatype_fp16 ? 2 : 4);
   }
 
   DimsType internal_dims;
@@ -79,7 +79,10 @@ import MediaPipeTasksGenAIC
                 num_draft_tokens: 0,
                 wait_for_weight_uploads: options.waitForWeightUploads,
                 use_submodel: options.useSubmodel,
-                preferred_backend: kLlmPreferredBackendDefault)
+                preferred_backend: kLlmPreferredBackendDefault,
+                max_num_batched_sessions: 0,
+                prefix_cache_size_mb: 0,
+                kv_cache_data_type: kLlmActivationDataTypeDefault)
               return try LlmTaskRunner(modelSettings: modelSetting)
             }
           }
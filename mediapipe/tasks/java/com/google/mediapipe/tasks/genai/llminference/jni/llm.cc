@@ -114,6 +114,9 @@ LlmModelSettings ParseModelSettings(void* bytes, int size) {
       output.preferred_backend = kLlmPreferredBackendDefault;
       break;
   }
+  output.max_num_batched_sessions = 0;
+  output.prefix_cache_size_mb = 0;
+  output.kv_cache_data_type = kLlmActivationDataTypeDefault;
   return output;
 }
 
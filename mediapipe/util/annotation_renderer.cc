@@ -18,6 +18,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <initializer_list>
+#include <limits>
 
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
@@ -142,6 +144,33 @@ void AnnotationRenderer::SetScaleFactor(float scale_factor) {
   if (scale_factor > 0.0f) scale_factor_ = std::min(scale_factor, 1.0f);
 }
 
+void AnnotationRenderer::SetTrackRenderedRegions(bool track) {
+  track_rendered_regions_ = track;
+  rendered_regions_.clear();
+}
+
+void AnnotationRenderer::AddRenderedRegion(
+    std::initializer_list<cv::Point> points, int margin) {
+  if (!track_rendered_regions_ || points.size() == 0) return;
+  int left = std::numeric_limits<int>::max();
+  int top = std::numeric_limits<int>::max();
+  int right = std::numeric_limits<int>::min();
+  int bottom = std::numeric_limits<int>::min();
+  for (const cv::Point& point : points) {
+    left = std::min(left, point.x);
+    top = std::min(top, point.y);
+    right = std::max(right, point.x);
+    bottom = std::max(bottom, point.y);
+  }
+  // Anti-aliased edges and rounding may spill one more pixel out.
+  margin = std::max(margin, 0) + 1;
+  const cv::Rect region =
+      cv::Rect(cv::Point(left - margin, top - margin),
+               cv::Point(right + margin + 1, bottom + margin + 1)) &
+      cv::Rect(0, 0, mat_image_.cols, mat_image_.rows);
+  if (!region.empty()) rendered_regions_.push_back(region);
+}
+
 void AnnotationRenderer::DrawRectangle(const RenderAnnotation& annotation) {
   int left = -1;
   int top = -1;
@@ -175,9 +204,13 @@ void AnnotationRenderer::DrawRectangle(const RenderAnnotation& annotation) {
       cv::line(mat_image_, vertices[i], vertices[(i + 1) % kNumVertices], color,
                thickness);
     }
+    AddRenderedRegion({vertices[0], vertices[1], vertices[2], vertices[3]},
+                      thickness);
   } else {
     cv::Rect rect(left, top, right - left, bottom - top);
     cv::rectangle(mat_image_, rect, color, thickness);
+    AddRenderedRegion({cv::Point(left, top), cv::Point(right, bottom)},
+                      thickness);
   }
   if (rectangle.has_top_left_thickness()) {
     const auto& rect = RectangleToOpenCVRotatedRect(left, top, right, bottom,
@@ -190,6 +223,7 @@ void AnnotationRenderer::DrawRectangle(const RenderAnnotation& annotation) {
     cv::ellipse(mat_image_, vertices[1],
                 cv::Size(top_left_thickness, top_left_thickness), 0.0, 0, 360,
                 color, -1);
+    AddRenderedRegion({vertices[1]}, top_left_thickness);
   }
 }
 
@@ -227,9 +261,11 @@ void AnnotationRenderer::DrawFilledRectangle(
       vertices[i] = vertices2f[i];
     }
     cv::fillConvexPoly(mat_image_, vertices, kNumVertices, color);
+    AddRenderedRegion({vertices[0], vertices[1], vertices[2], vertices[3]}, 0);
   } else {
     cv::Rect rect(left, top, right - left, bottom - top);
     cv::rectangle(mat_image_, rect, color, -1);
+    AddRenderedRegion({cv::Point(left, top), cv::Point(right, bottom)}, 0);
   }
 }
 
@@ -263,6 +299,13 @@ void AnnotationRenderer::DrawRoundedRectangle(
   DrawRoundedRectangle(mat_image_, cv::Point(left, top),
                        cv::Point(right, bottom), color, thickness, line_type,
                        corner_radius);
+  // The corner arcs reach past the rectangle when the radius is larger than
+  // half of its width or height.
+  const cv::Point corner_extent(2 * corner_radius, 2 * corner_radius);
+  AddRenderedRegion({cv::Point(left, top), cv::Point(right, bottom),
+                     cv::Point(left, top) + corner_extent,
+                     cv::Point(right, bottom) - corner_extent},
+                    thickness);
 }
 
 void AnnotationRenderer::DrawFilledRoundedRectangle(
@@ -294,6 +337,11 @@ void AnnotationRenderer::DrawFilledRoundedRectangle(
   DrawRoundedRectangle(mat_image_, cv::Point(left, top),
                        cv::Point(right, bottom), color, -1, line_type,
                        corner_radius);
+  const cv::Point corner_extent(2 * corner_radius, 2 * corner_radius);
+  AddRenderedRegion({cv::Point(left, top), cv::Point(right, bottom),
+                     cv::Point(left, top) + corner_extent,
+                     cv::Point(right, bottom) - corner_extent},
+                    0);
 }
 
 void AnnotationRenderer::DrawRoundedRectangle(cv::Mat src, cv::Point top_left,
@@ -366,6 +414,11 @@ void AnnotationRenderer::DrawOval(const RenderAnnotation& annotation) {
   const int thickness =
       ClampThickness(round(annotation.thickness() * scale_factor_));
   cv::ellipse(mat_image_, center, size, rotation, 0, 360, color, thickness);
+  // Bounds the rotated oval by a circle of radius width + height.
+  const int radius = std::abs(size.width) + std::abs(size.height);
+  AddRenderedRegion({center - cv::Point(radius, radius),
+                     center + cv::Point(radius, radius)},
+                    thickness);
 }
 
 void AnnotationRenderer::DrawFilledOval(const RenderAnnotation& annotation) {
@@ -394,6 +447,11 @@ void AnnotationRenderer::DrawFilledOval(const RenderAnnotation& annotation) {
   const double rotation = enclosing_rectangle.rotation() / M_PI * 180.f;
   const cv::Scalar color = MediapipeColorToOpenCVColor(annotation.color());
   cv::ellipse(mat_image_, center, size, rotation, 0, 360, color, -1);
+  // Bounds the rotated oval by a circle of radius width + height.
+  const int radius = std::abs(size.width) + std::abs(size.height);
+  AddRenderedRegion({center - cv::Point(radius, radius),
+                     center + cv::Point(radius, radius)},
+                    0);
 }
 
 void AnnotationRenderer::DrawArrow(const RenderAnnotation& annotation) {
@@ -444,6 +502,9 @@ void AnnotationRenderer::DrawArrow(const RenderAnnotation& annotation) {
                                  static_cast<int>(round(arrowtip_right[1])));
   cv::line(mat_image_, arrowtip_left_start, arrow_end, color, thickness);
   cv::line(mat_image_, arrowtip_right_start, arrow_end, color, thickness);
+  AddRenderedRegion(
+      {arrow_start, arrow_end, arrowtip_left_start, arrowtip_right_start},
+      thickness);
 }
 
 void AnnotationRenderer::DrawPoint(const RenderAnnotation& annotation) {
@@ -467,6 +528,7 @@ void AnnotationRenderer::DrawPoint(const RenderAnnotation::Point& point,
   const int thickness =
       ClampThickness(round(annotation.thickness() * scale_factor_));
   cv::circle(mat_image_, point_to_draw, thickness, color, -1);
+  AddRenderedRegion({point_to_draw}, thickness);
 }
 
 void AnnotationRenderer::DrawScribble(const RenderAnnotation& annotation) {
@@ -502,6 +564,7 @@ void AnnotationRenderer::DrawLine(const RenderAnnotation& annotation) {
   const int thickness =
       ClampThickness(round(annotation.thickness() * scale_factor_));
   cv::line(mat_image_, start, end, color, thickness);
+  AddRenderedRegion({start, end}, thickness);
 }
 
 void AnnotationRenderer::DrawGradientLine(const RenderAnnotation& annotation) {
@@ -532,6 +595,7 @@ void AnnotationRenderer::DrawGradientLine(const RenderAnnotation& annotation) {
   const cv::Scalar color1 = MediapipeColorToOpenCVColor(line.color1());
   const cv::Scalar color2 = MediapipeColorToOpenCVColor(line.color2());
   cv_line2(mat_image_, start, end, color1, color2, thickness);
+  AddRenderedRegion({start, end}, thickness);
 }
 
 void AnnotationRenderer::DrawText(const RenderAnnotation& annotation) {
@@ -569,6 +633,14 @@ void AnnotationRenderer::DrawText(const RenderAnnotation& annotation) {
     origin.y += text_size.height / 2;
   }
 
+  // The text extends below the baseline, or above it if flipped. Script and
+  // italic glyphs also lean past the advance width, by less than their height.
+  const int text_extent = text_size.height + text_baseline;
+  const cv::Point text_top_left(origin.x - text_extent,
+                                origin.y - text_extent);
+  const cv::Point text_bottom_right(origin.x + text_size.width + text_extent,
+                                    origin.y + text_extent);
+  AddRenderedRegion({text_top_left, text_bottom_right}, thickness);
   if (text.outline_thickness() > 0.0) {
     const int background_thickness = ClampThickness(
         round((annotation.thickness() + 2.0 * text.outline_thickness()) *
@@ -578,6 +650,8 @@ void AnnotationRenderer::DrawText(const RenderAnnotation& annotation) {
     cv::putText(mat_image_, text.display_text(), origin, font_face, font_scale,
                 outline_color, background_thickness, /*lineType=*/8,
                 /*bottomLeftOrigin=*/flip_text_vertically_);
+    AddRenderedRegion({text_top_left, text_bottom_right},
+                      background_thickness);
   }
   cv::putText(mat_image_, text.display_text(), origin, font_face, font_scale,
               color, thickness, /*lineType=*/8,
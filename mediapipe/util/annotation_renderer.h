@@ -15,7 +15,9 @@
 #ifndef MEDIAPIPE_UTIL_ANNOTATION_RENDERER_H_
 #define MEDIAPIPE_UTIL_ANNOTATION_RENDERER_H_
 
+#include <initializer_list>
 #include <string>
+#include <vector>
 
 #include "mediapipe/framework/port/opencv_core_inc.h"
 #include "mediapipe/framework/port/opencv_imgproc_inc.h"
@@ -78,7 +80,23 @@ class AnnotationRenderer {
   void SetScaleFactor(float scale_factor);
   float GetScaleFactor() { return scale_factor_; }
 
+  // Sets whether the image regions touched by rendering are recorded, see
+  // GetRenderedRegions(). This is default to false.
+  void SetTrackRenderedRegions(bool track);
+
+  // Returns conservative bounding boxes, clipped to the image, of everything
+  // rendered since the last call to ClearRenderedRegions(). Empty unless
+  // rendered regions are tracked.
+  const std::vector<cv::Rect>& GetRenderedRegions() const {
+    return rendered_regions_;
+  }
+  void ClearRenderedRegions() { rendered_regions_.clear(); }
+
  private:
+  // Records the bounding box of `points`, grown by `margin` pixels on each
+  // side, if rendered regions are tracked.
+  void AddRenderedRegion(std::initializer_list<cv::Point> points, int margin);
+
   // Draws a rectangle on the image as described in the annotation.
   void DrawRectangle(const RenderAnnotation& annotation);
 
@@ -142,6 +160,10 @@ class AnnotationRenderer {
 
   // See SetScaleFactor(float)
   float scale_factor_ = 1.0;
+
+  // See SetTrackRenderedRegions(bool).
+  bool track_rendered_regions_ = false;
+  std::vector<cv::Rect> rendered_regions_;
 };
 }  // namespace mediapipe
 
@@ -253,6 +253,39 @@ absl::Status ValidateFloatTensorInputs(const FrameBuffer& buffer,
   return absl::OkStatus();
 }
 
+absl::Status ValidateCropRotateResizeToTensorInputs(const FrameBuffer& buffer,
+                                                    int x0, int y0, int x1,
+                                                    int y1, int angle_deg,
+                                                    const Tensor& tensor) {
+  if (!IsSupportedYuvBuffer(buffer)) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Unsupported buffer format: %i.", buffer.format()));
+  }
+  bool is_buffer_size_valid =
+      ((x1 < buffer.dimension().width) && y1 < buffer.dimension().height);
+  bool are_points_valid = (x0 >= 0) && (y0 >= 0) && (x1 >= x0) && (y1 >= y0);
+  if (!is_buffer_size_valid || !are_points_valid) {
+    return absl::InvalidArgumentError("Invalid crop coordinates.");
+  }
+  // The chroma planes are subsampled by 2 in both directions, so the crop must
+  // start on a chroma sample.
+  if (x0 % 2 != 0 || y0 % 2 != 0) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Crop origin (%d, %d) must be even for YUV buffers.", x0, y0));
+  }
+  if (angle_deg >= 360 || angle_deg < 0 || angle_deg % 90 != 0) {
+    return absl::InvalidArgumentError(
+        "Rotation angle must be 0, 90, 180 or 270 degrees.");
+  }
+  const auto& shape = tensor.shape();
+  if (shape.dims.size() != 4 || shape.dims[0] != 1 ||
+      shape.dims[3] != kRgbChannels) {
+    return absl::InvalidArgumentError(
+        "Expected tensor with shape [1, height, width, 3].");
+  }
+  return absl::OkStatus();
+}
+
 // Construct buffer helper functions.
 //------------------------------------------------------------------------------
 
@@ -484,6 +517,43 @@ absl::Status FlipVerticallyYuv(const FrameBuffer& buffer,
              : absl::UnknownError("Halide YUV vertical flip operation failed.");
 }
 
+absl::Status CropRotateResizeYuvToTensor(const FrameBuffer& buffer, int x0,
+                                         int y0, int x1, int y1, int angle_deg,
+                                         float scale, float offset,
+                                         Tensor& tensor) {
+  MP_ASSIGN_OR_RETURN(auto input, CreateYuvBuffer(buffer));
+  if (!input.Crop(x0, y0, x1, y1)) {
+    return absl::UnknownError("Halide YUV crop operation failed.");
+  }
+  const int width = tensor.shape().dims[2];
+  const int height = tensor.shape().dims[1];
+  switch (tensor.element_type()) {
+    case Tensor::ElementType::kFloat32: {
+      auto view = tensor.GetCpuWriteView();
+      FloatBuffer output(view.buffer<float>(), width, height, kRgbChannels);
+      return input.ResizeRotateToFloat(angle_deg, scale, offset, &output)
+                 ? absl::OkStatus()
+                 : absl::UnknownError(
+                       "Halide YUV to float conversion failed.");
+    }
+    case Tensor::ElementType::kUInt8: {
+      if (scale != 1.0f || offset != 0.0f) {
+        return absl::InvalidArgumentError(
+            "Scale and offset are not supported for uint8 tensors.");
+      }
+      auto view = tensor.GetCpuWriteView();
+      RgbBuffer output(view.buffer<uint8_t>(), width, height,
+                       /*alpha=*/false);
+      return input.ResizeRotateConvert(angle_deg, &output)
+                 ? absl::OkStatus()
+                 : absl::UnknownError("Halide YUV convert operation failed.");
+    }
+    default:
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Tensor type %i is not supported.", tensor.element_type()));
+  }
+}
+
 // Converts input YUV `buffer` into the `output_buffer` in RGB, RGBA or gray
 // scale format.
 absl::Status ConvertYuv(const FrameBuffer& buffer, FrameBuffer* output_buffer) {
@@ -779,6 +849,16 @@ absl::Status ToFloatTensor(const FrameBuffer& buffer, float scale, float offset,
   }
 }
 
+absl::Status CropRotateResizeToTensor(const FrameBuffer& buffer, int x0, int y0,
+                                      int x1, int y1, int angle_deg,
+                                      float scale, float offset,
+                                      Tensor& tensor) {
+  MP_RETURN_IF_ERROR(ValidateCropRotateResizeToTensorInputs(
+      buffer, x0, y0, x1, y1, angle_deg, tensor));
+  return CropRotateResizeYuvToTensor(buffer, x0, y0, x1, y1, angle_deg, scale,
+                                     offset, tensor);
+}
+
 int GetFrameBufferByteSize(FrameBuffer::Dimension dimension,
                            FrameBuffer::Format format) {
   switch (format) {
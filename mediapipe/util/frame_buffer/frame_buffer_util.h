@@ -107,6 +107,23 @@ absl::Status Convert(const FrameBuffer& buffer, FrameBuffer* output_buffer);
 absl::Status ToFloatTensor(const FrameBuffer& buffer, float scale, float offset,
                            Tensor& tensor);
 
+// Crops `buffer` to the specified points, rotates the result counter-clockwise
+// by `angle_deg` (in degrees), resizes it to the size of `tensor` using
+// bilinear interpolation and converts it to RGB, all in a single pass. Values
+// written to a kFloat32 tensor are converted using:
+//   output = input * scale + offset
+// while a kUInt8 tensor receives the RGB values, with scale 1 and offset 0.
+//
+// Produces the same result as Crop, Rotate, Convert and ToFloatTensor one
+// after another, without their intermediate buffers. Only YUV formats are
+// supported; (x0, y0) must be even, the angle must be 0, 90, 180 or 270 and
+// the tensor must have shape [1, height, width, 3]. Returns InvalidArgument
+// otherwise.
+absl::Status CropRotateResizeToTensor(const FrameBuffer& buffer, int x0, int y0,
+                                      int x1, int y1, int angle_deg,
+                                      float scale, float offset,
+                                      Tensor& tensor);
+
 // Miscellaneous Methods
 // -----------------------------------------------------------------
 
@@ -0,0 +1,151 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Benchmarks the frame_buffer_util operations on a 720p camera frame, and
+// compares preparing a model input from an NV21 frame with Crop, Rotate,
+// Convert and ToFloatTensor against CropRotateResizeToTensor.
+//
+// $ bazel run -c opt mediapipe/util/frame_buffer:frame_buffer_util_benchmark
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "benchmark/benchmark.h"
+#include "mediapipe/framework/formats/frame_buffer.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/util/frame_buffer/frame_buffer_util.h"
+
+namespace mediapipe {
+namespace frame_buffer {
+namespace {
+
+constexpr FrameBuffer::Dimension kFrameDimension = {.width = 1280,
+                                                    .height = 720};
+// A centered square region of interest, as used for e.g. face detection.
+constexpr int kCropX0 = 280, kCropY0 = 0, kCropX1 = 999, kCropY1 = 719;
+constexpr FrameBuffer::Dimension kCropDimension = {.width = 720,
+                                                   .height = 720};
+constexpr FrameBuffer::Dimension kTensorDimension = {.width = 256,
+                                                     .height = 256};
+
+// Owns the pixels of a FrameBuffer.
+struct Frame {
+  Frame(FrameBuffer::Dimension dimension, FrameBuffer::Format format)
+      : data(GetFrameBufferByteSize(dimension, format)) {
+    for (int i = 0; i < data.size(); ++i) data[i] = i * 13 % 256;
+    auto frame_buffer = CreateFromRawBuffer(data.data(), dimension, format);
+    ABSL_CHECK_OK(frame_buffer);
+    buffer = *std::move(frame_buffer);
+  }
+
+  std::vector<uint8_t> data;
+  std::shared_ptr<FrameBuffer> buffer;
+};
+
+void BM_Nv21Crop(benchmark::State& state) {
+  Frame input(kFrameDimension, FrameBuffer::Format::kNV21);
+  Frame output(kTensorDimension, FrameBuffer::Format::kNV21);
+  for (auto _ : state) {
+    ABSL_CHECK_OK(Crop(*input.buffer, kCropX0, kCropY0, kCropX1, kCropY1,
+                       output.buffer.get()));
+  }
+}
+BENCHMARK(BM_Nv21Crop);
+
+void BM_Nv21Rotate(benchmark::State& state) {
+  Frame input(kFrameDimension, FrameBuffer::Format::kNV21);
+  Frame output({.width = kFrameDimension.height,
+                .height = kFrameDimension.width},
+               FrameBuffer::Format::kNV21);
+  for (auto _ : state) {
+    ABSL_CHECK_OK(Rotate(*input.buffer, 90, output.buffer.get()));
+  }
+}
+BENCHMARK(BM_Nv21Rotate);
+
+void BM_Nv21ConvertRgb(benchmark::State& state) {
+  Frame input(kFrameDimension, FrameBuffer::Format::kNV21);
+  Frame output(kFrameDimension, FrameBuffer::Format::kRGB);
+  for (auto _ : state) {
+    ABSL_CHECK_OK(Convert(*input.buffer, output.buffer.get()));
+  }
+}
+BENCHMARK(BM_Nv21ConvertRgb);
+
+void BM_RgbResize(benchmark::State& state) {
+  Frame input(kCropDimension, FrameBuffer::Format::kRGB);
+  Frame output(kTensorDimension, FrameBuffer::Format::kRGB);
+  for (auto _ : state) {
+    ABSL_CHECK_OK(Resize(*input.buffer, output.buffer.get()));
+  }
+}
+BENCHMARK(BM_RgbResize);
+
+void BM_RgbToFloatTensor(benchmark::State& state) {
+  Frame input(kTensorDimension, FrameBuffer::Format::kRGB);
+  Tensor tensor(Tensor::ElementType::kFloat32,
+                Tensor::Shape{1, kTensorDimension.height,
+                              kTensorDimension.width, 3});
+  for (auto _ : state) {
+    ABSL_CHECK_OK(ToFloatTensor(*input.buffer, 2.0f / 255.0f, -1.0f, tensor));
+  }
+}
+BENCHMARK(BM_RgbToFloatTensor);
+
+// Arg: rotation angle.
+void BM_Nv21ToFloatTensorInSteps(benchmark::State& state) {
+  const int angle = state.range(0);
+  Frame input(kFrameDimension, FrameBuffer::Format::kNV21);
+  Frame cropped(kTensorDimension, FrameBuffer::Format::kNV21);
+  Frame rotated(kTensorDimension, FrameBuffer::Format::kNV21);
+  Frame rgb(kTensorDimension, FrameBuffer::Format::kRGB);
+  Tensor tensor(Tensor::ElementType::kFloat32,
+                Tensor::Shape{1, kTensorDimension.height,
+                              kTensorDimension.width, 3});
+  for (auto _ : state) {
+    ABSL_CHECK_OK(Crop(*input.buffer, kCropX0, kCropY0, kCropX1, kCropY1,
+                       cropped.buffer.get()));
+    const FrameBuffer* to_convert = cropped.buffer.get();
+    if (angle != 0) {
+      ABSL_CHECK_OK(Rotate(*cropped.buffer, angle, rotated.buffer.get()));
+      to_convert = rotated.buffer.get();
+    }
+    ABSL_CHECK_OK(Convert(*to_convert, rgb.buffer.get()));
+    ABSL_CHECK_OK(ToFloatTensor(*rgb.buffer, 2.0f / 255.0f, -1.0f, tensor));
+  }
+}
+BENCHMARK(BM_Nv21ToFloatTensorInSteps)->Arg(0)->Arg(90);
+
+// Arg: rotation angle.
+void BM_Nv21ToFloatTensorFused(benchmark::State& state) {
+  const int angle = state.range(0);
+  Frame input(kFrameDimension, FrameBuffer::Format::kNV21);
+  Tensor tensor(Tensor::ElementType::kFloat32,
+                Tensor::Shape{1, kTensorDimension.height,
+                              kTensorDimension.width, 3});
+  for (auto _ : state) {
+    ABSL_CHECK_OK(CropRotateResizeToTensor(*input.buffer, kCropX0, kCropY0,
+                                           kCropX1, kCropY1, angle,
+                                           2.0f / 255.0f, -1.0f, tensor));
+  }
+}
+BENCHMARK(BM_Nv21ToFloatTensorFused)->Arg(0)->Arg(90);
+
+}  // namespace
+}  // namespace frame_buffer
+}  // namespace mediapipe
+
+BENCHMARK_MAIN();
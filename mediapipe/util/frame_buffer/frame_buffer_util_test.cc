@@ -14,6 +14,7 @@
 
 #include "mediapipe/util/frame_buffer/frame_buffer_util.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -1195,6 +1196,140 @@ TEST(FrameBufferUtil, NV21ConvertYV12) {
   EXPECT_EQ(nv21_data.v_buffer[0], yv12_data.v_buffer[0]);
 }
 
+// Crops, rotates and converts an NV21 frame into an RGB tensor one step at a
+// time, for comparison with CropRotateResizeToTensor.
+void CropRotateResizeToTensorInSteps(const FrameBuffer& input, int x0, int y0,
+                                     int x1, int y1, int angle_deg,
+                                     float scale, float offset,
+                                     Tensor& tensor) {
+  const FrameBuffer::Dimension output_dimension = {
+      .width = tensor.shape().dims[2], .height = tensor.shape().dims[1]};
+  FrameBuffer::Dimension cropped_dimension = output_dimension;
+  if (angle_deg % 180 != 0) cropped_dimension.Swap();
+  std::vector<uint8_t> cropped_data(
+      GetFrameBufferByteSize(cropped_dimension, FrameBuffer::Format::kNV21));
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto cropped, CreateFromRawBuffer(cropped_data.data(), cropped_dimension,
+                                        FrameBuffer::Format::kNV21));
+  MP_ASSERT_OK(Crop(input, x0, y0, x1, y1, cropped.get()));
+  std::vector<uint8_t> rotated_data(
+      GetFrameBufferByteSize(output_dimension, FrameBuffer::Format::kNV21));
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto rotated, CreateFromRawBuffer(rotated_data.data(), output_dimension,
+                                        FrameBuffer::Format::kNV21));
+  if (angle_deg == 0) {
+    rotated = cropped;
+  } else {
+    MP_ASSERT_OK(Rotate(*cropped, angle_deg, rotated.get()));
+  }
+  std::vector<uint8_t> rgb_data(
+      GetFrameBufferByteSize(output_dimension, FrameBuffer::Format::kRGB));
+  auto rgb = CreateFromRgbRawBuffer(rgb_data.data(), output_dimension);
+  MP_ASSERT_OK(Convert(*rotated, rgb.get()));
+  if (tensor.element_type() == Tensor::ElementType::kFloat32) {
+    MP_ASSERT_OK(ToFloatTensor(*rgb, scale, offset, tensor));
+  } else {
+    auto view = tensor.GetCpuWriteView();
+    std::copy(rgb_data.begin(), rgb_data.end(), view.buffer<uint8_t>());
+  }
+}
+
+class CropRotateResizeToTensorTest : public testing::TestWithParam<int> {};
+
+TEST_P(CropRotateResizeToTensorTest, MatchesSteps) {
+  constexpr FrameBuffer::Dimension kBufferDimension = {.width = 64,
+                                                       .height = 48};
+  constexpr float kScale = 2.0f / 255.0f, kOffset = -1.0f;
+  const int angle_deg = GetParam();
+  std::vector<uint8_t> input_data(
+      GetFrameBufferByteSize(kBufferDimension, FrameBuffer::Format::kNV21));
+  for (int i = 0; i < input_data.size(); ++i) {
+    input_data[i] = (i * 37 + i / 64 * 11) % 256;
+  }
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto input, CreateFromRawBuffer(input_data.data(), kBufferDimension,
+                                      FrameBuffer::Format::kNV21));
+
+  for (Tensor::ElementType type :
+       {Tensor::ElementType::kFloat32, Tensor::ElementType::kUInt8}) {
+    const float scale = type == Tensor::ElementType::kFloat32 ? kScale : 1.0f;
+    const float offset = type == Tensor::ElementType::kFloat32 ? kOffset : 0.0f;
+    const Tensor::Shape shape{1, 32, 48, 3};
+    Tensor expected(type, shape);
+    CropRotateResizeToTensorInSteps(*input, 4, 2, 51, 41, angle_deg, scale,
+                                    offset, expected);
+    Tensor actual(type, shape);
+    MP_ASSERT_OK(CropRotateResizeToTensor(*input, 4, 2, 51, 41, angle_deg,
+                                          scale, offset, actual));
+
+    auto expected_view = expected.GetCpuReadView();
+    auto actual_view = actual.GetCpuReadView();
+    const int num_values = shape.num_elements();
+    if (type == Tensor::ElementType::kFloat32) {
+      const float* expected_data = expected_view.buffer<float>();
+      const float* actual_data = actual_view.buffer<float>();
+      for (int i = 0; i < num_values; ++i) {
+        ASSERT_EQ(actual_data[i], expected_data[i]) << "at " << i;
+      }
+    } else {
+      const uint8_t* expected_data = expected_view.buffer<uint8_t>();
+      const uint8_t* actual_data = actual_view.buffer<uint8_t>();
+      for (int i = 0; i < num_values; ++i) {
+        ASSERT_EQ(actual_data[i], expected_data[i]) << "at " << i;
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Angles, CropRotateResizeToTensorTest,
+                         testing::Values(0, 90, 180, 270));
+
+TEST(FrameBufferUtil, CropRotateResizeToTensorValidatesInputs) {
+  constexpr FrameBuffer::Dimension kBufferDimension = {.width = 64,
+                                                       .height = 48};
+  std::vector<uint8_t> input_data(
+      GetFrameBufferByteSize(kBufferDimension, FrameBuffer::Format::kNV21));
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto input, CreateFromRawBuffer(input_data.data(), kBufferDimension,
+                                      FrameBuffer::Format::kNV21));
+  Tensor tensor(Tensor::ElementType::kFloat32, Tensor::Shape{1, 32, 32, 3});
+
+  // Out of bounds.
+  EXPECT_FALSE(
+      CropRotateResizeToTensor(*input, 0, 0, 64, 47, 0, 1.0f, 0.0f, tensor)
+          .ok());
+  // Odd crop origin.
+  EXPECT_EQ(
+      CropRotateResizeToTensor(*input, 1, 0, 63, 47, 0, 1.0f, 0.0f, tensor)
+          .code(),
+      absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(
+      CropRotateResizeToTensor(*input, 0, 1, 63, 47, 0, 1.0f, 0.0f, tensor)
+          .code(),
+      absl::StatusCode::kInvalidArgument);
+  // Not a multiple of 90 degrees.
+  EXPECT_FALSE(
+      CropRotateResizeToTensor(*input, 0, 0, 63, 47, 45, 1.0f, 0.0f, tensor)
+          .ok());
+  // Not a YUV input.
+  std::vector<uint8_t> rgb_data(
+      GetFrameBufferByteSize(kBufferDimension, FrameBuffer::Format::kRGB));
+  auto rgb = CreateFromRgbRawBuffer(rgb_data.data(), kBufferDimension);
+  EXPECT_FALSE(
+      CropRotateResizeToTensor(*rgb, 0, 0, 63, 47, 0, 1.0f, 0.0f, tensor).ok());
+  // Not an RGB tensor.
+  Tensor rgba_tensor(Tensor::ElementType::kFloat32,
+                     Tensor::Shape{1, 32, 32, 4});
+  EXPECT_FALSE(CropRotateResizeToTensor(*input, 0, 0, 63, 47, 0, 1.0f, 0.0f,
+                                        rgba_tensor)
+                   .ok());
+  // Normalization of uint8 values.
+  Tensor uint8_tensor(Tensor::ElementType::kUInt8, Tensor::Shape{1, 32, 32, 3});
+  EXPECT_FALSE(CropRotateResizeToTensor(*input, 0, 0, 63, 47, 0, 2.0f, 0.0f,
+                                        uint8_tensor)
+                   .ok());
+}
+
 }  // namespace
 }  // namespace frame_buffer
 }  // namespace mediapipe
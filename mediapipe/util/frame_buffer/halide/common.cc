@@ -83,6 +83,41 @@ void rotate(Halide::Func input, Halide::Func result, Halide::Expr width,
              result_270_degrees(x, y, _), input(x, y, _));
 }
 
+// Integer math versions of the full-range JFIF YUV-RGB coefficients.
+//   R = Y' + 1.40200*(V-128)
+//   G = Y' - 0.34414*(U-128) - 0.71414*(V-128)
+//   B = Y' + 1.77200*(U-128)
+// See https://www.w3.org/Graphics/JPEG/jfif3.pdf. These coefficients are
+// similar to, but not identical, to those used in Android. The same math as
+// in yuv_rgb_generator.cc.
+Halide::Expr yuv_rgb(Halide::Expr c, Halide::Expr y, Halide::Expr u,
+                     Halide::Expr v) {
+  y = Halide::cast<int32_t>(y);
+  u = Halide::cast<int32_t>(u) - 128;
+  v = Halide::cast<int32_t>(v) - 128;
+  return select(c == 0, y + ((91881 * v + 32768) >> 16), c == 1,
+                y - ((22544 * u + 46802 * v + 32768) >> 16), c == 2,
+                y + ((116130 * u + 32768) >> 16), 255);
+}
+
+void yuv_resize_rotate_rgb(Halide::Func y_plane, Halide::Func uv_plane,
+                           Halide::Func result, Halide::Expr fx,
+                           Halide::Expr fy, Halide::Expr width,
+                           Halide::Expr height, Halide::Expr angle) {
+  Halide::Var x{"x"}, y{"y"}, c{"c"};
+  Halide::Func y_resized("y_resized"), uv_resized("uv_resized");
+  resize_bilinear_int(y_plane, y_resized, fx, fy);
+  resize_bilinear_int(uv_plane, uv_resized, fx, fy);
+
+  Halide::Func y_rotated("y_rotated"), uv_rotated("uv_rotated");
+  rotate(y_resized, y_rotated, width, height, angle);
+  rotate(uv_resized, uv_rotated, (width + 1) / 2, (height + 1) / 2, angle);
+
+  result(x, y, c) = Halide::saturating_cast<uint8_t>(
+      yuv_rgb(c, y_rotated(x, y), uv_rotated(x / 2, y / 2, 1),
+              uv_rotated(x / 2, y / 2, 0)));
+}
+
 }  // namespace common
 }  // namespace halide
 }  // namespace frame_buffer
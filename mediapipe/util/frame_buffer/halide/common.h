@@ -53,6 +53,21 @@ void resize_bilinear_int(Halide::Func input, Halide::Func result,
 void rotate(Halide::Func input, Halide::Func result, Halide::Expr width,
             Halide::Expr height, Halide::Expr angle);
 
+// Returns channel c of the RGBA value of the given full-range YUV values, as
+// an int32 that still needs to be saturated to [0, 255]. Alpha is opaque.
+Halide::Expr yuv_rgb(Halide::Expr c, Halide::Expr y, Halide::Expr u,
+                     Halide::Expr v);
+
+// Resizes the Y and UV planes of a YUV 4:2:0 image by (fx, fy), rotates them
+// and converts them to 8-bit RGB(A), without intermediate buffers; the result
+// is identical to that of resize_bilinear_int, rotate and yuv_rgb applied one
+// after another. The UV channels are in VU order. Width and height are the
+// dimensions of the resized image before rotation.
+void yuv_resize_rotate_rgb(Halide::Func y_plane, Halide::Func uv_plane,
+                           Halide::Func result, Halide::Expr fx,
+                           Halide::Expr fy, Halide::Expr width,
+                           Halide::Expr height, Halide::Expr angle);
+
 }  // namespace common
 }  // namespace halide
 }  // namespace frame_buffer
@@ -0,0 +1,93 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Halide.h"
+#include "mediapipe/util/frame_buffer/halide/common.h"
+
+namespace {
+
+using ::Halide::BoundaryConditions::repeat_edge;
+using ::mediapipe::frame_buffer::halide::common::yuv_resize_rotate_rgb;
+
+// Resizes, rotates and converts a YUV image to RGB in a single pass.
+// Equivalent to yuv_resize, yuv_rotate and yuv_rgb one after another, without
+// the intermediate buffers.
+class YuvRgbResize : public Halide::Generator<YuvRgbResize> {
+ public:
+  Var x{"x"}, y{"y"}, c{"c"};
+
+  Input<Buffer<uint8_t, 2>> src_y{"src_y"};
+  Input<Buffer<uint8_t, 3>> src_uv{"src_uv"};
+  // Rotation angle in degrees counter-clockwise. Must be in {0, 90, 180, 270}.
+  Input<int> rotation_angle{"rotation_angle", 0};
+
+  Output<Buffer<uint8_t, 3>> dst_rgb{"dst_rgb"};
+
+  void generate();
+  void schedule();
+};
+
+void YuvRgbResize::generate() {
+  // The image is resized to the output size before it gets rotated.
+  const Halide::Expr swap_dimensions =
+      rotation_angle == 90 || rotation_angle == 270;
+  const Halide::Expr width = select(swap_dimensions, dst_rgb.dim(1).extent(),
+                                    dst_rgb.dim(0).extent());
+  const Halide::Expr height = select(swap_dimensions, dst_rgb.dim(0).extent(),
+                                     dst_rgb.dim(1).extent());
+  const Halide::Expr scale_x =
+      Halide::cast<float>(src_y.dim(0).extent()) / width;
+  const Halide::Expr scale_y =
+      Halide::cast<float>(src_y.dim(1).extent()) / height;
+
+  yuv_resize_rotate_rgb(repeat_edge(src_y), repeat_edge(src_uv), dst_rgb,
+                        scale_x, scale_y, width, height, rotation_angle);
+}
+
+void YuvRgbResize::schedule() {
+  // Y plane dimensions start at zero.
+  src_y.dim(0).set_min(0);
+  src_y.dim(1).set_min(0);
+
+  // UV plane has two channels and is half the size of the Y plane in X/Y.
+  // Remove default memory layout constraints on it so that we accept generic
+  // UV (including semi-planar and planar).
+  src_uv.dim(0).set_bounds(0, (src_y.dim(0).extent() + 1) / 2);
+  src_uv.dim(1).set_bounds(0, (src_y.dim(1).extent() + 1) / 2);
+  src_uv.dim(2).set_bounds(0, 2);
+  src_uv.dim(0).set_stride(Expr());
+
+  // The destination buffer starts at zero in every dimension and must be
+  // interleaved RGB.
+  dst_rgb.dim(0).set_min(0);
+  dst_rgb.dim(1).set_min(0);
+  dst_rgb.dim(2).set_bounds(0, 3);
+  dst_rgb.dim(0).set_stride(3);
+  dst_rgb.dim(2).set_stride(1);
+
+  // Specializing on the angle drops the unused branches of the rotation;
+  // otherwise all four would be interpolated for every pixel.
+  const int vector_size = natural_vector_size<uint8_t>();
+  Halide::Func dst_rgb_func = dst_rgb;
+  dst_rgb_func.reorder(c, x, y).unroll(c);
+  for (const int angle : {0, 90, 180, 270}) {
+    dst_rgb_func.specialize(rotation_angle == angle)
+        .specialize(dst_rgb.dim(0).extent() >= vector_size)
+        .vectorize(x, vector_size);
+  }
+}
+
+}  // namespace
+
+HALIDE_REGISTER_GENERATOR(YuvRgbResize, yuv_rgb_resize_generator)
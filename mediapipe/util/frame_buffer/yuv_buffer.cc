@@ -17,9 +17,12 @@
 #include <utility>
 
 #include "mediapipe/util/frame_buffer/buffer_common.h"
+#include "mediapipe/util/frame_buffer/float_buffer.h"
 #include "mediapipe/util/frame_buffer/halide/yuv_flip_halide.h"
+#include "mediapipe/util/frame_buffer/halide/yuv_float_halide.h"
 #include "mediapipe/util/frame_buffer/halide/yuv_resize_halide.h"
 #include "mediapipe/util/frame_buffer/halide/yuv_rgb_halide.h"
+#include "mediapipe/util/frame_buffer/halide/yuv_rgb_resize_halide.h"
 #include "mediapipe/util/frame_buffer/halide/yuv_rotate_halide.h"
 #include "mediapipe/util/frame_buffer/rgb_buffer.h"
 
@@ -148,5 +151,18 @@ bool YuvBuffer::Convert(bool halve, RgbBuffer* output) {
   return result == 0;
 }
 
+bool YuvBuffer::ResizeRotateConvert(int angle, RgbBuffer* output) {
+  const int result = yuv_rgb_resize_halide(y_buffer(), uv_buffer(), angle,
+                                           output->buffer());
+  return result == 0;
+}
+
+bool YuvBuffer::ResizeRotateToFloat(int angle, float scale, float offset,
+                                    FloatBuffer* output) {
+  const int result = yuv_float_halide(y_buffer(), uv_buffer(), angle, scale,
+                                      offset, output->buffer());
+  return result == 0;
+}
+
 }  // namespace frame_buffer
 }  // namespace mediapipe
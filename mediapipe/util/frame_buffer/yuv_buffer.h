@@ -22,6 +22,7 @@
 
 namespace mediapipe {
 namespace frame_buffer {
+class FloatBuffer;
 class RgbBuffer;
 
 // YuvBuffer represents a view over a YUV 4:2:0 image.
@@ -120,6 +121,18 @@ class YuvBuffer {
   // two by discarding three of four luminance values in every 2x2 block.
   bool Convert(bool halve, RgbBuffer* output);
 
+  // Resizes this image, rotates it by the given angle (0, 90, 180, 270) and
+  // converts it to RGB into the given output RgbBuffer, in a single pass.
+  // Produces the same result as Resize, Rotate and Convert one after another,
+  // without intermediate buffers. The output must be RGB, not RGBA, and have
+  // the dimensions of the rotated image.
+  bool ResizeRotateConvert(int angle, RgbBuffer* output);
+
+  // Same as ResizeRotateConvert, followed by a conversion of each value to
+  // float: value * scale + offset. The output must have 3 channels.
+  bool ResizeRotateToFloat(int angle, float scale, float offset,
+                           FloatBuffer* output);
+
   // Release ownership of the owned backing buffer.
   uint8_t* Release() { return owned_buffer_.release(); }
 
@@ -0,0 +1,152 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/incremental_annotation_renderer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "absl/log/absl_check.h"
+#include "absl/types/span.h"
+#include "mediapipe/framework/port/opencv_core_inc.h"
+#include "mediapipe/util/render_data.pb.h"
+
+namespace mediapipe {
+namespace {
+
+// Copies the pixels of `layer` that are not of the background color onto
+// `image`, which has the same size.
+template <int kChannels>
+void CompositeRegion(const cv::Mat& layer, cv::Mat& image) {
+  constexpr uint8_t kKey = IncrementalAnnotationRenderer::kBackgroundColor;
+  for (int y = 0; y < layer.rows; ++y) {
+    const uint8_t* src = layer.ptr<uint8_t>(y);
+    uint8_t* dst = image.ptr<uint8_t>(y);
+    for (int x = 0; x < layer.cols; ++x, src += kChannels, dst += kChannels) {
+      if (src[0] != kKey || src[1] != kKey || src[2] != kKey) {
+        std::memcpy(dst, src, kChannels);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+IncrementalAnnotationRenderer::IncrementalAnnotationRenderer() {
+  renderer_.SetTrackRenderedRegions(true);
+}
+
+void IncrementalAnnotationRenderer::SetFlipTextVertically(bool flip) {
+  renderer_.SetFlipTextVertically(flip);
+  // Forces the layer to be re-rendered.
+  layer_.release();
+}
+
+void IncrementalAnnotationRenderer::RenderDataOnImage(
+    absl::Span<const RenderData* const> render_data, cv::Mat& image) {
+  ABSL_CHECK(image.type() == CV_8UC3 || image.type() == CV_8UC4)
+      << "Unsupported image type: " << image.type();
+  bool changed = UpdateRenderData(render_data);
+  if (layer_.size() != image.size() || layer_.type() != image.type()) {
+    layer_.create(image.rows, image.cols, image.type());
+    layer_.setTo(cv::Scalar::all(kBackgroundColor));
+    num_tile_columns_ = (image.cols + kTileSize - 1) / kTileSize;
+    num_tile_rows_ = (image.rows + kTileSize - 1) / kTileSize;
+    dirty_tiles_.assign(num_tile_columns_ * num_tile_rows_, false);
+    changed = true;
+  }
+  last_call_rendered_ = changed;
+  if (changed) RenderLayer(render_data);
+
+  // Composites horizontal runs of dirty tiles at once.
+  const cv::Rect image_rect(0, 0, image.cols, image.rows);
+  for (int row = 0; row < num_tile_rows_; ++row) {
+    int column = 0;
+    while (column < num_tile_columns_) {
+      if (!dirty_tiles_[row * num_tile_columns_ + column]) {
+        ++column;
+        continue;
+      }
+      const int first_column = column;
+      while (column < num_tile_columns_ &&
+             dirty_tiles_[row * num_tile_columns_ + column]) {
+        ++column;
+      }
+      Composite(cv::Rect(first_column * kTileSize, row * kTileSize,
+                         (column - first_column) * kTileSize, kTileSize) &
+                    image_rect,
+                image);
+    }
+  }
+}
+
+bool IncrementalAnnotationRenderer::UpdateRenderData(
+    absl::Span<const RenderData* const> render_data) {
+  bool changed = render_data.size() != serialized_render_data_.size();
+  serialized_render_data_.resize(render_data.size());
+  std::string serialized;
+  for (int i = 0; i < render_data.size(); ++i) {
+    render_data[i]->SerializeToString(&serialized);
+    if (serialized != serialized_render_data_[i]) {
+      serialized_render_data_[i].swap(serialized);
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+void IncrementalAnnotationRenderer::RenderLayer(
+    absl::Span<const RenderData* const> render_data) {
+  // Everything previously rendered lies within the dirty tiles.
+  for (int row = 0; row < num_tile_rows_; ++row) {
+    for (int column = 0; column < num_tile_columns_; ++column) {
+      if (!dirty_tiles_[row * num_tile_columns_ + column]) continue;
+      layer_(cv::Rect(column * kTileSize, row * kTileSize, kTileSize,
+                      kTileSize) &
+             cv::Rect(0, 0, layer_.cols, layer_.rows))
+          .setTo(cv::Scalar::all(kBackgroundColor));
+    }
+  }
+  std::fill(dirty_tiles_.begin(), dirty_tiles_.end(), false);
+
+  renderer_.AdoptImage(&layer_);
+  renderer_.ClearRenderedRegions();
+  for (const RenderData* data : render_data) {
+    renderer_.RenderDataOnImage(*data);
+  }
+  for (const cv::Rect& region : renderer_.GetRenderedRegions()) {
+    const int last_column = (region.x + region.width - 1) / kTileSize;
+    const int last_row = (region.y + region.height - 1) / kTileSize;
+    for (int row = region.y / kTileSize; row <= last_row; ++row) {
+      for (int column = region.x / kTileSize; column <= last_column;
+           ++column) {
+        dirty_tiles_[row * num_tile_columns_ + column] = true;
+      }
+    }
+  }
+}
+
+void IncrementalAnnotationRenderer::Composite(const cv::Rect& region,
+                                              cv::Mat& image) const {
+  cv::Mat image_region = image(region);
+  if (image.channels() == 4) {
+    CompositeRegion<4>(layer_(region), image_region);
+  } else {
+    CompositeRegion<3>(layer_(region), image_region);
+  }
+}
+
+}  // namespace mediapipe
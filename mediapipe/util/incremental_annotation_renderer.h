@@ -0,0 +1,95 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_UTIL_INCREMENTAL_ANNOTATION_RENDERER_H_
+#define MEDIAPIPE_UTIL_INCREMENTAL_ANNOTATION_RENDERER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "mediapipe/framework/port/opencv_core_inc.h"
+#include "mediapipe/util/annotation_renderer.h"
+#include "mediapipe/util/render_data.pb.h"
+
+namespace mediapipe {
+
+// Renders annotations on a stream of images, doing work proportional to the
+// area covered by the annotations rather than to the image size.
+//
+// The annotations are rendered with AnnotationRenderer into an overlay layer
+// cached across calls. The layer is only re-rendered when the RenderData
+// differs from the previous call, and only the parts of it that were drawn on
+// are cleared. The layer is then composited onto the image within the
+// bounding boxes of the rendered annotations, split into tiles.
+//
+// Like the GPU path of AnnotationOverlayCalculator, the layer uses
+// kBackgroundColor as its transparent color: annotations drawn in this exact
+// color are not rendered, and anti-aliased edges are blended with it instead of
+// with the image.
+//
+// Example usage:
+//
+// IncrementalAnnotationRenderer renderer;
+// for (...) {
+//   cv::Mat image = <NEXT FRAME>;
+//   renderer.RenderDataOnImage({&render_data_0, &render_data_1}, image);
+// }
+class IncrementalAnnotationRenderer {
+ public:
+  // The transparent color of the overlay layer, as an RGB gray value.
+  static constexpr uint8_t kBackgroundColor = 2;
+  // The size of the tiles the layer is composited in, in pixels.
+  static constexpr int kTileSize = 32;
+
+  IncrementalAnnotationRenderer();
+
+  // Renders `render_data` in order on `image`, which must be of type CV_8UC3
+  // or CV_8UC4. Produces the same pixels as AnnotationRenderer, except for the
+  // limitations above.
+  void RenderDataOnImage(absl::Span<const RenderData* const> render_data,
+                         cv::Mat& image);
+
+  // See AnnotationRenderer::SetFlipTextVertically(bool).
+  void SetFlipTextVertically(bool flip);
+
+  // Whether the last call to RenderDataOnImage() re-rendered the layer.
+  bool last_call_rendered() const { return last_call_rendered_; }
+
+ private:
+  // Returns whether `render_data` differs from the one of the previous call,
+  // and caches it.
+  bool UpdateRenderData(absl::Span<const RenderData* const> render_data);
+
+  // Clears the layer and renders `render_data` into it.
+  void RenderLayer(absl::Span<const RenderData* const> render_data);
+
+  // Copies the drawn pixels of the layer within `region` onto `image`.
+  void Composite(const cv::Rect& region, cv::Mat& image) const;
+
+  AnnotationRenderer renderer_;
+  cv::Mat layer_;
+  // Row-major grid of the tiles of layer_ that were rendered on.
+  std::vector<bool> dirty_tiles_;
+  int num_tile_columns_ = 0;
+  int num_tile_rows_ = 0;
+  // The serialized RenderData rendered in layer_.
+  std::vector<std::string> serialized_render_data_;
+  bool last_call_rendered_ = false;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_UTIL_INCREMENTAL_ANNOTATION_RENDERER_H_
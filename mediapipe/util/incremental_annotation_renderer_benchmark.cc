@@ -0,0 +1,117 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Compares the CPU path of AnnotationOverlayCalculator, which copies the frame
+// into a render target, renders all annotations on it and copies it into the
+// output frame, with IncrementalAnnotationRenderer, which copies the frame
+// into the output once and blends a cached overlay onto it. The overlay is a
+// hand landmark skeleton (21 points, 21 connections), either moving every
+// frame or static.
+//
+// $ bazel run -c opt mediapipe/util:incremental_annotation_renderer_benchmark
+
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "mediapipe/framework/port/opencv_core_inc.h"
+#include "mediapipe/util/annotation_renderer.h"
+#include "mediapipe/util/incremental_annotation_renderer.h"
+#include "mediapipe/util/render_data.pb.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr int kNumLandmarks = 21;
+
+// A hand-sized skeleton of normalized landmarks, shifted by `frame`.
+RenderData MakeLandmarkRenderData(int frame) {
+  RenderData render_data;
+  float x[kNumLandmarks];
+  float y[kNumLandmarks];
+  for (int i = 0; i < kNumLandmarks; ++i) {
+    x[i] = 0.4f + 0.1f * std::cos(i * 0.3f) + 0.001f * (frame % 50);
+    y[i] = 0.4f + 0.1f * std::sin(i * 0.3f);
+  }
+  for (int i = 0; i < kNumLandmarks; ++i) {
+    auto* line = render_data.add_render_annotations();
+    line->set_thickness(4);
+    line->mutable_color()->set_g(255);
+    line->mutable_line()->set_normalized(true);
+    line->mutable_line()->set_x_start(x[i]);
+    line->mutable_line()->set_y_start(y[i]);
+    line->mutable_line()->set_x_end(x[(i + 1) % kNumLandmarks]);
+    line->mutable_line()->set_y_end(y[(i + 1) % kNumLandmarks]);
+  }
+  for (int i = 0; i < kNumLandmarks; ++i) {
+    auto* point = render_data.add_render_annotations();
+    point->set_thickness(6);
+    point->mutable_color()->set_r(255);
+    point->mutable_point()->set_normalized(true);
+    point->mutable_point()->set_x(x[i]);
+    point->mutable_point()->set_y(y[i]);
+  }
+  return render_data;
+}
+
+// Args: image width, image height, whether the landmarks move.
+void BM_FullFrame(benchmark::State& state) {
+  const cv::Mat input(state.range(1), state.range(0), CV_8UC3,
+                      cv::Scalar(30, 60, 90));
+  cv::Mat output(input.size(), input.type());
+  AnnotationRenderer renderer;
+  int frame = 0;
+  for (auto _ : state) {
+    const RenderData render_data =
+        MakeLandmarkRenderData(state.range(2) ? frame++ : 0);
+    cv::Mat render_target = input.clone();
+    renderer.AdoptImage(&render_target);
+    renderer.RenderDataOnImage(render_data);
+    std::memcpy(output.data, render_target.data,
+                render_target.total() * render_target.elemSize());
+    benchmark::DoNotOptimize(output.data);
+  }
+}
+
+void BM_Incremental(benchmark::State& state) {
+  const cv::Mat input(state.range(1), state.range(0), CV_8UC3,
+                      cv::Scalar(30, 60, 90));
+  cv::Mat output(input.size(), input.type());
+  IncrementalAnnotationRenderer renderer;
+  int frame = 0;
+  for (auto _ : state) {
+    const RenderData render_data =
+        MakeLandmarkRenderData(state.range(2) ? frame++ : 0);
+    input.copyTo(output);
+    renderer.RenderDataOnImage({&render_data}, output);
+    benchmark::DoNotOptimize(output.data);
+  }
+}
+
+void FrameSizes(benchmark::internal::Benchmark* benchmark) {
+  for (const auto& [width, height] :
+       {std::pair{1920, 1080}, std::pair{3840, 2160}}) {
+    benchmark->Args({width, height, 1})->Args({width, height, 0});
+  }
+}
+
+BENCHMARK(BM_FullFrame)->Apply(FrameSizes);
+BENCHMARK(BM_Incremental)->Apply(FrameSizes);
+
+}  // namespace
+}  // namespace mediapipe
+
+BENCHMARK_MAIN();
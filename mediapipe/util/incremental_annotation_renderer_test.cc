@@ -0,0 +1,154 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/incremental_annotation_renderer.h"
+
+#include <vector>
+
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/opencv_core_inc.h"
+#include "mediapipe/util/annotation_renderer.h"
+#include "mediapipe/util/render_data.pb.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr int kWidth = 200;
+constexpr int kHeight = 120;
+
+RenderData MakeRenderData(float offset) {
+  RenderData render_data;
+  auto* point = render_data.add_render_annotations();
+  point->set_thickness(3);
+  point->mutable_color()->set_r(255);
+  point->mutable_point()->set_normalized(true);
+  point->mutable_point()->set_x(0.2 + offset);
+  point->mutable_point()->set_y(0.3);
+
+  auto* line = render_data.add_render_annotations();
+  line->set_thickness(2);
+  line->mutable_color()->set_g(255);
+  line->mutable_line()->set_x_start(10 + offset * kWidth);
+  line->mutable_line()->set_y_start(100);
+  line->mutable_line()->set_x_end(150 + offset * kWidth);
+  line->mutable_line()->set_y_end(20);
+
+  auto* rectangle = render_data.add_render_annotations();
+  rectangle->set_thickness(1);
+  rectangle->mutable_color()->set_b(200);
+  rectangle->mutable_rectangle()->set_normalized(true);
+  rectangle->mutable_rectangle()->set_left(0.5);
+  rectangle->mutable_rectangle()->set_top(0.1 + offset);
+  rectangle->mutable_rectangle()->set_right(0.9);
+  rectangle->mutable_rectangle()->set_bottom(0.6 + offset);
+  rectangle->mutable_rectangle()->set_rotation(0.3);
+
+  auto* text = render_data.add_render_annotations();
+  text->set_thickness(1);
+  text->mutable_color()->set_r(20);
+  text->mutable_color()->set_g(40);
+  text->mutable_color()->set_b(60);
+  text->mutable_text()->set_display_text("MediaPipe");
+  text->mutable_text()->set_left(40);
+  text->mutable_text()->set_baseline(60 + offset * kHeight);
+  text->mutable_text()->set_font_height(16);
+  text->mutable_text()->set_outline_thickness(1);
+  text->mutable_text()->mutable_outline_color()->set_r(255);
+  return render_data;
+}
+
+cv::Mat MakeImage(int type, int seed) {
+  cv::Mat image(kHeight, kWidth, type);
+  cv::randu(image, cv::Scalar::all(seed), cv::Scalar::all(seed + 100));
+  return image;
+}
+
+cv::Mat RenderDirectly(const RenderData& render_data, const cv::Mat& image) {
+  cv::Mat expected = image.clone();
+  AnnotationRenderer renderer;
+  renderer.AdoptImage(&expected);
+  renderer.RenderDataOnImage(render_data);
+  return expected;
+}
+
+void ExpectEqual(const cv::Mat& actual, const cv::Mat& expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  ASSERT_EQ(actual.type(), expected.type());
+  EXPECT_EQ(cv::norm(actual, expected, cv::NORM_INF), 0);
+}
+
+TEST(IncrementalAnnotationRendererTest, MatchesAnnotationRenderer) {
+  for (int type : {CV_8UC3, CV_8UC4}) {
+    IncrementalAnnotationRenderer renderer;
+    const RenderData render_data = MakeRenderData(0.0f);
+    const cv::Mat image = MakeImage(type, 10);
+    cv::Mat actual = image.clone();
+    renderer.RenderDataOnImage({&render_data}, actual);
+    ExpectEqual(actual, RenderDirectly(render_data, image));
+  }
+}
+
+TEST(IncrementalAnnotationRendererTest, ReusesLayerForUnchangedRenderData) {
+  IncrementalAnnotationRenderer renderer;
+  const RenderData render_data = MakeRenderData(0.0f);
+  for (int frame = 0; frame < 3; ++frame) {
+    const cv::Mat image = MakeImage(CV_8UC3, 10 * frame);
+    cv::Mat actual = image.clone();
+    renderer.RenderDataOnImage({&render_data}, actual);
+    EXPECT_EQ(renderer.last_call_rendered(), frame == 0);
+    ExpectEqual(actual, RenderDirectly(render_data, image));
+  }
+}
+
+TEST(IncrementalAnnotationRendererTest, ClearsPreviousAnnotations) {
+  IncrementalAnnotationRenderer renderer;
+  const cv::Mat image = MakeImage(CV_8UC3, 10);
+  for (float offset : {0.0f, 0.1f, 0.25f}) {
+    const RenderData render_data = MakeRenderData(offset);
+    cv::Mat actual = image.clone();
+    renderer.RenderDataOnImage({&render_data}, actual);
+    EXPECT_TRUE(renderer.last_call_rendered());
+    ExpectEqual(actual, RenderDirectly(render_data, image));
+  }
+
+  // Nothing left to render.
+  cv::Mat actual = image.clone();
+  renderer.RenderDataOnImage({}, actual);
+  EXPECT_TRUE(renderer.last_call_rendered());
+  ExpectEqual(actual, image);
+}
+
+TEST(IncrementalAnnotationRendererTest, RendersInOrder) {
+  IncrementalAnnotationRenderer renderer;
+  const RenderData first = MakeRenderData(0.0f);
+  const RenderData second = MakeRenderData(0.05f);
+  const cv::Mat image = MakeImage(CV_8UC3, 10);
+  cv::Mat actual = image.clone();
+  renderer.RenderDataOnImage({&first, &second}, actual);
+
+  cv::Mat expected = image.clone();
+  AnnotationRenderer direct_renderer;
+  direct_renderer.AdoptImage(&expected);
+  direct_renderer.RenderDataOnImage(first);
+  direct_renderer.RenderDataOnImage(second);
+  ExpectEqual(actual, expected);
+
+  // Swapping the order re-renders the layer.
+  actual = image.clone();
+  renderer.RenderDataOnImage({&second, &first}, actual);
+  EXPECT_TRUE(renderer.last_call_rendered());
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,50 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/parallel_for_rows.h"
+
+#include <algorithm>
+
+#include "absl/functional/function_ref.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "mediapipe/framework/port/threadpool.h"
+
+namespace mediapipe {
+
+void ParallelForRows(int num_rows, int min_rows_per_band,
+                     ThreadPool* thread_pool,
+                     absl::FunctionRef<void(int begin, int end)> process_rows) {
+  if (num_rows <= 0) return;
+  int num_bands = 1;
+  if (thread_pool != nullptr) {
+    num_bands = std::min(thread_pool->num_threads() + 1,
+                         num_rows / std::max(min_rows_per_band, 1));
+  }
+  if (num_bands <= 1) {
+    process_rows(0, num_rows);
+    return;
+  }
+  absl::BlockingCounter pending_bands(num_bands - 1);
+  for (int band = 1; band < num_bands; ++band) {
+    thread_pool->Schedule([&, band] {
+      process_rows(num_rows * band / num_bands,
+                   num_rows * (band + 1) / num_bands);
+      pending_bands.DecrementCount();
+    });
+  }
+  process_rows(0, num_rows / num_bands);
+  pending_bands.Wait();
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,41 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_UTIL_PARALLEL_FOR_ROWS_H_
+#define MEDIAPIPE_UTIL_PARALLEL_FOR_ROWS_H_
+
+#include "absl/functional/function_ref.h"
+#include "mediapipe/framework/port/threadpool.h"
+
+namespace mediapipe {
+
+// Splits [0, num_rows) into contiguous bands and calls "process_rows(begin,
+// end)" once per band. The first band runs on the calling thread and the
+// others on "thread_pool", one band per thread, but no band is smaller than
+// "min_rows_per_band". Returns when all bands are processed.
+//
+// Runs everything on the calling thread if "thread_pool" is null. Bands must
+// not depend on each other, and "thread_pool" must not be busy with work that
+// waits for this call.
+//
+// Meant for image kernels that write disjoint output rows, with a thread pool
+// owned by the calculator, so that the thread count can be configured per
+// node.
+void ParallelForRows(int num_rows, int min_rows_per_band,
+                     ThreadPool* thread_pool,
+                     absl::FunctionRef<void(int begin, int end)> process_rows);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_UTIL_PARALLEL_FOR_ROWS_H_
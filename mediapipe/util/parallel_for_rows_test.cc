@@ -0,0 +1,74 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/parallel_for_rows.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/threadpool.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::Each;
+using ::testing::ElementsAre;
+
+TEST(ParallelForRowsTest, RunsOnCallingThreadWithoutPool) {
+  std::vector<std::pair<int, int>> bands;
+  ParallelForRows(/*num_rows=*/10, /*min_rows_per_band=*/1,
+                  /*thread_pool=*/nullptr,
+                  [&](int begin, int end) { bands.push_back({begin, end}); });
+  EXPECT_THAT(bands, ElementsAre(std::pair{0, 10}));
+}
+
+TEST(ParallelForRowsTest, CoversEachRowOnce) {
+  ThreadPool thread_pool("parallel_for_rows_test", /*num_threads=*/3);
+  thread_pool.StartWorkers();
+  for (int num_rows : {1, 2, 3, 4, 5, 17, 1080}) {
+    std::vector<std::atomic<int>> counts(num_rows);
+    std::atomic<int> num_bands = 0;
+    ParallelForRows(num_rows, /*min_rows_per_band=*/1, &thread_pool,
+                    [&](int begin, int end) {
+                      EXPECT_LT(begin, end);
+                      ++num_bands;
+                      for (int row = begin; row < end; ++row) ++counts[row];
+                    });
+    EXPECT_EQ(num_bands, std::min(num_rows, 4));
+    for (int row = 0; row < num_rows; ++row) {
+      EXPECT_EQ(counts[row], 1) << "num_rows=" << num_rows << " row=" << row;
+    }
+  }
+}
+
+TEST(ParallelForRowsTest, RespectsMinRowsPerBand) {
+  ThreadPool thread_pool("parallel_for_rows_test", /*num_threads=*/3);
+  thread_pool.StartWorkers();
+  std::vector<int> band_sizes(4, 0);
+  std::atomic<int> num_bands = 0;
+  ParallelForRows(/*num_rows=*/100, /*min_rows_per_band=*/40, &thread_pool,
+                  [&](int begin, int end) {
+                    band_sizes[num_bands++] = end - begin;
+                  });
+  EXPECT_EQ(num_bands, 2);
+  EXPECT_THAT(std::vector<int>(band_sizes.begin(), band_sizes.begin() + 2),
+              Each(50));
+}
+
+}  // namespace
+}  // namespace mediapipe